@@ -0,0 +1,168 @@
+/**
+ * @file barreras.h
+ * @brief Barreras reutilizables y phaser para algoritmos por fases
+ * @author Ejercicios C
+ * @date 2025
+ *
+ * Un algoritmo por fases (reducciones iterativas, relajaciones, simulaciones)
+ * que crea y une los hilos en cada fase paga pthread_create + pthread_join
+ * por fase, decenas de microsegundos por hilo. Con hilos persistentes basta
+ * una barrera entre fases:
+ *
+ * - barrera_centralizada_t: un contador y un sentido global. El último en
+ *   llegar reinicia el contador e invierte el sentido; el resto espera a ver
+ *   el cambio. Cada sentido local se deduce del global al llegar (no puede
+ *   cambiar hasta que lleguen todos), así que no hace falta estado por hilo.
+ *   Todos los hilos tocan la misma línea de caché: O(n) traspasos por fase.
+ * - barrera_diseminacion_t: en la ronda k el hilo i avisa al hilo
+ *   (i + 2^k) mod n y espera el aviso de (i - 2^k) mod n. Tras log2(n)
+ *   rondas todos saben que todos han llegado. Cada hilo espera sobre su
+ *   propia línea de caché, lo que escala mejor con muchos núcleos.
+ * - phaser_t: barrera con registro dinámico. Los participantes pueden
+ *   registrarse y darse de baja entre fases, y llegar sin esperar. Todo el
+ *   estado (fase, registrados, pendientes) va en una palabra de 64 bits que se
+ *   actualiza con CAS.
+ *
+ * La espera gira unas vueltas con pausa de CPU y después cede la CPU con
+ * sched_yield, para no bloquear la máquina si hay más hilos que núcleos.
+ */
+
+#ifndef BARRERAS_H
+#define BARRERAS_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define TAM_LINEA_BARRERA 64
+#define MAX_RONDAS_DISEMINACION 16       // Hasta 65536 hilos
+#define MAX_PARTICIPANTES_PHASER 0xFFFF
+
+/* ====================================================================
+ * BARRERA CENTRALIZADA CON INVERSIÓN DE SENTIDO
+ * ==================================================================== */
+
+/**
+ * @brief Barrera centralizada con inversión de sentido
+ */
+typedef struct {
+    _Alignas(TAM_LINEA_BARRERA) atomic_int pendientes;  // Hilos que faltan por llegar
+    _Alignas(TAM_LINEA_BARRERA) atomic_int sentido;     // Cambia al completar cada fase
+    int num_hilos;
+} barrera_centralizada_t;
+
+/**
+ * @brief Inicializa la barrera para num_hilos participantes
+ * @return true si num_hilos es válido (> 0)
+ */
+bool barrera_centralizada_init(barrera_centralizada_t* barrera, int num_hilos);
+
+/**
+ * @brief Espera a que lleguen todos los participantes
+ * @return true en exactamente un hilo por fase (el último en llegar)
+ */
+bool barrera_centralizada_esperar(barrera_centralizada_t* barrera);
+
+/* ====================================================================
+ * BARRERA DE DISEMINACIÓN
+ * ==================================================================== */
+
+/**
+ * @brief Estado de un participante: avisos recibidos por paridad y ronda
+ */
+typedef struct {
+    _Alignas(TAM_LINEA_BARRERA) atomic_int avisos[2][MAX_RONDAS_DISEMINACION];
+    int paridad;      // Alterna entre fases para no pisar avisos de la anterior
+    int sentido;      // Valor que indica "aviso recibido" en esta paridad
+} participante_diseminacion_t;
+
+/**
+ * @brief Barrera de diseminación (Hensgen, Finkel y Manber)
+ */
+typedef struct {
+    participante_diseminacion_t* participantes;
+    int num_hilos;
+    int rondas;       // ceil(log2(num_hilos))
+} barrera_diseminacion_t;
+
+/**
+ * @brief Reserva el estado de num_hilos participantes
+ * @return true si la reserva fue exitosa
+ */
+bool barrera_diseminacion_init(barrera_diseminacion_t* barrera, int num_hilos);
+
+/**
+ * @brief Libera la barrera (sin hilos esperando)
+ */
+void barrera_diseminacion_destruir(barrera_diseminacion_t* barrera);
+
+/**
+ * @brief Espera a que lleguen todos los participantes
+ * @param id_hilo Identificador del participante, en [0, num_hilos)
+ * @return true en el participante 0
+ */
+bool barrera_diseminacion_esperar(barrera_diseminacion_t* barrera, int id_hilo);
+
+/* ====================================================================
+ * PHASER
+ * ==================================================================== */
+
+/**
+ * @brief Phaser: barrera reutilizable con registro dinámico
+ *
+ * estado = fase (32 bits) | registrados (16 bits) | pendientes (16 bits)
+ */
+typedef struct {
+    _Alignas(TAM_LINEA_BARRERA) _Atomic uint64_t estado;
+} phaser_t;
+
+/**
+ * @brief Inicializa el phaser en la fase 0
+ * @param participantes Participantes registrados desde el principio
+ * @return true si el número es válido (0..MAX_PARTICIPANTES_PHASER)
+ */
+bool phaser_init(phaser_t* phaser, int participantes);
+
+/**
+ * @brief Registra un participante más
+ * @return Fase en la que entra (debe llegar a ella), o -1 si no caben más
+ *
+ * Registrarse durante una fase añade un pendiente a esa misma fase.
+ */
+int phaser_registrar(phaser_t* phaser);
+
+/**
+ * @brief Llega a la fase actual sin esperar a los demás
+ * @return Fase a la que se llegó, o -1 si no había participantes pendientes
+ */
+int phaser_llegar(phaser_t* phaser);
+
+/**
+ * @brief Llega y espera a que la fase se complete
+ * @return Número de la nueva fase, o -1 si no había participantes pendientes
+ */
+int phaser_llegar_y_esperar(phaser_t* phaser);
+
+/**
+ * @brief Llega a la fase actual y se da de baja para las siguientes
+ * @return Fase a la que se llegó, o -1 si no había participantes pendientes
+ */
+int phaser_llegar_y_desregistrar(phaser_t* phaser);
+
+/**
+ * @brief Espera a que termine la fase indicada (sin llegar a ella)
+ * @return Número de fase actual al salir
+ */
+int phaser_esperar_fase(phaser_t* phaser, int fase);
+
+/**
+ * @brief Fase actual
+ */
+int phaser_fase(phaser_t* phaser);
+
+/**
+ * @brief Participantes registrados
+ */
+int phaser_registrados(phaser_t* phaser);
+
+#endif /* BARRERAS_H */
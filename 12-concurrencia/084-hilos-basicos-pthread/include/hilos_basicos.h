@@ -12,6 +12,8 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "pool_hilos.h"
+
 /* ====================================================================
  * CONFIGURACIÓN Y CONSTANTES
  * ==================================================================== */
@@ -103,17 +105,19 @@ int demostrar_hilo_basico(void);
 int demostrar_hilos_con_parametros(void);
 
 /**
- * @brief Demuestra la creación de múltiples hilos
- * @param num_hilos Número de hilos a crear
+ * @brief Demuestra la ejecución de múltiples tareas de trabajo
+ * @param pool Pool del programa (se reutiliza entre demostraciones)
+ * @param num_hilos Número de tareas a lanzar
  * @return 0 si es exitoso, código de error en caso contrario
  */
-int demostrar_multiples_hilos(int num_hilos);
+int demostrar_multiples_hilos(pool_hilos_t* pool, int num_hilos);
 
 /**
  * @brief Demuestra hilos realizando cálculos paralelos
+ * @param pool Pool del programa (se reutiliza entre demostraciones)
  * @return 0 si es exitoso, código de error en caso contrario
  */
-int demostrar_calculo_paralelo(void);
+int demostrar_calculo_paralelo(pool_hilos_t* pool);
 
 /**
  * @brief Demuestra la sincronización básica entre hilos
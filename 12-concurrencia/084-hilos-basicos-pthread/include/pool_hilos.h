@@ -0,0 +1,148 @@
+/**
+ * @file pool_hilos.h
+ * @brief Pool de hilos reutilizable con robo de trabajo (work stealing)
+ * @author Ejercicios C
+ * @date 2025
+ *
+ * Cada trabajador tiene su propia deque de Chase-Lev: añade y saca tareas
+ * por un extremo sin locks, y los trabajadores ociosos roban por el otro
+ * extremo a una víctima elegida al azar. Las tareas enviadas desde hilos que
+ * no pertenecen al pool entran por una cola global protegida con mutex.
+ */
+
+#ifndef POOL_HILOS_H
+#define POOL_HILOS_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ====================================================================
+ * TIPOS
+ * ==================================================================== */
+
+/**
+ * @brief Función que ejecuta una tarea del pool
+ */
+typedef void (*tarea_fn_t)(void* arg);
+
+/**
+ * @brief Función que procesa el subrango [desde, hasta) de un bucle paralelo
+ */
+typedef void (*rango_fn_t)(void* arg, long desde, long hasta);
+
+/**
+ * @brief Pool de hilos (estructura opaca)
+ */
+typedef struct pool_hilos pool_hilos_t;
+
+/**
+ * @brief Grupo de espera: cuenta tareas pendientes y permite esperar a todas
+ */
+typedef struct {
+    atomic_long pendientes;    // Tareas enviadas y aún no terminadas
+    atomic_int esperando;      // Hilos dormidos en cond
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+} grupo_espera_t;
+
+/**
+ * @brief Estadísticas de un trabajador
+ */
+typedef struct {
+    uint64_t tareas_ejecutadas;  // Tareas completadas por el trabajador
+    uint64_t robos_exitosos;     // Tareas robadas a otros trabajadores
+    uint64_t robos_fallidos;     // Intentos de robo sin éxito
+    uint64_t tiempo_inactivo_ns; // Tiempo buscando trabajo o dormido
+} estadisticas_trabajador_t;
+
+/* ====================================================================
+ * CICLO DE VIDA
+ * ==================================================================== */
+
+/**
+ * @brief Crea un pool y arranca sus trabajadores
+ * @param num_trabajadores Número de hilos (0 = núcleos en línea)
+ * @return Pool creado o NULL si falla
+ */
+pool_hilos_t* pool_crear(int num_trabajadores);
+
+/**
+ * @brief Detiene los trabajadores y libera el pool
+ * @param pool Pool a destruir (las tareas pendientes se descartan)
+ */
+void pool_destruir(pool_hilos_t* pool);
+
+/**
+ * @brief Número de trabajadores del pool
+ */
+int pool_num_trabajadores(const pool_hilos_t* pool);
+
+/* ====================================================================
+ * ENVÍO Y ESPERA DE TAREAS
+ * ==================================================================== */
+
+/**
+ * @brief Inicializa un grupo de espera vacío
+ */
+void grupo_espera_iniciar(grupo_espera_t* grupo);
+
+/**
+ * @brief Libera los recursos de un grupo de espera
+ *
+ * Se puede llamar en cuanto pool_esperar vuelve: para entonces ninguna
+ * tarea del grupo sigue accediendo a él.
+ */
+void grupo_espera_destruir(grupo_espera_t* grupo);
+
+/**
+ * @brief Envía una tarea al pool
+ * @param pool Pool destino
+ * @param funcion Función de la tarea
+ * @param arg Argumento para la función
+ * @param grupo Grupo al que pertenece la tarea (puede ser NULL)
+ * @return 0 si se encoló, -1 en caso de error
+ *
+ * Desde un trabajador la tarea va a su propia deque; desde cualquier otro
+ * hilo, a la cola global.
+ */
+int pool_enviar(pool_hilos_t* pool, tarea_fn_t funcion, void* arg, grupo_espera_t* grupo);
+
+/**
+ * @brief Espera a que terminen todas las tareas del grupo
+ *
+ * Mientras espera, el hilo llamante ejecuta tareas pendientes del pool. Un
+ * hilo externo acaba durmiendo si no encuentra trabajo; un trabajador sigue
+ * ayudando para que las esperas anidadas no bloqueen el pool.
+ */
+void pool_esperar(pool_hilos_t* pool, grupo_espera_t* grupo);
+
+/**
+ * @brief Ejecuta funcion sobre [inicio, fin) repartido en bloques
+ * @param tam_bloque Tamaño máximo de cada subrango (0 = automático)
+ *
+ * El rango se divide recursivamente por la mitad; cada mitad se publica como
+ * tarea para que los trabajadores ociosos la roben. Vuelve cuando todo el
+ * rango se ha procesado.
+ */
+void pool_paralelo_para(pool_hilos_t* pool, long inicio, long fin, long tam_bloque,
+                        rango_fn_t funcion, void* arg);
+
+/* ====================================================================
+ * ESTADÍSTICAS
+ * ==================================================================== */
+
+/**
+ * @brief Copia las estadísticas de un trabajador
+ * @return 0 si el índice es válido, -1 en caso contrario
+ */
+int pool_obtener_estadisticas(const pool_hilos_t* pool, int trabajador,
+                              estadisticas_trabajador_t* estadisticas);
+
+/**
+ * @brief Muestra una tabla con las estadísticas de todos los trabajadores
+ */
+void pool_mostrar_estadisticas(const pool_hilos_t* pool);
+
+#endif /* POOL_HILOS_H */
@@ -0,0 +1,183 @@
+/**
+ * @file topologia_cpu.h
+ * @brief Topología de CPUs y políticas de afinidad para hilos pthread
+ * @author Ejercicios C
+ * @date 2025
+ *
+ * La topología se lee de /sys/devices/system/cpu: núcleo físico de cada CPU
+ * lógica (sus hermanos SMT), dominio de caché L3 y nodo NUMA. Solo se tienen
+ * en cuenta las CPUs en línea que el proceso tiene permitidas.
+ *
+ * Las políticas asignan al hilo i una CPU:
+ * - COMPACTA: llena primero los hermanos SMT de un núcleo, luego los núcleos
+ *   del mismo L3 y luego el siguiente dominio. Hilos que comparten datos
+ *   se comunican por la caché más cercana.
+ * - DISPERSA: reparte los hilos entre dominios L3 (y nodos) por turnos y usa
+ *   los hermanos SMT solo cuando no quedan núcleos libres. Da el máximo de
+ *   caché y ancho de banda de memoria por hilo.
+ * - UNO_POR_NUCLEO: un hilo por núcleo físico, sin hermanos SMT, en orden
+ *   compacto. Si hay más hilos que núcleos se vuelve a empezar.
+ *
+ * Los hilos de las demos y del pool de 084, los trabajadores de 086 y los
+ * hilos de los benchmarks de 088 (la biblioteca de 088 no crea hilos) se
+ * colocan con crear_hilo_con_afinidad o fijar_hilo_actual_con_politica y la
+ * política de politica_afinidad_por_defecto(), que se lee de la variable de
+ * entorno AFINIDAD_HILOS (compacta, dispersa, nucleo o ninguna). Sin la
+ * variable no se fija ningún hilo.
+ *
+ * El orden de CPUs de cada política se calcula al leer la topología, así que
+ * cpu_para_hilo es una consulta a una tabla.
+ *
+ * Fuera de Linux no hay topología: cada CPU cuenta como un núcleo de un
+ * único dominio L3 y nodo. crear_hilo_con_afinidad crea el hilo sin fijar y
+ * fijar_hilo_actual_con_politica devuelve 0 sin hacer nada;
+ * obtener_afinidad_hilo_actual y fijar_afinidad_hilo_actual devuelven -1.
+ */
+
+#ifndef TOPOLOGIA_CPU_H
+#define TOPOLOGIA_CPU_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define MAX_CPUS_TOPOLOGIA 1024
+
+/* ====================================================================
+ * TOPOLOGÍA
+ * ==================================================================== */
+
+/**
+ * @brief Posición de una CPU lógica en la topología
+ */
+typedef struct {
+    int cpu;           // Número de CPU lógica del sistema
+    int nucleo;        // Índice de núcleo físico (0..num_nucleos-1)
+    int hermano_smt;   // Posición dentro de su núcleo (0 = primer hilo SMT)
+    int dominio_l3;    // Índice de dominio L3 (0..num_dominios_l3-1)
+    int nodo_numa;     // Índice de nodo NUMA (0..num_nodos-1)
+} cpu_topologia_t;
+
+/**
+ * @brief Topología del sistema
+ */
+typedef struct {
+    int num_cpus;
+    int num_nucleos;
+    int num_dominios_l3;
+    int num_nodos;
+    cpu_topologia_t cpus[MAX_CPUS_TOPOLOGIA];  // Ordenadas por número de CPU
+    // CPU del hilo i con cada política (cpu_para_hilo); uno por núcleo tiene
+    // num_nucleos entradas y las otras dos num_cpus
+    int orden_compacta[MAX_CPUS_TOPOLOGIA];
+    int orden_dispersa[MAX_CPUS_TOPOLOGIA];
+    int orden_uno_por_nucleo[MAX_CPUS_TOPOLOGIA];
+} topologia_cpu_t;
+
+/**
+ * @brief Conjunto de CPUs (independiente de cpu_set_t)
+ */
+typedef struct {
+    uint64_t bits[MAX_CPUS_TOPOLOGIA / 64];
+} mascara_cpus_t;
+
+/**
+ * @brief Topología del sistema (se lee una sola vez)
+ * @return Puntero a la topología compartida; nunca NULL
+ */
+const topologia_cpu_t* obtener_topologia_cpu(void);
+
+/**
+ * @brief Lee la topología desde un directorio con la estructura de sysfs
+ * @param ruta_cpu Directorio equivalente a /sys/devices/system/cpu
+ * @param ruta_nodos Directorio equivalente a /sys/devices/system/node
+ * @param permitidas CPUs a incluir (NULL = todas las que estén en línea)
+ * @param topologia Estructura a rellenar
+ * @return 0 si se leyó, -1 si no hay información (topologia queda plana)
+ */
+int leer_topologia_cpu(const char* ruta_cpu, const char* ruta_nodos,
+                       const mascara_cpus_t* permitidas, topologia_cpu_t* topologia);
+
+/**
+ * @brief Muestra núcleos, hermanos SMT, dominios L3 y nodos
+ */
+void mostrar_topologia_cpu(const topologia_cpu_t* topologia);
+
+/* ====================================================================
+ * POLÍTICAS DE AFINIDAD
+ * ==================================================================== */
+
+/**
+ * @brief Política de colocación de hilos
+ */
+typedef enum {
+    AFINIDAD_NINGUNA = 0,      // El planificador decide
+    AFINIDAD_COMPACTA,
+    AFINIDAD_DISPERSA,
+    AFINIDAD_UNO_POR_NUCLEO,
+    NUM_POLITICAS_AFINIDAD
+} politica_afinidad_t;
+
+/**
+ * @brief CPU que corresponde al hilo indice según una política
+ * @return Número de CPU lógica, o -1 con AFINIDAD_NINGUNA
+ */
+int cpu_para_hilo(const topologia_cpu_t* topologia, politica_afinidad_t politica, int indice);
+
+/**
+ * @brief Crea un hilo ya fijado a la CPU que le da la política
+ * @param hilo Identificador del hilo creado
+ * @param funcion Función del hilo
+ * @param arg Argumento de la función
+ * @param politica Política de colocación
+ * @param indice Índice del hilo dentro de su grupo (0, 1, 2...)
+ * @return 0 si se creó, código de error de pthread_create en caso contrario
+ *
+ * La afinidad se fija en los atributos, así que el hilo nunca llega a
+ * ejecutarse fuera de su CPU. Si el sistema no permite fijarla, el hilo se
+ * crea sin afinidad.
+ */
+int crear_hilo_con_afinidad(pthread_t* hilo, void* (*funcion)(void*), void* arg,
+                            politica_afinidad_t politica, int indice);
+
+/**
+ * @brief Fija el hilo actual a la CPU que le da la política
+ * @return 0 si se fijó (o si la política es NINGUNA, o fuera de Linux),
+ *         -1 en caso contrario
+ */
+int fijar_hilo_actual_con_politica(politica_afinidad_t politica, int indice);
+
+/**
+ * @brief Lee la afinidad del hilo actual
+ * @return 0 si se leyó, -1 en caso contrario
+ */
+int obtener_afinidad_hilo_actual(mascara_cpus_t* mascara);
+
+/**
+ * @brief Restaura una afinidad leída con obtener_afinidad_hilo_actual
+ * @return 0 si se aplicó, -1 en caso contrario
+ */
+int fijar_afinidad_hilo_actual(const mascara_cpus_t* mascara);
+
+/**
+ * @brief Política de la variable de entorno AFINIDAD_HILOS (NINGUNA si no está)
+ */
+politica_afinidad_t politica_afinidad_por_defecto(void);
+
+/**
+ * @brief Nombre de una política ("ninguna", "compacta", "dispersa", "nucleo")
+ */
+const char* nombre_politica_afinidad(politica_afinidad_t politica);
+
+/**
+ * @brief Convierte un nombre de política
+ * @return 0 si el nombre es válido, -1 en caso contrario
+ */
+int parsear_politica_afinidad(const char* nombre, politica_afinidad_t* politica);
+
+/**
+ * @brief CPU en la que se está ejecutando el hilo actual (-1 si no se sabe)
+ */
+int cpu_actual(void);
+
+#endif /* TOPOLOGIA_CPU_H */
@@ -0,0 +1,242 @@
+/**
+ * @file barreras.c
+ * @brief Barrera centralizada, barrera de diseminación y phaser
+ * @author Ejercicios C
+ * @date 2025
+ */
+
+#include "barreras.h"
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <unistd.h>
+
+#define VUELTAS_ANTES_DE_CEDER 256  // Pausas de CPU antes de pasar a sched_yield
+
+#define FASE_PHASER(e)        ((uint32_t)((e) >> 32))
+#define REGISTRADOS_PHASER(e) ((unsigned)(((e) >> 16) & 0xFFFFu))
+#define PENDIENTES_PHASER(e)  ((unsigned)((e) & 0xFFFFu))
+#define ESTADO_PHASER(fase, registrados, pendientes) \
+    (((uint64_t)(fase) << 32) | ((uint64_t)(registrados) << 16) | (uint64_t)(pendientes))
+
+static inline void pausa_cpu(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+// Con una sola CPU girar no sirve de nada: el hilo que falta por llegar no
+// puede ejecutarse mientras este gira
+static int vueltas_maximas(void) {
+    static atomic_int vueltas = -1;
+    int v = atomic_load_explicit(&vueltas, memory_order_relaxed);
+    if (v < 0) {
+        v = sysconf(_SC_NPROCESSORS_ONLN) > 1 ? VUELTAS_ANTES_DE_CEDER : 0;
+        atomic_store_explicit(&vueltas, v, memory_order_relaxed);
+    }
+    return v;
+}
+
+// Gira unas vueltas y luego cede la CPU: con más hilos que núcleos, el hilo
+// que falta por llegar necesita que alguien le deje ejecutarse
+static inline void esperar_un_poco(int* vueltas) {
+    if (*vueltas < vueltas_maximas()) {
+        pausa_cpu();
+        (*vueltas)++;
+    } else {
+        sched_yield();
+    }
+}
+
+/* ====================================================================
+ * BARRERA CENTRALIZADA
+ * ==================================================================== */
+
+bool barrera_centralizada_init(barrera_centralizada_t* barrera, int num_hilos) {
+    if (barrera == NULL || num_hilos <= 0) {
+        return false;
+    }
+    atomic_init(&barrera->pendientes, num_hilos);
+    atomic_init(&barrera->sentido, 0);
+    barrera->num_hilos = num_hilos;
+    return true;
+}
+
+bool barrera_centralizada_esperar(barrera_centralizada_t* barrera) {
+    // El sentido no puede cambiar hasta que este hilo llegue
+    int sentido = atomic_load_explicit(&barrera->sentido, memory_order_relaxed);
+
+    if (atomic_fetch_sub_explicit(&barrera->pendientes, 1, memory_order_acq_rel) == 1) {
+        atomic_store_explicit(&barrera->pendientes, barrera->num_hilos, memory_order_relaxed);
+        atomic_store_explicit(&barrera->sentido, !sentido, memory_order_release);
+        return true;
+    }
+
+    int vueltas = 0;
+    while (atomic_load_explicit(&barrera->sentido, memory_order_acquire) == sentido) {
+        esperar_un_poco(&vueltas);
+    }
+    return false;
+}
+
+/* ====================================================================
+ * BARRERA DE DISEMINACIÓN
+ * ==================================================================== */
+
+bool barrera_diseminacion_init(barrera_diseminacion_t* barrera, int num_hilos) {
+    if (barrera == NULL || num_hilos <= 0) {
+        return false;
+    }
+
+    int rondas = 0;
+    while ((1L << rondas) < num_hilos) {
+        rondas++;
+    }
+    if (rondas > MAX_RONDAS_DISEMINACION) {
+        return false;
+    }
+
+    void* memoria = NULL;
+    size_t bytes = (size_t)num_hilos * sizeof(participante_diseminacion_t);
+    if (posix_memalign(&memoria, TAM_LINEA_BARRERA, bytes) != 0) {
+        return false;
+    }
+    barrera->participantes = memoria;
+    barrera->num_hilos = num_hilos;
+    barrera->rondas = rondas;
+
+    for (int i = 0; i < num_hilos; i++) {
+        participante_diseminacion_t* p = &barrera->participantes[i];
+        for (int paridad = 0; paridad < 2; paridad++) {
+            for (int k = 0; k < MAX_RONDAS_DISEMINACION; k++) {
+                atomic_init(&p->avisos[paridad][k], 0);
+            }
+        }
+        p->paridad = 0;
+        p->sentido = 1;
+    }
+    return true;
+}
+
+void barrera_diseminacion_destruir(barrera_diseminacion_t* barrera) {
+    if (barrera == NULL) {
+        return;
+    }
+    free(barrera->participantes);
+    barrera->participantes = NULL;
+    barrera->num_hilos = 0;
+}
+
+bool barrera_diseminacion_esperar(barrera_diseminacion_t* barrera, int id_hilo) {
+    participante_diseminacion_t* yo = &barrera->participantes[id_hilo];
+
+    for (int k = 0; k < barrera->rondas; k++) {
+        int socio = (int)((id_hilo + (1L << k)) % barrera->num_hilos);
+        atomic_store_explicit(&barrera->participantes[socio].avisos[yo->paridad][k],
+                              yo->sentido, memory_order_release);
+
+        int vueltas = 0;
+        while (atomic_load_explicit(&yo->avisos[yo->paridad][k], memory_order_acquire) !=
+               yo->sentido) {
+            esperar_un_poco(&vueltas);
+        }
+    }
+
+    // Las dos paridades se alternan; al volver a la 0 se invierte el sentido
+    // para que los avisos de hace dos fases no cuenten como nuevos
+    if (yo->paridad == 1) {
+        yo->sentido = !yo->sentido;
+    }
+    yo->paridad = 1 - yo->paridad;
+    return id_hilo == 0;
+}
+
+/* ====================================================================
+ * PHASER
+ * ==================================================================== */
+
+bool phaser_init(phaser_t* phaser, int participantes) {
+    if (phaser == NULL || participantes < 0 || participantes > MAX_PARTICIPANTES_PHASER) {
+        return false;
+    }
+    atomic_init(&phaser->estado, ESTADO_PHASER(0, participantes, participantes));
+    return true;
+}
+
+int phaser_registrar(phaser_t* phaser) {
+    uint64_t estado = atomic_load_explicit(&phaser->estado, memory_order_relaxed);
+    for (;;) {
+        unsigned registrados = REGISTRADOS_PHASER(estado);
+        if (registrados == MAX_PARTICIPANTES_PHASER) {
+            return -1;
+        }
+        uint64_t nuevo = ESTADO_PHASER(FASE_PHASER(estado), registrados + 1,
+                                       PENDIENTES_PHASER(estado) + 1);
+        if (atomic_compare_exchange_weak_explicit(&phaser->estado, &estado, nuevo,
+                                                  memory_order_acq_rel,
+                                                  memory_order_relaxed)) {
+            return (int)(FASE_PHASER(estado) & 0x7FFFFFFFu);
+        }
+    }
+}
+
+// Llega a la fase actual; si es el último, abre la siguiente con todos los
+// registrados pendientes. Devuelve la fase (sin recortar) o UINT64_MAX
+static uint64_t llegar(phaser_t* phaser, bool desregistrar) {
+    uint64_t estado = atomic_load_explicit(&phaser->estado, memory_order_relaxed);
+    for (;;) {
+        unsigned pendientes = PENDIENTES_PHASER(estado);
+        if (pendientes == 0) {
+            return UINT64_MAX;
+        }
+        uint32_t fase = FASE_PHASER(estado);
+        unsigned registrados = REGISTRADOS_PHASER(estado) - (desregistrar ? 1u : 0u);
+        uint64_t nuevo = (pendientes == 1)
+            ? ESTADO_PHASER(fase + 1, registrados, registrados)
+            : ESTADO_PHASER(fase, registrados, pendientes - 1);
+        if (atomic_compare_exchange_weak_explicit(&phaser->estado, &estado, nuevo,
+                                                  memory_order_acq_rel,
+                                                  memory_order_relaxed)) {
+            return fase;
+        }
+    }
+}
+
+int phaser_llegar(phaser_t* phaser) {
+    uint64_t fase = llegar(phaser, false);
+    return fase == UINT64_MAX ? -1 : (int)(fase & 0x7FFFFFFFu);
+}
+
+int phaser_llegar_y_desregistrar(phaser_t* phaser) {
+    uint64_t fase = llegar(phaser, true);
+    return fase == UINT64_MAX ? -1 : (int)(fase & 0x7FFFFFFFu);
+}
+
+int phaser_esperar_fase(phaser_t* phaser, int fase) {
+    int vueltas = 0;
+    uint64_t estado;
+    while (((estado = atomic_load_explicit(&phaser->estado, memory_order_acquire)) >> 32 &
+            0x7FFFFFFFu) == (uint64_t)fase) {
+        esperar_un_poco(&vueltas);
+    }
+    return (int)(FASE_PHASER(estado) & 0x7FFFFFFFu);
+}
+
+int phaser_llegar_y_esperar(phaser_t* phaser) {
+    int fase = phaser_llegar(phaser);
+    if (fase < 0) {
+        return -1;
+    }
+    return phaser_esperar_fase(phaser, fase);
+}
+
+int phaser_fase(phaser_t* phaser) {
+    return (int)(FASE_PHASER(atomic_load_explicit(&phaser->estado, memory_order_acquire)) &
+                 0x7FFFFFFFu);
+}
+
+int phaser_registrados(phaser_t* phaser) {
+    return (int)REGISTRADOS_PHASER(atomic_load_explicit(&phaser->estado, memory_order_acquire));
+}
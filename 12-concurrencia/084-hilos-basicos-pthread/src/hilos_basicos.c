@@ -6,6 +6,8 @@
  */
 
 #include "hilos_basicos.h"
+#include "pool_hilos.h"
+#include "topologia_cpu.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -44,7 +46,7 @@ void* funcion_hilo_con_parametros(void* arg) {
     
     long tiempo_inicio = obtener_tiempo_ms();
     
-    printf("🧵 Hilo %d iniciado: %s\n", params->id, params->mensaje);
+    printf("🧵 Hilo %d iniciado en CPU %d: %s\n", params->id, cpu_actual(), params->mensaje);
     
     // Realizar iteraciones con delay
     for (int i = 0; i < params->iteraciones; i++) {
@@ -141,6 +143,23 @@ void* funcion_hilo_trabajo(void* arg) {
     return resultado;
 }
 
+/* ====================================================================
+ * ADAPTADOR DE FUNCIONES DE HILO A TAREAS DEL POOL
+ * ==================================================================== */
+
+// Permite enviar al pool las mismas funciones que se pasan a pthread_create
+// y recoger su valor de retorno como haría pthread_join
+typedef struct {
+    void* (*funcion)(void*);
+    void* arg;
+    void* resultado;
+} tarea_hilo_t;
+
+static void ejecutar_tarea_hilo(void* arg) {
+    tarea_hilo_t* tarea = (tarea_hilo_t*)arg;
+    tarea->resultado = tarea->funcion(tarea->arg);
+}
+
 /* ====================================================================
  * FUNCIONES DE DEMOSTRACIÓN
  * ==================================================================== */
@@ -201,8 +220,8 @@ int demostrar_hilos_con_parametros(void) {
     // Crear hilos
     printf("📋 Creando %d hilos con parámetros...\n", num_hilos);
     for (int i = 0; i < num_hilos; i++) {
-        int resultado = pthread_create(&hilos[i], NULL, 
-                                     funcion_hilo_con_parametros, &params[i]);
+        int resultado = crear_hilo_con_afinidad(&hilos[i], funcion_hilo_con_parametros,
+                                                &params[i], politica_afinidad_por_defecto(), i);
         if (resultado != 0) {
             printf("❌ Error al crear hilo %d: %s\n", i, strerror(resultado));
             return resultado;
@@ -235,28 +254,35 @@ int demostrar_hilos_con_parametros(void) {
     return 0;
 }
 
-int demostrar_multiples_hilos(int num_hilos) {
+int demostrar_multiples_hilos(pool_hilos_t* pool, int num_hilos) {
     printf("\n=== DEMOSTRACIÓN: MÚLTIPLES HILOS (%d) ===\n", num_hilos);
     
+    if (pool == NULL) {
+        printf("❌ No hay pool de hilos\n");
+        return -1;
+    }
     if (num_hilos <= 0 || num_hilos > MAX_HILOS) {
         printf("❌ Número de hilos inválido (1-%d permitidos)\n", MAX_HILOS);
         return -1;
     }
     
-    pthread_t* hilos = malloc(num_hilos * sizeof(pthread_t));
+    tarea_hilo_t* tareas = malloc(num_hilos * sizeof(tarea_hilo_t));
     hilo_params_t* params = malloc(num_hilos * sizeof(hilo_params_t));
     
-    if (hilos == NULL || params == NULL) {
+    if (tareas == NULL || params == NULL) {
         printf("❌ Error al asignar memoria\n");
-        free(hilos);
+        free(tareas);
         free(params);
         return -1;
     }
     
+    grupo_espera_t grupo;
+    grupo_espera_iniciar(&grupo);
     long tiempo_inicio = obtener_tiempo_ms();
     
-    // Crear hilos
-    printf("📋 Lanzando %d hilos trabajadores...\n", num_hilos);
+    // Enviar las tareas al pool
+    printf("📋 Lanzando %d tareas en un pool de %d hilos...\n", 
+           num_hilos, pool_num_trabajadores(pool));
     for (int i = 0; i < num_hilos; i++) {
         char mensaje[BUFFER_SIZE];
         snprintf(mensaje, sizeof(mensaje), "Trabajador #%d procesando", i + 1);
@@ -265,82 +291,83 @@ int demostrar_multiples_hilos(int num_hilos) {
         params[i].iteraciones = 3 + (i % 3); // Varíar entre 3-5 iteraciones
         params[i].delay_ms = 200 + (i * 50);  // Varíar delay
         
-        int resultado = pthread_create(&hilos[i], NULL, 
-                                     funcion_hilo_trabajo, &params[i]);
-        if (resultado != 0) {
-            printf("❌ Error al crear hilo %d: %s\n", i + 1, strerror(resultado));
-            // Continuar con los otros hilos
+        tareas[i] = (tarea_hilo_t){ funcion_hilo_trabajo, &params[i], NULL };
+        if (pool_enviar(pool, ejecutar_tarea_hilo, &tareas[i], &grupo) != 0) {
+            printf("❌ Error al enviar tarea %d\n", i + 1);
+            // Continuar con las otras tareas
         }
     }
     
-    // Esperar a todos los hilos
-    printf("📋 Esperando a que terminen todos los hilos...\n");
-    int hilos_exitosos = 0;
+    // Esperar a todas las tareas
+    printf("📋 Esperando a que terminen todas las tareas...\n");
+    pool_esperar(pool, &grupo);
     
+    int hilos_exitosos = 0;
     for (int i = 0; i < num_hilos; i++) {
-        void* resultado_ptr;
-        int resultado_join = pthread_join(hilos[i], &resultado_ptr);
-        
-        if (resultado_join == 0) {
+        if (tareas[i].resultado != NULL) {
             hilos_exitosos++;
-            if (resultado_ptr != NULL) {
-                liberar_resultado_hilo((hilo_resultado_t*)resultado_ptr);
-            }
-        } else {
-            printf("❌ Error al esperar hilo %d: %s\n", i + 1, strerror(resultado_join));
+            liberar_resultado_hilo((hilo_resultado_t*)tareas[i].resultado);
         }
     }
     
     long tiempo_total = obtener_tiempo_ms() - tiempo_inicio;
     
     printf("✅ Ejecución completada:\n");
-    printf("   - Hilos lanzados: %d\n", num_hilos);
-    printf("   - Hilos exitosos: %d\n", hilos_exitosos);
+    printf("   - Tareas lanzadas: %d\n", num_hilos);
+    printf("   - Tareas exitosas: %d\n", hilos_exitosos);
     printf("   - Tiempo total: %ld ms\n", tiempo_total);
+    pool_mostrar_estadisticas(pool);
     
-    free(hilos);
+    grupo_espera_destruir(&grupo);
+    free(tareas);
     free(params);
     
     return 0;
 }
 
-int demostrar_calculo_paralelo(void) {
+int demostrar_calculo_paralelo(pool_hilos_t* pool) {
     printf("\n=== DEMOSTRACIÓN: CÁLCULO PARALELO ===\n");
     
+    if (pool == NULL) {
+        printf("❌ No hay pool de hilos\n");
+        return -1;
+    }
+    
     const int num_hilos = 4;
     const int limite_base = 10000;
     
-    pthread_t hilos[num_hilos];
+    tarea_hilo_t tareas[num_hilos];
     int limites[num_hilos];
     long* resultados[num_hilos];
     
-    // Configurar límites para cada hilo
+    // Configurar límites para cada tarea
     for (int i = 0; i < num_hilos; i++) {
         limites[i] = limite_base * (i + 1);
     }
     
+    grupo_espera_t grupo;
+    grupo_espera_iniciar(&grupo);
+    
     long tiempo_inicio = obtener_tiempo_ms();
     
-    // Crear hilos de cálculo
+    // Enviar tareas de cálculo
     printf("📋 Iniciando cálculos paralelos...\n");
     for (int i = 0; i < num_hilos; i++) {
-        int resultado = pthread_create(&hilos[i], NULL, 
-                                     funcion_hilo_calculo, &limites[i]);
-        if (resultado != 0) {
-            printf("❌ Error al crear hilo de cálculo %d: %s\n", 
-                   i + 1, strerror(resultado));
-            return resultado;
+        tareas[i] = (tarea_hilo_t){ funcion_hilo_calculo, &limites[i], NULL };
+        if (pool_enviar(pool, ejecutar_tarea_hilo, &tareas[i], &grupo) != 0) {
+            printf("❌ Error al enviar tarea de cálculo %d\n", i + 1);
+            continue;
         }
-        printf("✅ Hilo de cálculo %d iniciado (límite: %d)\n", i + 1, limites[i]);
+        printf("✅ Tarea de cálculo %d enviada (límite: %d)\n", i + 1, limites[i]);
     }
     
     // Recoger resultados
     printf("📋 Recogiendo resultados...\n");
+    pool_esperar(pool, &grupo);
     for (int i = 0; i < num_hilos; i++) {
-        void* resultado_ptr;
-        int resultado_join = pthread_join(hilos[i], &resultado_ptr);
+        void* resultado_ptr = tareas[i].resultado;
         
-        if (resultado_join == 0 && resultado_ptr != NULL) {
+        if (resultado_ptr != NULL) {
             resultados[i] = (long*)resultado_ptr;
             printf("✅ Hilo %d: suma(1..%d) = %ld\n", 
                    i + 1, limites[i], *resultados[i]);
@@ -365,6 +392,8 @@ int demostrar_calculo_paralelo(void) {
     printf("   - Tiempo total de cálculo paralelo: %ld ms\n", tiempo_total);
     printf("   - Suma combinada de todos los cálculos: %ld\n", suma_total);
     
+    grupo_espera_destruir(&grupo);
+    
     return 0;
 }
 
@@ -452,6 +481,13 @@ void mostrar_info_hilos(void) {
            verificar_soporte_pthread() ? "✅ Disponible" : "❌ No disponible");
     printf("📋 ID del hilo principal: %ld\n", obtener_id_hilo_actual());
     printf("📋 Máximo de hilos configurado: %d\n", MAX_HILOS);
+
+    const topologia_cpu_t* topologia = obtener_topologia_cpu();
+    printf("📋 CPUs: %d lógicas, %d núcleos, %d dominios L3, %d nodos NUMA\n",
+           topologia->num_cpus, topologia->num_nucleos,
+           topologia->num_dominios_l3, topologia->num_nodos);
+    printf("📋 Política de afinidad (AFINIDAD_HILOS): %s\n",
+           nombre_politica_afinidad(politica_afinidad_por_defecto()));
 }
 
 void mostrar_estadisticas_hilos(hilo_resultado_t* resultados[], int num_resultados) {
@@ -10,6 +10,7 @@
 #include <string.h>
 #include <unistd.h>
 #include "hilos_basicos.h"
+#include "topologia_cpu.h"
 
 /* ====================================================================
  * FUNCIONES DE PRESENTACIÓN
@@ -30,6 +31,7 @@ void mostrar_menu(void) {
     printf("5. Información del sistema de hilos\n");
     printf("6. Ejecutar ejemplo simple\n");
     printf("7. Demostración completa (todos los casos)\n");
+    printf("8. Topología de CPU y políticas de afinidad\n");
     printf("0. Salir\n");
     printf("\nOpción: ");
 }
@@ -73,7 +75,7 @@ int ejecutar_ejemplo_simple(void) {
  * FUNCIÓN DE DEMOSTRACIÓN COMPLETA
  * ==================================================================== */
 
-int ejecutar_demostracion_completa(void) {
+int ejecutar_demostracion_completa(pool_hilos_t* pool) {
     printf("\n🎭 EJECUTANDO DEMOSTRACIÓN COMPLETA\n");
     printf("===================================\n");
     
@@ -103,7 +105,7 @@ int ejecutar_demostracion_completa(void) {
     sleep(2);
     
     // 4. Múltiples hilos
-    resultado = demostrar_multiples_hilos(5);
+    resultado = demostrar_multiples_hilos(pool, 5);
     if (resultado != 0) {
         printf("❌ Error en múltiples hilos: %d\n", resultado);
         return resultado;
@@ -113,7 +115,7 @@ int ejecutar_demostracion_completa(void) {
     sleep(2);
     
     // 5. Cálculo paralelo
-    resultado = demostrar_calculo_paralelo();
+    resultado = demostrar_calculo_paralelo(pool);
     if (resultado != 0) {
         printf("❌ Error en cálculo paralelo: %d\n", resultado);
         return resultado;
@@ -151,6 +153,14 @@ int main(void) {
     
     mostrar_info_hilos();
     
+    // Un solo pool para todo el programa: las demostraciones no crean ni
+    // destruyen hilos en cada ejecución
+    pool_hilos_t* pool = pool_crear(0);
+    if (pool == NULL) {
+        printf("❌ Error al crear el pool de hilos\n");
+        return 1;
+    }
+    
     int opcion;
     bool continuar = true;
     
@@ -177,19 +187,19 @@ int main(void) {
                 break;
                 
             case 3: {
-                printf("¿Cuántos hilos crear? (1-%d): ", MAX_HILOS);
+                printf("¿Cuántas tareas lanzar en el pool? (1-%d): ", MAX_HILOS);
                 int num_hilos;
                 if (scanf("%d", &num_hilos) == 1) {
-                    resultado = demostrar_multiples_hilos(num_hilos);
+                    resultado = demostrar_multiples_hilos(pool, num_hilos);
                 } else {
                     printf("❌ Número inválido, usando 3 hilos por defecto\n");
-                    resultado = demostrar_multiples_hilos(3);
+                    resultado = demostrar_multiples_hilos(pool, 3);
                 }
                 break;
             }
             
             case 4:
-                resultado = demostrar_calculo_paralelo();
+                resultado = demostrar_calculo_paralelo(pool);
                 break;
                 
             case 5:
@@ -201,7 +211,11 @@ int main(void) {
                 break;
                 
             case 7:
-                resultado = ejecutar_demostracion_completa();
+                resultado = ejecutar_demostracion_completa(pool);
+                break;
+                
+            case 8:
+                mostrar_topologia_cpu(obtener_topologia_cpu());
                 break;
                 
             case 0:
@@ -243,6 +257,7 @@ int main(void) {
     printf("• Explora variables de condición (condition variables)\n");
     printf("• Investiga pools de hilos y patrones avanzados\n");
     
+    pool_destruir(pool);
     return 0;
 }
 #endif
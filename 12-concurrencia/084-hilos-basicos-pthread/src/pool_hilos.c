@@ -0,0 +1,684 @@
+/**
+ * @file pool_hilos.c
+ * @brief Implementación del pool de hilos con deques de Chase-Lev
+ * @author Ejercicios C
+ * @date 2025
+ */
+
+#include "pool_hilos.h"
+#include "topologia_cpu.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sched.h>
+
+/* ====================================================================
+ * CONFIGURACIÓN INTERNA
+ * ==================================================================== */
+
+#define TAM_LINEA_CACHE 64
+#define CAPACIDAD_INICIAL_DEQUE 256
+#define RONDAS_BUSQUEDA 32      // Búsquedas fallidas antes de dormir
+#define BLOQUES_POR_TRABAJADOR 8 // Granularidad automática de pool_paralelo_para
+
+/* ====================================================================
+ * ESTRUCTURAS INTERNAS
+ * ==================================================================== */
+
+typedef struct tarea {
+    tarea_fn_t funcion;
+    void* arg;
+    grupo_espera_t* grupo;
+    struct tarea* siguiente;   // Enlace en la cola global
+} tarea_t;
+
+// Arreglo circular de la deque. Al crecer, el arreglo viejo no se libera
+// (un ladrón puede estar leyéndolo); queda enlazado y se libera al destruir.
+typedef struct arreglo_deque {
+    long capacidad;                   // Potencia de dos
+    struct arreglo_deque* anterior;
+    _Atomic(tarea_t*) celdas[];
+} arreglo_deque_t;
+
+// Deque de Chase-Lev: el dueño empuja y saca por 'abajo'; los ladrones
+// roban por 'arriba'. Cada extremo en su propia línea de caché.
+typedef struct {
+    _Alignas(TAM_LINEA_CACHE) atomic_long arriba;
+    _Alignas(TAM_LINEA_CACHE) atomic_long abajo;
+    _Atomic(arreglo_deque_t*) arreglo;
+} deque_t;
+
+typedef struct {
+    deque_t deque;
+    pool_hilos_t* pool;
+    pthread_t hilo;
+    int indice;
+    // Solo las escribe el propio trabajador; atómicas para leerlas sin carreras
+    _Alignas(TAM_LINEA_CACHE) _Atomic uint64_t tareas_ejecutadas;
+    _Atomic uint64_t robos_exitosos;
+    _Atomic uint64_t robos_fallidos;
+    _Atomic uint64_t tiempo_inactivo_ns;
+} trabajador_t;
+
+struct pool_hilos {
+    trabajador_t* trabajadores;
+    int num_trabajadores;
+    int hilos_arrancados;
+
+    // Cola global para tareas enviadas desde fuera del pool
+    pthread_mutex_t mutex;
+    pthread_cond_t cond_trabajo;
+    tarea_t* global_primera;
+    tarea_t* global_ultima;
+    atomic_long global_tamano;
+
+    atomic_long tareas_en_cola;   // Encoladas y aún no tomadas por nadie
+    atomic_int dormidos;          // Trabajadores dormidos en cond_trabajo
+    atomic_bool apagando;
+};
+
+// Trabajador que ejecuta el hilo actual (NULL fuera de cualquier pool)
+static _Thread_local trabajador_t* trabajador_actual = NULL;
+// Semilla xorshift por hilo para elegir víctimas de robo
+static _Thread_local uint64_t semilla_robo = 0;
+
+/* ====================================================================
+ * UTILIDADES
+ * ==================================================================== */
+
+static uint64_t ahora_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t aleatorio_robo(void) {
+    if (semilla_robo == 0) {
+        semilla_robo = ahora_ns() ^ (uint64_t)(uintptr_t)&semilla_robo;
+        if (semilla_robo == 0) semilla_robo = 0x9E3779B97F4A7C15ull;
+    }
+    semilla_robo ^= semilla_robo << 13;
+    semilla_robo ^= semilla_robo >> 7;
+    semilla_robo ^= semilla_robo << 17;
+    return semilla_robo;
+}
+
+static void sumar_estadistica(_Atomic uint64_t* campo, uint64_t valor) {
+    atomic_fetch_add_explicit(campo, valor, memory_order_relaxed);
+}
+
+/* ====================================================================
+ * DEQUE DE CHASE-LEV
+ * (Lê, Pop, Cohen, Zappa Nardelli: "Correct and Efficient Work-Stealing
+ *  for Weak Memory Models", PPoPP 2013)
+ * ==================================================================== */
+
+static arreglo_deque_t* arreglo_crear(long capacidad) {
+    arreglo_deque_t* arreglo = malloc(sizeof(arreglo_deque_t) +
+                                      (size_t)capacidad * sizeof(_Atomic(tarea_t*)));
+    if (arreglo == NULL) {
+        return NULL;
+    }
+    arreglo->capacidad = capacidad;
+    arreglo->anterior = NULL;
+    for (long i = 0; i < capacidad; i++) {
+        atomic_init(&arreglo->celdas[i], NULL);
+    }
+    return arreglo;
+}
+
+static bool deque_iniciar(deque_t* deque) {
+    arreglo_deque_t* arreglo = arreglo_crear(CAPACIDAD_INICIAL_DEQUE);
+    if (arreglo == NULL) {
+        return false;
+    }
+    atomic_init(&deque->arriba, 0);
+    atomic_init(&deque->abajo, 0);
+    atomic_init(&deque->arreglo, arreglo);
+    return true;
+}
+
+static void deque_liberar(deque_t* deque) {
+    arreglo_deque_t* arreglo = atomic_load_explicit(&deque->arreglo, memory_order_relaxed);
+    while (arreglo != NULL) {
+        arreglo_deque_t* anterior = arreglo->anterior;
+        free(arreglo);
+        arreglo = anterior;
+    }
+}
+
+static arreglo_deque_t* deque_crecer(deque_t* deque, arreglo_deque_t* viejo, long arriba, long abajo) {
+    arreglo_deque_t* nuevo = arreglo_crear(viejo->capacidad * 2);
+    if (nuevo == NULL) {
+        return NULL;
+    }
+    for (long i = arriba; i < abajo; i++) {
+        tarea_t* t = atomic_load_explicit(&viejo->celdas[i & (viejo->capacidad - 1)], memory_order_relaxed);
+        atomic_store_explicit(&nuevo->celdas[i & (nuevo->capacidad - 1)], t, memory_order_relaxed);
+    }
+    nuevo->anterior = viejo;
+    atomic_store_explicit(&deque->arreglo, nuevo, memory_order_release);
+    return nuevo;
+}
+
+// Solo el dueño. Devuelve false si la deque no pudo crecer.
+static bool deque_empujar(deque_t* deque, tarea_t* tarea) {
+    long abajo = atomic_load_explicit(&deque->abajo, memory_order_relaxed);
+    long arriba = atomic_load_explicit(&deque->arriba, memory_order_acquire);
+    arreglo_deque_t* arreglo = atomic_load_explicit(&deque->arreglo, memory_order_relaxed);
+
+    if (abajo - arriba > arreglo->capacidad - 1) {
+        arreglo = deque_crecer(deque, arreglo, arriba, abajo);
+        if (arreglo == NULL) {
+            return false;
+        }
+    }
+    atomic_store_explicit(&arreglo->celdas[abajo & (arreglo->capacidad - 1)], tarea, memory_order_relaxed);
+    // Store release en lugar de fence + relaxed: mismo efecto y visible para TSan
+    atomic_store_explicit(&deque->abajo, abajo + 1, memory_order_release);
+    return true;
+}
+
+// Solo el dueño: saca la tarea más reciente (LIFO, mejor localidad)
+static tarea_t* deque_sacar(deque_t* deque) {
+    long abajo = atomic_load_explicit(&deque->abajo, memory_order_relaxed) - 1;
+    arreglo_deque_t* arreglo = atomic_load_explicit(&deque->arreglo, memory_order_relaxed);
+    atomic_store_explicit(&deque->abajo, abajo, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    long arriba = atomic_load_explicit(&deque->arriba, memory_order_relaxed);
+
+    tarea_t* tarea = NULL;
+    if (arriba <= abajo) {
+        tarea = atomic_load_explicit(&arreglo->celdas[abajo & (arreglo->capacidad - 1)], memory_order_relaxed);
+        if (arriba == abajo) {
+            // Último elemento: competimos con los ladrones por él
+            if (!atomic_compare_exchange_strong_explicit(&deque->arriba, &arriba, arriba + 1,
+                                                         memory_order_seq_cst, memory_order_relaxed)) {
+                tarea = NULL;
+            }
+            atomic_store_explicit(&deque->abajo, abajo + 1, memory_order_relaxed);
+        }
+    } else {
+        atomic_store_explicit(&deque->abajo, abajo + 1, memory_order_relaxed);
+    }
+    return tarea;
+}
+
+// Cualquier hilo: roba la tarea más antigua (FIFO)
+static tarea_t* deque_robar(deque_t* deque) {
+    long arriba = atomic_load_explicit(&deque->arriba, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long abajo = atomic_load_explicit(&deque->abajo, memory_order_acquire);
+
+    if (arriba >= abajo) {
+        return NULL;
+    }
+    arreglo_deque_t* arreglo = atomic_load_explicit(&deque->arreglo, memory_order_acquire);
+    tarea_t* tarea = atomic_load_explicit(&arreglo->celdas[arriba & (arreglo->capacidad - 1)], memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&deque->arriba, &arriba, arriba + 1,
+                                                 memory_order_seq_cst, memory_order_relaxed)) {
+        return NULL;  // Otro ladrón o el dueño se la llevaron
+    }
+    return tarea;
+}
+
+/* ====================================================================
+ * COLA GLOBAL, BÚSQUEDA Y EJECUCIÓN DE TAREAS
+ * ==================================================================== */
+
+static void cola_global_meter(pool_hilos_t* pool, tarea_t* tarea) {
+    tarea->siguiente = NULL;
+    pthread_mutex_lock(&pool->mutex);
+    if (pool->global_ultima != NULL) {
+        pool->global_ultima->siguiente = tarea;
+    } else {
+        pool->global_primera = tarea;
+    }
+    pool->global_ultima = tarea;
+    atomic_fetch_add_explicit(&pool->global_tamano, 1, memory_order_relaxed);
+    pthread_mutex_unlock(&pool->mutex);
+}
+
+static tarea_t* cola_global_sacar(pool_hilos_t* pool) {
+    // Comprobación sin lock para no serializar a los trabajadores ociosos
+    if (atomic_load_explicit(&pool->global_tamano, memory_order_relaxed) == 0) {
+        return NULL;
+    }
+    pthread_mutex_lock(&pool->mutex);
+    tarea_t* tarea = pool->global_primera;
+    if (tarea != NULL) {
+        pool->global_primera = tarea->siguiente;
+        if (pool->global_primera == NULL) {
+            pool->global_ultima = NULL;
+        }
+        atomic_fetch_sub_explicit(&pool->global_tamano, 1, memory_order_relaxed);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    return tarea;
+}
+
+static tarea_t* robar_tarea(pool_hilos_t* pool, trabajador_t* yo) {
+    int n = pool->num_trabajadores;
+    int inicio = (int)(aleatorio_robo() % (uint64_t)n);
+
+    for (int i = 0; i < n; i++) {
+        trabajador_t* victima = &pool->trabajadores[(inicio + i) % n];
+        if (victima == yo) {
+            continue;
+        }
+        tarea_t* tarea = deque_robar(&victima->deque);
+        if (tarea != NULL) {
+            if (yo != NULL) sumar_estadistica(&yo->robos_exitosos, 1);
+            return tarea;
+        }
+        if (yo != NULL) sumar_estadistica(&yo->robos_fallidos, 1);
+    }
+    return NULL;
+}
+
+// Orden de búsqueda: deque propia, cola global y robo a una víctima al azar
+static tarea_t* buscar_tarea(pool_hilos_t* pool, trabajador_t* yo) {
+    tarea_t* tarea = NULL;
+    if (yo != NULL) {
+        tarea = deque_sacar(&yo->deque);
+    }
+    if (tarea == NULL) {
+        tarea = cola_global_sacar(pool);
+    }
+    if (tarea == NULL) {
+        tarea = robar_tarea(pool, yo);
+    }
+    if (tarea != NULL) {
+        atomic_fetch_sub_explicit(&pool->tareas_en_cola, 1, memory_order_relaxed);
+    }
+    return tarea;
+}
+
+static void grupo_completar(grupo_espera_t* grupo) {
+    // Las tareas que no son la última restan sin bloquear y no vuelven a
+    // tocar el grupo
+    long pendientes = atomic_load_explicit(&grupo->pendientes, memory_order_relaxed);
+    while (pendientes > 1) {
+        if (atomic_compare_exchange_weak_explicit(&grupo->pendientes, &pendientes, pendientes - 1,
+                                                  memory_order_acq_rel, memory_order_relaxed)) {
+            return;
+        }
+    }
+    // Posible última tarea: el paso a 0 se hace con el mutex tomado. Quien
+    // espera lo toma antes de volver, así que no puede destruir el grupo
+    // mientras aquí se sigue usando
+    pthread_mutex_lock(&grupo->mutex);
+    if (atomic_fetch_sub_explicit(&grupo->pendientes, 1, memory_order_acq_rel) == 1 &&
+        atomic_load_explicit(&grupo->esperando, memory_order_relaxed) > 0) {
+        pthread_cond_broadcast(&grupo->cond);
+    }
+    pthread_mutex_unlock(&grupo->mutex);
+}
+
+static void ejecutar_tarea(trabajador_t* yo, tarea_t* tarea) {
+    grupo_espera_t* grupo = tarea->grupo;
+    tarea->funcion(tarea->arg);
+    free(tarea);
+    if (yo != NULL) {
+        sumar_estadistica(&yo->tareas_ejecutadas, 1);
+    }
+    if (grupo != NULL) {
+        grupo_completar(grupo);
+    }
+}
+
+static trabajador_t* trabajador_del_pool(pool_hilos_t* pool) {
+    trabajador_t* yo = trabajador_actual;
+    return (yo != NULL && yo->pool == pool) ? yo : NULL;
+}
+
+/* ====================================================================
+ * BUCLE DE LOS TRABAJADORES
+ * ==================================================================== */
+
+static void despertar_trabajador(pool_hilos_t* pool) {
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&pool->dormidos, memory_order_relaxed) > 0) {
+        pthread_mutex_lock(&pool->mutex);
+        pthread_cond_signal(&pool->cond_trabajo);
+        pthread_mutex_unlock(&pool->mutex);
+    }
+}
+
+// Busca durante unas rondas y, si no hay nada, duerme hasta que se encole
+// una tarea. Devuelve NULL si el pool se está apagando.
+static tarea_t* esperar_trabajo(pool_hilos_t* pool, trabajador_t* yo) {
+    for (;;) {
+        for (int i = 0; i < RONDAS_BUSQUEDA; i++) {
+            if (atomic_load_explicit(&pool->apagando, memory_order_acquire)) {
+                return NULL;
+            }
+            tarea_t* tarea = buscar_tarea(pool, yo);
+            if (tarea != NULL) {
+                return tarea;
+            }
+            sched_yield();
+        }
+
+        pthread_mutex_lock(&pool->mutex);
+        atomic_fetch_add_explicit(&pool->dormidos, 1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        while (atomic_load_explicit(&pool->tareas_en_cola, memory_order_relaxed) == 0 &&
+               !atomic_load_explicit(&pool->apagando, memory_order_acquire)) {
+            pthread_cond_wait(&pool->cond_trabajo, &pool->mutex);
+        }
+        atomic_fetch_sub_explicit(&pool->dormidos, 1, memory_order_relaxed);
+        pthread_mutex_unlock(&pool->mutex);
+    }
+}
+
+static void* bucle_trabajador(void* arg) {
+    trabajador_t* yo = (trabajador_t*)arg;
+    pool_hilos_t* pool = yo->pool;
+    trabajador_actual = yo;
+
+    while (!atomic_load_explicit(&pool->apagando, memory_order_acquire)) {
+        tarea_t* tarea = buscar_tarea(pool, yo);
+        if (tarea == NULL) {
+            uint64_t inicio_inactivo = ahora_ns();
+            tarea = esperar_trabajo(pool, yo);
+            sumar_estadistica(&yo->tiempo_inactivo_ns, ahora_ns() - inicio_inactivo);
+            if (tarea == NULL) {
+                break;
+            }
+        }
+        ejecutar_tarea(yo, tarea);
+    }
+
+    trabajador_actual = NULL;
+    return NULL;
+}
+
+/* ====================================================================
+ * CICLO DE VIDA
+ * ==================================================================== */
+
+pool_hilos_t* pool_crear(int num_trabajadores) {
+    if (num_trabajadores <= 0) {
+        long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+        num_trabajadores = nucleos > 0 ? (int)nucleos : 1;
+    }
+
+    pool_hilos_t* pool = calloc(1, sizeof(pool_hilos_t));
+    if (pool == NULL) {
+        return NULL;
+    }
+    pool->trabajadores = aligned_alloc(_Alignof(trabajador_t),
+                                       (size_t)num_trabajadores * sizeof(trabajador_t));
+    if (pool->trabajadores == NULL) {
+        free(pool);
+        return NULL;
+    }
+    memset(pool->trabajadores, 0, (size_t)num_trabajadores * sizeof(trabajador_t));
+    pool->num_trabajadores = num_trabajadores;
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->cond_trabajo, NULL);
+    atomic_init(&pool->global_tamano, 0);
+    atomic_init(&pool->tareas_en_cola, 0);
+    atomic_init(&pool->dormidos, 0);
+    atomic_init(&pool->apagando, false);
+
+    for (int i = 0; i < num_trabajadores; i++) {
+        trabajador_t* t = &pool->trabajadores[i];
+        t->pool = pool;
+        t->indice = i;
+        atomic_init(&t->tareas_ejecutadas, 0);
+        atomic_init(&t->robos_exitosos, 0);
+        atomic_init(&t->robos_fallidos, 0);
+        atomic_init(&t->tiempo_inactivo_ns, 0);
+        if (!deque_iniciar(&t->deque)) {
+            pool_destruir(pool);
+            return NULL;
+        }
+    }
+
+    // Las deques deben existir antes de arrancar: cualquiera puede robar
+    politica_afinidad_t politica = politica_afinidad_por_defecto();
+    for (int i = 0; i < num_trabajadores; i++) {
+        if (crear_hilo_con_afinidad(&pool->trabajadores[i].hilo, bucle_trabajador,
+                                    &pool->trabajadores[i], politica, i) != 0) {
+            pool_destruir(pool);
+            return NULL;
+        }
+        pool->hilos_arrancados++;
+    }
+    return pool;
+}
+
+void pool_destruir(pool_hilos_t* pool) {
+    if (pool == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->mutex);
+    atomic_store_explicit(&pool->apagando, true, memory_order_release);
+    pthread_cond_broadcast(&pool->cond_trabajo);
+    pthread_mutex_unlock(&pool->mutex);
+
+    for (int i = 0; i < pool->hilos_arrancados; i++) {
+        pthread_join(pool->trabajadores[i].hilo, NULL);
+    }
+
+    // Sin hilos vivos ya no hay carreras: descartar lo que quede encolado
+    for (int i = 0; i < pool->num_trabajadores; i++) {
+        deque_t* deque = &pool->trabajadores[i].deque;
+        if (atomic_load_explicit(&deque->arreglo, memory_order_relaxed) == NULL) {
+            continue;
+        }
+        tarea_t* tarea;
+        while ((tarea = deque_sacar(deque)) != NULL) {
+            free(tarea);
+        }
+        deque_liberar(deque);
+    }
+    tarea_t* tarea = pool->global_primera;
+    while (tarea != NULL) {
+        tarea_t* siguiente = tarea->siguiente;
+        free(tarea);
+        tarea = siguiente;
+    }
+
+    pthread_cond_destroy(&pool->cond_trabajo);
+    pthread_mutex_destroy(&pool->mutex);
+    free(pool->trabajadores);
+    free(pool);
+}
+
+int pool_num_trabajadores(const pool_hilos_t* pool) {
+    return pool != NULL ? pool->num_trabajadores : 0;
+}
+
+/* ====================================================================
+ * ENVÍO Y ESPERA DE TAREAS
+ * ==================================================================== */
+
+void grupo_espera_iniciar(grupo_espera_t* grupo) {
+    if (grupo == NULL) {
+        return;
+    }
+    atomic_init(&grupo->pendientes, 0);
+    atomic_init(&grupo->esperando, 0);
+    pthread_mutex_init(&grupo->mutex, NULL);
+    pthread_cond_init(&grupo->cond, NULL);
+}
+
+void grupo_espera_destruir(grupo_espera_t* grupo) {
+    if (grupo == NULL) {
+        return;
+    }
+    pthread_cond_destroy(&grupo->cond);
+    pthread_mutex_destroy(&grupo->mutex);
+}
+
+int pool_enviar(pool_hilos_t* pool, tarea_fn_t funcion, void* arg, grupo_espera_t* grupo) {
+    if (pool == NULL || funcion == NULL) {
+        return -1;
+    }
+    tarea_t* tarea = malloc(sizeof(tarea_t));
+    if (tarea == NULL) {
+        return -1;
+    }
+    tarea->funcion = funcion;
+    tarea->arg = arg;
+    tarea->grupo = grupo;
+    tarea->siguiente = NULL;
+
+    if (grupo != NULL) {
+        atomic_fetch_add_explicit(&grupo->pendientes, 1, memory_order_relaxed);
+    }
+    // Se cuenta antes de publicarla para que el contador nunca sea negativo
+    atomic_fetch_add_explicit(&pool->tareas_en_cola, 1, memory_order_relaxed);
+
+    trabajador_t* yo = trabajador_del_pool(pool);
+    if (yo == NULL || !deque_empujar(&yo->deque, tarea)) {
+        cola_global_meter(pool, tarea);
+    }
+    despertar_trabajador(pool);
+    return 0;
+}
+
+void pool_esperar(pool_hilos_t* pool, grupo_espera_t* grupo) {
+    if (pool == NULL || grupo == NULL) {
+        return;
+    }
+    trabajador_t* yo = trabajador_del_pool(pool);
+
+    while (atomic_load_explicit(&grupo->pendientes, memory_order_acquire) > 0) {
+        tarea_t* tarea = buscar_tarea(pool, yo);
+        if (tarea != NULL) {
+            ejecutar_tarea(yo, tarea);
+            continue;
+        }
+        if (yo != NULL) {
+            // Un trabajador nunca duerme aquí: las tareas que faltan pueden
+            // generar más trabajo que solo él llegaría a ver
+            sched_yield();
+            continue;
+        }
+
+        pthread_mutex_lock(&grupo->mutex);
+        atomic_fetch_add_explicit(&grupo->esperando, 1, memory_order_relaxed);
+        while (atomic_load_explicit(&grupo->pendientes, memory_order_acquire) > 0) {
+            pthread_cond_wait(&grupo->cond, &grupo->mutex);
+        }
+        atomic_fetch_sub_explicit(&grupo->esperando, 1, memory_order_relaxed);
+        pthread_mutex_unlock(&grupo->mutex);
+    }
+
+    // La última tarea pone pendientes a 0 con el mutex tomado y lo suelta al
+    // terminar con el grupo: pasar por él garantiza que ya no lo usa
+    pthread_mutex_lock(&grupo->mutex);
+    pthread_mutex_unlock(&grupo->mutex);
+}
+
+/* ====================================================================
+ * BUCLE PARALELO
+ * ==================================================================== */
+
+typedef struct {
+    pool_hilos_t* pool;
+    grupo_espera_t* grupo;
+    rango_fn_t funcion;
+    void* arg;
+    long tam_bloque;
+    long desde;
+    long hasta;
+} rango_t;
+
+static void tarea_rango(void* arg);
+
+// Publica la mitad superior mientras el rango sea mayor que un bloque y
+// procesa el resto en el hilo actual
+static void procesar_rango(const rango_t* base, long desde, long hasta) {
+    while (hasta - desde > base->tam_bloque) {
+        long medio = desde + (hasta - desde) / 2;
+        rango_t* mitad = malloc(sizeof(rango_t));
+        if (mitad == NULL) {
+            break;
+        }
+        *mitad = *base;
+        mitad->desde = medio;
+        mitad->hasta = hasta;
+        if (pool_enviar(base->pool, tarea_rango, mitad, base->grupo) != 0) {
+            free(mitad);
+            break;
+        }
+        hasta = medio;
+    }
+    base->funcion(base->arg, desde, hasta);
+}
+
+static void tarea_rango(void* arg) {
+    rango_t* rango = (rango_t*)arg;
+    procesar_rango(rango, rango->desde, rango->hasta);
+    free(rango);
+}
+
+void pool_paralelo_para(pool_hilos_t* pool, long inicio, long fin, long tam_bloque,
+                        rango_fn_t funcion, void* arg) {
+    if (pool == NULL || funcion == NULL || fin <= inicio) {
+        return;
+    }
+    if (tam_bloque <= 0) {
+        tam_bloque = (fin - inicio) / ((long)pool->num_trabajadores * BLOQUES_POR_TRABAJADOR);
+        if (tam_bloque < 1) tam_bloque = 1;
+    }
+
+    grupo_espera_t grupo;
+    grupo_espera_iniciar(&grupo);
+    rango_t base = {
+        .pool = pool, .grupo = &grupo, .funcion = funcion, .arg = arg,
+        .tam_bloque = tam_bloque, .desde = inicio, .hasta = fin
+    };
+    procesar_rango(&base, inicio, fin);
+    pool_esperar(pool, &grupo);
+    grupo_espera_destruir(&grupo);
+}
+
+/* ====================================================================
+ * ESTADÍSTICAS
+ * ==================================================================== */
+
+int pool_obtener_estadisticas(const pool_hilos_t* pool, int trabajador,
+                              estadisticas_trabajador_t* estadisticas) {
+    if (pool == NULL || estadisticas == NULL || trabajador < 0 || trabajador >= pool->num_trabajadores) {
+        return -1;
+    }
+    trabajador_t* t = &pool->trabajadores[trabajador];
+    estadisticas->tareas_ejecutadas = atomic_load_explicit(&t->tareas_ejecutadas, memory_order_relaxed);
+    estadisticas->robos_exitosos = atomic_load_explicit(&t->robos_exitosos, memory_order_relaxed);
+    estadisticas->robos_fallidos = atomic_load_explicit(&t->robos_fallidos, memory_order_relaxed);
+    estadisticas->tiempo_inactivo_ns = atomic_load_explicit(&t->tiempo_inactivo_ns, memory_order_relaxed);
+    return 0;
+}
+
+void pool_mostrar_estadisticas(const pool_hilos_t* pool) {
+    if (pool == NULL) {
+        return;
+    }
+    printf("\n📊 ESTADÍSTICAS DEL POOL (%d trabajadores):\n", pool->num_trabajadores);
+    printf("   %-10s %12s %10s %14s %14s\n", "Trabajador", "Tareas", "Robos", "Robos fallidos", "Inactivo (ms)");
+
+    uint64_t total_tareas = 0, total_robos = 0;
+    for (int i = 0; i < pool->num_trabajadores; i++) {
+        estadisticas_trabajador_t e;
+        pool_obtener_estadisticas(pool, i, &e);
+        printf("   %-10d %12llu %10llu %14llu %14.2f\n", i,
+               (unsigned long long)e.tareas_ejecutadas,
+               (unsigned long long)e.robos_exitosos,
+               (unsigned long long)e.robos_fallidos,
+               e.tiempo_inactivo_ns / 1e6);
+        total_tareas += e.tareas_ejecutadas;
+        total_robos += e.robos_exitosos;
+    }
+    printf("   ────────────────────────────\n");
+    printf("   Total: %llu tareas, %llu robos\n",
+           (unsigned long long)total_tareas, (unsigned long long)total_robos);
+}
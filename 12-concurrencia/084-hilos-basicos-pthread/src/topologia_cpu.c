@@ -0,0 +1,564 @@
+/**
+ * @file topologia_cpu.c
+ * @brief Lectura de la topología desde sysfs y políticas de afinidad
+ * @author Ejercicios C
+ * @date 2025
+ */
+
+#include "topologia_cpu.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sched.h>
+#define TOPOLOGIA_LINUX 1
+#endif
+
+// Se pueden redefinir al compilar para probar con una topología simulada
+#ifndef RUTA_SYSFS_CPU
+#define RUTA_SYSFS_CPU "/sys/devices/system/cpu"
+#endif
+#ifndef RUTA_SYSFS_NODOS
+#define RUTA_SYSFS_NODOS "/sys/devices/system/node"
+#endif
+
+#define MAX_INDICES_CACHE 16  // index0..indexN de cada CPU
+
+/* ====================================================================
+ * MÁSCARAS Y LISTAS DE SYSFS
+ * ==================================================================== */
+
+static void mascara_vaciar(mascara_cpus_t* m) {
+    memset(m, 0, sizeof(*m));
+}
+
+static void mascara_poner(mascara_cpus_t* m, int cpu) {
+    if (cpu >= 0 && cpu < MAX_CPUS_TOPOLOGIA) {
+        m->bits[cpu / 64] |= UINT64_C(1) << (cpu % 64);
+    }
+}
+
+static bool mascara_contiene(const mascara_cpus_t* m, int cpu) {
+    return cpu >= 0 && cpu < MAX_CPUS_TOPOLOGIA &&
+           (m->bits[cpu / 64] >> (cpu % 64)) & 1;
+}
+
+// Primera CPU de la máscara, o -1 si está vacía
+static int mascara_primera(const mascara_cpus_t* m) {
+    for (int cpu = 0; cpu < MAX_CPUS_TOPOLOGIA; cpu++) {
+        if (mascara_contiene(m, cpu)) {
+            return cpu;
+        }
+    }
+    return -1;
+}
+
+// Lee una lista de sysfs ("0-3,8,10-11") en una máscara
+static int leer_lista_cpus(const char* ruta, mascara_cpus_t* m) {
+    FILE* f = fopen(ruta, "r");
+    if (f == NULL) {
+        return -1;
+    }
+    char linea[4096];
+    bool leida = fgets(linea, sizeof(linea), f) != NULL;
+    fclose(f);
+    if (!leida) {
+        return -1;
+    }
+
+    mascara_vaciar(m);
+    char* p = linea;
+    while (*p != '\0' && *p != '\n') {
+        char* fin;
+        long desde = strtol(p, &fin, 10);
+        if (fin == p) {
+            return -1;
+        }
+        long hasta = desde;
+        p = fin;
+        if (*p == '-') {
+            hasta = strtol(p + 1, &fin, 10);
+            if (fin == p + 1 || hasta < desde) {
+                return -1;
+            }
+            p = fin;
+        }
+        for (long cpu = desde; cpu <= hasta; cpu++) {
+            mascara_poner(m, (int)cpu);
+        }
+        if (*p == ',') {
+            p++;
+        }
+    }
+    return 0;
+}
+
+static int leer_entero(const char* ruta, int* valor) {
+    FILE* f = fopen(ruta, "r");
+    if (f == NULL) {
+        return -1;
+    }
+    int ok = fscanf(f, "%d", valor) == 1 ? 0 : -1;
+    fclose(f);
+    return ok;
+}
+
+#ifdef TOPOLOGIA_LINUX
+static void mascara_a_cpu_set(const mascara_cpus_t* m, cpu_set_t* conjunto) {
+    CPU_ZERO(conjunto);
+    for (int cpu = 0; cpu < MAX_CPUS_TOPOLOGIA && cpu < CPU_SETSIZE; cpu++) {
+        if (mascara_contiene(m, cpu)) {
+            CPU_SET(cpu, conjunto);
+        }
+    }
+}
+
+static void cpu_set_a_mascara(const cpu_set_t* conjunto, mascara_cpus_t* m) {
+    mascara_vaciar(m);
+    for (int cpu = 0; cpu < MAX_CPUS_TOPOLOGIA && cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, conjunto)) {
+            mascara_poner(m, cpu);
+        }
+    }
+}
+#endif
+
+/* ====================================================================
+ * TOPOLOGÍA
+ * ==================================================================== */
+
+typedef struct {
+    int clave[4];
+    int cpu;
+} cpu_ordenada_t;
+
+static int comparar_cpus_ordenadas(const void* a, const void* b) {
+    const cpu_ordenada_t* x = (const cpu_ordenada_t*)a;
+    const cpu_ordenada_t* y = (const cpu_ordenada_t*)b;
+    for (int i = 0; i < 4; i++) {
+        if (x->clave[i] != y->clave[i]) {
+            return x->clave[i] < y->clave[i] ? -1 : 1;
+        }
+    }
+    return (x->cpu > y->cpu) - (x->cpu < y->cpu);
+}
+
+// Ordena las CPUs según la política y deja sus números en destino
+static void ordenar_para_politica(const topologia_cpu_t* t, politica_afinidad_t politica,
+                                  const int* rango_nucleo, const int* rango_l3, int* destino) {
+    cpu_ordenada_t orden[MAX_CPUS_TOPOLOGIA];
+    int n = 0;
+    for (int i = 0; i < t->num_cpus; i++) {
+        const cpu_topologia_t* c = &t->cpus[i];
+        cpu_ordenada_t* o = &orden[n];
+        o->cpu = c->cpu;
+        if (politica == AFINIDAD_DISPERSA) {
+            o->clave[0] = c->hermano_smt;
+            o->clave[1] = rango_nucleo[c->nucleo];
+            o->clave[2] = rango_l3[c->dominio_l3];
+            o->clave[3] = c->nodo_numa;
+        } else {
+            if (politica == AFINIDAD_UNO_POR_NUCLEO && c->hermano_smt != 0) {
+                continue;
+            }
+            o->clave[0] = c->nodo_numa;
+            o->clave[1] = c->dominio_l3;
+            o->clave[2] = c->nucleo;
+            o->clave[3] = c->hermano_smt;
+        }
+        n++;
+    }
+    qsort(orden, (size_t)n, sizeof(cpu_ordenada_t), comparar_cpus_ordenadas);
+    for (int i = 0; i < n; i++) {
+        destino[i] = orden[i].cpu;
+    }
+}
+
+// Calcula el orden de CPUs de cada política una sola vez por topología
+static void calcular_ordenes(topologia_cpu_t* t) {
+    // Rango de cada núcleo dentro de su L3 y de cada L3 dentro de su nodo,
+    // para que la política dispersa alterne dominios y nodos
+    int rango_nucleo[MAX_CPUS_TOPOLOGIA];
+    int rango_l3[MAX_CPUS_TOPOLOGIA];
+    int nucleos_en_l3[MAX_CPUS_TOPOLOGIA];
+    int l3_en_nodo[MAX_CPUS_TOPOLOGIA];
+
+    for (int i = 0; i < MAX_CPUS_TOPOLOGIA; i++) {
+        rango_nucleo[i] = rango_l3[i] = -1;
+        nucleos_en_l3[i] = l3_en_nodo[i] = 0;
+    }
+    for (int i = 0; i < t->num_cpus; i++) {
+        const cpu_topologia_t* c = &t->cpus[i];
+        if (rango_l3[c->dominio_l3] < 0) {
+            rango_l3[c->dominio_l3] = l3_en_nodo[c->nodo_numa]++;
+        }
+        if (rango_nucleo[c->nucleo] < 0) {
+            rango_nucleo[c->nucleo] = nucleos_en_l3[c->dominio_l3]++;
+        }
+    }
+
+    ordenar_para_politica(t, AFINIDAD_COMPACTA, rango_nucleo, rango_l3, t->orden_compacta);
+    ordenar_para_politica(t, AFINIDAD_DISPERSA, rango_nucleo, rango_l3, t->orden_dispersa);
+    ordenar_para_politica(t, AFINIDAD_UNO_POR_NUCLEO, rango_nucleo, rango_l3, t->orden_uno_por_nucleo);
+}
+
+static void topologia_plana(topologia_cpu_t* t) {
+    long en_linea = sysconf(_SC_NPROCESSORS_ONLN);
+    int n = en_linea > 0 ? (int)en_linea : 1;
+    if (n > MAX_CPUS_TOPOLOGIA) {
+        n = MAX_CPUS_TOPOLOGIA;
+    }
+    t->num_cpus = n;
+    t->num_nucleos = n;
+    t->num_dominios_l3 = 1;
+    t->num_nodos = 1;
+    for (int i = 0; i < n; i++) {
+        t->cpus[i] = (cpu_topologia_t){ .cpu = i, .nucleo = i };
+    }
+    calcular_ordenes(t);
+}
+
+// Índice denso de una clave: el orden de aparición (las CPUs van en orden)
+static int indice_denso(int* claves, int* num_claves, int clave) {
+    for (int i = 0; i < *num_claves; i++) {
+        if (claves[i] == clave) {
+            return i;
+        }
+    }
+    claves[*num_claves] = clave;
+    return (*num_claves)++;
+}
+
+// Clave del dominio L3 de una CPU: su primera CPU compartida o, sin L3,
+// el paquete físico (en negativo para no confundirlo con una CPU)
+static int clave_dominio_l3(const char* ruta_cpu, int cpu) {
+    char ruta[512];
+    for (int indice = 0; indice < MAX_INDICES_CACHE; indice++) {
+        int nivel;
+        snprintf(ruta, sizeof(ruta), "%s/cpu%d/cache/index%d/level", ruta_cpu, cpu, indice);
+        if (leer_entero(ruta, &nivel) != 0) {
+            break;
+        }
+        if (nivel == 3) {
+            mascara_cpus_t compartidas;
+            snprintf(ruta, sizeof(ruta), "%s/cpu%d/cache/index%d/shared_cpu_list",
+                     ruta_cpu, cpu, indice);
+            if (leer_lista_cpus(ruta, &compartidas) == 0 && mascara_primera(&compartidas) >= 0) {
+                return mascara_primera(&compartidas);
+            }
+        }
+    }
+
+    int paquete = 0;
+    snprintf(ruta, sizeof(ruta), "%s/cpu%d/topology/physical_package_id", ruta_cpu, cpu);
+    leer_entero(ruta, &paquete);
+    return -1 - paquete;
+}
+
+int leer_topologia_cpu(const char* ruta_cpu, const char* ruta_nodos,
+                       const mascara_cpus_t* permitidas, topologia_cpu_t* topologia) {
+    if (ruta_cpu == NULL || ruta_nodos == NULL || topologia == NULL) {
+        return -1;
+    }
+    topologia_plana(topologia);
+
+    char ruta[512];
+    mascara_cpus_t en_linea;
+    snprintf(ruta, sizeof(ruta), "%s/online", ruta_cpu);
+    if (leer_lista_cpus(ruta, &en_linea) != 0) {
+        return -1;
+    }
+
+    // Nodo de cada CPU; los nodos sin CPUs no cuentan
+    int nodo_de_cpu[MAX_CPUS_TOPOLOGIA];
+    for (int cpu = 0; cpu < MAX_CPUS_TOPOLOGIA; cpu++) {
+        nodo_de_cpu[cpu] = 0;
+    }
+    mascara_cpus_t nodos;
+    snprintf(ruta, sizeof(ruta), "%s/online", ruta_nodos);
+    if (leer_lista_cpus(ruta, &nodos) == 0) {
+        for (int nodo = 0; nodo < MAX_CPUS_TOPOLOGIA; nodo++) {
+            mascara_cpus_t cpus_nodo;
+            if (!mascara_contiene(&nodos, nodo)) {
+                continue;
+            }
+            snprintf(ruta, sizeof(ruta), "%s/node%d/cpulist", ruta_nodos, nodo);
+            if (leer_lista_cpus(ruta, &cpus_nodo) != 0) {
+                continue;
+            }
+            for (int cpu = 0; cpu < MAX_CPUS_TOPOLOGIA; cpu++) {
+                if (mascara_contiene(&cpus_nodo, cpu)) {
+                    nodo_de_cpu[cpu] = nodo;
+                }
+            }
+        }
+    }
+
+    int claves_nucleo[MAX_CPUS_TOPOLOGIA];
+    int claves_l3[MAX_CPUS_TOPOLOGIA];
+    int claves_nodo[MAX_CPUS_TOPOLOGIA];
+    int num_nucleos = 0, num_l3 = 0, num_nodos = 0;
+    int n = 0;
+
+    for (int cpu = 0; cpu < MAX_CPUS_TOPOLOGIA; cpu++) {
+        if (!mascara_contiene(&en_linea, cpu) ||
+            (permitidas != NULL && !mascara_contiene(permitidas, cpu))) {
+            continue;
+        }
+
+        // El núcleo se identifica por su primer hermano SMT
+        mascara_cpus_t hermanos;
+        snprintf(ruta, sizeof(ruta), "%s/cpu%d/topology/thread_siblings_list", ruta_cpu, cpu);
+        if (leer_lista_cpus(ruta, &hermanos) != 0 || !mascara_contiene(&hermanos, cpu)) {
+            mascara_vaciar(&hermanos);
+            mascara_poner(&hermanos, cpu);
+        }
+        int hermano_smt = 0;
+        for (int otra = 0; otra < cpu; otra++) {
+            if (mascara_contiene(&hermanos, otra) && mascara_contiene(&en_linea, otra) &&
+                (permitidas == NULL || mascara_contiene(permitidas, otra))) {
+                hermano_smt++;
+            }
+        }
+
+        topologia->cpus[n] = (cpu_topologia_t){
+            .cpu = cpu,
+            .nucleo = indice_denso(claves_nucleo, &num_nucleos, mascara_primera(&hermanos)),
+            .hermano_smt = hermano_smt,
+            .dominio_l3 = indice_denso(claves_l3, &num_l3, clave_dominio_l3(ruta_cpu, cpu)),
+            .nodo_numa = indice_denso(claves_nodo, &num_nodos, nodo_de_cpu[cpu]),
+        };
+        n++;
+    }
+
+    if (n == 0) {
+        topologia_plana(topologia);
+        return -1;
+    }
+    topologia->num_cpus = n;
+    topologia->num_nucleos = num_nucleos;
+    topologia->num_dominios_l3 = num_l3;
+    topologia->num_nodos = num_nodos;
+    calcular_ordenes(topologia);
+    return 0;
+}
+
+static topologia_cpu_t topologia_sistema;
+static pthread_once_t topologia_once = PTHREAD_ONCE_INIT;
+
+static void cargar_topologia_sistema(void) {
+#ifdef TOPOLOGIA_LINUX
+    cpu_set_t conjunto;
+    mascara_cpus_t permitidas;
+    if (sched_getaffinity(0, sizeof(conjunto), &conjunto) == 0) {
+        cpu_set_a_mascara(&conjunto, &permitidas);
+        leer_topologia_cpu(RUTA_SYSFS_CPU, RUTA_SYSFS_NODOS, &permitidas, &topologia_sistema);
+    } else {
+        leer_topologia_cpu(RUTA_SYSFS_CPU, RUTA_SYSFS_NODOS, NULL, &topologia_sistema);
+    }
+#else
+    topologia_plana(&topologia_sistema);
+#endif
+}
+
+const topologia_cpu_t* obtener_topologia_cpu(void) {
+    pthread_once(&topologia_once, cargar_topologia_sistema);
+    return &topologia_sistema;
+}
+
+void mostrar_topologia_cpu(const topologia_cpu_t* topologia) {
+    if (topologia == NULL) {
+        return;
+    }
+
+    printf("\n=== TOPOLOGÍA DE CPU ===\n");
+    printf("CPUs lógicas: %d | Núcleos: %d | Dominios L3: %d | Nodos NUMA: %d\n",
+           topologia->num_cpus, topologia->num_nucleos,
+           topologia->num_dominios_l3, topologia->num_nodos);
+
+    for (int nucleo = 0; nucleo < topologia->num_nucleos; nucleo++) {
+        bool primera = true;
+        for (int i = 0; i < topologia->num_cpus; i++) {
+            const cpu_topologia_t* c = &topologia->cpus[i];
+            if (c->nucleo != nucleo) {
+                continue;
+            }
+            if (primera) {
+                printf("  Núcleo %3d (L3 %d, nodo %d): CPU", nucleo, c->dominio_l3, c->nodo_numa);
+                primera = false;
+            }
+            printf(" %d", c->cpu);
+        }
+        printf("\n");
+    }
+
+    int mostrar = topologia->num_cpus < 16 ? topologia->num_cpus : 16;
+    printf("\nCPU asignada al hilo i por cada política:\n");
+    printf("  %-10s", "hilo");
+    for (int i = 0; i < mostrar; i++) {
+        printf(" %4d", i);
+    }
+    printf("\n");
+    for (int p = AFINIDAD_COMPACTA; p < NUM_POLITICAS_AFINIDAD; p++) {
+        printf("  %-10s", nombre_politica_afinidad((politica_afinidad_t)p));
+        for (int i = 0; i < mostrar; i++) {
+            printf(" %4d", cpu_para_hilo(topologia, (politica_afinidad_t)p, i));
+        }
+        printf("\n");
+    }
+}
+
+/* ====================================================================
+ * POLÍTICAS DE AFINIDAD
+ * ==================================================================== */
+
+int cpu_para_hilo(const topologia_cpu_t* topologia, politica_afinidad_t politica, int indice) {
+    if (topologia == NULL || topologia->num_cpus <= 0 || indice < 0) {
+        return -1;
+    }
+    switch (politica) {
+        case AFINIDAD_COMPACTA:
+            return topologia->orden_compacta[indice % topologia->num_cpus];
+        case AFINIDAD_DISPERSA:
+            return topologia->orden_dispersa[indice % topologia->num_cpus];
+        case AFINIDAD_UNO_POR_NUCLEO:
+            if (topologia->num_nucleos <= 0) {
+                return -1;
+            }
+            return topologia->orden_uno_por_nucleo[indice % topologia->num_nucleos];
+        default:
+            return -1;
+    }
+}
+
+int crear_hilo_con_afinidad(pthread_t* hilo, void* (*funcion)(void*), void* arg,
+                            politica_afinidad_t politica, int indice) {
+#ifdef TOPOLOGIA_LINUX
+    int cpu = cpu_para_hilo(obtener_topologia_cpu(), politica, indice);
+    if (cpu >= 0) {
+        pthread_attr_t atributos;
+        cpu_set_t conjunto;
+        CPU_ZERO(&conjunto);
+        CPU_SET(cpu, &conjunto);
+        if (pthread_attr_init(&atributos) == 0) {
+            int resultado = pthread_attr_setaffinity_np(&atributos, sizeof(conjunto), &conjunto);
+            if (resultado == 0) {
+                resultado = pthread_create(hilo, &atributos, funcion, arg);
+            }
+            pthread_attr_destroy(&atributos);
+            // EINVAL: la CPU no está permitida (p. ej. por un cgroup); se crea sin fijar
+            if (resultado != EINVAL) {
+                return resultado;
+            }
+        }
+    }
+#else
+    (void)politica;
+    (void)indice;
+#endif
+    return pthread_create(hilo, NULL, funcion, arg);
+}
+
+int fijar_hilo_actual_con_politica(politica_afinidad_t politica, int indice) {
+    if (politica == AFINIDAD_NINGUNA) {
+        return 0;
+    }
+#ifdef TOPOLOGIA_LINUX
+    int cpu = cpu_para_hilo(obtener_topologia_cpu(), politica, indice);
+    if (cpu < 0) {
+        return -1;
+    }
+    cpu_set_t conjunto;
+    CPU_ZERO(&conjunto);
+    CPU_SET(cpu, &conjunto);
+    return pthread_setaffinity_np(pthread_self(), sizeof(conjunto), &conjunto) == 0 ? 0 : -1;
+#else
+    (void)indice;
+    return 0;
+#endif
+}
+
+int obtener_afinidad_hilo_actual(mascara_cpus_t* mascara) {
+    if (mascara == NULL) {
+        return -1;
+    }
+#ifdef TOPOLOGIA_LINUX
+    cpu_set_t conjunto;
+    if (pthread_getaffinity_np(pthread_self(), sizeof(conjunto), &conjunto) != 0) {
+        return -1;
+    }
+    cpu_set_a_mascara(&conjunto, mascara);
+    return 0;
+#else
+    mascara_vaciar(mascara);
+    return -1;
+#endif
+}
+
+int fijar_afinidad_hilo_actual(const mascara_cpus_t* mascara) {
+    if (mascara == NULL) {
+        return -1;
+    }
+#ifdef TOPOLOGIA_LINUX
+    cpu_set_t conjunto;
+    mascara_a_cpu_set(mascara, &conjunto);
+    return pthread_setaffinity_np(pthread_self(), sizeof(conjunto), &conjunto) == 0 ? 0 : -1;
+#else
+    return -1;
+#endif
+}
+
+static const char* const nombres_politica[NUM_POLITICAS_AFINIDAD] = {
+    [AFINIDAD_NINGUNA] = "ninguna",
+    [AFINIDAD_COMPACTA] = "compacta",
+    [AFINIDAD_DISPERSA] = "dispersa",
+    [AFINIDAD_UNO_POR_NUCLEO] = "nucleo",
+};
+
+const char* nombre_politica_afinidad(politica_afinidad_t politica) {
+    if (politica < AFINIDAD_NINGUNA || politica >= NUM_POLITICAS_AFINIDAD) {
+        return "desconocida";
+    }
+    return nombres_politica[politica];
+}
+
+int parsear_politica_afinidad(const char* nombre, politica_afinidad_t* politica) {
+    if (nombre == NULL || politica == NULL) {
+        return -1;
+    }
+    for (int p = 0; p < NUM_POLITICAS_AFINIDAD; p++) {
+        if (strcmp(nombre, nombres_politica[p]) == 0) {
+            *politica = (politica_afinidad_t)p;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static politica_afinidad_t politica_entorno = AFINIDAD_NINGUNA;
+static pthread_once_t politica_once = PTHREAD_ONCE_INIT;
+
+static void cargar_politica_entorno(void) {
+    const char* valor = getenv("AFINIDAD_HILOS");
+    if (valor != NULL && parsear_politica_afinidad(valor, &politica_entorno) != 0) {
+        fprintf(stderr, "AFINIDAD_HILOS=%s no es válida (ninguna, compacta, dispersa, nucleo)\n",
+                valor);
+        politica_entorno = AFINIDAD_NINGUNA;
+    }
+}
+
+politica_afinidad_t politica_afinidad_por_defecto(void) {
+    pthread_once(&politica_once, cargar_politica_entorno);
+    return politica_entorno;
+}
+
+int cpu_actual(void) {
+#ifdef TOPOLOGIA_LINUX
+    return sched_getcpu();
+#else
+    return -1;
+#endif
+}
@@ -0,0 +1,382 @@
+/**
+ * @file benchmark_barreras.c
+ * @brief Latencia de barreras y coste de un algoritmo por fases
+ *
+ * Compara pthread_barrier_t con la barrera centralizada, la de diseminación
+ * y el phaser de barreras.h para 1, 2, 4... hilos, y ejecuta una reducción
+ * iterativa creando los hilos en cada fase frente a hilos persistentes que
+ * se sincronizan con cada barrera.
+ *
+ * Uso: benchmark_barreras [max_hilos] [episodios] [fases]
+ */
+
+#include "../include/barreras.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#define EPISODIOS_DEFAULT 20000
+#define FASES_DEFAULT 2000
+#define ELEMENTOS_REDUCCION (1 << 16)
+
+typedef enum {
+    BARRERA_PTHREAD,
+    BARRERA_CENTRALIZADA,
+    BARRERA_DISEMINACION,
+    BARRERA_PHASER,
+    NUM_TIPOS_BARRERA
+} tipo_barrera_t;
+
+static const char* const nombres_barrera[NUM_TIPOS_BARRERA] = {
+    "pthread_barrier_t", "Centralizada", "Diseminación", "Phaser"
+};
+
+typedef struct {
+    tipo_barrera_t tipo;
+    pthread_barrier_t pthread;
+    barrera_centralizada_t centralizada;
+    barrera_diseminacion_t diseminacion;
+    phaser_t phaser;
+} barrera_prueba_t;
+
+static uint64_t obtener_tiempo_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static bool crear_barrera(barrera_prueba_t* b, tipo_barrera_t tipo, int num_hilos) {
+    b->tipo = tipo;
+    switch (tipo) {
+        case BARRERA_PTHREAD:
+            return pthread_barrier_init(&b->pthread, NULL, (unsigned)num_hilos) == 0;
+        case BARRERA_CENTRALIZADA:
+            return barrera_centralizada_init(&b->centralizada, num_hilos);
+        case BARRERA_DISEMINACION:
+            return barrera_diseminacion_init(&b->diseminacion, num_hilos);
+        case BARRERA_PHASER:
+            return phaser_init(&b->phaser, num_hilos);
+        default:
+            return false;
+    }
+}
+
+static void destruir_barrera(barrera_prueba_t* b) {
+    if (b->tipo == BARRERA_PTHREAD) {
+        pthread_barrier_destroy(&b->pthread);
+    } else if (b->tipo == BARRERA_DISEMINACION) {
+        barrera_diseminacion_destruir(&b->diseminacion);
+    }
+}
+
+static void esperar_barrera(barrera_prueba_t* b, int id_hilo) {
+    switch (b->tipo) {
+        case BARRERA_PTHREAD:      pthread_barrier_wait(&b->pthread); break;
+        case BARRERA_CENTRALIZADA: barrera_centralizada_esperar(&b->centralizada); break;
+        case BARRERA_DISEMINACION: barrera_diseminacion_esperar(&b->diseminacion, id_hilo); break;
+        case BARRERA_PHASER:       phaser_llegar_y_esperar(&b->phaser); break;
+        default: break;
+    }
+}
+
+/* ====================================================================
+ * LATENCIA DE UNA FASE VACÍA
+ * ==================================================================== */
+
+typedef struct {
+    barrera_prueba_t* barrera;
+    int id;
+    int episodios;
+    uint64_t ns;     // Solo el hilo 0
+} hilo_latencia_t;
+
+static void* hilo_latencia(void* arg) {
+    hilo_latencia_t* h = arg;
+    esperar_barrera(h->barrera, h->id);  // Todos arrancados antes de medir
+    uint64_t inicio = obtener_tiempo_ns();
+    for (int i = 0; i < h->episodios; i++) {
+        esperar_barrera(h->barrera, h->id);
+    }
+    h->ns = obtener_tiempo_ns() - inicio;
+    return NULL;
+}
+
+static double medir_latencia(tipo_barrera_t tipo, int num_hilos, int episodios) {
+    barrera_prueba_t barrera;
+    pthread_t* hilos = malloc((size_t)num_hilos * sizeof(pthread_t));
+    hilo_latencia_t* datos = malloc((size_t)num_hilos * sizeof(hilo_latencia_t));
+    if (hilos == NULL || datos == NULL || !crear_barrera(&barrera, tipo, num_hilos)) {
+        free(hilos);
+        free(datos);
+        return -1.0;
+    }
+
+    int creados = 0;
+    for (int i = 0; i < num_hilos; i++) {
+        datos[i] = (hilo_latencia_t){ &barrera, i, episodios, 0 };
+        if (pthread_create(&hilos[i], NULL, hilo_latencia, &datos[i]) != 0) {
+            break;
+        }
+        creados++;
+    }
+    if (creados != num_hilos) {
+        // Los creados esperan a los que faltan: no se pueden unir
+        fprintf(stderr, "No se pudieron crear %d hilos\n", num_hilos);
+        exit(1);
+    }
+    for (int i = 0; i < creados; i++) {
+        pthread_join(hilos[i], NULL);
+    }
+
+    double ns_por_fase = (double)datos[0].ns / episodios;
+    destruir_barrera(&barrera);
+    free(hilos);
+    free(datos);
+    return ns_por_fase;
+}
+
+/* ====================================================================
+ * REDUCCIÓN ITERATIVA: HILOS POR FASE VS HILOS PERSISTENTES
+ * ==================================================================== */
+
+// Cada fase acerca los valores a la media de la fase anterior y calcula la
+// suma parcial del bloque. Las parciales van en doble buffer: con una sola
+// barrera por fase, nadie escribe la parcial de la fase p+2 hasta que todos
+// han leído las de la fase p.
+typedef struct {
+    double* valores;
+    double* parciales[2];
+    int num_hilos;
+    int fases;
+    barrera_prueba_t* barrera;
+} reduccion_t;
+
+typedef struct {
+    reduccion_t* r;
+    int id;
+    int fase;        // Solo en la versión con un hilo por fase
+    double media;    // Media de la fase anterior
+} hilo_reduccion_t;
+
+static void ejecutar_fase(reduccion_t* r, int id, int fase, double media) {
+    long desde = (long)ELEMENTOS_REDUCCION * id / r->num_hilos;
+    long hasta = (long)ELEMENTOS_REDUCCION * (id + 1) / r->num_hilos;
+    double suma = 0.0;
+    for (long i = desde; i < hasta; i++) {
+        if (fase > 0) {
+            r->valores[i] = 0.5 * (r->valores[i] + media);
+        }
+        suma += r->valores[i];
+    }
+    r->parciales[fase & 1][id] = suma;
+}
+
+static double media_fase(const reduccion_t* r, int fase) {
+    double total = 0.0;
+    for (int i = 0; i < r->num_hilos; i++) {
+        total += r->parciales[fase & 1][i];
+    }
+    return total / ELEMENTOS_REDUCCION;
+}
+
+static void* hilo_una_fase(void* arg) {
+    hilo_reduccion_t* h = arg;
+    ejecutar_fase(h->r, h->id, h->fase, h->media);
+    return NULL;
+}
+
+static void* hilo_todas_las_fases(void* arg) {
+    hilo_reduccion_t* h = arg;
+    double media = 0.0;
+    for (int fase = 0; fase < h->r->fases; fase++) {
+        ejecutar_fase(h->r, h->id, fase, media);
+        esperar_barrera(h->r->barrera, h->id);
+        media = media_fase(h->r, fase);
+    }
+    h->media = media;
+    return NULL;
+}
+
+static void iniciar_valores(double* valores) {
+    for (int i = 0; i < ELEMENTOS_REDUCCION; i++) {
+        valores[i] = (double)(i % 1000);
+    }
+}
+
+// Devuelve microsegundos totales; *media recibe el resultado final
+static double medir_reduccion(int tipo, int num_hilos, int fases, double* media) {
+    double* valores = malloc(ELEMENTOS_REDUCCION * sizeof(double));
+    double* parciales = calloc(2 * (size_t)num_hilos, sizeof(double));
+    pthread_t* hilos = malloc((size_t)num_hilos * sizeof(pthread_t));
+    hilo_reduccion_t* datos = malloc((size_t)num_hilos * sizeof(hilo_reduccion_t));
+    barrera_prueba_t barrera;
+    bool persistentes = tipo >= 0;
+    if (valores == NULL || parciales == NULL || hilos == NULL || datos == NULL ||
+        (persistentes && !crear_barrera(&barrera, (tipo_barrera_t)tipo, num_hilos))) {
+        free(valores);
+        free(parciales);
+        free(hilos);
+        free(datos);
+        return -1.0;
+    }
+    iniciar_valores(valores);
+    reduccion_t r = { valores, { parciales, parciales + num_hilos }, num_hilos, fases,
+                      persistentes ? &barrera : NULL };
+
+    uint64_t inicio = obtener_tiempo_ns();
+    if (persistentes) {
+        for (int i = 0; i < num_hilos; i++) {
+            datos[i] = (hilo_reduccion_t){ &r, i, 0, 0.0 };
+            pthread_create(&hilos[i], NULL, hilo_todas_las_fases, &datos[i]);
+        }
+        for (int i = 0; i < num_hilos; i++) {
+            pthread_join(hilos[i], NULL);
+        }
+        *media = datos[0].media;
+    } else {
+        double m = 0.0;
+        for (int fase = 0; fase < fases; fase++) {
+            for (int i = 0; i < num_hilos; i++) {
+                datos[i] = (hilo_reduccion_t){ &r, i, fase, m };
+                pthread_create(&hilos[i], NULL, hilo_una_fase, &datos[i]);
+            }
+            for (int i = 0; i < num_hilos; i++) {
+                pthread_join(hilos[i], NULL);
+            }
+            m = media_fase(&r, fase);
+        }
+        *media = m;
+    }
+    double us = (obtener_tiempo_ns() - inicio) / 1e3;
+
+    if (persistentes) {
+        destruir_barrera(&barrera);
+    }
+    free(valores);
+    free(parciales);
+    free(hilos);
+    free(datos);
+    return us;
+}
+
+/* ====================================================================
+ * PHASER CON BAJAS
+ * ==================================================================== */
+
+typedef struct {
+    phaser_t* phaser;
+    int fases_activo;
+    atomic_int* llegadas;  // Llegadas por fase
+} hilo_phaser_t;
+
+static void* hilo_con_baja(void* arg) {
+    hilo_phaser_t* h = arg;
+    for (int i = 0; i < h->fases_activo - 1; i++) {
+        int fase = phaser_fase(h->phaser);
+        atomic_fetch_add(&h->llegadas[fase], 1);
+        phaser_llegar_y_esperar(h->phaser);
+    }
+    int fase = phaser_fase(h->phaser);
+    atomic_fetch_add(&h->llegadas[fase], 1);
+    phaser_llegar_y_desregistrar(h->phaser);
+    return NULL;
+}
+
+// El hilo i participa en i + 1 fases: en la fase f deben llegar n - f hilos
+static bool comprobar_phaser_con_bajas(int num_hilos) {
+    phaser_t phaser;
+    phaser_init(&phaser, 0);
+    pthread_t* hilos = malloc((size_t)num_hilos * sizeof(pthread_t));
+    hilo_phaser_t* datos = malloc((size_t)num_hilos * sizeof(hilo_phaser_t));
+    atomic_int* llegadas = calloc((size_t)num_hilos + 1, sizeof(atomic_int));
+    if (hilos == NULL || datos == NULL || llegadas == NULL) {
+        free(hilos);
+        free(datos);
+        free(llegadas);
+        return false;
+    }
+
+    // Todos se registran antes de arrancar ninguno: el registro es dinámico,
+    // pero un hilo que se registre tarde entraría en una fase posterior
+    for (int i = 0; i < num_hilos; i++) {
+        phaser_registrar(&phaser);
+        datos[i] = (hilo_phaser_t){ &phaser, i + 1, llegadas };
+    }
+    for (int i = 0; i < num_hilos; i++) {
+        pthread_create(&hilos[i], NULL, hilo_con_baja, &datos[i]);
+    }
+    for (int i = 0; i < num_hilos; i++) {
+        pthread_join(hilos[i], NULL);
+    }
+
+    bool correcto = phaser_registrados(&phaser) == 0 && phaser_fase(&phaser) == num_hilos;
+    for (int f = 0; f < num_hilos; f++) {
+        correcto = correcto && atomic_load(&llegadas[f]) == num_hilos - f;
+    }
+    free(hilos);
+    free(datos);
+    free(llegadas);
+    return correcto;
+}
+
+int main(int argc, char* argv[]) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int max_hilos = argc > 1 ? atoi(argv[1]) : (cpus > 4 ? (int)cpus : 4);
+    int episodios = argc > 2 ? atoi(argv[2]) : EPISODIOS_DEFAULT;
+    int fases = argc > 3 ? atoi(argv[3]) : FASES_DEFAULT;
+    if (max_hilos < 1 || episodios < 1 || fases < 1) {
+        fprintf(stderr, "Uso: %s [max_hilos] [episodios] [fases]\n", argv[0]);
+        return 1;
+    }
+
+    printf("BENCHMARKS DE BARRERAS\n");
+    printf("======================\n");
+    printf("CPUs en línea: %ld\n", cpus);
+
+    printf("\n=== LATENCIA POR FASE (ns, %d fases vacías) ===\n", episodios);
+    printf("%-6s", "Hilos");
+    for (int t = 0; t < NUM_TIPOS_BARRERA; t++) {
+        printf(" %18s", nombres_barrera[t]);
+    }
+    printf("\n");
+    for (int n = 1;; n *= 2) {
+        if (n > max_hilos) {
+            n = max_hilos;
+        }
+        printf("%-6d", n);
+        for (int t = 0; t < NUM_TIPOS_BARRERA; t++) {
+            printf(" %18.0f", medir_latencia((tipo_barrera_t)t, n, episodios));
+            fflush(stdout);
+        }
+        printf("\n");
+        if (n == max_hilos) {
+            break;
+        }
+    }
+
+    int hilos_reduccion = max_hilos;
+    printf("\n=== REDUCCIÓN ITERATIVA (%d fases, %d hilos, %d elementos) ===\n",
+           fases, hilos_reduccion, ELEMENTOS_REDUCCION);
+    printf("%-32s %12s %12s %s\n", "Sincronización", "Total ms", "us/fase", "Resultado");
+    double media_referencia = 0.0;
+    double us = medir_reduccion(-1, hilos_reduccion, fases, &media_referencia);
+    printf("%-32s %12.2f %12.2f %.6f\n", "pthread_create por fase", us / 1e3, us / fases,
+           media_referencia);
+    bool correcto = us >= 0.0;
+    for (int t = 0; t < NUM_TIPOS_BARRERA; t++) {
+        double media = 0.0;
+        us = medir_reduccion(t, hilos_reduccion, fases, &media);
+        bool igual = us >= 0.0 && media == media_referencia;
+        correcto = correcto && igual;
+        printf("%-32s %12.2f %12.2f %.6f %s\n", nombres_barrera[t], us / 1e3, us / fases,
+               media, igual ? "✓" : "✗");
+    }
+
+    bool phaser_ok = comprobar_phaser_con_bajas(max_hilos);
+    printf("\nPhaser con bajas (el hilo i participa en i+1 fases): %s\n",
+           phaser_ok ? "✓ correcto" : "✗ ERROR");
+
+    return (correcto && phaser_ok) ? 0 : 1;
+}
@@ -0,0 +1,224 @@
+/**
+ * @file benchmark_pool_hilos.c
+ * @brief Benchmarks del pool de hilos con robo de trabajo
+ *
+ * Compara el coste de lanzar tareas pequeñas con pthread_create/pthread_join
+ * por tarea frente a enviarlas a un pool persistente, y mide pool_paralelo_para.
+ */
+
+#include "../include/pool_hilos.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#define TAREAS_PTHREAD 20000
+#define TAREAS_POOL 1000000
+#define PROFUNDIDAD_ARBOL 18
+#define ELEMENTOS_VECTOR (1L << 24)
+
+static uint64_t obtener_tiempo_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static atomic_long contador_tareas;
+
+static void tarea_vacia(void* arg) {
+    (void)arg;
+    atomic_fetch_add_explicit(&contador_tareas, 1, memory_order_relaxed);
+}
+
+static void* hilo_vacio(void* arg) {
+    tarea_vacia(arg);
+    return NULL;
+}
+
+/* ====================================================================
+ * LANZAMIENTO DE TAREAS: pthread_create POR TAREA VS POOL
+ * ==================================================================== */
+
+static double medir_pthread_por_tarea(int num_tareas, int en_vuelo) {
+    pthread_t* hilos = malloc((size_t)en_vuelo * sizeof(pthread_t));
+    if (hilos == NULL) return 0.0;
+
+    atomic_store(&contador_tareas, 0);
+    uint64_t inicio = obtener_tiempo_ns();
+    for (int hechas = 0; hechas < num_tareas; hechas += en_vuelo) {
+        int lote = num_tareas - hechas < en_vuelo ? num_tareas - hechas : en_vuelo;
+        for (int i = 0; i < lote; i++) {
+            pthread_create(&hilos[i], NULL, hilo_vacio, NULL);
+        }
+        for (int i = 0; i < lote; i++) {
+            pthread_join(hilos[i], NULL);
+        }
+    }
+    double segundos = (obtener_tiempo_ns() - inicio) / 1e9;
+    free(hilos);
+
+    if (atomic_load(&contador_tareas) != num_tareas) {
+        printf("❌ pthread: se esperaban %d tareas y se ejecutaron %ld\n",
+               num_tareas, atomic_load(&contador_tareas));
+    }
+    return num_tareas / segundos;
+}
+
+static double medir_pool_externo(pool_hilos_t* pool, int num_tareas) {
+    grupo_espera_t grupo;
+    grupo_espera_iniciar(&grupo);
+
+    atomic_store(&contador_tareas, 0);
+    uint64_t inicio = obtener_tiempo_ns();
+    for (int i = 0; i < num_tareas; i++) {
+        pool_enviar(pool, tarea_vacia, NULL, &grupo);
+    }
+    pool_esperar(pool, &grupo);
+    double segundos = (obtener_tiempo_ns() - inicio) / 1e9;
+    grupo_espera_destruir(&grupo);
+
+    if (atomic_load(&contador_tareas) != num_tareas) {
+        printf("❌ pool: se esperaban %d tareas y se ejecutaron %ld\n",
+               num_tareas, atomic_load(&contador_tareas));
+    }
+    return num_tareas / segundos;
+}
+
+// Árbol binario de tareas: cada nodo interno envía dos hijos desde dentro de
+// un trabajador, así que las tareas entran en las deques locales y se roban
+typedef struct {
+    pool_hilos_t* pool;
+    grupo_espera_t* grupo;
+    int profundidad;
+} nodo_arbol_t;
+
+static void tarea_arbol(void* arg) {
+    nodo_arbol_t* nodo = (nodo_arbol_t*)arg;
+    tarea_vacia(NULL);
+    if (nodo->profundidad > 0) {
+        for (int i = 0; i < 2; i++) {
+            nodo_arbol_t* hijo = malloc(sizeof(nodo_arbol_t));
+            if (hijo == NULL) break;
+            *hijo = *nodo;
+            hijo->profundidad = nodo->profundidad - 1;
+            if (pool_enviar(nodo->pool, tarea_arbol, hijo, nodo->grupo) != 0) {
+                free(hijo);
+            }
+        }
+    }
+    free(nodo);
+}
+
+static double medir_pool_arbol(pool_hilos_t* pool, int profundidad, long* num_tareas) {
+    grupo_espera_t grupo;
+    grupo_espera_iniciar(&grupo);
+    nodo_arbol_t* raiz = malloc(sizeof(nodo_arbol_t));
+    if (raiz == NULL) return 0.0;
+    *raiz = (nodo_arbol_t){ pool, &grupo, profundidad };
+
+    atomic_store(&contador_tareas, 0);
+    uint64_t inicio = obtener_tiempo_ns();
+    pool_enviar(pool, tarea_arbol, raiz, &grupo);
+    pool_esperar(pool, &grupo);
+    double segundos = (obtener_tiempo_ns() - inicio) / 1e9;
+    grupo_espera_destruir(&grupo);
+
+    *num_tareas = atomic_load(&contador_tareas);
+    return *num_tareas / segundos;
+}
+
+void benchmark_lanzamiento_tareas(pool_hilos_t* pool) {
+    int trabajadores = pool_num_trabajadores(pool);
+    printf("\n=== BENCHMARK: LANZAMIENTO DE TAREAS ===\n");
+    printf("Trabajadores del pool: %d\n", trabajadores);
+
+    double tasa_pthread = medir_pthread_por_tarea(TAREAS_PTHREAD, trabajadores);
+    double tasa_externo = medir_pool_externo(pool, TAREAS_POOL);
+    long tareas_arbol = 0;
+    double tasa_arbol = medir_pool_arbol(pool, PROFUNDIDAD_ARBOL, &tareas_arbol);
+
+    printf("%-36s %14s %10s\n", "Método", "Tareas/s", "Speedup");
+    printf("%-36s %14.0f %9.1fx\n", "pthread_create + join por tarea", tasa_pthread, 1.0);
+    printf("%-36s %14.0f %9.1fx\n", "pool_enviar desde hilo externo", tasa_externo,
+           tasa_externo / tasa_pthread);
+    printf("%-36s %14.0f %9.1fx\n", "pool_enviar anidado (árbol)", tasa_arbol,
+           tasa_arbol / tasa_pthread);
+    printf("(%d tareas con pthread, %d externas, %ld en el árbol)\n",
+           TAREAS_PTHREAD, TAREAS_POOL, tareas_arbol);
+}
+
+/* ====================================================================
+ * BUCLE PARALELO
+ * ==================================================================== */
+
+typedef struct {
+    const double* datos;
+    atomic_long suma;   // Suma de los subrangos, sin locks
+} suma_vector_t;
+
+static void sumar_rango(void* arg, long desde, long hasta) {
+    suma_vector_t* s = (suma_vector_t*)arg;
+    long parcial = 0;
+    for (long i = desde; i < hasta; i++) {
+        parcial += (long)s->datos[i];
+    }
+    atomic_fetch_add_explicit(&s->suma, parcial, memory_order_relaxed);
+}
+
+void benchmark_paralelo_para(pool_hilos_t* pool) {
+    printf("\n=== BENCHMARK: POOL_PARALELO_PARA ===\n");
+    double* datos = malloc(ELEMENTOS_VECTOR * sizeof(double));
+    if (datos == NULL) {
+        printf("❌ Error al asignar memoria\n");
+        return;
+    }
+    for (long i = 0; i < ELEMENTOS_VECTOR; i++) {
+        datos[i] = (double)(i % 100);
+    }
+
+    suma_vector_t secuencial = { datos, 0 };
+    uint64_t inicio = obtener_tiempo_ns();
+    sumar_rango(&secuencial, 0, ELEMENTOS_VECTOR);
+    double t_secuencial = (obtener_tiempo_ns() - inicio) / 1e6;
+
+    printf("%-22s %12s %10s\n", "Bloque", "Tiempo (ms)", "Speedup");
+    printf("%-22s %12.2f %9.2fx\n", "secuencial", t_secuencial, 1.0);
+
+    long bloques[] = { 0, 1L << 10, 1L << 14, 1L << 18 };
+    for (size_t b = 0; b < sizeof(bloques) / sizeof(bloques[0]); b++) {
+        suma_vector_t paralelo = { datos, 0 };
+        inicio = obtener_tiempo_ns();
+        pool_paralelo_para(pool, 0, ELEMENTOS_VECTOR, bloques[b], sumar_rango, &paralelo);
+        double t_paralelo = (obtener_tiempo_ns() - inicio) / 1e6;
+
+        char etiqueta[32];
+        if (bloques[b] == 0) {
+            snprintf(etiqueta, sizeof(etiqueta), "automático");
+        } else {
+            snprintf(etiqueta, sizeof(etiqueta), "%ld", bloques[b]);
+        }
+        printf("%-22s %12.2f %9.2fx%s\n", etiqueta, t_paralelo, t_secuencial / t_paralelo,
+               atomic_load(&paralelo.suma) == atomic_load(&secuencial.suma) ? "" : "  ❌ suma distinta");
+    }
+    free(datos);
+}
+
+int main(void) {
+    printf("BENCHMARKS DEL POOL DE HILOS\n");
+    printf("============================\n");
+    printf("Núcleos en línea: %ld\n", sysconf(_SC_NPROCESSORS_ONLN));
+
+    pool_hilos_t* pool = pool_crear(0);
+    if (pool == NULL) {
+        printf("❌ Error al crear el pool\n");
+        return 1;
+    }
+
+    benchmark_lanzamiento_tareas(pool);
+    benchmark_paralelo_para(pool);
+    pool_mostrar_estadisticas(pool);
+
+    pool_destruir(pool);
+    printf("\n✅ Benchmarks completados\n");
+    return 0;
+}
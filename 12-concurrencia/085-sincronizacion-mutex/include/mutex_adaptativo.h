@@ -0,0 +1,80 @@
+#ifndef MUTEX_ADAPTATIVO_H
+#define MUTEX_ADAPTATIVO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @file mutex_adaptativo.h
+ * @brief Mutex que gira antes de dormir, sobre futex
+ *
+ * Con secciones críticas de decenas de nanosegundos, dormir en el kernel en
+ * cuanto el mutex está ocupado cuesta mucho más que esperar un poco a que se
+ * libere. Este mutex:
+ *
+ * - Intenta primero un CAS sin más (camino rápido sin llamadas al sistema).
+ * - Si está ocupado, gira con espera exponencial (1, 2, 4... pausas de CPU
+ *   entre intentos) hasta un presupuesto de vueltas.
+ * - El presupuesto se ajusta con una media móvil de las vueltas que hicieron
+ *   falta en las últimas adquisiciones, que es una medida barata (sin leer
+ *   el reloj) de cuánto retienen el mutex los demás hilos. Si girar no basta,
+ *   el presupuesto baja: con retenciones largas no compensa girar.
+ * - Si se agota, duerme en un futex (estados 0 libre, 1 ocupado, 2 ocupado
+ *   con hilos dormidos, como en "Futexes Are Tricky" de Drepper).
+ * - Un hilo que se despierta UMBRAL_HAMBRE_MUTEX veces sin conseguir el mutex
+ *   pasa a hambriento. Mientras haya hambrientos nadie gira ni entra por el
+ *   camino rápido, y quien libera el mutex se lo cede directamente a un
+ *   hambriento en lugar de dejarlo libre.
+ *
+ * Fuera de Linux no hay futex: dormir se sustituye por sched_yield.
+ */
+
+#define UMBRAL_HAMBRE_MUTEX 4          // Despertares sin éxito antes de pedir cesión
+#define MIN_VUELTAS_MUTEX 4            // Límites del presupuesto de giro
+#define MAX_VUELTAS_MUTEX 64
+#define MAX_PAUSAS_VUELTA_MUTEX 16     // Tope de la espera exponencial entre intentos
+
+typedef struct {
+    uint32_t estado;                   // 0 libre, 1 ocupado, 2 ocupado con durmientes
+    uint32_t hambrientos;              // Hilos esperando una cesión directa
+    uint32_t avisos_hambre;            // Secuencia para despertar a los hambrientos
+    uint32_t cesiones;                 // Cesiones pendientes de recoger
+    uint32_t presupuesto_vueltas;      // Media móvil de las vueltas necesarias
+    // Estadísticas (solo se actualizan fuera del camino rápido)
+    uint64_t adquisiciones_girando;    // Conseguidas durante el giro
+    uint64_t adquisiciones_durmiendo;  // Conseguidas tras agotar el giro
+    uint64_t adquisiciones_cedidas;    // Recibidas por cesión directa
+} mutex_adaptativo_t;
+
+#define MUTEX_ADAPTATIVO_INICIALIZADOR { 0, 0, 0, 0, 16, 0, 0, 0 }
+
+/**
+ * @brief Inicializa un mutex adaptativo
+ */
+void mutex_adaptativo_init(mutex_adaptativo_t* mutex);
+
+/**
+ * @brief Bloquea el mutex (gira, luego duerme)
+ */
+void mutex_adaptativo_lock(mutex_adaptativo_t* mutex);
+
+/**
+ * @brief Intenta bloquear sin esperar
+ * @return true si se adquirió
+ */
+bool mutex_adaptativo_trylock(mutex_adaptativo_t* mutex);
+
+/**
+ * @brief Libera el mutex (o se lo cede a un hilo hambriento)
+ */
+void mutex_adaptativo_unlock(mutex_adaptativo_t* mutex);
+
+/**
+ * @brief Compara el mutex adaptativo con pthread normal, recursivo y errorcheck
+ * @param max_hilos Máximo de hilos (se prueba 1, 2, 4, ... hasta max_hilos)
+ * @param operaciones_totales Adquisiciones repartidas entre los hilos de cada prueba
+ * @return true si todos los contadores terminaron con el valor esperado
+ */
+bool ejecutar_benchmark_mutex_adaptativo(int max_hilos, int operaciones_totales);
+
+#endif // MUTEX_ADAPTATIVO_H
@@ -0,0 +1,122 @@
+#ifndef PERFIL_CONTENCION_H
+#define PERFIL_CONTENCION_H
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @file perfil_contencion.h
+ * @brief Perfilador de contención de mutex
+ *
+ * Para instrumentar un cerrojo basta con cambiar pthread_mutex_lock/unlock
+ * por las macros:
+ *
+ *     MUTEX_LOCK_PERFILADO(&cola->mutex);
+ *     ...
+ *     MUTEX_UNLOCK_PERFILADO(&cola->mutex);
+ *
+ * Cada hilo guarda, por cerrojo, dos histogramas logarítmicos en
+ * nanosegundos: espera para adquirir y tiempo retenido. Los histogramas son
+ * del hilo, así que registrar una adquisición no usa ningún cerrojo ni
+ * operación atómica de lectura-modificación-escritura. El informe recorre
+ * los bloques de todos los hilos y los fusiona por nombre e id de registro.
+ *
+ * El id identifica cada vida de un cerrojo: registrar_cerrojo_perfil() tras
+ * pthread_mutex_init le da uno nuevo aunque la dirección se haya usado antes
+ * (mutex en la pila, recursos reinicializados). Un cerrojo sin registrar
+ * recibe un id la primera vez que se bloquea con el perfilador activo.
+ *
+ * Mientras el perfilador está desactivado las macros solo comprueban una
+ * variable antes de llamar a pthread. Compilando con
+ * -DPERFIL_CONTENCION_DESACTIVADO son exactamente pthread_mutex_lock/unlock.
+ */
+
+#define NUM_CUBETAS_CONTENCION 40      // Cubeta b: [2^b, 2^(b+1)) ns; la última acumula el resto
+#define MAX_CERROJOS_POR_HILO 32       // Cerrojos distintos que registra cada hilo
+
+// Resumen fusionado de un cerrojo
+typedef struct {
+    const void* cerrojo;
+    uint32_t id;                       // Id de registro; se muestra como nombre#id
+    const char* nombre;
+    uint64_t adquisiciones;
+    uint64_t contendidas;              // Adquisiciones que tuvieron que esperar
+    uint64_t espera_total_ns;
+    uint64_t retencion_total_ns;
+    uint64_t espera[NUM_CUBETAS_CONTENCION];
+    uint64_t retencion[NUM_CUBETAS_CONTENCION];
+} resumen_contencion_t;
+
+/**
+ * @brief Activa o desactiva el registro (desactivado al empezar)
+ */
+void activar_perfil_contencion(bool activo);
+
+/**
+ * @brief Indica si el perfilador está registrando
+ */
+bool perfil_contencion_activo(void);
+
+/**
+ * @brief Pone a cero los histogramas de todos los hilos
+ *
+ * Debe llamarse sin hilos registrando (por ejemplo, antes de una prueba).
+ */
+void reiniciar_perfil_contencion(void);
+
+/**
+ * @brief Da un id nuevo a un cerrojo recién inicializado
+ *
+ * Llamar tras pthread_mutex_init para que el informe no mezcle este cerrojo
+ * con otro que ocupó antes la misma dirección.
+ * @param mutex Mutex a registrar
+ * @return Id asignado, 0 si el registro está lleno
+ */
+uint32_t registrar_cerrojo_perfil(const pthread_mutex_t* mutex);
+
+/**
+ * @brief pthread_mutex_lock que registra la espera (usar MUTEX_LOCK_PERFILADO)
+ * @param mutex Mutex a bloquear
+ * @param nombre Nombre del cerrojo en el informe
+ * @return Código de pthread_mutex_lock
+ */
+int perfil_mutex_lock(pthread_mutex_t* mutex, const char* nombre);
+
+/**
+ * @brief pthread_mutex_unlock que registra el tiempo retenido
+ * @return Código de pthread_mutex_unlock
+ */
+int perfil_mutex_unlock(pthread_mutex_t* mutex);
+
+/**
+ * @brief Fusiona los histogramas de todos los hilos por cerrojo
+ * @param resumenes Salida, ordenada por espera total descendente
+ * @param max_resumenes Capacidad de resumenes
+ * @return Número de cerrojos escritos
+ */
+int fusionar_perfil_contencion(resumen_contencion_t* resumenes, int max_resumenes);
+
+/**
+ * @brief Percentil aproximado de un histograma (límite superior de la cubeta)
+ * @param cubetas Histograma de NUM_CUBETAS_CONTENCION cubetas
+ * @param percentil Entre 0 y 100
+ * @return Nanosegundos
+ */
+uint64_t percentil_contencion(const uint64_t* cubetas, double percentil);
+
+/**
+ * @brief Imprime los cerrojos con más espera
+ * @param max_cerrojos Máximo de cerrojos a mostrar
+ */
+void imprimir_perfil_contencion(int max_cerrojos);
+
+#ifdef PERFIL_CONTENCION_DESACTIVADO
+#define MUTEX_LOCK_PERFILADO(m) pthread_mutex_lock(m)
+#define MUTEX_UNLOCK_PERFILADO(m) pthread_mutex_unlock(m)
+#else
+#define MUTEX_LOCK_PERFILADO(m) perfil_mutex_lock((m), #m)
+#define MUTEX_UNLOCK_PERFILADO(m) perfil_mutex_unlock(m)
+#endif
+
+#endif // PERFIL_CONTENCION_H
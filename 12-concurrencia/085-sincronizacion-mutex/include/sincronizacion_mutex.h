@@ -19,12 +19,23 @@
  * - Deadlock y su prevención
  * - Mutex recursivos
  * - Mutex con timeout
+ * - Cerrojos de lectura/escritura (pthread_rwlock_t) y seqlocks
  */
 
+// Primitiva que protege un recurso compartido
+typedef enum {
+    RECURSO_MUTEX = 0,          // Lectores y escritores se excluyen entre sí
+    RECURSO_RWLOCK,             // Varios lectores a la vez (pthread_rwlock_t)
+    RECURSO_SEQLOCK             // Lectores sin bloqueo que reintentan si hubo escritura
+} tipo_recurso_t;
+
 // Estructura para demostrar acceso concurrente a recurso compartido
 typedef struct {
     int64_t valor;              // Recurso compartido
-    pthread_mutex_t mutex;      // Mutex para proteger el recurso
+    pthread_mutex_t mutex;      // Mutex para proteger el recurso (en seqlock, entre escritores)
+    pthread_rwlock_t rwlock;    // Solo con RECURSO_RWLOCK
+    uint64_t secuencia;         // Solo con RECURSO_SEQLOCK: impar mientras se escribe
+    tipo_recurso_t tipo;        // Primitiva usada por leer/incrementar/establecer
     bool inicializado;          // Flag de inicialización
 } recurso_compartido_t;
 
@@ -34,7 +45,7 @@ typedef struct {
     uint64_t operaciones_escritura;
     uint64_t colisiones_detectadas;
     uint64_t tiempo_espera_ms;
-    pthread_mutex_t mutex_stats;
+    pthread_mutex_t mutex_stats;    // Ya no se usa para registrar: los contadores son atómicos
 } estadisticas_mutex_t;
 
 // Estructura para prueba de rendimiento
@@ -44,6 +55,7 @@ typedef struct {
     recurso_compartido_t* recurso;
     estadisticas_mutex_t* stats;
     bool usar_mutex;  // Para comparar con/sin mutex
+    bool barrido_lectura_escritura; // Comparar además mutex, rwlock y seqlock
 } parametros_prueba_t;
 
 // Estructura para demostrar diferentes tipos de mutex
@@ -63,6 +75,26 @@ typedef struct {
  */
 bool inicializar_recurso_compartido(recurso_compartido_t* recurso, int64_t valor_inicial);
 
+/**
+ * @brief Inicializa un recurso compartido con la primitiva indicada
+ * @param recurso Puntero al recurso a inicializar
+ * @param valor_inicial Valor inicial del recurso
+ * @param tipo Mutex, rwlock o seqlock
+ * @return true si la inicialización fue exitosa
+ *
+ * leer_recurso_seguro, incrementar_recurso_seguro y establecer_recurso_seguro
+ * funcionan igual con los tres tipos. Con rwlock los lectores no se bloquean
+ * entre sí; con seqlock los lectores no escriben en memoria compartida y
+ * reintentan si una escritura se cruzó con su lectura.
+ */
+bool inicializar_recurso_compartido_tipo(recurso_compartido_t* recurso, int64_t valor_inicial,
+                                         tipo_recurso_t tipo);
+
+/**
+ * @brief Nombre legible de un tipo de recurso ("mutex", "rwlock", "seqlock")
+ */
+const char* nombre_tipo_recurso(tipo_recurso_t tipo);
+
 /**
  * @brief Destruye un recurso compartido y libera el mutex
  * @param recurso Puntero al recurso a destruir
@@ -144,6 +176,14 @@ void* hilo_prueba_concurrencia(void* arg);
  */
 bool ejecutar_prueba_rendimiento(parametros_prueba_t* params);
 
+/**
+ * @brief Compara mutex, rwlock y seqlock con proporciones 99:1, 90:10 y 50:50
+ * @param num_hilos Número de hilos a usar
+ * @param operaciones_por_hilo Lecturas + escrituras de cada hilo
+ * @return true si todas las variantes terminaron con el valor esperado
+ */
+bool ejecutar_barrido_lectura_escritura(int num_hilos, int operaciones_por_hilo);
+
 /**
  * @brief Demuestra el problema de condiciones de carrera
  * @param num_hilos Número de hilos a usar
@@ -1,4 +1,5 @@
 #include "../include/sincronizacion_mutex.h"
+#include "../include/perfil_contencion.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
@@ -11,6 +12,8 @@ static void imprimir_menu(void) {
     printf("4. Demostrar tipos de mutex\n");
     printf("5. Prueba de timeout en mutex\n");
     printf("6. Demostración completa\n");
+    printf("7. Mutex vs rwlock vs seqlock (lectura:escritura)\n");
+    printf("8. Perfil de contención de cerrojos\n");
     printf("0. Salir\n");
     printf("Seleccione una opción: ");
 }
@@ -163,6 +166,71 @@ static void demo_timeout_mutex(void) {
     printf("y implementar lógica de fallback cuando un recurso no está disponible.\n");
 }
 
+static void demo_lectura_escritura(void) {
+    printf("\n=== Mutex vs RWLock vs Seqlock ===\n");
+    printf("Con mutex los lectores se excluyen entre sí aunque no modifiquen nada.\n");
+    printf("Con rwlock pueden leer a la vez; con seqlock ni siquiera escriben en\n");
+    printf("memoria compartida y solo reintentan si coincidieron con una escritura.\n");
+    
+    int hilos_a_probar[] = {1, 2, 4, 8};
+    int num_pruebas = sizeof(hilos_a_probar) / sizeof(hilos_a_probar[0]);
+    for (int i = 0; i < num_pruebas; i++) {
+        ejecutar_barrido_lectura_escritura(hilos_a_probar[i], 200000);
+    }
+}
+
+// Dos cerrojos: uno muy disputado con secciones cortas y otro poco usado
+// con secciones largas, para ver cómo los distingue el perfil
+typedef struct {
+    recurso_compartido_t* contador;
+    pthread_mutex_t* mutex_registro;
+    int operaciones;
+} args_perfil_t;
+
+static void* hilo_perfil_contencion(void* arg) {
+    args_perfil_t* args = (args_perfil_t*)arg;
+    for (int i = 0; i < args->operaciones; i++) {
+        incrementar_recurso_seguro(args->contador, 1);
+        if (i % 100 == 0) {
+            MUTEX_LOCK_PERFILADO(args->mutex_registro);
+            usleep(50);
+            MUTEX_UNLOCK_PERFILADO(args->mutex_registro);
+        }
+    }
+    return NULL;
+}
+
+static void demo_perfil_contencion(void) {
+    printf("\n=== Perfil de Contención ===\n");
+    printf("Cada hilo registra la espera y la retención de cada cerrojo en sus\n");
+    printf("propios histogramas; el informe los fusiona al final.\n");
+    
+    recurso_compartido_t contador;
+    pthread_mutex_t mutex_registro;
+    inicializar_recurso_compartido(&contador, 0);
+    pthread_mutex_init(&mutex_registro, NULL);
+    registrar_cerrojo_perfil(&mutex_registro);
+    
+    const int num_hilos = 8;
+    pthread_t hilos[8];
+    args_perfil_t args = { &contador, &mutex_registro, 20000 };
+    
+    reiniciar_perfil_contencion();
+    activar_perfil_contencion(true);
+    for (int i = 0; i < num_hilos; i++) {
+        pthread_create(&hilos[i], NULL, hilo_perfil_contencion, &args);
+    }
+    for (int i = 0; i < num_hilos; i++) {
+        pthread_join(hilos[i], NULL);
+    }
+    activar_perfil_contencion(false);
+    
+    imprimir_perfil_contencion(10);
+    
+    pthread_mutex_destroy(&mutex_registro);
+    destruir_recurso_compartido(&contador);
+}
+
 #ifndef UNIT_TESTING
 int main(void) {
     int opcion;
@@ -205,6 +273,14 @@ int main(void) {
                 ejecutar_demo_completa_mutex();
                 break;
                 
+            case 7:
+                demo_lectura_escritura();
+                break;
+                
+            case 8:
+                demo_perfil_contencion();
+                break;
+                
             case 0:
                 printf("Saliendo del programa...\n");
                 break;
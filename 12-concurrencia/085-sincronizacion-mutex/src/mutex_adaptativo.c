@@ -0,0 +1,326 @@
+#include "../include/mutex_adaptativo.h"
+#include "../include/sincronizacion_mutex.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// ==================== PRIMITIVAS ====================
+
+static inline void pausa_cpu(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+#ifdef __linux__
+static void futex_esperar(uint32_t* direccion, uint32_t esperado) {
+    syscall(SYS_futex, direccion, FUTEX_WAIT_PRIVATE, esperado, NULL, NULL, 0);
+}
+
+static void futex_despertar(uint32_t* direccion, int num_hilos) {
+    syscall(SYS_futex, direccion, FUTEX_WAKE_PRIVATE, num_hilos, NULL, NULL, 0);
+}
+#else
+// Sin futex: ceder la CPU y volver a comprobar (todas las esperas están en bucles)
+static void futex_esperar(uint32_t* direccion, uint32_t esperado) {
+    (void)direccion;
+    (void)esperado;
+    sched_yield();
+}
+
+static void futex_despertar(uint32_t* direccion, int num_hilos) {
+    (void)direccion;
+    (void)num_hilos;
+}
+#endif
+
+static inline bool hay_hambrientos(mutex_adaptativo_t* mutex) {
+    return __atomic_load_n(&mutex->hambrientos, __ATOMIC_RELAXED) != 0;
+}
+
+static inline bool intentar_tomar(mutex_adaptativo_t* mutex) {
+    uint32_t libre = 0;
+    return __atomic_compare_exchange_n(&mutex->estado, &libre, 1, false,
+                                       __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+}
+
+static inline void contar(uint64_t* contador) {
+    __atomic_fetch_add(contador, 1, __ATOMIC_RELAXED);
+}
+
+// ==================== GIRO ADAPTATIVO ====================
+
+// Media móvil con peso 1/8 hacia el objetivo, dentro de los límites
+static void ajustar_presupuesto(mutex_adaptativo_t* mutex, uint32_t objetivo) {
+    if (objetivo < MIN_VUELTAS_MUTEX) objetivo = MIN_VUELTAS_MUTEX;
+    if (objetivo > MAX_VUELTAS_MUTEX) objetivo = MAX_VUELTAS_MUTEX;
+    int32_t actual = (int32_t)__atomic_load_n(&mutex->presupuesto_vueltas, __ATOMIC_RELAXED);
+    int32_t nuevo = actual + ((int32_t)objetivo - actual) / 8;
+    __atomic_store_n(&mutex->presupuesto_vueltas, (uint32_t)nuevo, __ATOMIC_RELAXED);
+}
+
+static bool girar(mutex_adaptativo_t* mutex) {
+    uint32_t presupuesto = __atomic_load_n(&mutex->presupuesto_vueltas, __ATOMIC_RELAXED);
+    uint32_t pausas = 1;
+
+    for (uint32_t vuelta = 1; vuelta <= presupuesto; vuelta++) {
+        if (hay_hambrientos(mutex)) {
+            return false;  // No adelantar a quien lleva tiempo esperando
+        }
+        for (uint32_t i = 0; i < pausas; i++) {
+            pausa_cpu();
+        }
+        if (pausas < MAX_PAUSAS_VUELTA_MUTEX) {
+            pausas <<= 1;
+        }
+        // Leer antes de intentar el CAS para no robar la línea de caché al dueño
+        if (__atomic_load_n(&mutex->estado, __ATOMIC_RELAXED) == 0 && intentar_tomar(mutex)) {
+            // Margen del doble sobre lo que ha hecho falta esta vez
+            ajustar_presupuesto(mutex, 2 * vuelta);
+            contar(&mutex->adquisiciones_girando);
+            return true;
+        }
+    }
+
+    // El mutex se retiene más de lo que compensa girar: girar menos
+    ajustar_presupuesto(mutex, MIN_VUELTAS_MUTEX);
+    return false;
+}
+
+// ==================== ESPERA EN EL KERNEL ====================
+
+static void esperar_cesion(mutex_adaptativo_t* mutex) {
+    __atomic_fetch_add(&mutex->hambrientos, 1, __ATOMIC_SEQ_CST);
+
+    for (;;) {
+        // Leer la secuencia antes de comprobar para no perder un aviso
+        uint32_t aviso = __atomic_load_n(&mutex->avisos_hambre, __ATOMIC_ACQUIRE);
+
+        uint32_t pendientes = __atomic_load_n(&mutex->cesiones, __ATOMIC_ACQUIRE);
+        while (pendientes > 0) {
+            if (__atomic_compare_exchange_n(&mutex->cesiones, &pendientes, pendientes - 1, false,
+                                            __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+                // El anterior dueño no liberó el estado: ya es nuestro.
+                // Se marca 2 por si hay durmientes que despertar al soltarlo.
+                __atomic_store_n(&mutex->estado, 2, __ATOMIC_RELAXED);
+                contar(&mutex->adquisiciones_cedidas);
+                __atomic_fetch_sub(&mutex->hambrientos, 1, __ATOMIC_SEQ_CST);
+                return;
+            }
+        }
+
+        uint32_t libre = 0;
+        if (__atomic_compare_exchange_n(&mutex->estado, &libre, 2, false,
+                                        __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+            contar(&mutex->adquisiciones_durmiendo);
+            __atomic_fetch_sub(&mutex->hambrientos, 1, __ATOMIC_SEQ_CST);
+            return;
+        }
+
+        futex_esperar(&mutex->avisos_hambre, aviso);
+    }
+}
+
+static void dormir(mutex_adaptativo_t* mutex) {
+    for (int despertares = 0; ; despertares++) {
+        if (despertares >= UMBRAL_HAMBRE_MUTEX) {
+            esperar_cesion(mutex);
+            return;
+        }
+        // Marcar que hay durmientes; si estaba libre, queda tomado
+        if (__atomic_exchange_n(&mutex->estado, 2, __ATOMIC_ACQUIRE) == 0) {
+            contar(&mutex->adquisiciones_durmiendo);
+            return;
+        }
+        futex_esperar(&mutex->estado, 2);
+    }
+}
+
+// ==================== API ====================
+
+void mutex_adaptativo_init(mutex_adaptativo_t* mutex) {
+    if (mutex == NULL) {
+        return;
+    }
+    mutex_adaptativo_t inicial = MUTEX_ADAPTATIVO_INICIALIZADOR;
+    *mutex = inicial;
+}
+
+void mutex_adaptativo_lock(mutex_adaptativo_t* mutex) {
+    if (!hay_hambrientos(mutex) && intentar_tomar(mutex)) {
+        return;
+    }
+    if (girar(mutex)) {
+        return;
+    }
+    dormir(mutex);
+}
+
+bool mutex_adaptativo_trylock(mutex_adaptativo_t* mutex) {
+    return !hay_hambrientos(mutex) && intentar_tomar(mutex);
+}
+
+void mutex_adaptativo_unlock(mutex_adaptativo_t* mutex) {
+    // Con hambrientos el mutex no se libera: se cede sin pasar por el estado 0
+    if (__atomic_load_n(&mutex->hambrientos, __ATOMIC_SEQ_CST) > 0) {
+        __atomic_fetch_add(&mutex->cesiones, 1, __ATOMIC_RELEASE);
+        __atomic_fetch_add(&mutex->avisos_hambre, 1, __ATOMIC_RELEASE);
+        futex_despertar(&mutex->avisos_hambre, 1);
+        return;
+    }
+
+    if (__atomic_exchange_n(&mutex->estado, 0, __ATOMIC_SEQ_CST) == 2) {
+        futex_despertar(&mutex->estado, 1);
+    }
+
+    // Un hilo pudo hacerse hambriento justo después de la primera comprobación
+    if (__atomic_load_n(&mutex->hambrientos, __ATOMIC_SEQ_CST) > 0) {
+        __atomic_fetch_add(&mutex->avisos_hambre, 1, __ATOMIC_RELEASE);
+        futex_despertar(&mutex->avisos_hambre, 1);
+    }
+}
+
+// ==================== BENCHMARK ====================
+
+typedef enum {
+    BENCH_PTHREAD_NORMAL = 0,
+    BENCH_PTHREAD_RECURSIVO,
+    BENCH_PTHREAD_ERRORCHECK,
+    BENCH_ADAPTATIVO,
+    NUM_TIPOS_BENCH_MUTEX
+} tipo_bench_mutex_t;
+
+static const char* const nombres_bench_mutex[NUM_TIPOS_BENCH_MUTEX] = {
+    "normal", "recursivo", "errorcheck", "adaptativo"
+};
+
+typedef struct {
+    tipo_bench_mutex_t tipo;
+    pthread_mutex_t* mutex_pthread;
+    mutex_adaptativo_t* mutex_adaptativo;
+    uint64_t* contador;
+    int operaciones;
+} args_bench_mutex_t;
+
+static void* hilo_bench_mutex(void* arg) {
+    args_bench_mutex_t* args = (args_bench_mutex_t*)arg;
+    for (int i = 0; i < args->operaciones; i++) {
+        // Sección crítica de unas pocas decenas de nanosegundos
+        if (args->tipo == BENCH_ADAPTATIVO) {
+            mutex_adaptativo_lock(args->mutex_adaptativo);
+            (*args->contador)++;
+            mutex_adaptativo_unlock(args->mutex_adaptativo);
+        } else {
+            pthread_mutex_lock(args->mutex_pthread);
+            (*args->contador)++;
+            pthread_mutex_unlock(args->mutex_pthread);
+        }
+    }
+    return NULL;
+}
+
+static bool inicializar_mutex_bench(tipo_bench_mutex_t tipo, pthread_mutex_t* mutex) {
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    if (tipo == BENCH_PTHREAD_RECURSIVO) {
+        pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    } else if (tipo == BENCH_PTHREAD_ERRORCHECK) {
+        pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_ERRORCHECK);
+    }
+    bool ok = pthread_mutex_init(mutex, &attr) == 0;
+    pthread_mutexattr_destroy(&attr);
+    return ok;
+}
+
+// Devuelve millones de adquisiciones por segundo (0 si falló)
+static double medir_mutex(tipo_bench_mutex_t tipo, int num_hilos, int operaciones_por_hilo,
+                          mutex_adaptativo_t* adaptativo, bool* correcto) {
+    pthread_mutex_t mutex_pthread;
+    uint64_t contador = 0;
+    *correcto = false;
+
+    if (tipo != BENCH_ADAPTATIVO && !inicializar_mutex_bench(tipo, &mutex_pthread)) {
+        return 0.0;
+    }
+
+    pthread_t* hilos = malloc((size_t)num_hilos * sizeof(pthread_t));
+    if (hilos == NULL) {
+        if (tipo != BENCH_ADAPTATIVO) pthread_mutex_destroy(&mutex_pthread);
+        return 0.0;
+    }
+    args_bench_mutex_t args = { tipo, &mutex_pthread, adaptativo, &contador, operaciones_por_hilo };
+
+    int creados = 0;
+    uint64_t inicio = obtener_tiempo_microsegundos();
+    for (int i = 0; i < num_hilos; i++) {
+        if (pthread_create(&hilos[i], NULL, hilo_bench_mutex, &args) != 0) {
+            break;
+        }
+        creados++;
+    }
+    for (int i = 0; i < creados; i++) {
+        pthread_join(hilos[i], NULL);
+    }
+    uint64_t duracion_us = obtener_tiempo_microsegundos() - inicio;
+
+    *correcto = (creados == num_hilos) &&
+                (contador == (uint64_t)num_hilos * (uint64_t)operaciones_por_hilo);
+
+    free(hilos);
+    if (tipo != BENCH_ADAPTATIVO) {
+        pthread_mutex_destroy(&mutex_pthread);
+    }
+    if (duracion_us == 0) {
+        duracion_us = 1;
+    }
+    return (double)creados * operaciones_por_hilo / (double)duracion_us;
+}
+
+bool ejecutar_benchmark_mutex_adaptativo(int max_hilos, int operaciones_totales) {
+    if (max_hilos <= 0 || operaciones_totales <= 0) {
+        return false;
+    }
+
+    printf("\n=== Mutex Adaptativo vs pthread (%d adquisiciones por prueba) ===\n",
+           operaciones_totales);
+    printf("%-6s", "Hilos");
+    for (int t = 0; t < NUM_TIPOS_BENCH_MUTEX; t++) {
+        printf(" %11s", nombres_bench_mutex[t]);
+    }
+    printf("   %-8s %s\n", "Vueltas", "Girando/Durmiendo/Cedidas");
+
+    bool todo_correcto = true;
+    for (int num_hilos = 1; num_hilos <= max_hilos; num_hilos *= 2) {
+        int operaciones_por_hilo = operaciones_totales / num_hilos;
+        if (operaciones_por_hilo == 0) operaciones_por_hilo = 1;
+
+        mutex_adaptativo_t adaptativo;
+        mutex_adaptativo_init(&adaptativo);
+
+        printf("%-6d", num_hilos);
+        for (int t = 0; t < NUM_TIPOS_BENCH_MUTEX; t++) {
+            bool correcto;
+            double mops = medir_mutex((tipo_bench_mutex_t)t, num_hilos, operaciones_por_hilo,
+                                      &adaptativo, &correcto);
+            printf(" %10.2f%s", mops, correcto ? " " : "!");
+            todo_correcto = todo_correcto && correcto;
+        }
+        printf("   %-8u %llu/%llu/%llu\n", adaptativo.presupuesto_vueltas,
+               (unsigned long long)adaptativo.adquisiciones_girando,
+               (unsigned long long)adaptativo.adquisiciones_durmiendo,
+               (unsigned long long)adaptativo.adquisiciones_cedidas);
+    }
+    printf("(millones de adquisiciones por segundo; ! = contador incorrecto)\n");
+
+    return todo_correcto;
+}
@@ -0,0 +1,372 @@
+#include "../include/perfil_contencion.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+
+// Contadores de un cerrojo en un hilo. Solo los escribe el hilo dueño del
+// bloque; el informe los lee con cargas atómicas mientras se actualizan.
+typedef struct {
+    const void* cerrojo;
+    uint32_t id;                       // Registro del cerrojo (ver id_cerrojo)
+    const char* nombre;
+    uint64_t inicio_retencion;         // Solo lo usa el hilo dueño
+    uint64_t adquisiciones;
+    uint64_t contendidas;
+    uint64_t espera_total_ns;
+    uint64_t retencion_total_ns;
+    uint64_t espera[NUM_CUBETAS_CONTENCION];
+    uint64_t retencion[NUM_CUBETAS_CONTENCION];
+} entrada_cerrojo_t;
+
+// Bloque de un hilo. Los bloques nunca se liberan: cuando un hilo termina
+// su bloque queda libre para el siguiente hilo y conserva lo registrado.
+typedef struct bloque_hilo {
+    entrada_cerrojo_t entradas[MAX_CERROJOS_POR_HILO];
+    int num_entradas;                  // Se publica tras rellenar la entrada
+    int en_uso;
+    struct bloque_hilo* siguiente;     // Inmutable una vez en la lista
+} bloque_hilo_t;
+
+static bloque_hilo_t* lista_bloques = NULL;
+static int registro_activo = 0;
+static pthread_key_t clave_bloque;
+static pthread_once_t clave_once = PTHREAD_ONCE_INIT;
+static __thread bloque_hilo_t* bloque_actual = NULL;
+
+// Registro global dirección -> id. Un mutex de pila o de un recurso
+// reinicializado puede reaparecer en la misma dirección; al registrarlo de
+// nuevo recibe otro id y el informe no lo mezcla con el anterior.
+#define TAM_REGISTRO_CERROJOS 4096     // Potencia de dos
+
+typedef struct {
+    const void* cerrojo;
+    uint32_t id;                       // 0 mientras se publica
+} registro_cerrojo_t;
+
+static registro_cerrojo_t registro_cerrojos[TAM_REGISTRO_CERROJOS];
+static uint32_t ultimo_id_cerrojo = 0;
+
+// ==================== REGISTRO DE CERROJOS ====================
+
+// Devuelve el id vigente de un cerrojo, dándole uno si no lo tenía. Con
+// nuevo=true asigna siempre un id nuevo. Devuelve 0 si el registro está lleno.
+static uint32_t id_cerrojo(const void* cerrojo, bool nuevo) {
+    uint64_t hash = ((uintptr_t)cerrojo >> 4) * 0x9E3779B97F4A7C15ull;
+    size_t inicio = (size_t)(hash >> 52) & (TAM_REGISTRO_CERROJOS - 1);
+    for (size_t i = 0; i < TAM_REGISTRO_CERROJOS; i++) {
+        registro_cerrojo_t* r = &registro_cerrojos[(inicio + i) & (TAM_REGISTRO_CERROJOS - 1)];
+        const void* actual = __atomic_load_n(&r->cerrojo, __ATOMIC_ACQUIRE);
+        if (actual == NULL) {
+            if (!__atomic_compare_exchange_n(&r->cerrojo, &actual, cerrojo, false,
+                                             __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+                if (actual != cerrojo) {
+                    continue;  // Otro cerrojo ocupó la casilla
+                }
+            } else {
+                uint32_t id = __atomic_add_fetch(&ultimo_id_cerrojo, 1, __ATOMIC_RELAXED);
+                __atomic_store_n(&r->id, id, __ATOMIC_RELEASE);
+                return id;
+            }
+        }
+        if (actual != cerrojo) {
+            continue;
+        }
+        if (nuevo) {
+            uint32_t id = __atomic_add_fetch(&ultimo_id_cerrojo, 1, __ATOMIC_RELAXED);
+            __atomic_store_n(&r->id, id, __ATOMIC_RELEASE);
+            return id;
+        }
+        uint32_t id;
+        while ((id = __atomic_load_n(&r->id, __ATOMIC_ACQUIRE)) == 0) {
+            // Otro hilo acaba de reclamar la casilla y está publicando el id
+        }
+        return id;
+    }
+    return 0;
+}
+
+// ==================== REGISTRO POR HILO ====================
+
+static uint64_t tiempo_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static int cubeta_para(uint64_t ns) {
+    if (ns < 2) {
+        return 0;
+    }
+    int cubeta = 63 - __builtin_clzll(ns);
+    return (cubeta < NUM_CUBETAS_CONTENCION) ? cubeta : NUM_CUBETAS_CONTENCION - 1;
+}
+
+// Un solo escritor por contador: basta una carga y un almacenamiento atómicos
+static inline void sumar_contador(uint64_t* contador, uint64_t valor) {
+    __atomic_store_n(contador, __atomic_load_n(contador, __ATOMIC_RELAXED) + valor, __ATOMIC_RELAXED);
+}
+
+static void liberar_bloque(void* arg) {
+    bloque_hilo_t* bloque = (bloque_hilo_t*)arg;
+    __atomic_store_n(&bloque->en_uso, 0, __ATOMIC_RELEASE);
+}
+
+static void crear_clave_bloque(void) {
+    pthread_key_create(&clave_bloque, liberar_bloque);
+}
+
+static bloque_hilo_t* obtener_bloque_hilo(void) {
+    if (bloque_actual != NULL) {
+        return bloque_actual;
+    }
+    pthread_once(&clave_once, crear_clave_bloque);
+
+    // Reutilizar el bloque de un hilo que ya terminó
+    bloque_hilo_t* bloque = __atomic_load_n(&lista_bloques, __ATOMIC_ACQUIRE);
+    for (; bloque != NULL; bloque = bloque->siguiente) {
+        int libre = 0;
+        if (__atomic_compare_exchange_n(&bloque->en_uso, &libre, 1, false,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+
+    if (bloque == NULL) {
+        bloque = calloc(1, sizeof(bloque_hilo_t));
+        if (bloque == NULL) {
+            return NULL;
+        }
+        bloque->en_uso = 1;
+        bloque->siguiente = __atomic_load_n(&lista_bloques, __ATOMIC_RELAXED);
+        while (!__atomic_compare_exchange_n(&lista_bloques, &bloque->siguiente, bloque, true,
+                                            __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+            // siguiente se actualiza con la cabeza actual
+        }
+    }
+
+    pthread_setspecific(clave_bloque, bloque);
+    bloque_actual = bloque;
+    return bloque;
+}
+
+static entrada_cerrojo_t* buscar_entrada(const void* cerrojo, const char* nombre) {
+    bloque_hilo_t* bloque = obtener_bloque_hilo();
+    if (bloque == NULL) {
+        return NULL;
+    }
+    uint32_t id = id_cerrojo(cerrojo, false);
+    int n = bloque->num_entradas;
+    for (int i = 0; i < n; i++) {
+        if (bloque->entradas[i].cerrojo == cerrojo && bloque->entradas[i].id == id) {
+            return &bloque->entradas[i];
+        }
+    }
+    if (nombre == NULL || n == MAX_CERROJOS_POR_HILO) {
+        return NULL;  // Desbloqueo de un cerrojo no registrado, o tabla llena
+    }
+    bloque->entradas[n].cerrojo = cerrojo;
+    bloque->entradas[n].id = id;
+    bloque->entradas[n].nombre = nombre;
+    __atomic_store_n(&bloque->num_entradas, n + 1, __ATOMIC_RELEASE);
+    return &bloque->entradas[n];
+}
+
+// ==================== API ====================
+
+uint32_t registrar_cerrojo_perfil(const pthread_mutex_t* mutex) {
+    return id_cerrojo(mutex, true);
+}
+
+void activar_perfil_contencion(bool activo) {
+    __atomic_store_n(&registro_activo, activo ? 1 : 0, __ATOMIC_RELAXED);
+}
+
+bool perfil_contencion_activo(void) {
+    return __atomic_load_n(&registro_activo, __ATOMIC_RELAXED) != 0;
+}
+
+void reiniciar_perfil_contencion(void) {
+    bloque_hilo_t* bloque = __atomic_load_n(&lista_bloques, __ATOMIC_ACQUIRE);
+    for (; bloque != NULL; bloque = bloque->siguiente) {
+        int n = __atomic_load_n(&bloque->num_entradas, __ATOMIC_ACQUIRE);
+        for (int i = 0; i < n; i++) {
+            entrada_cerrojo_t* e = &bloque->entradas[i];
+            __atomic_store_n(&e->adquisiciones, 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&e->contendidas, 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&e->espera_total_ns, 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&e->retencion_total_ns, 0, __ATOMIC_RELAXED);
+            for (int c = 0; c < NUM_CUBETAS_CONTENCION; c++) {
+                __atomic_store_n(&e->espera[c], 0, __ATOMIC_RELAXED);
+                __atomic_store_n(&e->retencion[c], 0, __ATOMIC_RELAXED);
+            }
+        }
+    }
+}
+
+int perfil_mutex_lock(pthread_mutex_t* mutex, const char* nombre) {
+    if (!perfil_contencion_activo()) {
+        return pthread_mutex_lock(mutex);
+    }
+
+    // Sin contención basta una lectura de reloj: espera cero
+    uint64_t inicio = tiempo_ns();
+    bool contendida = false;
+    int resultado = pthread_mutex_trylock(mutex);
+    if (resultado == EBUSY) {
+        contendida = true;
+        resultado = pthread_mutex_lock(mutex);
+    }
+    if (resultado != 0) {
+        return resultado;
+    }
+    uint64_t adquirido = contendida ? tiempo_ns() : inicio;
+
+    entrada_cerrojo_t* entrada = buscar_entrada(mutex, nombre);
+    if (entrada != NULL) {
+        uint64_t espera = adquirido - inicio;
+        sumar_contador(&entrada->adquisiciones, 1);
+        if (contendida) {
+            sumar_contador(&entrada->contendidas, 1);
+        }
+        sumar_contador(&entrada->espera_total_ns, espera);
+        sumar_contador(&entrada->espera[cubeta_para(espera)], 1);
+        entrada->inicio_retencion = adquirido;
+    }
+    return 0;
+}
+
+int perfil_mutex_unlock(pthread_mutex_t* mutex) {
+    if (perfil_contencion_activo()) {
+        entrada_cerrojo_t* entrada = buscar_entrada(mutex, NULL);
+        if (entrada != NULL && entrada->inicio_retencion != 0) {
+            uint64_t retencion = tiempo_ns() - entrada->inicio_retencion;
+            sumar_contador(&entrada->retencion_total_ns, retencion);
+            sumar_contador(&entrada->retencion[cubeta_para(retencion)], 1);
+            entrada->inicio_retencion = 0;
+        }
+    }
+    return pthread_mutex_unlock(mutex);
+}
+
+// ==================== INFORME ====================
+
+static int comparar_por_espera(const void* a, const void* b) {
+    const resumen_contencion_t* ra = (const resumen_contencion_t*)a;
+    const resumen_contencion_t* rb = (const resumen_contencion_t*)b;
+    if (ra->espera_total_ns != rb->espera_total_ns) {
+        return (ra->espera_total_ns < rb->espera_total_ns) ? 1 : -1;
+    }
+    return (ra->adquisiciones < rb->adquisiciones) ? 1 : (ra->adquisiciones > rb->adquisiciones) ? -1 : 0;
+}
+
+int fusionar_perfil_contencion(resumen_contencion_t* resumenes, int max_resumenes) {
+    if (resumenes == NULL || max_resumenes <= 0) {
+        return 0;
+    }
+
+    int num = 0;
+    bloque_hilo_t* bloque = __atomic_load_n(&lista_bloques, __ATOMIC_ACQUIRE);
+    for (; bloque != NULL; bloque = bloque->siguiente) {
+        int n = __atomic_load_n(&bloque->num_entradas, __ATOMIC_ACQUIRE);
+        for (int i = 0; i < n; i++) {
+            const entrada_cerrojo_t* e = &bloque->entradas[i];
+            if (__atomic_load_n(&e->adquisiciones, __ATOMIC_RELAXED) == 0) {
+                continue;  // Cerrojo de una prueba anterior a reiniciar_perfil_contencion
+            }
+            int r = 0;
+            while (r < num && !(resumenes[r].id == e->id &&
+                                strcmp(resumenes[r].nombre, e->nombre) == 0)) r++;
+            if (r == num) {
+                if (num == max_resumenes) {
+                    continue;
+                }
+                memset(&resumenes[r], 0, sizeof(resumenes[r]));
+                resumenes[r].cerrojo = e->cerrojo;
+                resumenes[r].id = e->id;
+                resumenes[r].nombre = e->nombre;
+                num++;
+            }
+            resumen_contencion_t* res = &resumenes[r];
+            res->adquisiciones += __atomic_load_n(&e->adquisiciones, __ATOMIC_RELAXED);
+            res->contendidas += __atomic_load_n(&e->contendidas, __ATOMIC_RELAXED);
+            res->espera_total_ns += __atomic_load_n(&e->espera_total_ns, __ATOMIC_RELAXED);
+            res->retencion_total_ns += __atomic_load_n(&e->retencion_total_ns, __ATOMIC_RELAXED);
+            for (int c = 0; c < NUM_CUBETAS_CONTENCION; c++) {
+                res->espera[c] += __atomic_load_n(&e->espera[c], __ATOMIC_RELAXED);
+                res->retencion[c] += __atomic_load_n(&e->retencion[c], __ATOMIC_RELAXED);
+            }
+        }
+    }
+
+    qsort(resumenes, (size_t)num, sizeof(resumen_contencion_t), comparar_por_espera);
+    return num;
+}
+
+uint64_t percentil_contencion(const uint64_t* cubetas, double percentil) {
+    uint64_t total = 0;
+    for (int c = 0; c < NUM_CUBETAS_CONTENCION; c++) {
+        total += cubetas[c];
+    }
+    if (total == 0) {
+        return 0;
+    }
+    uint64_t objetivo = (uint64_t)(percentil / 100.0 * (double)total);
+    if (objetivo == 0) objetivo = 1;
+    uint64_t acumulado = 0;
+    for (int c = 0; c < NUM_CUBETAS_CONTENCION; c++) {
+        acumulado += cubetas[c];
+        if (acumulado >= objetivo) {
+            return (2ull << c) - 1;
+        }
+    }
+    return (2ull << (NUM_CUBETAS_CONTENCION - 1)) - 1;
+}
+
+// 1234 ns -> "1.2us"
+static void formatear_ns(uint64_t ns, char* buffer, size_t tam) {
+    if (ns < 1000) {
+        snprintf(buffer, tam, "%lluns", (unsigned long long)ns);
+    } else if (ns < 1000000) {
+        snprintf(buffer, tam, "%.1fus", ns / 1e3);
+    } else if (ns < 1000000000ull) {
+        snprintf(buffer, tam, "%.1fms", ns / 1e6);
+    } else {
+        snprintf(buffer, tam, "%.2fs", ns / 1e9);
+    }
+}
+
+void imprimir_perfil_contencion(int max_cerrojos) {
+    resumen_contencion_t* resumenes = malloc(256 * sizeof(resumen_contencion_t));
+    if (resumenes == NULL) {
+        return;
+    }
+    int num = fusionar_perfil_contencion(resumenes, 256);
+
+    printf("\n=== Perfil de Contención (%d cerrojos) ===\n", num);
+    printf("%-24s %10s %7s %10s %21s %15s\n", "Cerrojo", "Adquis.", "Cont.%",
+           "Espera", "Espera p50/p99/máx", "Ret. p50/p99");
+
+    for (int i = 0; i < num && i < max_cerrojos; i++) {
+        const resumen_contencion_t* r = &resumenes[i];
+        char total[16], p50[16], p99[16], maximo[16], r50[16], r99[16];
+        formatear_ns(r->espera_total_ns, total, sizeof(total));
+        formatear_ns(percentil_contencion(r->espera, 50), p50, sizeof(p50));
+        formatear_ns(percentil_contencion(r->espera, 99), p99, sizeof(p99));
+        formatear_ns(percentil_contencion(r->espera, 100), maximo, sizeof(maximo));
+        formatear_ns(percentil_contencion(r->retencion, 50), r50, sizeof(r50));
+        formatear_ns(percentil_contencion(r->retencion, 99), r99, sizeof(r99));
+
+        char nombre[48], espera[48], retencion[32];
+        snprintf(nombre, sizeof(nombre), "%s#%u", r->nombre, (unsigned)r->id);
+        snprintf(espera, sizeof(espera), "%s/%s/%s", p50, p99, maximo);
+        snprintf(retencion, sizeof(retencion), "%s/%s", r50, r99);
+        printf("%-24.24s %10llu %6.1f%% %10s %21s %15s\n", nombre,
+               (unsigned long long)r->adquisiciones,
+               r->adquisiciones ? 100.0 * r->contendidas / r->adquisiciones : 0.0,
+               total, espera, retencion);
+    }
+    printf("(percentiles: límite superior de la cubeta logarítmica)\n");
+    free(resumenes);
+}
@@ -1,4 +1,6 @@
 #include "../include/sincronizacion_mutex.h"
+#include "../include/perfil_contencion.h"
+#include "../include/mutex_adaptativo.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -29,24 +31,60 @@ static void* incrementar_sin_proteccion_thread(void* arg) {
 
 // Implementación de funciones básicas de recurso compartido
 
+#define OPERACIONES_BARRIDO_POR_HILO 200000
+
 bool inicializar_recurso_compartido(recurso_compartido_t* recurso, int64_t valor_inicial) {
+    return inicializar_recurso_compartido_tipo(recurso, valor_inicial, RECURSO_MUTEX);
+}
+
+bool inicializar_recurso_compartido_tipo(recurso_compartido_t* recurso, int64_t valor_inicial,
+                                         tipo_recurso_t tipo) {
     if (recurso == NULL) {
         return false;
     }
     
-    // Inicializar mutex con atributos por defecto
+    // Inicializar mutex con atributos por defecto (en seqlock serializa escritores)
     int resultado = pthread_mutex_init(&recurso->mutex, NULL);
     if (resultado != 0) {
         fprintf(stderr, "Error inicializando mutex: %s\n", strerror(resultado));
         return false;
     }
+    // Cada recurso es un cerrojo distinto en el perfil aunque reutilice la dirección
+    registrar_cerrojo_perfil(&recurso->mutex);
+    
+    if (tipo == RECURSO_RWLOCK) {
+        pthread_rwlockattr_t attr;
+        pthread_rwlockattr_init(&attr);
+#if defined(__GLIBC__)
+        // Por defecto glibc prioriza lectores y con 99:1 los escritores no entran nunca
+        pthread_rwlockattr_setkind_np(&attr, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+#endif
+        resultado = pthread_rwlock_init(&recurso->rwlock, &attr);
+        pthread_rwlockattr_destroy(&attr);
+        if (resultado != 0) {
+            fprintf(stderr, "Error inicializando rwlock: %s\n", strerror(resultado));
+            pthread_mutex_destroy(&recurso->mutex);
+            return false;
+        }
+    }
     
     recurso->valor = valor_inicial;
+    recurso->secuencia = 0;
+    recurso->tipo = tipo;
     recurso->inicializado = true;
     
     return true;
 }
 
+const char* nombre_tipo_recurso(tipo_recurso_t tipo) {
+    switch (tipo) {
+        case RECURSO_MUTEX:   return "mutex";
+        case RECURSO_RWLOCK:  return "rwlock";
+        case RECURSO_SEQLOCK: return "seqlock";
+    }
+    return "desconocido";
+}
+
 bool destruir_recurso_compartido(recurso_compartido_t* recurso) {
     if (recurso == NULL || !recurso->inicializado) {
         return false;
@@ -58,33 +96,87 @@ bool destruir_recurso_compartido(recurso_compartido_t* recurso) {
         return false;
     }
     
+    if (recurso->tipo == RECURSO_RWLOCK) {
+        resultado = pthread_rwlock_destroy(&recurso->rwlock);
+        if (resultado != 0) {
+            fprintf(stderr, "Error destruyendo rwlock: %s\n", strerror(resultado));
+            return false;
+        }
+    }
+    
     recurso->inicializado = false;
     return true;
 }
 
+// Bloqueo exclusivo para escritores según el tipo de recurso
+static bool bloquear_escritura(recurso_compartido_t* recurso) {
+    int resultado = (recurso->tipo == RECURSO_RWLOCK)
+                        ? pthread_rwlock_wrlock(&recurso->rwlock)
+                        : MUTEX_LOCK_PERFILADO(&recurso->mutex);
+    if (resultado != 0) {
+        fprintf(stderr, "Error bloqueando %s para escritura: %s\n",
+                nombre_tipo_recurso(recurso->tipo), strerror(resultado));
+        return false;
+    }
+    return true;
+}
+
+static bool desbloquear_escritura(recurso_compartido_t* recurso) {
+    int resultado = (recurso->tipo == RECURSO_RWLOCK)
+                        ? pthread_rwlock_unlock(&recurso->rwlock)
+                        : MUTEX_UNLOCK_PERFILADO(&recurso->mutex);
+    if (resultado != 0) {
+        fprintf(stderr, "Error desbloqueando %s después de escritura: %s\n",
+                nombre_tipo_recurso(recurso->tipo), strerror(resultado));
+        return false;
+    }
+    return true;
+}
+
+// Escribe el valor con el escritor ya en exclusión. En seqlock la secuencia
+// es impar mientras dura la escritura para que los lectores reintenten.
+static void escribir_valor(recurso_compartido_t* recurso, int64_t nuevo_valor) {
+    if (recurso->tipo != RECURSO_SEQLOCK) {
+        recurso->valor = nuevo_valor;
+        return;
+    }
+    uint64_t secuencia = __atomic_load_n(&recurso->secuencia, __ATOMIC_RELAXED);
+    __atomic_store_n(&recurso->secuencia, secuencia + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&recurso->valor, nuevo_valor, __ATOMIC_RELAXED);
+    __atomic_store_n(&recurso->secuencia, secuencia + 2, __ATOMIC_RELEASE);
+}
+
+// Lector de seqlock: no toma ningún cerrojo, repite si vio una escritura
+static int64_t leer_valor_seqlock(recurso_compartido_t* recurso) {
+    for (;;) {
+        uint64_t antes = __atomic_load_n(&recurso->secuencia, __ATOMIC_ACQUIRE);
+        if (antes & 1) {
+            continue;  // Escritura en curso
+        }
+        int64_t valor = __atomic_load_n(&recurso->valor, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&recurso->secuencia, __ATOMIC_RELAXED) == antes) {
+            return valor;
+        }
+    }
+}
+
 bool incrementar_recurso_seguro(recurso_compartido_t* recurso, int64_t incremento) {
     if (recurso == NULL || !recurso->inicializado) {
         return false;
     }
     
     // Entrar en sección crítica
-    int resultado = pthread_mutex_lock(&recurso->mutex);
-    if (resultado != 0) {
-        fprintf(stderr, "Error bloqueando mutex: %s\n", strerror(resultado));
+    if (!bloquear_escritura(recurso)) {
         return false;
     }
     
     // Operación crítica
-    recurso->valor += incremento;
+    escribir_valor(recurso, recurso->valor + incremento);
     
     // Salir de sección crítica
-    resultado = pthread_mutex_unlock(&recurso->mutex);
-    if (resultado != 0) {
-        fprintf(stderr, "Error desbloqueando mutex: %s\n", strerror(resultado));
-        return false;
-    }
-    
-    return true;
+    return desbloquear_escritura(recurso);
 }
 
 bool leer_recurso_seguro(recurso_compartido_t* recurso, int64_t* valor) {
@@ -92,17 +184,28 @@ bool leer_recurso_seguro(recurso_compartido_t* recurso, int64_t* valor) {
         return false;
     }
     
-    int resultado = pthread_mutex_lock(&recurso->mutex);
+    if (recurso->tipo == RECURSO_SEQLOCK) {
+        *valor = leer_valor_seqlock(recurso);
+        return true;
+    }
+    
+    int resultado = (recurso->tipo == RECURSO_RWLOCK)
+                        ? pthread_rwlock_rdlock(&recurso->rwlock)
+                        : MUTEX_LOCK_PERFILADO(&recurso->mutex);
     if (resultado != 0) {
-        fprintf(stderr, "Error bloqueando mutex para lectura: %s\n", strerror(resultado));
+        fprintf(stderr, "Error bloqueando %s para lectura: %s\n",
+                nombre_tipo_recurso(recurso->tipo), strerror(resultado));
         return false;
     }
     
     *valor = recurso->valor;
     
-    resultado = pthread_mutex_unlock(&recurso->mutex);
+    resultado = (recurso->tipo == RECURSO_RWLOCK)
+                    ? pthread_rwlock_unlock(&recurso->rwlock)
+                    : MUTEX_UNLOCK_PERFILADO(&recurso->mutex);
     if (resultado != 0) {
-        fprintf(stderr, "Error desbloqueando mutex después de lectura: %s\n", strerror(resultado));
+        fprintf(stderr, "Error desbloqueando %s después de lectura: %s\n",
+                nombre_tipo_recurso(recurso->tipo), strerror(resultado));
         return false;
     }
     
@@ -114,21 +217,13 @@ bool establecer_recurso_seguro(recurso_compartido_t* recurso, int64_t nuevo_valo
         return false;
     }
     
-    int resultado = pthread_mutex_lock(&recurso->mutex);
-    if (resultado != 0) {
-        fprintf(stderr, "Error bloqueando mutex para escritura: %s\n", strerror(resultado));
+    if (!bloquear_escritura(recurso)) {
         return false;
     }
     
-    recurso->valor = nuevo_valor;
+    escribir_valor(recurso, nuevo_valor);
     
-    resultado = pthread_mutex_unlock(&recurso->mutex);
-    if (resultado != 0) {
-        fprintf(stderr, "Error desbloqueando mutex después de escritura: %s\n", strerror(resultado));
-        return false;
-    }
-    
-    return true;
+    return desbloquear_escritura(recurso);
 }
 
 // Implementación de estadísticas
@@ -163,22 +258,20 @@ bool destruir_estadisticas_mutex(estadisticas_mutex_t* stats) {
     return true;
 }
 
+// Los contadores se actualizan con sumas atómicas: medir la contención no
+// debe añadir un segundo cerrojo disputado por todos los hilos
 void registrar_lectura(estadisticas_mutex_t* stats, uint64_t tiempo_espera_ms) {
     if (stats == NULL) return;
     
-    pthread_mutex_lock(&stats->mutex_stats);
-    stats->operaciones_lectura++;
-    stats->tiempo_espera_ms += tiempo_espera_ms;
-    pthread_mutex_unlock(&stats->mutex_stats);
+    __atomic_fetch_add(&stats->operaciones_lectura, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&stats->tiempo_espera_ms, tiempo_espera_ms, __ATOMIC_RELAXED);
 }
 
 void registrar_escritura(estadisticas_mutex_t* stats, uint64_t tiempo_espera_ms) {
     if (stats == NULL) return;
     
-    pthread_mutex_lock(&stats->mutex_stats);
-    stats->operaciones_escritura++;
-    stats->tiempo_espera_ms += tiempo_espera_ms;
-    pthread_mutex_unlock(&stats->mutex_stats);
+    __atomic_fetch_add(&stats->operaciones_escritura, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&stats->tiempo_espera_ms, tiempo_espera_ms, __ATOMIC_RELAXED);
 }
 
 bool obtener_estadisticas(estadisticas_mutex_t* stats, estadisticas_mutex_t* copia) {
@@ -186,14 +279,10 @@ bool obtener_estadisticas(estadisticas_mutex_t* stats, estadisticas_mutex_t* cop
         return false;
     }
     
-    pthread_mutex_lock(&stats->mutex_stats);
-    
-    copia->operaciones_lectura = stats->operaciones_lectura;
-    copia->operaciones_escritura = stats->operaciones_escritura;
-    copia->colisiones_detectadas = stats->colisiones_detectadas;
-    copia->tiempo_espera_ms = stats->tiempo_espera_ms;
-    
-    pthread_mutex_unlock(&stats->mutex_stats);
+    copia->operaciones_lectura = __atomic_load_n(&stats->operaciones_lectura, __ATOMIC_RELAXED);
+    copia->operaciones_escritura = __atomic_load_n(&stats->operaciones_escritura, __ATOMIC_RELAXED);
+    copia->colisiones_detectadas = __atomic_load_n(&stats->colisiones_detectadas, __ATOMIC_RELAXED);
+    copia->tiempo_espera_ms = __atomic_load_n(&stats->tiempo_espera_ms, __ATOMIC_RELAXED);
     
     return true;
 }
@@ -291,9 +380,143 @@ bool ejecutar_prueba_rendimiento(parametros_prueba_t* params) {
     imprimir_estadisticas_rendimiento(params->stats, tiempo_total);
     
     free(hilos);
+    
+    if (params->barrido_lectura_escritura) {
+        return ejecutar_barrido_lectura_escritura(params->num_hilos, OPERACIONES_BARRIDO_POR_HILO);
+    }
     return true;
 }
 
+// Parámetros por hilo del barrido lectura:escritura
+typedef struct {
+    recurso_compartido_t* recurso;
+    int operaciones;
+    int porcentaje_lecturas;
+    uint32_t semilla;
+    int64_t escrituras;         // Salida: incrementos realizados
+    int64_t suma_lecturas;      // Salida: evita que se eliminen las lecturas
+} args_barrido_t;
+
+static void* hilo_barrido_lectura_escritura(void* arg) {
+    args_barrido_t* args = (args_barrido_t*)arg;
+    uint32_t estado = args->semilla;
+    
+    for (int i = 0; i < args->operaciones; i++) {
+        // xorshift32: mezcla lecturas y escrituras sin patrón fijo
+        estado ^= estado << 13;
+        estado ^= estado >> 17;
+        estado ^= estado << 5;
+        
+        if ((int)(estado % 100) < args->porcentaje_lecturas) {
+            int64_t valor;
+            leer_recurso_seguro(args->recurso, &valor);
+            args->suma_lecturas += valor;
+        } else {
+            incrementar_recurso_seguro(args->recurso, 1);
+            args->escrituras++;
+        }
+    }
+    return NULL;
+}
+
+// Ejecuta una combinación tipo/proporción; devuelve millones de operaciones por segundo
+static double medir_lectura_escritura(tipo_recurso_t tipo, int num_hilos, int operaciones_por_hilo,
+                                      int porcentaje_lecturas, bool* correcto) {
+    *correcto = false;
+    recurso_compartido_t recurso;
+    if (!inicializar_recurso_compartido_tipo(&recurso, 0, tipo)) {
+        return 0.0;
+    }
+    
+    pthread_t* hilos = malloc((size_t)num_hilos * sizeof(pthread_t));
+    args_barrido_t* args = calloc((size_t)num_hilos, sizeof(args_barrido_t));
+    if (hilos == NULL || args == NULL) {
+        free(hilos);
+        free(args);
+        destruir_recurso_compartido(&recurso);
+        return 0.0;
+    }
+    
+    int creados = 0;
+    uint64_t inicio = obtener_tiempo_microsegundos();
+    for (int i = 0; i < num_hilos; i++) {
+        args[i].recurso = &recurso;
+        args[i].operaciones = operaciones_por_hilo;
+        args[i].porcentaje_lecturas = porcentaje_lecturas;
+        args[i].semilla = 2463534242u + (uint32_t)i * 7919u;
+        if (pthread_create(&hilos[i], NULL, hilo_barrido_lectura_escritura, &args[i]) != 0) {
+            break;
+        }
+        creados++;
+    }
+    for (int i = 0; i < creados; i++) {
+        pthread_join(hilos[i], NULL);
+    }
+    uint64_t duracion_us = obtener_tiempo_microsegundos() - inicio;
+    
+    // Cada escritura suma 1: el valor final debe ser el total de escrituras
+    int64_t esperado = 0;
+    for (int i = 0; i < creados; i++) {
+        esperado += args[i].escrituras;
+    }
+    int64_t valor_final;
+    leer_recurso_seguro(&recurso, &valor_final);
+    *correcto = (creados == num_hilos) && (valor_final == esperado);
+    
+    free(hilos);
+    free(args);
+    destruir_recurso_compartido(&recurso);
+    
+    if (duracion_us == 0) {
+        duracion_us = 1;
+    }
+    return (double)creados * operaciones_por_hilo / (double)duracion_us;
+}
+
+bool ejecutar_barrido_lectura_escritura(int num_hilos, int operaciones_por_hilo) {
+    if (num_hilos <= 0 || operaciones_por_hilo <= 0) {
+        return false;
+    }
+    
+    static const int porcentajes_lectura[] = { 99, 90, 50 };
+    static const tipo_recurso_t tipos[] = { RECURSO_MUTEX, RECURSO_RWLOCK, RECURSO_SEQLOCK };
+    const int num_porcentajes = (int)(sizeof(porcentajes_lectura) / sizeof(porcentajes_lectura[0]));
+    const int num_tipos = (int)(sizeof(tipos) / sizeof(tipos[0]));
+    
+    printf("\n=== Barrido Lectura:Escritura (%d hilos, %d operaciones por hilo) ===\n",
+           num_hilos, operaciones_por_hilo);
+    printf("%-10s", "Lect:Escr");
+    for (int t = 0; t < num_tipos; t++) {
+        printf(" %10s", nombre_tipo_recurso(tipos[t]));
+    }
+    printf("   %s\n", "Mejor");
+    
+    bool todo_correcto = true;
+    for (int p = 0; p < num_porcentajes; p++) {
+        char proporcion[16];
+        snprintf(proporcion, sizeof(proporcion), "%d:%d", porcentajes_lectura[p], 100 - porcentajes_lectura[p]);
+        printf("%-10s", proporcion);
+        
+        int mejor = 0;
+        double mejor_mops = 0.0;
+        for (int t = 0; t < num_tipos; t++) {
+            bool correcto;
+            double mops = medir_lectura_escritura(tipos[t], num_hilos, operaciones_por_hilo,
+                                                  porcentajes_lectura[p], &correcto);
+            printf(" %9.2f%s", mops, correcto ? " " : "!");
+            todo_correcto = todo_correcto && correcto;
+            if (mops > mejor_mops) {
+                mejor_mops = mops;
+                mejor = t;
+            }
+        }
+        printf("   %s\n", nombre_tipo_recurso(tipos[mejor]));
+    }
+    printf("(millones de operaciones por segundo; ! = valor final incorrecto)\n");
+    
+    return todo_correcto;
+}
+
 int64_t demostrar_race_condition(int num_hilos, int operaciones) {
     printf("\n=== Demostración de Race Condition ===\n");
     
@@ -575,10 +798,21 @@ bool ejecutar_demo_completa_mutex(void) {
         .operaciones_por_hilo = 1000,
         .recurso = &recurso,
         .stats = &stats,
-        .usar_mutex = true
+        .usar_mutex = true,
+        .barrido_lectura_escritura = false
     };
     
+    // El perfil de contención muestra cuánto esperan y retienen los hilos el
+    // mutex. Solo se perfila esta prueba: en el barrido solo están
+    // instrumentadas las variantes con mutex y el perfilador las penalizaría
+    // frente a rwlock y seqlock.
+    reiniciar_perfil_contencion();
+    activar_perfil_contencion(true);
     ejecutar_prueba_rendimiento(&params);
+    activar_perfil_contencion(false);
+    imprimir_perfil_contencion(5);
+    
+    ejecutar_barrido_lectura_escritura(params.num_hilos, OPERACIONES_BARRIDO_POR_HILO);
     
     // 3. Demostrar tipos de mutex
     printf("\n=== Demostración de Tipos de Mutex ===\n");
@@ -593,6 +827,9 @@ bool ejecutar_demo_completa_mutex(void) {
         destruir_demo_tipos_mutex(&demo);
     }
     
+    // 4. Secciones críticas muy cortas: girar antes de dormir
+    ejecutar_benchmark_mutex_adaptativo(64, 1000000);
+    
     // Cleanup
     destruir_estadisticas_mutex(&stats);
     destruir_recurso_compartido(&recurso);
@@ -0,0 +1,124 @@
+#ifndef MOTOR_SUMA_H
+#define MOTOR_SUMA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @file motor_suma.h
+ * @brief Motor de ejecución persistente y kernels vectoriales de suma
+ *
+ * suma_paralela se llama muchas veces seguidas sobre arrays de ~1M elementos:
+ * crear y unir hilos en cada llamada cuesta tanto como la propia suma. El
+ * motor mantiene los hilos vivos entre llamadas y los despierta con un
+ * contador de generación.
+ *
+ * La suma de cada bloque la hace un kernel int32 -> int64 elegido en tiempo
+ * de ejecución según la CPU: AVX2, SSE2 o escalar.
+ */
+
+/* ==================== KERNELS DE SUMA ==================== */
+
+// Implementaciones disponibles del kernel de suma
+typedef enum {
+    KERNEL_SUMA_ESCALAR = 0,
+    KERNEL_SUMA_SSE2,
+    KERNEL_SUMA_AVX2,
+    NUM_KERNELS_SUMA
+} kernel_suma_t;
+
+// Suma un bloque contiguo de enteros con acumuladores de 64 bits
+typedef int64_t (*funcion_kernel_suma_t)(const int* datos, size_t n);
+
+/**
+ * @brief Suma un bloque con el kernel activo
+ * @param datos Inicio del bloque
+ * @param n Número de elementos
+ * @return Suma del bloque
+ */
+int64_t sumar_bloque(const int* datos, size_t n);
+
+/**
+ * @brief Kernel activo (el mejor que soporta la CPU salvo que se fuerce otro)
+ */
+kernel_suma_t obtener_kernel_suma(void);
+
+/**
+ * @brief Indica si la CPU actual puede ejecutar un kernel
+ */
+bool kernel_suma_soportado(kernel_suma_t kernel);
+
+/**
+ * @brief Fuerza un kernel concreto (para comparar implementaciones)
+ * @param kernel Kernel a usar
+ * @return false si la CPU no lo soporta; el kernel activo no cambia
+ * @note No debe llamarse mientras otras sumas están en curso
+ */
+bool forzar_kernel_suma(kernel_suma_t kernel);
+
+/**
+ * @brief Nombre legible de un kernel ("AVX2", "SSE2", "escalar")
+ */
+const char* nombre_kernel_suma(kernel_suma_t kernel);
+
+/**
+ * @brief Devuelve la función de un kernel concreto, o NULL si no está soportado
+ */
+funcion_kernel_suma_t funcion_kernel_suma(kernel_suma_t kernel);
+
+/* ==================== MOTOR PERSISTENTE ==================== */
+
+// Motor de ejecución con hilos persistentes (estructura opaca)
+typedef struct motor_suma motor_suma_t;
+
+// Trabajo que ejecuta cada participante: indice va de 0 a num_hilos-1
+typedef void (*trabajo_motor_t)(void* arg, int indice);
+
+/**
+ * @brief Crea un motor con num_hilos participantes
+ * @param num_hilos Participantes, incluido el hilo que llama a ejecutar
+ *        (se crean num_hilos-1 hilos trabajadores)
+ * @return Motor creado o NULL si falla
+ */
+motor_suma_t* motor_suma_crear(int num_hilos);
+
+/**
+ * @brief Detiene los hilos trabajadores y libera el motor
+ */
+void motor_suma_destruir(motor_suma_t* motor);
+
+/**
+ * @brief Número de participantes del motor
+ */
+int motor_suma_num_hilos(const motor_suma_t* motor);
+
+/**
+ * @brief Ejecuta trabajo(arg, i) para i en [0, participantes) y espera a todos
+ * @param motor Motor a usar
+ * @param participantes Hilos que trabajan (0 = todos los del motor)
+ * @param trabajo Función a ejecutar
+ * @param arg Argumento común
+ * @return true si se ejecutó, false si participantes supera al motor
+ *
+ * El hilo llamante ejecuta el índice 0. Las llamadas concurrentes sobre el
+ * mismo motor se serializan.
+ */
+bool motor_suma_ejecutar(motor_suma_t* motor, int participantes, trabajo_motor_t trabajo, void* arg);
+
+/**
+ * @brief Motor compartido del proceso con al menos num_hilos participantes
+ *
+ * Se crea en la primera llamada con tantos hilos como CPUs (o num_hilos si es
+ * mayor) y solo se sustituye por uno mayor si se piden más. Lo usa
+ * suma_paralela para no crear hilos en cada llamada.
+ */
+motor_suma_t* obtener_motor_suma_global(int num_hilos);
+
+/**
+ * @brief Mide el ancho de banda de lectura de memoria con todos los núcleos
+ * @return GB/s leyendo un buffer mayor que la caché (se mide una sola vez)
+ */
+double medir_techo_ancho_banda(void);
+
+#endif // MOTOR_SUMA_H
@@ -0,0 +1,106 @@
+#ifndef NUMA_SUMA_H
+#define NUMA_SUMA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "motor_suma.h"
+
+/**
+ * @file numa_suma.h
+ * @brief Colocación de arrays y afinidad de hilos en máquinas NUMA
+ *
+ * Linux coloca cada página en el nodo del hilo que la escribe por primera
+ * vez (first-touch). Si un solo hilo inicializa todo el array, todas las
+ * páginas acaban en su nodo y, en una máquina de dos sockets, la mitad de
+ * los hilos de suma_paralela leen memoria remota.
+ *
+ * reservar_array_numa reparte el array con dividir_rango_en_chunks igual que
+ * suma_paralela, fija cada hilo del motor al nodo de su chunk y hace que sea
+ * ese hilo quien toque primero sus páginas. suma_paralela fija a cada
+ * participante al mismo nodo (nodo_para_chunk) mientras suma su chunk, así
+ * que con el mismo número de hilos cada uno lee de su memoria local. Al
+ * terminar cada operación los hilos recuperan su afinidad: el motor
+ * compartido no queda fijado para el resto del programa.
+ *
+ * La topología se lee de /sys/devices/system/node. Con un solo nodo (o fuera
+ * de Linux) todo esto no hace nada: se reserva con malloc y no se toca la
+ * afinidad de ningún hilo.
+ */
+
+#define MAX_NODOS_NUMA 64
+
+/**
+ * @brief Número de nodos NUMA con CPUs (1 si no hay información)
+ */
+int obtener_num_nodos_numa(void);
+
+/**
+ * @brief Número de CPUs de un nodo
+ * @param nodo Índice de nodo en [0, obtener_num_nodos_numa())
+ * @return CPUs del nodo, o 0 si el nodo no existe
+ */
+int obtener_cpus_nodo_numa(int nodo);
+
+/**
+ * @brief Nodo al que corresponde el chunk indice de num_hilos
+ *
+ * Los chunks consecutivos se asignan al mismo nodo: con 8 hilos y 2 nodos,
+ * los chunks 0-3 van al nodo 0 y los 4-7 al nodo 1.
+ */
+int nodo_para_chunk(int indice, int num_hilos);
+
+/**
+ * @brief Fija el hilo actual a las CPUs de un nodo
+ * @return true si se cambió la afinidad (false con un solo nodo)
+ */
+bool fijar_hilo_a_nodo(int nodo);
+
+/**
+ * @brief Ejecuta trabajo(arg, indice) con el hilo fijado al nodo de su chunk
+ * @param indice Participante (chunk) de num_hilos
+ *
+ * El hilo recupera su afinidad original al terminar. Con un solo nodo llama
+ * a trabajo sin tocar la afinidad.
+ */
+void ejecutar_en_nodo_de_chunk(trabajo_motor_t trabajo, void* arg, int indice, int num_hilos);
+
+/**
+ * @brief Reserva un array y coloca cada chunk en el nodo del hilo que lo suma
+ * @param tamano Número de elementos
+ * @param num_hilos Hilos con los que se va a sumar (reparto de chunks)
+ * @return Array sin inicializar liberable con free(), o NULL si falla la reserva
+ *
+ * Con un solo nodo equivale a malloc. Cada participante (el llamante ejecuta
+ * el chunk 0) recupera su afinidad original al terminar.
+ */
+int* reservar_array_numa(size_t tamano, int num_hilos);
+
+/**
+ * @brief Compara ancho de banda de suma con memoria local y remota
+ * @param tamano Elementos del array de prueba (mayor que la caché)
+ * @param num_hilos Hilos por prueba (0 = CPUs del nodo 0)
+ * @return true si las sumas coinciden (o si solo hay un nodo)
+ *
+ * Mide cuatro colocaciones: datos e hilos en el nodo 0, datos en el nodo 0 e
+ * hilos en el nodo 1, datos en el nodo 0 con hilos repartidos, y first-touch
+ * por chunk con hilos repartidos.
+ */
+bool ejecutar_benchmark_numa(size_t tamano, int num_hilos);
+
+/**
+ * @brief Compara las políticas de afinidad de topologia_cpu.h en la suma
+ * @param tamano Elementos del array de prueba
+ * @param num_hilos Hilos por prueba (0 = núcleos físicos)
+ * @return true si todas las sumas coinciden
+ *
+ * Cada participante del motor se fija a la CPU que le da la política (sin
+ * afinidad, compacta, dispersa y uno por núcleo) y recupera su afinidad al
+ * terminar. Con arrays mayores que la L3 la dispersa suele ganar, porque
+ * cada hilo tiene más caché y ancho de banda para él; la compacta solo
+ * compensa cuando los hilos comparten datos.
+ */
+bool ejecutar_benchmark_afinidad(size_t tamano, int num_hilos);
+
+#endif // NUMA_SUMA_H
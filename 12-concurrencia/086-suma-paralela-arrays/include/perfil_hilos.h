@@ -0,0 +1,92 @@
+#ifndef PERFIL_HILOS_H
+#define PERFIL_HILOS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @file perfil_hilos.h
+ * @brief Perfil de máquina para calcular_num_hilos_optimo
+ *
+ * Los umbrales fijos de calcular_num_hilos_optimo no sirven igual en un
+ * portátil de 4 núcleos que en un servidor de 64. La calibración mide el
+ * tiempo de suma_paralela para varios tamaños de array y números de hilos,
+ * busca a partir de qué tamaño compensa cada número de hilos y, con ese
+ * número de hilos, si repartir el array en chunks dinámicos mejora al
+ * reparto fijo. Guarda esos puntos de cruce en un fichero de texto:
+ *
+ *     # comentario
+ *     cpus 64
+ *     kernel AVX2
+ *     umbral 0 1 0
+ *     umbral 65536 4 0
+ *     umbral 1048576 32 65536
+ *
+ * "umbral T H C" significa: para arrays de T elementos o más, usar H hilos
+ * y chunks dinámicos de C elementos (0 = un chunk fijo por hilo). Los
+ * perfiles antiguos sin C se leen con C = 0.
+ * calcular_num_hilos_optimo carga el perfil la primera vez que se llama
+ * (ruta en $SUMA_PARALELA_PERFIL o RUTA_PERFIL_HILOS_DEFECTO). Si no existe
+ * o se generó en una máquina con otro número de CPUs, usa los umbrales fijos.
+ */
+
+#define RUTA_PERFIL_HILOS_DEFECTO "suma_paralela.perfil"
+#define VARIABLE_ENTORNO_PERFIL "SUMA_PARALELA_PERFIL"
+#define MAX_UMBRALES_PERFIL 32
+
+// Punto de cruce: desde tamano_minimo elementos, usar num_hilos
+typedef struct {
+    size_t tamano_minimo;
+    int num_hilos;
+    size_t tamano_chunk;        // Chunk dinámico (0 = un chunk por hilo)
+} umbral_hilos_t;
+
+typedef struct {
+    int num_cpus;                           // CPUs de la máquina calibrada
+    int num_umbrales;
+    umbral_hilos_t umbrales[MAX_UMBRALES_PERFIL]; // Ordenados por tamano_minimo
+} perfil_hilos_t;
+
+/**
+ * @brief Mide suma_paralela para varios tamaños, números de hilos y chunks
+ * @param max_hilos Máximo de hilos a probar (0 = número de CPUs)
+ * @param perfil Perfil resultante
+ * @param mostrar_detalles Imprimir las tablas de escalabilidad de cada tamaño
+ * @return true si la calibración terminó
+ */
+bool calibrar_perfil_hilos(int max_hilos, perfil_hilos_t* perfil, bool mostrar_detalles);
+
+/**
+ * @brief Guarda un perfil en un fichero de texto
+ * @return true si se escribió correctamente
+ */
+bool guardar_perfil_hilos(const perfil_hilos_t* perfil, const char* ruta);
+
+/**
+ * @brief Lee un perfil de un fichero de texto
+ * @return true si el fichero existe y es válido
+ */
+bool cargar_perfil_hilos(const char* ruta, perfil_hilos_t* perfil);
+
+/**
+ * @brief Instala un perfil para calcular_num_hilos_optimo (NULL = quitarlo)
+ * @return false si el perfil es de una máquina con otro número de CPUs
+ */
+bool activar_perfil_hilos(const perfil_hilos_t* perfil);
+
+/**
+ * @brief Consulta el perfil activo
+ * @param tamano_array Tamaño del array
+ * @param num_hilos Hilos recomendados por el perfil
+ * @param tamano_chunk Chunk dinámico recomendado (puede ser NULL)
+ * @return false si no hay perfil activo (la primera llamada intenta cargarlo)
+ */
+bool consultar_perfil_hilos(size_t tamano_array, int* num_hilos, size_t* tamano_chunk);
+
+/**
+ * @brief Muestra los umbrales de un perfil
+ */
+void imprimir_perfil_hilos(const perfil_hilos_t* perfil);
+
+#endif // PERFIL_HILOS_H
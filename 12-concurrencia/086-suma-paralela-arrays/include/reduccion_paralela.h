@@ -0,0 +1,109 @@
+#ifndef REDUCCION_PARALELA_H
+#define REDUCCION_PARALELA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @file reduccion_paralela.h
+ * @brief Reducciones paralelas genéricas sobre arrays de enteros
+ *
+ * Una reducción se describe con tres operaciones sobre un acumulador:
+ * identidad, procesar un bloque de datos y combinar dos acumuladores. El
+ * framework reparte el array con dividir_rango_en_chunks, ejecuta los
+ * bloques en el motor persistente y combina los parciales en orden.
+ *
+ * Varias reducciones pueden ejecutarse fusionadas: cada hilo recorre su
+ * parte en teselas que caben en L1 y aplica todas las reducciones a cada
+ * tesela antes de pasar a la siguiente, así que cada línea de caché se trae
+ * de memoria una sola vez aunque se calculen cinco estadísticas.
+ */
+
+/* ==================== DESCRIPTOR ==================== */
+
+typedef struct {
+    const char* nombre;
+    size_t tam_acumulador;   // Bytes del acumulador parcial
+    // Deja en acum el elemento neutro de la reducción
+    void (*identidad)(void* acum, const void* contexto);
+    // Acumula datos[0..n) en acum. Debe poder llamarse varias veces seguidas.
+    void (*procesar_bloque)(void* acum, const int* datos, size_t n, const void* contexto);
+    // destino = destino ⊕ origen (asociativa; se combina en orden de chunk)
+    void (*combinar)(void* destino, const void* origen, const void* contexto);
+    const void* contexto;    // Parámetros de la reducción (p. ej. histograma)
+} descriptor_reduccion_t;
+
+/* ==================== ACUMULADORES PREDEFINIDOS ==================== */
+
+// Momentos para media y varianza (combinación de Chan et al.)
+typedef struct {
+    uint64_t n;
+    double media;
+    double m2;               // Suma de cuadrados de las desviaciones
+} acumulador_momentos_t;
+
+// Configuración de un histograma de cubetas iguales sobre [minimo, maximo].
+// Los valores fuera del rango se cuentan en la primera o última cubeta.
+// El acumulador es un array de num_cubetas uint64_t.
+typedef struct {
+    int minimo;
+    int maximo;
+    int num_cubetas;
+} config_histograma_t;
+
+descriptor_reduccion_t reduccion_suma(void);                 // int64_t
+descriptor_reduccion_t reduccion_minimo(void);               // int
+descriptor_reduccion_t reduccion_maximo(void);               // int
+descriptor_reduccion_t reduccion_momentos(void);             // acumulador_momentos_t
+descriptor_reduccion_t reduccion_histograma(const config_histograma_t* config); // uint64_t[num_cubetas]
+
+/* ==================== EJECUCIÓN ==================== */
+
+/**
+ * @brief Ejecuta varias reducciones fusionadas en una sola pasada paralela
+ * @param array Datos de entrada
+ * @param tamano Número de elementos
+ * @param num_hilos Hilos a usar (se limita al tamaño del array)
+ * @param descriptores Reducciones a calcular
+ * @param num_descriptores Número de reducciones
+ * @param resultados resultados[i] recibe el acumulador final de descriptores[i]
+ * @return true si la reducción se ejecutó
+ */
+bool reduccion_paralela(const int* array, size_t tamano, int num_hilos,
+                        const descriptor_reduccion_t* descriptores, int num_descriptores,
+                        void* const* resultados);
+
+/* ==================== ESTADÍSTICAS FUSIONADAS ==================== */
+
+// Estadísticas calculadas en una sola pasada
+typedef struct {
+    int64_t suma;
+    int minimo;
+    int maximo;
+    double media;
+    double varianza;         // Varianza poblacional
+    // Histograma opcional: si histograma != NULL se rellena con
+    // config_histograma.num_cubetas contadores
+    uint64_t* histograma;
+    config_histograma_t config_histograma;
+} estadisticas_array_t;
+
+/**
+ * @brief Calcula suma, mínimo, máximo, media, varianza e histograma a la vez
+ * @param array Datos de entrada
+ * @param tamano Número de elementos
+ * @param num_hilos Hilos a usar
+ * @param estadisticas Entrada (histograma opcional) y salida
+ * @return true si el cálculo fue exitoso
+ */
+bool calcular_estadisticas_paralelas(const int* array, size_t tamano, int num_hilos,
+                                     estadisticas_array_t* estadisticas);
+
+/**
+ * @brief Compara estadísticas en pasadas separadas frente a una pasada fusionada
+ * @return true si ambas versiones dan los mismos resultados
+ */
+bool ejecutar_benchmark_estadisticas(const int* array, size_t tamano, int num_hilos);
+
+#endif // REDUCCION_PARALELA_H
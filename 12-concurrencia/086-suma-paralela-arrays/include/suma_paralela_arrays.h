@@ -6,6 +6,8 @@
 #include <stdbool.h>
 #include <stddef.h>
 
+#include "motor_suma.h"
+
 /**
  * @file suma_paralela_arrays.h
  * @brief Ejercicio 086: Suma Paralela de Arrays con Hilos
@@ -20,6 +22,7 @@
  * - Medición de rendimiento paralelo vs secuencial
  * - Load balancing entre hilos
  * - Escalabilidad horizontal
+ * - Hilos persistentes y kernels SIMD (ver motor_suma.h)
  */
 
 // Estructura para pasar parámetros a un hilo de suma
@@ -28,16 +31,21 @@ typedef struct {
     size_t inicio;              // Índice de inicio (inclusivo)
     size_t fin;                 // Índice de fin (exclusivo)
     int64_t resultado;          // Resultado de la suma parcial
+    size_t num_chunks;          // Chunks sumados (solo con reparto dinámico)
     int id_hilo;                // Identificador del hilo
     uint64_t tiempo_inicio;     // Tiempo de inicio en microsegundos
     uint64_t tiempo_fin;        // Tiempo de fin en microsegundos
 } parametros_suma_t;
 
+// tamano_chunk que fuerza un chunk fijo por hilo aunque el perfil diga otra cosa
+#define TAMANO_CHUNK_FIJO SIZE_MAX
+
 // Estructura para configuración de suma paralela
 typedef struct {
     const int* array;           // Array a procesar
     size_t tamano;              // Tamaño del array
-    int num_hilos;              // Número de hilos a usar
+    int num_hilos;              // Número de hilos a usar (0 = calcular_num_hilos_optimo)
+    size_t tamano_chunk;        // Elementos por reparto dinámico (0 = según el perfil)
     bool mostrar_detalles;      // Mostrar información detallada
 } configuracion_suma_t;
 
@@ -55,18 +63,26 @@ typedef struct {
 typedef struct {
     int64_t suma_secuencial;
     int64_t suma_paralela;
-    uint64_t tiempo_secuencial_us;
+    uint64_t tiempo_secuencial_us;  // Un hilo con el mismo kernel que la paralela
     uint64_t tiempo_paralelo_us;
-    double speedup;
+    uint64_t tiempo_escalar_us;     // Bucle escalar de suma_secuencial
+    double speedup;             // Solo escalado por hilos (mismo kernel)
     double eficiencia;
+    double ganancia_simd;       // Escalar frente al kernel, ambos en un hilo
     int num_hilos;
     size_t tamano_array;
+    kernel_suma_t kernel;       // Kernel usado por la suma paralela
+    double gbps_secuencial;     // Ancho de banda efectivo de cada versión
+    double gbps_paralelo;
+    double techo_gbps;          // Ancho de banda de lectura de memoria medido
 } benchmark_suma_t;
 
 /**
  * @brief Función que ejecuta un hilo para calcular suma parcial
  * @param arg Puntero a parametros_suma_t
  * @return NULL
+ *
+ * Suma el rango con el kernel vectorial activo (sumar_bloque).
  */
 void* hilo_suma_parcial(void* arg);
 
@@ -75,6 +91,19 @@ void* hilo_suma_parcial(void* arg);
  * @param config Configuración de la suma paralela
  * @param resultado Estructura donde almacenar los resultados
  * @return true si la operación fue exitosa
+ *
+ * Los hilos salen del motor persistente global: solo la primera llamada
+ * (o una que pida más hilos que las anteriores) los crea.
+ *
+ * Con reparto fijo cada hilo suma un rango de dividir_rango_en_chunks fijado
+ * al nodo NUMA de ese rango (ver numa_suma.h). Con chunks dinámicos los hilos
+ * van tomando chunks de tamano_chunk elementos de un contador atómico hasta
+ * agotar el array, sin fijar: cualquier hilo puede tomar cualquier chunk.
+ *
+ * num_hilos = 0 toma el número de hilos del perfil de la máquina. Con
+ * tamano_chunk = 0 se usa el chunk del perfil si el perfil recomienda
+ * justamente esos hilos para este tamaño (ver calcular_tamano_chunk_optimo),
+ * y si no, el reparto fijo. TAMANO_CHUNK_FIJO fuerza el reparto fijo.
  */
 bool suma_paralela(const configuracion_suma_t* config, resultado_suma_paralela_t* resultado);
 
@@ -84,6 +113,8 @@ bool suma_paralela(const configuracion_suma_t* config, resultado_suma_paralela_t
  * @param tamano Tamaño del array
  * @param tiempo_us Puntero donde almacenar el tiempo (puede ser NULL)
  * @return Suma total del array
+ *
+ * Bucle escalar simple: es la referencia de los benchmarks.
  */
 int64_t suma_secuencial(const int* array, size_t tamano, uint64_t* tiempo_us);
 
@@ -106,18 +137,26 @@ void limpiar_resultado_suma(resultado_suma_paralela_t* resultado);
  * @param tamano Tamaño del array a crear
  * @param valor_min Valor mínimo de los elementos
  * @param valor_max Valor máximo de los elementos
+ * @param num_hilos Hilos con los que se va a sumar (0 o 1 = reserva normal)
  * @return Puntero al array creado (debe liberarse con free)
+ *
+ * En máquinas NUMA cada uno de los num_hilos chunks queda en el nodo del
+ * hilo que lo suma (ver reservar_array_numa).
  */
-int* crear_array_aleatorio(size_t tamano, int valor_min, int valor_max);
+int* crear_array_aleatorio(size_t tamano, int valor_min, int valor_max, int num_hilos);
 
 /**
  * @brief Crea un array con secuencia aritmética
  * @param tamano Tamaño del array
  * @param inicio Valor inicial
  * @param incremento Incremento entre elementos
+ * @param num_hilos Hilos con los que se va a sumar (0 o 1 = reserva normal)
  * @return Puntero al array creado (debe liberarse con free)
+ *
+ * En máquinas NUMA cada uno de los num_hilos chunks queda en el nodo del
+ * hilo que lo suma (ver reservar_array_numa).
  */
-int* crear_array_secuencia(size_t tamano, int inicio, int incremento);
+int* crear_array_secuencia(size_t tamano, int inicio, int incremento, int num_hilos);
 
 /**
  * @brief Verifica que dos sumas sean iguales
@@ -137,6 +176,15 @@ bool verificar_sumas_iguales(int64_t suma1, int64_t suma2);
  */
 bool ejecutar_benchmark_suma(const int* array, size_t tamano, int num_hilos, benchmark_suma_t* benchmark);
 
+/**
+ * @brief Compara el ancho de banda de la suma paralela con cada kernel soportado
+ * @param array Array a usar
+ * @param tamano Tamaño del array
+ * @param num_hilos Número de hilos
+ * @return true si todas las sumas coinciden con la secuencial
+ */
+bool ejecutar_comparacion_kernels(const int* array, size_t tamano, int num_hilos);
+
 /**
  * @brief Imprime los resultados de una suma paralela
  * @param resultado Puntero a los resultados
@@ -153,9 +201,21 @@ void imprimir_benchmark(const benchmark_suma_t* benchmark);
  * @brief Calcula el número óptimo de hilos para un tamaño de array dado
  * @param tamano_array Tamaño del array
  * @return Número recomendado de hilos
+ *
+ * Usa el perfil calibrado de la máquina si existe (ver perfil_hilos.h);
+ * si no, umbrales fijos.
  */
 int calcular_num_hilos_optimo(size_t tamano_array);
 
+/**
+ * @brief Tamaño de chunk dinámico recomendado para un tamaño de array
+ * @param tamano_array Tamaño del array
+ * @param num_hilos Hilos con los que se va a sumar
+ * @return Elementos por chunk, o 0 (un chunk por hilo) si no hay perfil o si
+ *         el perfil se calibró con otro número de hilos para este tamaño
+ */
+size_t calcular_tamano_chunk_optimo(size_t tamano_array, int num_hilos);
+
 /**
  * @brief Divide un rango en chunks para distribución entre hilos
  * @param inicio Inicio del rango
@@ -199,6 +259,9 @@ bool ejecutar_demo_completa_suma_paralela(void);
  * @param min Puntero donde almacenar el mínimo
  * @param max Puntero donde almacenar el máximo
  * @param promedio Puntero donde almacenar el promedio
+ *
+ * Usa calcular_estadisticas_paralelas (reduccion_paralela.h): una sola
+ * pasada paralela fusionada.
  */
 void calcular_estadisticas_array(const int* array, size_t tamano, int* min, int* max, double* promedio);
 
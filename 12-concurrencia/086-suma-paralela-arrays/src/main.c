@@ -1,4 +1,6 @@
 #include "../include/suma_paralela_arrays.h"
+#include "../include/perfil_hilos.h"
+#include "../include/numa_suma.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
@@ -11,6 +13,9 @@ static void imprimir_menu(void) {
     printf("4. Array aleatorio personalizado\n");
     printf("5. Análisis de rendimiento detallado\n");
     printf("6. Demostración completa\n");
+    printf("7. Calibrar perfil de hilos\n");
+    printf("8. Benchmark NUMA (memoria local vs remota)\n");
+    printf("9. Benchmark de políticas de afinidad\n");
     printf("0. Salir\n");
     printf("Seleccione una opción: ");
 }
@@ -72,7 +77,7 @@ static void demo_benchmark(void) {
     }
     
     printf("\nCreando array de %zu elementos...\n", tamano);
-    int* array = crear_array_secuencia(tamano, 1, 1);
+    int* array = crear_array_secuencia(tamano, 1, 1, num_hilos);
     if (array == NULL) {
         printf("Error creando array\n");
         return;
@@ -114,17 +119,17 @@ static void demo_escalabilidad(void) {
     size_t tamano = 1000000; // 1 millón de elementos
     printf("Usando array de %zu elementos\n", tamano);
     
-    int* array = crear_array_secuencia(tamano, 1, 1);
-    if (array == NULL) {
-        printf("Error creando array\n");
-        return;
-    }
-    
     int max_hilos = obtener_num_cpus();
     if (max_hilos <= 0) {
         max_hilos = 8; // Valor por defecto
     }
     
+    int* array = crear_array_secuencia(tamano, 1, 1, max_hilos);
+    if (array == NULL) {
+        printf("Error creando array\n");
+        return;
+    }
+    
     printf("Número de CPUs detectadas: %d\n", max_hilos);
     printf("Probando escalabilidad hasta %d hilos...\n\n", max_hilos);
     
@@ -171,7 +176,7 @@ static void demo_array_personalizado(void) {
     }
     
     printf("\nCreando array aleatorio...\n");
-    int* array = crear_array_aleatorio(tamano, valor_min, valor_max);
+    int* array = crear_array_aleatorio(tamano, valor_min, valor_max, num_hilos);
     if (array == NULL) {
         printf("Error creando array\n");
         return;
@@ -218,7 +223,8 @@ static void demo_analisis_detallado(void) {
     size_t tamano = 50000;
     printf("Usando array de %zu elementos (secuencia 1, 2, 3, ...)\n", tamano);
     
-    int* array = crear_array_secuencia(tamano, 1, 1);
+    // Se suma con 1 a 8 hilos: sin colocación por nodo
+    int* array = crear_array_secuencia(tamano, 1, 1, 0);
     if (array == NULL) {
         printf("Error creando array\n");
         return;
@@ -258,6 +264,30 @@ static void demo_analisis_detallado(void) {
     free(array);
 }
 
+static void demo_calibrar_perfil(void) {
+    printf("\n=== Calibración del Número de Hilos ===\n");
+    printf("Midiendo suma_paralela con distintos tamaños y números de hilos...\n");
+    
+    perfil_hilos_t perfil;
+    if (!calibrar_perfil_hilos(0, &perfil, true)) {
+        printf("Error durante la calibración\n");
+        return;
+    }
+    imprimir_perfil_hilos(&perfil);
+    
+    const char* ruta = getenv(VARIABLE_ENTORNO_PERFIL);
+    if (ruta == NULL) {
+        ruta = RUTA_PERFIL_HILOS_DEFECTO;
+    }
+    if (guardar_perfil_hilos(&perfil, ruta)) {
+        printf("\nPerfil guardado en %s\n", ruta);
+    } else {
+        printf("\nNo se pudo guardar el perfil en %s\n", ruta);
+    }
+    activar_perfil_hilos(&perfil);
+    printf("calcular_num_hilos_optimo(1000000) = %d\n", calcular_num_hilos_optimo(1000000));
+}
+
 #ifndef UNIT_TESTING
 int main(void) {
     int opcion;
@@ -300,6 +330,18 @@ int main(void) {
                 ejecutar_demo_completa_suma_paralela();
                 break;
                 
+            case 7:
+                demo_calibrar_perfil();
+                break;
+                
+            case 8:
+                ejecutar_benchmark_numa(32 * 1024 * 1024, 0);
+                break;
+                
+            case 9:
+                ejecutar_benchmark_afinidad(32 * 1024 * 1024, 0);
+                break;
+                
             case 0:
                 printf("Saliendo del programa...\n");
                 break;
@@ -0,0 +1,471 @@
+#include "../include/motor_suma.h"
+#include "../include/suma_paralela_arrays.h"
+#include "topologia_cpu.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SUMA_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+#define TAM_LINEA_CACHE 64
+#define VUELTAS_ESPERA 256                 // Vueltas con sched_yield antes de dormir
+#define TAM_BUFFER_ANCHO_BANDA (128u << 20) // Mayor que cualquier LLC habitual
+#define REPETICIONES_ANCHO_BANDA 3
+
+// ==================== KERNELS ====================
+
+static int64_t sumar_escalar(const int* datos, size_t n) {
+    int64_t suma = 0;
+    for (size_t i = 0; i < n; i++) {
+        suma += datos[i];
+    }
+    return suma;
+}
+
+#ifdef SUMA_X86_SIMD
+
+// SSE2 no tiene extensión de signo de 32 a 64 bits (llega con SSE4.1):
+// se intercala cada valor con su máscara de signo
+__attribute__((target("sse2")))
+static int64_t sumar_sse2(const int* datos, size_t n) {
+    const __m128i cero = _mm_setzero_si128();
+    __m128i acum0 = _mm_setzero_si128();
+    __m128i acum1 = _mm_setzero_si128();
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(datos + i));
+        __m128i b = _mm_loadu_si128((const __m128i*)(datos + i + 4));
+        __m128i signo_a = _mm_cmpgt_epi32(cero, a);
+        __m128i signo_b = _mm_cmpgt_epi32(cero, b);
+        acum0 = _mm_add_epi64(acum0, _mm_unpacklo_epi32(a, signo_a));
+        acum1 = _mm_add_epi64(acum1, _mm_unpackhi_epi32(a, signo_a));
+        acum0 = _mm_add_epi64(acum0, _mm_unpacklo_epi32(b, signo_b));
+        acum1 = _mm_add_epi64(acum1, _mm_unpackhi_epi32(b, signo_b));
+    }
+
+    int64_t parciales[2];
+    _mm_storeu_si128((__m128i*)parciales, _mm_add_epi64(acum0, acum1));
+    return parciales[0] + parciales[1] + sumar_escalar(datos + i, n - i);
+}
+
+// 16 enteros por iteración en cuatro acumuladores independientes para
+// ocultar la latencia de vpmovsxdq + vpaddq
+__attribute__((target("avx2")))
+static int64_t sumar_avx2(const int* datos, size_t n) {
+    __m256i acum0 = _mm256_setzero_si256();
+    __m256i acum1 = _mm256_setzero_si256();
+    __m256i acum2 = _mm256_setzero_si256();
+    __m256i acum3 = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)(datos + i));
+        __m256i b = _mm256_loadu_si256((const __m256i*)(datos + i + 8));
+        acum0 = _mm256_add_epi64(acum0, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(a)));
+        acum1 = _mm256_add_epi64(acum1, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(a, 1)));
+        acum2 = _mm256_add_epi64(acum2, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(b)));
+        acum3 = _mm256_add_epi64(acum3, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(b, 1)));
+    }
+
+    __m256i total = _mm256_add_epi64(_mm256_add_epi64(acum0, acum1), _mm256_add_epi64(acum2, acum3));
+    int64_t parciales[4];
+    _mm256_storeu_si256((__m256i*)parciales, total);
+    return parciales[0] + parciales[1] + parciales[2] + parciales[3] +
+           sumar_escalar(datos + i, n - i);
+}
+
+#endif // SUMA_X86_SIMD
+
+static const char* const nombres_kernel[NUM_KERNELS_SUMA] = { "escalar", "SSE2", "AVX2" };
+
+static pthread_once_t kernel_once = PTHREAD_ONCE_INIT;
+static kernel_suma_t kernel_activo = KERNEL_SUMA_ESCALAR;
+static funcion_kernel_suma_t funcion_activa = sumar_escalar;
+
+bool kernel_suma_soportado(kernel_suma_t kernel) {
+    switch (kernel) {
+        case KERNEL_SUMA_ESCALAR:
+            return true;
+#ifdef SUMA_X86_SIMD
+        case KERNEL_SUMA_SSE2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("sse2");
+        case KERNEL_SUMA_AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+funcion_kernel_suma_t funcion_kernel_suma(kernel_suma_t kernel) {
+    if (!kernel_suma_soportado(kernel)) {
+        return NULL;
+    }
+    switch (kernel) {
+#ifdef SUMA_X86_SIMD
+        case KERNEL_SUMA_SSE2: return sumar_sse2;
+        case KERNEL_SUMA_AVX2: return sumar_avx2;
+#endif
+        default:               return sumar_escalar;
+    }
+}
+
+static void seleccionar_kernel(void) {
+    for (int k = NUM_KERNELS_SUMA - 1; k >= 0; k--) {
+        if (kernel_suma_soportado((kernel_suma_t)k)) {
+            kernel_activo = (kernel_suma_t)k;
+            funcion_activa = funcion_kernel_suma(kernel_activo);
+            return;
+        }
+    }
+}
+
+int64_t sumar_bloque(const int* datos, size_t n) {
+    pthread_once(&kernel_once, seleccionar_kernel);
+    return funcion_activa(datos, n);
+}
+
+kernel_suma_t obtener_kernel_suma(void) {
+    pthread_once(&kernel_once, seleccionar_kernel);
+    return kernel_activo;
+}
+
+bool forzar_kernel_suma(kernel_suma_t kernel) {
+    pthread_once(&kernel_once, seleccionar_kernel);
+    funcion_kernel_suma_t funcion = funcion_kernel_suma(kernel);
+    if (funcion == NULL) {
+        return false;
+    }
+    kernel_activo = kernel;
+    funcion_activa = funcion;
+    return true;
+}
+
+const char* nombre_kernel_suma(kernel_suma_t kernel) {
+    return (kernel >= 0 && kernel < NUM_KERNELS_SUMA) ? nombres_kernel[kernel] : "desconocido";
+}
+
+// ==================== MOTOR PERSISTENTE ====================
+
+typedef struct {
+    motor_suma_t* motor;
+    int indice;
+} trabajador_motor_t;
+
+struct motor_suma {
+    int num_hilos;
+    pthread_t* hilos;
+    trabajador_motor_t* trabajadores;
+    int hilos_creados;
+
+    pthread_mutex_t mutex_ejecucion;  // Un trabajo a la vez por motor
+    pthread_mutex_t mutex;            // Solo para dormir/despertar
+    pthread_cond_t cond_inicio;
+    pthread_cond_t cond_fin;
+
+    // Trabajo en curso: se escribe antes de publicar la nueva generación
+    trabajo_motor_t trabajo;
+    void* arg;
+    int participantes;
+
+    _Alignas(TAM_LINEA_CACHE) atomic_uint generacion;
+    atomic_int dormidos;
+    atomic_bool terminar;
+    _Alignas(TAM_LINEA_CACHE) atomic_int pendientes;
+    atomic_bool llamante_esperando;
+};
+
+static void* hilo_motor(void* arg) {
+    trabajador_motor_t* yo = (trabajador_motor_t*)arg;
+    motor_suma_t* motor = yo->motor;
+    // La generación empieza en 0 al crear el motor; no se lee aquí porque el
+    // primer trabajo puede publicarse antes de que este hilo arranque
+    unsigned vista = 0;
+
+    for (;;) {
+        // Esperar a una generación nueva: primero cediendo la CPU, luego durmiendo
+        unsigned generacion = vista;
+        for (int v = 0; v < VUELTAS_ESPERA && generacion == vista; v++) {
+            if (atomic_load_explicit(&motor->terminar, memory_order_acquire)) return NULL;
+            sched_yield();
+            generacion = atomic_load_explicit(&motor->generacion, memory_order_acquire);
+        }
+        if (generacion == vista) {
+            pthread_mutex_lock(&motor->mutex);
+            atomic_fetch_add_explicit(&motor->dormidos, 1, memory_order_relaxed);
+            atomic_thread_fence(memory_order_seq_cst);
+            while ((generacion = atomic_load_explicit(&motor->generacion, memory_order_acquire)) == vista &&
+                   !atomic_load_explicit(&motor->terminar, memory_order_acquire)) {
+                pthread_cond_wait(&motor->cond_inicio, &motor->mutex);
+            }
+            atomic_fetch_sub_explicit(&motor->dormidos, 1, memory_order_relaxed);
+            pthread_mutex_unlock(&motor->mutex);
+        }
+        if (atomic_load_explicit(&motor->terminar, memory_order_acquire)) return NULL;
+        vista = generacion;
+
+        // Todos los trabajadores confirman cada generación, participen o no:
+        // así ninguno puede quedarse leyendo el trabajo anterior
+        if (yo->indice < motor->participantes) {
+            motor->trabajo(motor->arg, yo->indice);
+        }
+
+        if (atomic_fetch_sub_explicit(&motor->pendientes, 1, memory_order_acq_rel) == 1) {
+            atomic_thread_fence(memory_order_seq_cst);
+            if (atomic_load_explicit(&motor->llamante_esperando, memory_order_relaxed)) {
+                pthread_mutex_lock(&motor->mutex);
+                pthread_cond_signal(&motor->cond_fin);
+                pthread_mutex_unlock(&motor->mutex);
+            }
+        }
+    }
+}
+
+motor_suma_t* motor_suma_crear(int num_hilos) {
+    if (num_hilos <= 0) {
+        return NULL;
+    }
+    motor_suma_t* motor = calloc(1, sizeof(motor_suma_t));
+    if (motor == NULL) {
+        return NULL;
+    }
+    motor->num_hilos = num_hilos;
+    motor->hilos = malloc((size_t)num_hilos * sizeof(pthread_t));
+    motor->trabajadores = malloc((size_t)num_hilos * sizeof(trabajador_motor_t));
+    if (motor->hilos == NULL || motor->trabajadores == NULL) {
+        free(motor->hilos);
+        free(motor->trabajadores);
+        free(motor);
+        return NULL;
+    }
+    pthread_mutex_init(&motor->mutex_ejecucion, NULL);
+    pthread_mutex_init(&motor->mutex, NULL);
+    pthread_cond_init(&motor->cond_inicio, NULL);
+    pthread_cond_init(&motor->cond_fin, NULL);
+    atomic_init(&motor->generacion, 0);
+    atomic_init(&motor->dormidos, 0);
+    atomic_init(&motor->terminar, false);
+    atomic_init(&motor->pendientes, 0);
+    atomic_init(&motor->llamante_esperando, false);
+
+    // El índice 0 lo ejecuta siempre el hilo que llama a motor_suma_ejecutar
+    politica_afinidad_t politica = politica_afinidad_por_defecto();
+    for (int i = 1; i < num_hilos; i++) {
+        motor->trabajadores[i].motor = motor;
+        motor->trabajadores[i].indice = i;
+        if (crear_hilo_con_afinidad(&motor->hilos[i], hilo_motor, &motor->trabajadores[i],
+                                    politica, i) != 0) {
+            motor_suma_destruir(motor);
+            return NULL;
+        }
+        motor->hilos_creados++;
+    }
+    return motor;
+}
+
+void motor_suma_destruir(motor_suma_t* motor) {
+    if (motor == NULL) {
+        return;
+    }
+    pthread_mutex_lock(&motor->mutex);
+    atomic_store_explicit(&motor->terminar, true, memory_order_release);
+    pthread_cond_broadcast(&motor->cond_inicio);
+    pthread_mutex_unlock(&motor->mutex);
+
+    for (int i = 1; i <= motor->hilos_creados; i++) {
+        pthread_join(motor->hilos[i], NULL);
+    }
+    pthread_cond_destroy(&motor->cond_inicio);
+    pthread_cond_destroy(&motor->cond_fin);
+    pthread_mutex_destroy(&motor->mutex);
+    pthread_mutex_destroy(&motor->mutex_ejecucion);
+    free(motor->hilos);
+    free(motor->trabajadores);
+    free(motor);
+}
+
+int motor_suma_num_hilos(const motor_suma_t* motor) {
+    return motor != NULL ? motor->num_hilos : 0;
+}
+
+bool motor_suma_ejecutar(motor_suma_t* motor, int participantes, trabajo_motor_t trabajo, void* arg) {
+    if (motor == NULL || trabajo == NULL || participantes < 0 || participantes > motor->num_hilos) {
+        return false;
+    }
+    if (participantes == 0) {
+        participantes = motor->num_hilos;
+    }
+    if (participantes == 1) {
+        trabajo(arg, 0);
+        return true;
+    }
+
+    pthread_mutex_lock(&motor->mutex_ejecucion);
+    motor->trabajo = trabajo;
+    motor->arg = arg;
+    motor->participantes = participantes;
+    atomic_store_explicit(&motor->pendientes, motor->num_hilos - 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&motor->generacion, 1, memory_order_release);
+
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&motor->dormidos, memory_order_relaxed) > 0) {
+        pthread_mutex_lock(&motor->mutex);
+        pthread_cond_broadcast(&motor->cond_inicio);
+        pthread_mutex_unlock(&motor->mutex);
+    }
+
+    trabajo(arg, 0);
+
+    for (int v = 0; v < VUELTAS_ESPERA; v++) {
+        if (atomic_load_explicit(&motor->pendientes, memory_order_acquire) == 0) break;
+        sched_yield();
+    }
+    if (atomic_load_explicit(&motor->pendientes, memory_order_acquire) > 0) {
+        pthread_mutex_lock(&motor->mutex);
+        atomic_store_explicit(&motor->llamante_esperando, true, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        while (atomic_load_explicit(&motor->pendientes, memory_order_acquire) > 0) {
+            pthread_cond_wait(&motor->cond_fin, &motor->mutex);
+        }
+        atomic_store_explicit(&motor->llamante_esperando, false, memory_order_relaxed);
+        pthread_mutex_unlock(&motor->mutex);
+    }
+    pthread_mutex_unlock(&motor->mutex_ejecucion);
+    return true;
+}
+
+// ==================== MOTOR GLOBAL ====================
+
+// Los motores sustituidos no se destruyen enseguida (otro hilo puede estar
+// usándolos): se guardan y se liberan al salir del proceso
+typedef struct motor_retirado {
+    motor_suma_t* motor;
+    struct motor_retirado* siguiente;
+} motor_retirado_t;
+
+static pthread_mutex_t mutex_motor_global = PTHREAD_MUTEX_INITIALIZER;
+static motor_suma_t* motor_global = NULL;
+static motor_retirado_t* motores_retirados = NULL;
+
+static void liberar_motores_globales(void) {
+    pthread_mutex_lock(&mutex_motor_global);
+    motor_suma_destruir(motor_global);
+    motor_global = NULL;
+    while (motores_retirados != NULL) {
+        motor_retirado_t* siguiente = motores_retirados->siguiente;
+        motor_suma_destruir(motores_retirados->motor);
+        free(motores_retirados);
+        motores_retirados = siguiente;
+    }
+    pthread_mutex_unlock(&mutex_motor_global);
+}
+
+motor_suma_t* obtener_motor_suma_global(int num_hilos) {
+    if (num_hilos <= 0) {
+        return NULL;
+    }
+    pthread_mutex_lock(&mutex_motor_global);
+    if (motor_global == NULL || motor_global->num_hilos < num_hilos) {
+        int num_cpus = obtener_num_cpus();
+        int tamano = num_hilos > num_cpus ? num_hilos : num_cpus;
+        motor_suma_t* nuevo = motor_suma_crear(tamano);
+        if (nuevo != NULL) {
+            if (motor_global == NULL) {
+                atexit(liberar_motores_globales);
+            } else {
+                motor_retirado_t* retirado = malloc(sizeof(motor_retirado_t));
+                if (retirado == NULL) {
+                    motor_suma_destruir(nuevo);
+                    pthread_mutex_unlock(&mutex_motor_global);
+                    return NULL;
+                }
+                retirado->motor = motor_global;
+                retirado->siguiente = motores_retirados;
+                motores_retirados = retirado;
+            }
+            motor_global = nuevo;
+        }
+    }
+    motor_suma_t* motor = (motor_global != NULL && motor_global->num_hilos >= num_hilos) ? motor_global : NULL;
+    pthread_mutex_unlock(&mutex_motor_global);
+    return motor;
+}
+
+// ==================== TECHO DE ANCHO DE BANDA ====================
+
+typedef struct {
+    const uint64_t* datos;
+    size_t* chunks;
+    uint64_t* resultados;
+} lectura_memoria_t;
+
+// Solo lecturas, con cuatro acumuladores: lo más cerca posible de lo que da
+// la memoria sin depender de ningún kernel de suma
+static void trabajo_lectura_memoria(void* arg, int indice) {
+    lectura_memoria_t* lectura = (lectura_memoria_t*)arg;
+    uint64_t x0 = 0, x1 = 0, x2 = 0, x3 = 0;
+    size_t i = lectura->chunks[indice];
+    size_t fin = lectura->chunks[indice + 1];
+    for (; i + 4 <= fin; i += 4) {
+        x0 ^= lectura->datos[i];
+        x1 ^= lectura->datos[i + 1];
+        x2 ^= lectura->datos[i + 2];
+        x3 ^= lectura->datos[i + 3];
+    }
+    for (; i < fin; i++) {
+        x0 ^= lectura->datos[i];
+    }
+    lectura->resultados[indice] = x0 ^ x1 ^ x2 ^ x3;
+}
+
+double medir_techo_ancho_banda(void) {
+    static pthread_mutex_t mutex_techo = PTHREAD_MUTEX_INITIALIZER;
+    static double techo_gbps = 0.0;
+
+    pthread_mutex_lock(&mutex_techo);
+    if (techo_gbps > 0.0) {
+        pthread_mutex_unlock(&mutex_techo);
+        return techo_gbps;
+    }
+
+    int num_cpus = obtener_num_cpus();
+    if (num_cpus <= 0) num_cpus = 1;
+    motor_suma_t* motor = obtener_motor_suma_global(num_cpus);
+    size_t elementos = TAM_BUFFER_ANCHO_BANDA / sizeof(uint64_t);
+    uint64_t* datos = malloc(TAM_BUFFER_ANCHO_BANDA);
+    size_t* chunks = malloc((size_t)(num_cpus + 1) * sizeof(size_t));
+    uint64_t* resultados = malloc((size_t)num_cpus * sizeof(uint64_t));
+
+    if (motor != NULL && datos != NULL && chunks != NULL && resultados != NULL) {
+        memset(datos, 1, TAM_BUFFER_ANCHO_BANDA);
+        dividir_rango_en_chunks(0, elementos, num_cpus, chunks);
+        lectura_memoria_t lectura = { datos, chunks, resultados };
+
+        uint64_t mejor_us = UINT64_MAX;
+        for (int r = 0; r < REPETICIONES_ANCHO_BANDA; r++) {
+            uint64_t inicio = obtener_tiempo_microsegundos();
+            motor_suma_ejecutar(motor, num_cpus, trabajo_lectura_memoria, &lectura);
+            uint64_t duracion = obtener_tiempo_microsegundos() - inicio;
+            if (duracion > 0 && duracion < mejor_us) mejor_us = duracion;
+        }
+        if (mejor_us != UINT64_MAX) {
+            techo_gbps = (double)TAM_BUFFER_ANCHO_BANDA / (mejor_us * 1e3);
+        }
+    }
+
+    free(datos);
+    free(chunks);
+    free(resultados);
+    double resultado = techo_gbps;
+    pthread_mutex_unlock(&mutex_techo);
+    return resultado;
+}
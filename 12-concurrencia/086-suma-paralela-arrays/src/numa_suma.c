@@ -0,0 +1,525 @@
+#include "../include/numa_suma.h"
+#include "../include/motor_suma.h"
+#include "../include/suma_paralela_arrays.h"
+#include "topologia_cpu.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sched.h>
+#define SUMA_NUMA_LINUX 1
+#endif
+
+// Se puede redefinir al compilar para probar con una topología simulada
+#ifndef RUTA_SYSFS_NODOS
+#define RUTA_SYSFS_NODOS "/sys/devices/system/node"
+#endif
+
+#define REPETICIONES_BENCHMARK_NUMA 5
+
+typedef struct {
+    int num_nodos;
+    int num_cpus[MAX_NODOS_NUMA];
+#ifdef SUMA_NUMA_LINUX
+    cpu_set_t cpus[MAX_NODOS_NUMA];
+#endif
+} topologia_numa_t;
+
+static topologia_numa_t topologia;
+static pthread_once_t topologia_once = PTHREAD_ONCE_INIT;
+
+// ==================== TOPOLOGÍA ====================
+
+#ifdef SUMA_NUMA_LINUX
+typedef struct {
+    int* ids;
+    int num_ids;
+} lista_ids_t;
+
+static void agregar_id_nodo(int id, void* ctx) {
+    lista_ids_t* lista = ctx;
+    if (lista->num_ids < MAX_NODOS_NUMA) {
+        lista->ids[lista->num_ids++] = id;
+    }
+}
+
+static void agregar_cpu(int id, void* ctx) {
+    if (id >= 0 && id < CPU_SETSIZE) {
+        CPU_SET(id, (cpu_set_t*)ctx);
+    }
+}
+
+// Lee una lista de sysfs con el formato "0-3,8-11"
+static bool leer_lista_rangos(const char* ruta, void (*agregar)(int id, void* ctx), void* ctx) {
+    FILE* f = fopen(ruta, "r");
+    if (f == NULL) {
+        return false;
+    }
+    char linea[4096];
+    bool leida = fgets(linea, sizeof(linea), f) != NULL;
+    fclose(f);
+    if (!leida) {
+        return false;
+    }
+
+    char* p = linea;
+    while (*p != '\0' && *p != '\n') {
+        char* fin;
+        long desde = strtol(p, &fin, 10);
+        if (fin == p) {
+            return false;
+        }
+        long hasta = desde;
+        p = fin;
+        if (*p == '-') {
+            hasta = strtol(p + 1, &fin, 10);
+            if (fin == p + 1 || hasta < desde) {
+                return false;
+            }
+            p = fin;
+        }
+        for (long id = desde; id <= hasta; id++) {
+            agregar((int)id, ctx);
+        }
+        if (*p == ',') {
+            p++;
+        }
+    }
+    return true;
+}
+#endif
+
+static void cargar_topologia_numa(void) {
+    topologia.num_nodos = 1;
+    topologia.num_cpus[0] = obtener_num_cpus();
+
+#ifdef SUMA_NUMA_LINUX
+    int ids[MAX_NODOS_NUMA];
+    lista_ids_t lista = { ids, 0 };
+    if (!leer_lista_rangos(RUTA_SYSFS_NODOS "/online", agregar_id_nodo, &lista)) {
+        return;
+    }
+
+    // Los nodos solo de memoria (sin CPUs) no sirven para fijar hilos
+    int num_nodos = 0;
+    for (int i = 0; i < lista.num_ids; i++) {
+        char ruta[256];
+        snprintf(ruta, sizeof(ruta), "%s/node%d/cpulist", RUTA_SYSFS_NODOS, ids[i]);
+        CPU_ZERO(&topologia.cpus[num_nodos]);
+        if (leer_lista_rangos(ruta, agregar_cpu, &topologia.cpus[num_nodos]) &&
+            CPU_COUNT(&topologia.cpus[num_nodos]) > 0) {
+            topologia.num_cpus[num_nodos] = CPU_COUNT(&topologia.cpus[num_nodos]);
+            num_nodos++;
+        }
+    }
+    if (num_nodos > 1) {
+        topologia.num_nodos = num_nodos;
+    } else {
+        topologia.num_cpus[0] = obtener_num_cpus();
+    }
+#endif
+}
+
+int obtener_num_nodos_numa(void) {
+    pthread_once(&topologia_once, cargar_topologia_numa);
+    return topologia.num_nodos;
+}
+
+int obtener_cpus_nodo_numa(int nodo) {
+    if (nodo < 0 || nodo >= obtener_num_nodos_numa()) {
+        return 0;
+    }
+    return topologia.num_cpus[nodo];
+}
+
+int nodo_para_chunk(int indice, int num_hilos) {
+    int num_nodos = obtener_num_nodos_numa();
+    if (num_nodos < 2 || num_hilos <= 0 || indice < 0 || indice >= num_hilos) {
+        return 0;
+    }
+    return (int)((int64_t)indice * num_nodos / num_hilos);
+}
+
+// ==================== AFINIDAD ====================
+
+bool fijar_hilo_a_nodo(int nodo) {
+    if (obtener_num_nodos_numa() < 2 || nodo < 0 || nodo >= topologia.num_nodos) {
+        return false;
+    }
+#ifdef SUMA_NUMA_LINUX
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &topologia.cpus[nodo]) == 0;
+#else
+    return false;
+#endif
+}
+
+#ifdef SUMA_NUMA_LINUX
+typedef cpu_set_t afinidad_hilo_t;
+
+static void guardar_afinidad(afinidad_hilo_t* afinidad) {
+    CPU_ZERO(afinidad);
+    pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), afinidad);
+}
+
+static void restaurar_afinidad(const afinidad_hilo_t* afinidad) {
+    if (CPU_COUNT(afinidad) > 0) {
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), afinidad);
+    }
+}
+#else
+typedef int afinidad_hilo_t;
+
+static void guardar_afinidad(afinidad_hilo_t* afinidad) { *afinidad = 0; }
+static void restaurar_afinidad(const afinidad_hilo_t* afinidad) { (void)afinidad; }
+#endif
+
+void ejecutar_en_nodo_de_chunk(trabajo_motor_t trabajo, void* arg, int indice, int num_hilos) {
+    if (obtener_num_nodos_numa() < 2) {
+        trabajo(arg, indice);
+        return;
+    }
+    // El motor es compartido: cada participante recupera su afinidad al
+    // terminar para no cambiar el comportamiento del resto del programa
+    afinidad_hilo_t original;
+    guardar_afinidad(&original);
+    fijar_hilo_a_nodo(nodo_para_chunk(indice, num_hilos));
+    trabajo(arg, indice);
+    restaurar_afinidad(&original);
+}
+
+// ==================== RESERVA CON FIRST-TOUCH ====================
+
+typedef struct {
+    char* datos;
+    const size_t* chunks;
+    int num_hilos;
+} colocacion_numa_t;
+
+static void tocar_chunk(void* arg, int indice) {
+    colocacion_numa_t* colocacion = arg;
+    size_t inicio = colocacion->chunks[indice];
+    size_t fin = colocacion->chunks[indice + 1];
+    memset(colocacion->datos + inicio * sizeof(int), 0, (fin - inicio) * sizeof(int));
+}
+
+static void trabajo_primer_toque(void* arg, int indice) {
+    colocacion_numa_t* colocacion = arg;
+    ejecutar_en_nodo_de_chunk(tocar_chunk, colocacion, indice, colocacion->num_hilos);
+}
+
+static int* reservar_alineado_a_pagina(size_t bytes) {
+    long pagina = sysconf(_SC_PAGESIZE);
+    size_t alineacion = (pagina > 0) ? (size_t)pagina : 4096;
+    size_t bytes_alineados = (bytes + alineacion - 1) / alineacion * alineacion;
+    return aligned_alloc(alineacion, bytes_alineados);
+}
+
+int* reservar_array_numa(size_t tamano, int num_hilos) {
+    if (tamano == 0 || tamano > SIZE_MAX / sizeof(int)) {
+        return NULL;
+    }
+    size_t bytes = tamano * sizeof(int);
+
+    // Un solo nodo: toda la memoria es igual de cercana
+    if (obtener_num_nodos_numa() < 2 || num_hilos < 2) {
+        return malloc(bytes);
+    }
+    if ((size_t)num_hilos > tamano) {
+        num_hilos = (int)tamano;
+    }
+
+    int* array = reservar_alineado_a_pagina(bytes);
+    if (array == NULL) {
+        return NULL;
+    }
+
+    motor_suma_t* motor = obtener_motor_suma_global(num_hilos);
+    size_t* chunks = malloc((size_t)(num_hilos + 1) * sizeof(size_t));
+    bool colocado = false;
+    if (motor != NULL && chunks != NULL) {
+        dividir_rango_en_chunks(0, tamano, num_hilos, chunks);
+        colocacion_numa_t colocacion = { (char*)array, chunks, num_hilos };
+        colocado = motor_suma_ejecutar(motor, num_hilos, trabajo_primer_toque, &colocacion);
+    }
+    if (!colocado) {
+        // Sin motor el array sigue siendo válido, solo sin colocación por nodo
+        memset(array, 0, bytes);
+    }
+    free(chunks);
+    return array;
+}
+
+// ==================== BENCHMARK LOCAL / REMOTO ====================
+
+typedef struct {
+    const int* array;
+    const size_t* chunks;
+    const int* nodos;             // Nodo de cada participante
+    afinidad_hilo_t* originales;  // Afinidad a restaurar de cada participante
+    int64_t* parciales;
+} suma_numa_t;
+
+static void trabajo_fijar_participante(void* arg, int indice) {
+    suma_numa_t* suma = arg;
+    guardar_afinidad(&suma->originales[indice]);
+    fijar_hilo_a_nodo(suma->nodos[indice]);
+}
+
+static void trabajo_restaurar_participante(void* arg, int indice) {
+    suma_numa_t* suma = arg;
+    restaurar_afinidad(&suma->originales[indice]);
+}
+
+static void trabajo_suma_numa(void* arg, int indice) {
+    suma_numa_t* suma = arg;
+    size_t inicio = suma->chunks[indice];
+    size_t fin = suma->chunks[indice + 1];
+    suma->parciales[indice] = sumar_bloque(suma->array + inicio, fin - inicio);
+}
+
+// Suma el array con cada participante fijado a nodos[i]; devuelve GB/s
+static double medir_colocacion(motor_suma_t* motor, const int* array, size_t tamano,
+                               int num_hilos, const int* nodos, int64_t* suma_total) {
+    *suma_total = 0;
+    size_t* chunks = malloc((size_t)(num_hilos + 1) * sizeof(size_t));
+    afinidad_hilo_t* originales = malloc((size_t)num_hilos * sizeof(afinidad_hilo_t));
+    int64_t* parciales = malloc((size_t)num_hilos * sizeof(int64_t));
+    if (chunks == NULL || originales == NULL || parciales == NULL) {
+        free(chunks);
+        free(originales);
+        free(parciales);
+        return 0.0;
+    }
+
+    dividir_rango_en_chunks(0, tamano, num_hilos, chunks);
+    suma_numa_t suma = { array, chunks, nodos, originales, parciales };
+    motor_suma_ejecutar(motor, num_hilos, trabajo_fijar_participante, &suma);
+
+    uint64_t mejor_us = UINT64_MAX;
+    for (int r = 0; r < REPETICIONES_BENCHMARK_NUMA; r++) {
+        uint64_t inicio = obtener_tiempo_microsegundos();
+        motor_suma_ejecutar(motor, num_hilos, trabajo_suma_numa, &suma);
+        uint64_t duracion = obtener_tiempo_microsegundos() - inicio;
+        if (duracion > 0 && duracion < mejor_us) mejor_us = duracion;
+    }
+
+    for (int i = 0; i < num_hilos; i++) {
+        *suma_total += parciales[i];
+    }
+    motor_suma_ejecutar(motor, num_hilos, trabajo_restaurar_participante, &suma);
+
+    free(chunks);
+    free(originales);
+    free(parciales);
+    return (mejor_us == UINT64_MAX) ? 0.0 : (double)(tamano * sizeof(int)) / (mejor_us * 1e3);
+}
+
+// Array con todas sus páginas en un nodo: lo inicializa el llamante fijado allí
+static int* reservar_array_en_nodo(size_t tamano, int nodo) {
+    int* array = reservar_alineado_a_pagina(tamano * sizeof(int));
+    if (array == NULL) {
+        return NULL;
+    }
+    afinidad_hilo_t original;
+    guardar_afinidad(&original);
+    fijar_hilo_a_nodo(nodo);
+    memset(array, 0, tamano * sizeof(int));
+    restaurar_afinidad(&original);
+    return array;
+}
+
+static void rellenar_array_prueba(int* array, size_t tamano, int64_t* suma_esperada) {
+    *suma_esperada = 0;
+    for (size_t i = 0; i < tamano; i++) {
+        array[i] = (int)(i & 1023);
+        *suma_esperada += array[i];
+    }
+}
+
+bool ejecutar_benchmark_numa(size_t tamano, int num_hilos) {
+    int num_nodos = obtener_num_nodos_numa();
+    printf("\n=== Benchmark NUMA: Memoria Local vs Remota ===\n");
+    if (num_nodos < 2) {
+        printf("Un solo nodo NUMA: toda la memoria es local, no hay nada que comparar.\n");
+        printf("reservar_array_numa equivale a malloc y no se fija la afinidad de ningún hilo.\n");
+        return true;
+    }
+    if (tamano == 0) {
+        return false;
+    }
+
+    if (num_hilos <= 0) {
+        num_hilos = obtener_cpus_nodo_numa(0);
+    }
+    if (num_hilos > obtener_cpus_nodo_numa(1)) {
+        num_hilos = obtener_cpus_nodo_numa(1);
+    }
+    if (num_hilos < 1) {
+        num_hilos = 1;
+    }
+
+    motor_suma_t* motor = obtener_motor_suma_global(num_hilos);
+    int* nodos = malloc((size_t)num_hilos * sizeof(int));
+    int* array_nodo0 = reservar_array_en_nodo(tamano, 0);
+    int* array_repartido = reservar_array_numa(tamano, num_hilos);
+    if (motor == NULL || nodos == NULL || array_nodo0 == NULL || array_repartido == NULL) {
+        free(nodos);
+        free(array_nodo0);
+        free(array_repartido);
+        return false;
+    }
+
+    int64_t suma_esperada;
+    rellenar_array_prueba(array_nodo0, tamano, &suma_esperada);
+    rellenar_array_prueba(array_repartido, tamano, &suma_esperada);
+
+    printf("Nodos: %d", num_nodos);
+    for (int n = 0; n < num_nodos; n++) {
+        printf("%s%d CPUs", (n == 0) ? " (" : ", ", obtener_cpus_nodo_numa(n));
+    }
+    printf(")\nArray: %zu elementos (%.1f MB), %d hilos por prueba\n\n",
+           tamano, tamano * sizeof(int) / (1024.0 * 1024.0), num_hilos);
+    printf("%-44s %10s %s\n", "Colocación", "GB/s", "Suma");
+
+    struct {
+        const char* nombre;
+        const int* array;
+        int nodo_fijo;    // -1 = cada hilo en el nodo de su chunk
+    } pruebas[] = {
+        { "Datos en nodo 0, hilos en nodo 0 (local)", array_nodo0, 0 },
+        { "Datos en nodo 0, hilos en nodo 1 (remoto)", array_nodo0, 1 },
+        { "Datos en nodo 0, hilos repartidos", array_nodo0, -1 },
+        { "First-touch por chunk, hilos repartidos", array_repartido, -1 },
+    };
+
+    bool correcto = true;
+    double gbps[4];
+    for (int p = 0; p < 4; p++) {
+        for (int i = 0; i < num_hilos; i++) {
+            nodos[i] = (pruebas[p].nodo_fijo >= 0) ? pruebas[p].nodo_fijo
+                                                   : nodo_para_chunk(i, num_hilos);
+        }
+        int64_t suma;
+        gbps[p] = medir_colocacion(motor, pruebas[p].array, tamano, num_hilos, nodos, &suma);
+        bool ok = (suma == suma_esperada);
+        correcto = correcto && ok;
+        printf("%-44s %10.2f %s\n", pruebas[p].nombre, gbps[p], ok ? "✓" : "✗");
+    }
+
+    if (gbps[1] > 0.0) {
+        printf("\nPenalización remota: %.2fx más lento que local\n", gbps[0] / gbps[1]);
+    }
+    if (gbps[2] > 0.0) {
+        printf("First-touch frente a inicializar en un solo hilo: %.2fx\n", gbps[3] / gbps[2]);
+    }
+
+    free(nodos);
+    free(array_nodo0);
+    free(array_repartido);
+    return correcto;
+}
+
+// ==================== BENCHMARK DE POLÍTICAS DE AFINIDAD ====================
+
+typedef struct {
+    politica_afinidad_t politica;
+    mascara_cpus_t* originales;   // Afinidad a restaurar de cada participante
+} afinidad_participantes_t;
+
+static void trabajo_fijar_con_politica(void* arg, int indice) {
+    afinidad_participantes_t* afinidad = arg;
+    obtener_afinidad_hilo_actual(&afinidad->originales[indice]);
+    fijar_hilo_actual_con_politica(afinidad->politica, indice);
+}
+
+static void trabajo_restaurar_politica(void* arg, int indice) {
+    afinidad_participantes_t* afinidad = arg;
+    fijar_afinidad_hilo_actual(&afinidad->originales[indice]);
+}
+
+bool ejecutar_benchmark_afinidad(size_t tamano, int num_hilos) {
+    const topologia_cpu_t* topologia = obtener_topologia_cpu();
+    printf("\n=== Benchmark de Políticas de Afinidad ===\n");
+    if (tamano == 0) {
+        return false;
+    }
+    if (num_hilos <= 0) {
+        num_hilos = topologia->num_nucleos;
+    }
+    if (num_hilos < 1) {
+        num_hilos = 1;
+    }
+
+    motor_suma_t* motor = obtener_motor_suma_global(num_hilos);
+    int* array = malloc(tamano * sizeof(int));
+    size_t* chunks = malloc((size_t)(num_hilos + 1) * sizeof(size_t));
+    int64_t* parciales = malloc((size_t)num_hilos * sizeof(int64_t));
+    mascara_cpus_t* originales = malloc((size_t)num_hilos * sizeof(mascara_cpus_t));
+    if (motor == NULL || array == NULL || chunks == NULL || parciales == NULL || originales == NULL) {
+        free(array);
+        free(chunks);
+        free(parciales);
+        free(originales);
+        return false;
+    }
+
+    int64_t suma_esperada;
+    rellenar_array_prueba(array, tamano, &suma_esperada);
+    dividir_rango_en_chunks(0, tamano, num_hilos, chunks);
+
+    printf("CPUs: %d lógicas, %d núcleos, %d dominios L3, %d nodos\n",
+           topologia->num_cpus, topologia->num_nucleos,
+           topologia->num_dominios_l3, topologia->num_nodos);
+    printf("Array: %zu elementos (%.1f MB), %d hilos por prueba\n\n",
+           tamano, tamano * sizeof(int) / (1024.0 * 1024.0), num_hilos);
+    printf("%-11s %-28s %10s %s\n", "Política", "CPUs", "GB/s", "Suma");
+
+    bool correcto = true;
+    for (int p = 0; p < NUM_POLITICAS_AFINIDAD; p++) {
+        politica_afinidad_t politica = (politica_afinidad_t)p;
+        afinidad_participantes_t afinidad = { politica, originales };
+        suma_numa_t suma = { array, chunks, NULL, NULL, parciales };
+
+        motor_suma_ejecutar(motor, num_hilos, trabajo_fijar_con_politica, &afinidad);
+        uint64_t mejor_us = UINT64_MAX;
+        for (int r = 0; r < REPETICIONES_BENCHMARK_NUMA; r++) {
+            uint64_t inicio = obtener_tiempo_microsegundos();
+            motor_suma_ejecutar(motor, num_hilos, trabajo_suma_numa, &suma);
+            uint64_t duracion = obtener_tiempo_microsegundos() - inicio;
+            if (duracion > 0 && duracion < mejor_us) mejor_us = duracion;
+        }
+        motor_suma_ejecutar(motor, num_hilos, trabajo_restaurar_politica, &afinidad);
+
+        int64_t total = 0;
+        for (int i = 0; i < num_hilos; i++) {
+            total += parciales[i];
+        }
+        bool ok = (total == suma_esperada);
+        correcto = correcto && ok;
+
+        char cpus[29] = "-";
+        if (politica != AFINIDAD_NINGUNA) {
+            size_t usado = 0;
+            cpus[0] = '\0';
+            for (int i = 0; i < num_hilos && usado < sizeof(cpus) - 1; i++) {
+                int escrito = snprintf(cpus + usado, sizeof(cpus) - usado, "%s%d",
+                                       (i == 0) ? "" : ",", cpu_para_hilo(topologia, politica, i));
+                if (escrito < 0) break;
+                usado += (size_t)escrito;
+            }
+        }
+        double gbps = (mejor_us == UINT64_MAX) ? 0.0
+                                               : (double)(tamano * sizeof(int)) / (mejor_us * 1e3);
+        printf("%-10s %-28s %10.2f %s\n", nombre_politica_afinidad(politica), cpus, gbps,
+               ok ? "✓" : "✗");
+    }
+
+    free(array);
+    free(chunks);
+    free(parciales);
+    free(originales);
+    return correcto;
+}
@@ -0,0 +1,321 @@
+#include "../include/perfil_hilos.h"
+#include "../include/suma_paralela_arrays.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+// Tamaños calibrados: de 1K a 16M elementos multiplicando por 4
+#define TAMANO_CALIBRACION_MIN ((size_t)1 << 10)
+#define TAMANO_CALIBRACION_MAX ((size_t)1 << 24)
+#define FACTOR_TAMANO_CALIBRACION 4
+// Un número de hilos mayor solo se elige si mejora al menor en más de un 5%
+#define MARGEN_MEJORA_CALIBRACION 0.05
+#define MAX_CONFIGURACIONES_HILOS 64
+// Chunks dinámicos probados con los hilos elegidos (0 = un chunk fijo por hilo)
+#define REPETICIONES_CALIBRACION_CHUNK 5
+static const size_t chunks_candidatos[] = { 0, 4096, 16384, 65536, 262144 };
+#define NUM_CHUNKS_CANDIDATOS (sizeof(chunks_candidatos) / sizeof(chunks_candidatos[0]))
+
+static pthread_mutex_t mutex_perfil = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t carga_perfil_once = PTHREAD_ONCE_INIT;
+static perfil_hilos_t perfil_activo;
+static bool hay_perfil_activo = false;
+
+// ==================== CALIBRACIÓN ====================
+
+// 1, 2, 4, ... hasta max_hilos (incluido aunque no sea potencia de dos)
+static int generar_hilos_candidatos(int max_hilos, int* hilos) {
+    int n = 0;
+    for (int h = 1; h < max_hilos && n < MAX_CONFIGURACIONES_HILOS - 1; h *= 2) {
+        hilos[n++] = h;
+    }
+    hilos[n++] = max_hilos;
+    return n;
+}
+
+static int elegir_num_hilos(const uint64_t* tiempos_us, const int* hilos, int n) {
+    uint64_t mejor_us = UINT64_MAX;
+    for (int i = 0; i < n; i++) {
+        if (tiempos_us[i] < mejor_us) mejor_us = tiempos_us[i];
+    }
+    // El menor número de hilos que queda dentro del margen del mejor tiempo
+    for (int i = 0; i < n; i++) {
+        if (tiempos_us[i] <= mejor_us * (1.0 + MARGEN_MEJORA_CALIBRACION)) {
+            return hilos[i];
+        }
+    }
+    return hilos[n - 1];
+}
+
+// Mejor tiempo de suma_paralela con un chunk dado (UINT64_MAX si falla o si
+// la suma no coincide con la esperada)
+static uint64_t medir_suma_con_chunk(const int* array, size_t tamano, int64_t suma_esperada,
+                                     int num_hilos, size_t tamano_chunk) {
+    configuracion_suma_t config = {
+        .array = array,
+        .tamano = tamano,
+        .num_hilos = num_hilos,
+        .tamano_chunk = tamano_chunk,
+        .mostrar_detalles = false
+    };
+    uint64_t mejor_us = UINT64_MAX;
+    for (int r = 0; r < REPETICIONES_CALIBRACION_CHUNK; r++) {
+        resultado_suma_paralela_t resultado;
+        if (!suma_paralela(&config, &resultado)) {
+            return UINT64_MAX;
+        }
+        bool correcta = (resultado.suma_total == suma_esperada);
+        if (resultado.tiempo_total_us < mejor_us) mejor_us = resultado.tiempo_total_us;
+        limpiar_resultado_suma(&resultado);
+        if (!correcta) {
+            return UINT64_MAX;
+        }
+    }
+    return mejor_us;
+}
+
+// Chunk dinámico que mejora al reparto fijo en más del margen, o 0
+static size_t elegir_tamano_chunk(const int* array, size_t tamano, int64_t suma_esperada,
+                                  int num_hilos, uint64_t tiempo_fijo) {
+    if (num_hilos < 2) {
+        return 0;
+    }
+    uint64_t mejor_us = tiempo_fijo;
+    size_t elegido = 0;
+    for (size_t i = 1; i < NUM_CHUNKS_CANDIDATOS; i++) {
+        // Con menos de dos chunks por hilo suma_paralela usa el reparto fijo
+        if (chunks_candidatos[i] > tamano / ((size_t)num_hilos * 2)) {
+            break;
+        }
+        uint64_t tiempo_us = medir_suma_con_chunk(array, tamano, suma_esperada, num_hilos,
+                                                  chunks_candidatos[i]);
+        if (tiempo_us < mejor_us) {
+            mejor_us = tiempo_us;
+            elegido = chunks_candidatos[i];
+        }
+    }
+    if (tiempo_fijo != UINT64_MAX &&
+        mejor_us * (1.0 + MARGEN_MEJORA_CALIBRACION) >= tiempo_fijo) {
+        return 0;
+    }
+    return elegido;
+}
+
+bool calibrar_perfil_hilos(int max_hilos, perfil_hilos_t* perfil, bool mostrar_detalles) {
+    if (perfil == NULL) {
+        return false;
+    }
+    int num_cpus = obtener_num_cpus();
+    if (num_cpus <= 0) num_cpus = 1;
+    if (max_hilos <= 0) max_hilos = num_cpus;
+    if (max_hilos > MAX_CONFIGURACIONES_HILOS) max_hilos = MAX_CONFIGURACIONES_HILOS;
+
+    int hilos[MAX_CONFIGURACIONES_HILOS];
+    uint64_t tiempos_us[MAX_CONFIGURACIONES_HILOS];
+    int num_configuraciones = generar_hilos_candidatos(max_hilos, hilos);
+
+    memset(perfil, 0, sizeof(*perfil));
+    perfil->num_cpus = num_cpus;
+
+    // Sin colocación por nodo: la calibración suma con todos los candidatos
+    int* array = crear_array_aleatorio(TAMANO_CALIBRACION_MAX, -1000, 1000, 0);
+    if (array == NULL) {
+        return false;
+    }
+
+    if (mostrar_detalles) {
+        printf("\n=== Calibración de Hilos (%d CPUs, kernel %s) ===\n",
+               num_cpus, nombre_kernel_suma(obtener_kernel_suma()));
+        printf("%-10s", "Tamaño");
+        for (int i = 0; i < num_configuraciones; i++) {
+            printf(" %6dh", hilos[i]);
+        }
+        printf("  %-7s %-9s %s\n", "Elegido", "Chunk", "Elem/hilo");
+    }
+
+    int hilos_anteriores = 1;
+    size_t chunk_anterior = 0;
+    for (size_t tamano = TAMANO_CALIBRACION_MIN; tamano <= TAMANO_CALIBRACION_MAX;
+         tamano *= FACTOR_TAMANO_CALIBRACION) {
+        // Los primeros elementos del array grande sirven para todos los tamaños.
+        // Los hilos se barren con reparto fijo: sin forzarlo, suma_paralela
+        // aplicaría el chunk de un perfil ya activo
+        int64_t suma_esperada = suma_secuencial(array, tamano, NULL);
+        for (int i = 0; i < num_configuraciones; i++) {
+            tiempos_us[i] = medir_suma_con_chunk(array, tamano, suma_esperada, hilos[i],
+                                                 TAMANO_CHUNK_FIJO);
+            if (tiempos_us[i] == UINT64_MAX) {
+                free(array);
+                return false;
+            }
+        }
+
+        // Más datos nunca deberían pedir menos hilos: se descarta ese ruido
+        int elegidos = elegir_num_hilos(tiempos_us, hilos, num_configuraciones);
+        if (elegidos < hilos_anteriores) elegidos = hilos_anteriores;
+
+        // Con los hilos elegidos, barrido de chunks dinámicos frente al fijo
+        uint64_t tiempo_fijo = UINT64_MAX;
+        for (int i = 0; i < num_configuraciones; i++) {
+            if (hilos[i] == elegidos) tiempo_fijo = tiempos_us[i];
+        }
+        size_t chunk = elegir_tamano_chunk(array, tamano, suma_esperada, elegidos, tiempo_fijo);
+
+        if (mostrar_detalles) {
+            printf("%-10zu", tamano);
+            for (int i = 0; i < num_configuraciones; i++) {
+                printf(" %7.3f", tiempos_us[i] / 1000.0);
+            }
+            printf("  %-7d %-9zu %zu\n", elegidos, chunk, tamano / (size_t)elegidos);
+        }
+
+        if ((perfil->num_umbrales == 0 || elegidos != hilos_anteriores || chunk != chunk_anterior) &&
+            perfil->num_umbrales < MAX_UMBRALES_PERFIL) {
+            // Por debajo del primer tamaño medido se usa la misma elección
+            size_t desde = (perfil->num_umbrales == 0) ? 0 : tamano;
+            perfil->umbrales[perfil->num_umbrales].tamano_minimo = desde;
+            perfil->umbrales[perfil->num_umbrales].num_hilos = elegidos;
+            perfil->umbrales[perfil->num_umbrales].tamano_chunk = chunk;
+            perfil->num_umbrales++;
+        }
+        hilos_anteriores = elegidos;
+        chunk_anterior = chunk;
+    }
+
+    if (mostrar_detalles) {
+        printf("(tiempos en ms, mejor de varias repeticiones; chunk 0 = uno fijo por hilo)\n");
+    }
+    free(array);
+    return true;
+}
+
+// ==================== FICHERO DE PERFIL ====================
+
+bool guardar_perfil_hilos(const perfil_hilos_t* perfil, const char* ruta) {
+    if (perfil == NULL || ruta == NULL) {
+        return false;
+    }
+    FILE* f = fopen(ruta, "w");
+    if (f == NULL) {
+        return false;
+    }
+    fprintf(f, "# Perfil de suma_paralela generado por calibrar_perfil_hilos\n");
+    fprintf(f, "# umbral <tamaño mínimo> <hilos> <chunk dinámico, 0 = fijo>\n");
+    fprintf(f, "cpus %d\n", perfil->num_cpus);
+    fprintf(f, "kernel %s\n", nombre_kernel_suma(obtener_kernel_suma()));
+    for (int i = 0; i < perfil->num_umbrales; i++) {
+        fprintf(f, "umbral %zu %d %zu\n", perfil->umbrales[i].tamano_minimo,
+                perfil->umbrales[i].num_hilos, perfil->umbrales[i].tamano_chunk);
+    }
+    return fclose(f) == 0;
+}
+
+bool cargar_perfil_hilos(const char* ruta, perfil_hilos_t* perfil) {
+    if (ruta == NULL || perfil == NULL) {
+        return false;
+    }
+    FILE* f = fopen(ruta, "r");
+    if (f == NULL) {
+        return false;
+    }
+
+    perfil_hilos_t leido;
+    memset(&leido, 0, sizeof(leido));
+    char linea[256];
+    bool valido = true;
+
+    while (valido && fgets(linea, sizeof(linea), f) != NULL) {
+        size_t tamano_minimo;
+        size_t tamano_chunk = 0;    // Perfiles sin chunk: reparto fijo
+        int valor;
+        if (linea[0] == '#' || linea[0] == '\n') {
+            continue;
+        } else if (sscanf(linea, "cpus %d", &valor) == 1) {
+            leido.num_cpus = valor;
+        } else if (sscanf(linea, "umbral %zu %d %zu", &tamano_minimo, &valor, &tamano_chunk) >= 2) {
+            int n = leido.num_umbrales;
+            valido = n < MAX_UMBRALES_PERFIL && valor > 0 &&
+                     (n == 0 || tamano_minimo > leido.umbrales[n - 1].tamano_minimo);
+            if (valido) {
+                leido.umbrales[n].tamano_minimo = tamano_minimo;
+                leido.umbrales[n].num_hilos = valor;
+                leido.umbrales[n].tamano_chunk = tamano_chunk;
+                leido.num_umbrales++;
+            }
+        }
+        // Otras claves (kernel) son informativas
+    }
+    fclose(f);
+
+    if (!valido || leido.num_cpus <= 0 || leido.num_umbrales == 0) {
+        return false;
+    }
+    *perfil = leido;
+    return true;
+}
+
+// ==================== PERFIL ACTIVO ====================
+
+static bool instalar_perfil(const perfil_hilos_t* perfil) {
+    if (perfil != NULL && perfil->num_cpus != obtener_num_cpus()) {
+        return false;  // Calibrado en otra máquina
+    }
+    pthread_mutex_lock(&mutex_perfil);
+    if (perfil != NULL) {
+        perfil_activo = *perfil;
+    }
+    hay_perfil_activo = (perfil != NULL);
+    pthread_mutex_unlock(&mutex_perfil);
+    return true;
+}
+
+static void cargar_perfil_inicial(void) {
+    const char* ruta = getenv(VARIABLE_ENTORNO_PERFIL);
+    perfil_hilos_t perfil;
+    if (cargar_perfil_hilos(ruta != NULL ? ruta : RUTA_PERFIL_HILOS_DEFECTO, &perfil)) {
+        instalar_perfil(&perfil);
+    }
+}
+
+bool activar_perfil_hilos(const perfil_hilos_t* perfil) {
+    // Primero la carga inicial, para que no pise después a este perfil
+    pthread_once(&carga_perfil_once, cargar_perfil_inicial);
+    return instalar_perfil(perfil);
+}
+
+bool consultar_perfil_hilos(size_t tamano_array, int* num_hilos, size_t* tamano_chunk) {
+    if (num_hilos == NULL) {
+        return false;
+    }
+    pthread_once(&carga_perfil_once, cargar_perfil_inicial);
+
+    pthread_mutex_lock(&mutex_perfil);
+    bool encontrado = false;
+    if (hay_perfil_activo) {
+        for (int i = perfil_activo.num_umbrales - 1; i >= 0; i--) {
+            if (tamano_array >= perfil_activo.umbrales[i].tamano_minimo) {
+                *num_hilos = perfil_activo.umbrales[i].num_hilos;
+                if (tamano_chunk != NULL) {
+                    *tamano_chunk = perfil_activo.umbrales[i].tamano_chunk;
+                }
+                encontrado = true;
+                break;
+            }
+        }
+    }
+    pthread_mutex_unlock(&mutex_perfil);
+    return encontrado;
+}
+
+void imprimir_perfil_hilos(const perfil_hilos_t* perfil) {
+    if (perfil == NULL) {
+        return;
+    }
+    printf("\n=== Perfil de Hilos (%d CPUs) ===\n", perfil->num_cpus);
+    printf("%-18s %-8s %s\n", "Desde (elementos)", "Hilos", "Chunk");
+    for (int i = 0; i < perfil->num_umbrales; i++) {
+        printf("%-18zu %-8d %zu\n", perfil->umbrales[i].tamano_minimo,
+               perfil->umbrales[i].num_hilos, perfil->umbrales[i].tamano_chunk);
+    }
+}
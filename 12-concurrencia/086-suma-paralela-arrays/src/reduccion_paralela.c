@@ -0,0 +1,383 @@
+#include "../include/reduccion_paralela.h"
+#include "../include/suma_paralela_arrays.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+
+#define TAM_LINEA_CACHE 64
+// 4096 enteros = 16 KB: la tesela cabe en L1 mientras la recorren todas las
+// reducciones fusionadas
+#define TAM_TESELA_REDUCCION 4096
+#define REPETICIONES_BENCHMARK 5
+#define MAX_DESCRIPTORES_ESTADISTICAS 5
+
+static size_t alinear_linea(size_t n) {
+    return (n + TAM_LINEA_CACHE - 1) & ~(size_t)(TAM_LINEA_CACHE - 1);
+}
+
+// ==================== REDUCCIONES PREDEFINIDAS ====================
+
+static void suma_identidad(void* acum, const void* contexto) {
+    (void)contexto;
+    *(int64_t*)acum = 0;
+}
+
+static void suma_procesar(void* acum, const int* datos, size_t n, const void* contexto) {
+    (void)contexto;
+    *(int64_t*)acum += sumar_bloque(datos, n);
+}
+
+static void suma_combinar(void* destino, const void* origen, const void* contexto) {
+    (void)contexto;
+    *(int64_t*)destino += *(const int64_t*)origen;
+}
+
+descriptor_reduccion_t reduccion_suma(void) {
+    descriptor_reduccion_t d = { "suma", sizeof(int64_t), suma_identidad, suma_procesar, suma_combinar, NULL };
+    return d;
+}
+
+static void minimo_identidad(void* acum, const void* contexto) {
+    (void)contexto;
+    *(int*)acum = INT_MAX;
+}
+
+static void minimo_procesar(void* acum, const int* datos, size_t n, const void* contexto) {
+    (void)contexto;
+    int minimo = *(int*)acum;
+    for (size_t i = 0; i < n; i++) {
+        minimo = datos[i] < minimo ? datos[i] : minimo;
+    }
+    *(int*)acum = minimo;
+}
+
+static void minimo_combinar(void* destino, const void* origen, const void* contexto) {
+    minimo_procesar(destino, (const int*)origen, 1, contexto);
+}
+
+descriptor_reduccion_t reduccion_minimo(void) {
+    descriptor_reduccion_t d = { "mínimo", sizeof(int), minimo_identidad, minimo_procesar, minimo_combinar, NULL };
+    return d;
+}
+
+static void maximo_identidad(void* acum, const void* contexto) {
+    (void)contexto;
+    *(int*)acum = INT_MIN;
+}
+
+static void maximo_procesar(void* acum, const int* datos, size_t n, const void* contexto) {
+    (void)contexto;
+    int maximo = *(int*)acum;
+    for (size_t i = 0; i < n; i++) {
+        maximo = datos[i] > maximo ? datos[i] : maximo;
+    }
+    *(int*)acum = maximo;
+}
+
+static void maximo_combinar(void* destino, const void* origen, const void* contexto) {
+    maximo_procesar(destino, (const int*)origen, 1, contexto);
+}
+
+descriptor_reduccion_t reduccion_maximo(void) {
+    descriptor_reduccion_t d = { "máximo", sizeof(int), maximo_identidad, maximo_procesar, maximo_combinar, NULL };
+    return d;
+}
+
+static void momentos_identidad(void* acum, const void* contexto) {
+    (void)contexto;
+    memset(acum, 0, sizeof(acumulador_momentos_t));
+}
+
+static void momentos_combinar(void* destino, const void* origen, const void* contexto) {
+    (void)contexto;
+    acumulador_momentos_t* a = (acumulador_momentos_t*)destino;
+    const acumulador_momentos_t* b = (const acumulador_momentos_t*)origen;
+    if (b->n == 0) return;
+    if (a->n == 0) {
+        *a = *b;
+        return;
+    }
+    double n = (double)(a->n + b->n);
+    double delta = b->media - a->media;
+    a->media += delta * (double)b->n / n;
+    a->m2 += b->m2 + delta * delta * (double)a->n * (double)b->n / n;
+    a->n += b->n;
+}
+
+// Media y desviaciones del bloque en dos recorridos (el bloque está en L1)
+// y luego se combina con el acumulador: más preciso que sumar cuadrados
+static void momentos_procesar(void* acum, const int* datos, size_t n, const void* contexto) {
+    if (n == 0) return;
+    acumulador_momentos_t bloque;
+    bloque.n = n;
+    bloque.media = (double)sumar_bloque(datos, n) / (double)n;
+    bloque.m2 = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        double desviacion = (double)datos[i] - bloque.media;
+        bloque.m2 += desviacion * desviacion;
+    }
+    momentos_combinar(acum, &bloque, contexto);
+}
+
+descriptor_reduccion_t reduccion_momentos(void) {
+    descriptor_reduccion_t d = { "momentos", sizeof(acumulador_momentos_t),
+                                 momentos_identidad, momentos_procesar, momentos_combinar, NULL };
+    return d;
+}
+
+static void histograma_identidad(void* acum, const void* contexto) {
+    const config_histograma_t* config = (const config_histograma_t*)contexto;
+    memset(acum, 0, (size_t)config->num_cubetas * sizeof(uint64_t));
+}
+
+static void histograma_procesar(void* acum, const int* datos, size_t n, const void* contexto) {
+    const config_histograma_t* config = (const config_histograma_t*)contexto;
+    uint64_t* cubetas = (uint64_t*)acum;
+    int64_t ancho = (int64_t)config->maximo - config->minimo + 1;
+    for (size_t i = 0; i < n; i++) {
+        int64_t desplazamiento = (int64_t)datos[i] - config->minimo;
+        if (desplazamiento < 0) desplazamiento = 0;
+        if (desplazamiento >= ancho) desplazamiento = ancho - 1;
+        cubetas[desplazamiento * config->num_cubetas / ancho]++;
+    }
+}
+
+static void histograma_combinar(void* destino, const void* origen, const void* contexto) {
+    const config_histograma_t* config = (const config_histograma_t*)contexto;
+    uint64_t* a = (uint64_t*)destino;
+    const uint64_t* b = (const uint64_t*)origen;
+    for (int i = 0; i < config->num_cubetas; i++) {
+        a[i] += b[i];
+    }
+}
+
+descriptor_reduccion_t reduccion_histograma(const config_histograma_t* config) {
+    descriptor_reduccion_t d = { "histograma", 0, histograma_identidad, histograma_procesar,
+                                 histograma_combinar, config };
+    if (config != NULL && config->num_cubetas > 0 && config->minimo <= config->maximo) {
+        d.tam_acumulador = (size_t)config->num_cubetas * sizeof(uint64_t);
+    }
+    return d;
+}
+
+// ==================== EJECUCIÓN ====================
+
+typedef struct {
+    const int* array;
+    const size_t* chunks;
+    const descriptor_reduccion_t* descriptores;
+    int num_descriptores;
+    const size_t* desplazamientos;  // Posición de cada acumulador dentro del hilo
+    size_t paso;                    // Bytes de acumuladores por hilo (múltiplo de 64)
+    uint8_t* acumuladores;
+} tarea_reduccion_t;
+
+static void trabajo_reduccion(void* arg, int indice) {
+    const tarea_reduccion_t* tarea = (const tarea_reduccion_t*)arg;
+    uint8_t* base = tarea->acumuladores + (size_t)indice * tarea->paso;
+
+    for (int d = 0; d < tarea->num_descriptores; d++) {
+        tarea->descriptores[d].identidad(base + tarea->desplazamientos[d], tarea->descriptores[d].contexto);
+    }
+
+    size_t fin = tarea->chunks[indice + 1];
+    for (size_t i = tarea->chunks[indice]; i < fin; i += TAM_TESELA_REDUCCION) {
+        size_t n = (fin - i < TAM_TESELA_REDUCCION) ? fin - i : TAM_TESELA_REDUCCION;
+        for (int d = 0; d < tarea->num_descriptores; d++) {
+            tarea->descriptores[d].procesar_bloque(base + tarea->desplazamientos[d], tarea->array + i, n,
+                                                   tarea->descriptores[d].contexto);
+        }
+    }
+}
+
+bool reduccion_paralela(const int* array, size_t tamano, int num_hilos,
+                        const descriptor_reduccion_t* descriptores, int num_descriptores,
+                        void* const* resultados) {
+    if (array == NULL || tamano == 0 || num_hilos <= 0 || descriptores == NULL ||
+        num_descriptores <= 0 || resultados == NULL) {
+        return false;
+    }
+    for (int d = 0; d < num_descriptores; d++) {
+        if (descriptores[d].tam_acumulador == 0 || descriptores[d].identidad == NULL ||
+            descriptores[d].procesar_bloque == NULL || descriptores[d].combinar == NULL ||
+            resultados[d] == NULL) {
+            return false;
+        }
+    }
+
+    int num_hilos_efectivo = (num_hilos > (int)tamano) ? (int)tamano : num_hilos;
+    motor_suma_t* motor = obtener_motor_suma_global(num_hilos_efectivo);
+    if (motor == NULL) {
+        return false;
+    }
+
+    // Acumuladores de cada hilo en sus propias líneas de caché
+    size_t* desplazamientos = malloc((size_t)num_descriptores * sizeof(size_t));
+    size_t* chunks = malloc((size_t)(num_hilos_efectivo + 1) * sizeof(size_t));
+    size_t paso = 0;
+    for (int d = 0; d < num_descriptores && desplazamientos != NULL; d++) {
+        desplazamientos[d] = paso;
+        paso += alinear_linea(descriptores[d].tam_acumulador);
+    }
+    uint8_t* acumuladores = aligned_alloc(TAM_LINEA_CACHE, paso * (size_t)num_hilos_efectivo);
+    if (desplazamientos == NULL || chunks == NULL || acumuladores == NULL) {
+        free(desplazamientos);
+        free(chunks);
+        free(acumuladores);
+        return false;
+    }
+
+    dividir_rango_en_chunks(0, tamano, num_hilos_efectivo, chunks);
+    tarea_reduccion_t tarea = {
+        .array = array,
+        .chunks = chunks,
+        .descriptores = descriptores,
+        .num_descriptores = num_descriptores,
+        .desplazamientos = desplazamientos,
+        .paso = paso,
+        .acumuladores = acumuladores
+    };
+    bool exito = motor_suma_ejecutar(motor, num_hilos_efectivo, trabajo_reduccion, &tarea);
+
+    // Combinar en orden de chunk: el resultado no depende de la planificación
+    for (int d = 0; exito && d < num_descriptores; d++) {
+        descriptores[d].identidad(resultados[d], descriptores[d].contexto);
+        for (int h = 0; h < num_hilos_efectivo; h++) {
+            descriptores[d].combinar(resultados[d], acumuladores + (size_t)h * paso + desplazamientos[d],
+                                     descriptores[d].contexto);
+        }
+    }
+
+    free(desplazamientos);
+    free(chunks);
+    free(acumuladores);
+    return exito;
+}
+
+// ==================== ESTADÍSTICAS FUSIONADAS ====================
+
+bool calcular_estadisticas_paralelas(const int* array, size_t tamano, int num_hilos,
+                                     estadisticas_array_t* estadisticas) {
+    if (estadisticas == NULL) {
+        return false;
+    }
+
+    int64_t suma;
+    int minimo, maximo;
+    acumulador_momentos_t momentos;
+    descriptor_reduccion_t descriptores[MAX_DESCRIPTORES_ESTADISTICAS] = {
+        reduccion_suma(), reduccion_minimo(), reduccion_maximo(), reduccion_momentos()
+    };
+    void* resultados[MAX_DESCRIPTORES_ESTADISTICAS] = { &suma, &minimo, &maximo, &momentos };
+    int num_descriptores = 4;
+
+    if (estadisticas->histograma != NULL) {
+        descriptores[num_descriptores] = reduccion_histograma(&estadisticas->config_histograma);
+        resultados[num_descriptores] = estadisticas->histograma;
+        num_descriptores++;
+    }
+
+    if (!reduccion_paralela(array, tamano, num_hilos, descriptores, num_descriptores, resultados)) {
+        return false;
+    }
+
+    estadisticas->suma = suma;
+    estadisticas->minimo = minimo;
+    estadisticas->maximo = maximo;
+    estadisticas->media = momentos.media;
+    estadisticas->varianza = momentos.n > 0 ? momentos.m2 / (double)momentos.n : 0.0;
+    return true;
+}
+
+// ==================== BENCHMARK ====================
+
+#define CUBETAS_BENCHMARK 16
+
+static bool estadisticas_iguales(const estadisticas_array_t* a, const estadisticas_array_t* b) {
+    if (a->suma != b->suma || a->minimo != b->minimo || a->maximo != b->maximo) return false;
+    if (fabs(a->media - b->media) > 1e-9 * (1.0 + fabs(a->media))) return false;
+    if (fabs(a->varianza - b->varianza) > 1e-9 * (1.0 + fabs(a->varianza))) return false;
+    return memcmp(a->histograma, b->histograma, CUBETAS_BENCHMARK * sizeof(uint64_t)) == 0;
+}
+
+// Una reducción por pasada: cada estadística vuelve a leer todo el array
+static bool estadisticas_por_pasadas(const int* array, size_t tamano, int num_hilos,
+                                     estadisticas_array_t* e) {
+    acumulador_momentos_t momentos;
+    descriptor_reduccion_t suma = reduccion_suma(), minimo = reduccion_minimo(),
+                           maximo = reduccion_maximo(), mom = reduccion_momentos(),
+                           histograma = reduccion_histograma(&e->config_histograma);
+    void* r_suma[] = { &e->suma };
+    void* r_minimo[] = { &e->minimo };
+    void* r_maximo[] = { &e->maximo };
+    void* r_momentos[] = { &momentos };
+    void* r_histograma[] = { e->histograma };
+
+    bool exito = reduccion_paralela(array, tamano, num_hilos, &suma, 1, r_suma) &&
+                 reduccion_paralela(array, tamano, num_hilos, &minimo, 1, r_minimo) &&
+                 reduccion_paralela(array, tamano, num_hilos, &maximo, 1, r_maximo) &&
+                 reduccion_paralela(array, tamano, num_hilos, &mom, 1, r_momentos) &&
+                 reduccion_paralela(array, tamano, num_hilos, &histograma, 1, r_histograma);
+    e->media = momentos.media;
+    e->varianza = momentos.n > 0 ? momentos.m2 / (double)momentos.n : 0.0;
+    return exito;
+}
+
+bool ejecutar_benchmark_estadisticas(const int* array, size_t tamano, int num_hilos) {
+    if (array == NULL || tamano == 0 || num_hilos <= 0) {
+        return false;
+    }
+
+    int minimo, maximo;
+    double promedio;
+    calcular_estadisticas_array(array, tamano, &minimo, &maximo, &promedio);
+
+    uint64_t histogramas[3][CUBETAS_BENCHMARK];
+    estadisticas_array_t resultados[3];
+    const char* nombres[3] = { "5 pasadas separadas", "Fusionada (1 hilo)", "Fusionada" };
+    int hilos[3] = { num_hilos, 1, num_hilos };
+    uint64_t mejores_us[3];
+    bool correcto = true;
+
+    printf("\n=== Benchmark de Estadísticas (%zu elementos, %d hilos) ===\n", tamano, num_hilos);
+    printf("%-22s %-6s %-12s %-10s\n", "Versión", "Hilos", "Tiempo(ms)", "ns/elem");
+
+    for (int v = 0; v < 3; v++) {
+        mejores_us[v] = UINT64_MAX;
+        for (int r = 0; r < REPETICIONES_BENCHMARK; r++) {
+            estadisticas_array_t* e = &resultados[v];
+            memset(e, 0, sizeof(*e));
+            e->histograma = histogramas[v];
+            e->config_histograma = (config_histograma_t){ minimo, maximo, CUBETAS_BENCHMARK };
+
+            uint64_t inicio = obtener_tiempo_microsegundos();
+            bool exito = (v == 0) ? estadisticas_por_pasadas(array, tamano, hilos[v], e)
+                                  : calcular_estadisticas_paralelas(array, tamano, hilos[v], e);
+            uint64_t duracion = obtener_tiempo_microsegundos() - inicio;
+            if (!exito) return false;
+            if (duracion == 0) duracion = 1;
+            if (duracion < mejores_us[v]) mejores_us[v] = duracion;
+        }
+        // Por elemento de entrada y no en GB/s: la pasada fusionada está
+        // limitada por el cálculo de momentos, no por la memoria
+        printf("%-22s %-6d %-12.3f %-10.3f\n", nombres[v], hilos[v],
+               mejores_us[v] / 1000.0, mejores_us[v] * 1e3 / (double)tamano);
+        if (v > 0 && !estadisticas_iguales(&resultados[0], &resultados[v])) {
+            correcto = false;
+        }
+    }
+
+    const estadisticas_array_t* e = &resultados[2];
+    printf("\nSuma: %" PRId64 "  Mín: %d  Máx: %d  Media: %.3f  Varianza: %.3f\n",
+           e->suma, e->minimo, e->maximo, e->media, e->varianza);
+    printf("Histograma (%d cubetas):", CUBETAS_BENCHMARK);
+    for (int i = 0; i < CUBETAS_BENCHMARK; i++) {
+        printf(" %" PRIu64, e->histograma[i]);
+    }
+    printf("\nFusionada vs pasadas separadas: %.2fx\n", (double)mejores_us[0] / mejores_us[2]);
+    printf("Correctitud: %s\n", correcto ? "✓ CORRECTO" : "✗ ERROR");
+    return correcto;
+}
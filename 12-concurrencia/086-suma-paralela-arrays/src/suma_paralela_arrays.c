@@ -1,4 +1,8 @@
 #include "../include/suma_paralela_arrays.h"
+#include "../include/reduccion_paralela.h"
+#include "../include/perfil_hilos.h"
+#include "../include/numa_suma.h"
+#include <inttypes.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -8,6 +12,9 @@
 #include <math.h>
 #include <errno.h>
 
+// Repeticiones de cada medición del benchmark (se toma la más rápida)
+#define REPETICIONES_BENCHMARK 5
+
 // Implementación de funciones básicas
 
 void* hilo_suma_parcial(void* arg) {
@@ -19,11 +26,8 @@ void* hilo_suma_parcial(void* arg) {
     // Registrar tiempo de inicio
     params->tiempo_inicio = obtener_tiempo_microsegundos();
     
-    // Calcular suma parcial
-    params->resultado = 0;
-    for (size_t i = params->inicio; i < params->fin; i++) {
-        params->resultado += params->array[i];
-    }
+    // Calcular suma parcial con el kernel vectorial activo
+    params->resultado = sumar_bloque(params->array + params->inicio, params->fin - params->inicio);
     
     // Registrar tiempo de fin
     params->tiempo_fin = obtener_tiempo_microsegundos();
@@ -34,34 +38,102 @@ void* hilo_suma_parcial(void* arg) {
     return NULL;
 }
 
+// Trabajo del motor: cada participante suma su parte
+static void trabajo_suma_parcial(void* arg, int indice) {
+    parametros_suma_t* partes = (parametros_suma_t*)arg;
+    hilo_suma_parcial(&partes[indice]);
+}
+
+typedef struct {
+    parametros_suma_t* partes;
+    int num_hilos;
+} reparto_fijo_t;
+
+// Cada participante suma fijado al nodo NUMA donde reservar_array_numa
+// colocó su chunk (sin efecto con un solo nodo)
+static void trabajo_suma_en_nodo(void* arg, int indice) {
+    reparto_fijo_t* reparto = arg;
+    ejecutar_en_nodo_de_chunk(trabajo_suma_parcial, reparto->partes, indice, reparto->num_hilos);
+}
+
+typedef struct {
+    const int* array;
+    size_t tamano;
+    size_t tamano_chunk;
+    size_t siguiente;           // Inicio del próximo chunk libre (atómico)
+    parametros_suma_t* partes;
+} reparto_dinamico_t;
+
+// Trabajo del motor con reparto dinámico: cada participante toma chunks
+// hasta que no quedan, así un hilo lento no retrasa a los demás
+static void trabajo_suma_dinamica(void* arg, int indice) {
+    reparto_dinamico_t* reparto = arg;
+    parametros_suma_t* parte = &reparto->partes[indice];
+    parte->tiempo_inicio = obtener_tiempo_microsegundos();
+    
+    for (;;) {
+        size_t inicio = __atomic_fetch_add(&reparto->siguiente, reparto->tamano_chunk,
+                                           __ATOMIC_RELAXED);
+        if (inicio >= reparto->tamano) {
+            break;
+        }
+        size_t n = reparto->tamano - inicio;
+        if (n > reparto->tamano_chunk) {
+            n = reparto->tamano_chunk;
+        }
+        parte->resultado += sumar_bloque(reparto->array + inicio, n);
+        parte->num_chunks++;
+    }
+    
+    parte->tiempo_fin = obtener_tiempo_microsegundos();
+    if (parte->tiempo_fin <= parte->tiempo_inicio) {
+        parte->tiempo_fin = parte->tiempo_inicio + 1;
+    }
+}
+
 bool suma_paralela(const configuracion_suma_t* config, resultado_suma_paralela_t* resultado) {
     if (config == NULL || resultado == NULL || config->array == NULL || 
-        config->tamano == 0 || config->num_hilos <= 0) {
+        config->tamano == 0 || config->num_hilos < 0) {
         return false;
     }
     
+    // 0 hilos: dejar que decida el perfil de la máquina
+    int num_hilos = (config->num_hilos == 0) ? calcular_num_hilos_optimo(config->tamano)
+                                             : config->num_hilos;
+    
     // Ajustar número de hilos si es mayor que el tamaño del array
-    int num_hilos_efectivo = (config->num_hilos > (int)config->tamano) ? 
-                             (int)config->tamano : config->num_hilos;
+    int num_hilos_efectivo = (num_hilos > (int)config->tamano) ? 
+                             (int)config->tamano : num_hilos;
+    
+    // Chunk 0: el del perfil, si se calibró para estos mismos hilos
+    size_t tamano_chunk = config->tamano_chunk;
+    if (tamano_chunk == 0) {
+        tamano_chunk = calcular_tamano_chunk_optimo(config->tamano, num_hilos_efectivo);
+    }
+    
+    // Un chunk que no deja al menos dos por hilo es el reparto fijo
+    if (tamano_chunk > 0 &&
+        tamano_chunk > config->tamano / ((size_t)num_hilos_efectivo * 2)) {
+        tamano_chunk = 0;
+    }
     
     // Inicializar resultado
     if (!inicializar_resultado_suma(resultado, num_hilos_efectivo)) {
         return false;
     }
     
-    uint64_t tiempo_inicio = obtener_tiempo_microsegundos();
-    
-    // Crear hilos
-    pthread_t* hilos = malloc(num_hilos_efectivo * sizeof(pthread_t));
-    if (hilos == NULL) {
+    // Hilos persistentes: solo se crean en la primera llamada
+    motor_suma_t* motor = obtener_motor_suma_global(num_hilos_efectivo);
+    if (motor == NULL) {
         limpiar_resultado_suma(resultado);
         return false;
     }
     
+    uint64_t tiempo_inicio = obtener_tiempo_microsegundos();
+    
     // Dividir trabajo entre hilos
     size_t* chunks = malloc((num_hilos_efectivo + 1) * sizeof(size_t));
     if (chunks == NULL) {
-        free(hilos);
         limpiar_resultado_suma(resultado);
         return false;
     }
@@ -71,32 +143,26 @@ bool suma_paralela(const configuracion_suma_t* config, resultado_suma_paralela_t
     // Configurar parámetros para cada hilo
     for (int i = 0; i < num_hilos_efectivo; i++) {
         resultado->resultados_hilos[i].array = config->array;
-        resultado->resultados_hilos[i].inicio = chunks[i];
-        resultado->resultados_hilos[i].fin = chunks[i + 1];
+        // Con reparto dinámico el rango fijo no se usa: solo cuenta chunks
+        resultado->resultados_hilos[i].inicio = (tamano_chunk == 0) ? chunks[i] : 0;
+        resultado->resultados_hilos[i].fin = (tamano_chunk == 0) ? chunks[i + 1] : 0;
         resultado->resultados_hilos[i].id_hilo = i;
         resultado->resultados_hilos[i].resultado = 0;
     }
     
-    // Crear hilos
-    for (int i = 0; i < num_hilos_efectivo; i++) {
-        int resultado_create = pthread_create(&hilos[i], NULL, hilo_suma_parcial, 
-                                            &resultado->resultados_hilos[i]);
-        if (resultado_create != 0) {
-            fprintf(stderr, "Error creando hilo %d: %s\n", i, strerror(resultado_create));
-            // Esperar hilos ya creados
-            for (int j = 0; j < i; j++) {
-                pthread_join(hilos[j], NULL);
-            }
-            free(hilos);
-            free(chunks);
-            limpiar_resultado_suma(resultado);
-            return false;
-        }
-    }
-    
-    // Esperar a que terminen todos los hilos
-    for (int i = 0; i < num_hilos_efectivo; i++) {
-        pthread_join(hilos[i], NULL);
+    // Repartir las partes entre los hilos del motor y esperar a todos
+    reparto_dinamico_t reparto = {
+        config->array, config->tamano, tamano_chunk, 0, resultado->resultados_hilos
+    };
+    reparto_fijo_t reparto_fijo = { resultado->resultados_hilos, num_hilos_efectivo };
+    bool ejecutado = (tamano_chunk > 0)
+        ? motor_suma_ejecutar(motor, num_hilos_efectivo, trabajo_suma_dinamica, &reparto)
+        : motor_suma_ejecutar(motor, num_hilos_efectivo, trabajo_suma_en_nodo, &reparto_fijo);
+    if (!ejecutado) {
+        fprintf(stderr, "Error ejecutando la suma en el motor de hilos\n");
+        free(chunks);
+        limpiar_resultado_suma(resultado);
+        return false;
     }
     
     uint64_t tiempo_fin = obtener_tiempo_microsegundos();
@@ -116,8 +182,16 @@ bool suma_paralela(const configuracion_suma_t* config, resultado_suma_paralela_t
         printf("Hilos utilizados: %d\n", num_hilos_efectivo);
         printf("Tamaño del array: %zu\n", config->tamano);
         
-        for (int i = 0; i < num_hilos_efectivo; i++) {
-            printf("Hilo %d: rango [%zu, %zu), suma=%ld, tiempo=%lu us\n",
+        for (int i = 0; i < num_hilos_efectivo && tamano_chunk > 0; i++) {
+            printf("Hilo %d: %zu chunks de %zu, suma=%" PRId64 ", tiempo=%" PRIu64 " us\n",
+                   resultado->resultados_hilos[i].id_hilo,
+                   resultado->resultados_hilos[i].num_chunks, tamano_chunk,
+                   resultado->resultados_hilos[i].resultado,
+                   resultado->resultados_hilos[i].tiempo_fin - 
+                   resultado->resultados_hilos[i].tiempo_inicio);
+        }
+        for (int i = 0; i < num_hilos_efectivo && tamano_chunk == 0; i++) {
+            printf("Hilo %d: rango [%zu, %zu), suma=%" PRId64 ", tiempo=%" PRIu64 " us\n",
                    resultado->resultados_hilos[i].id_hilo,
                    resultado->resultados_hilos[i].inicio,
                    resultado->resultados_hilos[i].fin,
@@ -127,7 +201,6 @@ bool suma_paralela(const configuracion_suma_t* config, resultado_suma_paralela_t
         }
     }
     
-    free(hilos);
     free(chunks);
     return true;
 }
@@ -186,12 +259,13 @@ void limpiar_resultado_suma(resultado_suma_paralela_t* resultado) {
 
 // Funciones de creación de arrays
 
-int* crear_array_aleatorio(size_t tamano, int valor_min, int valor_max) {
+int* crear_array_aleatorio(size_t tamano, int valor_min, int valor_max, int num_hilos) {
     if (tamano == 0 || valor_min > valor_max) {
         return NULL;
     }
     
-    int* array = malloc(tamano * sizeof(int));
+    // Cada página queda en el nodo NUMA del hilo que sumará su chunk
+    int* array = reservar_array_numa(tamano, num_hilos);
     if (array == NULL) {
         return NULL;
     }
@@ -211,12 +285,12 @@ int* crear_array_aleatorio(size_t tamano, int valor_min, int valor_max) {
     return array;
 }
 
-int* crear_array_secuencia(size_t tamano, int inicio, int incremento) {
+int* crear_array_secuencia(size_t tamano, int inicio, int incremento, int num_hilos) {
     if (tamano == 0) {
         return NULL;
     }
     
-    int* array = malloc(tamano * sizeof(int));
+    int* array = reservar_array_numa(tamano, num_hilos);
     if (array == NULL) {
         return NULL;
     }
@@ -234,6 +308,21 @@ bool verificar_sumas_iguales(int64_t suma1, int64_t suma2) {
 
 // Funciones de benchmark
 
+// Referencia de un hilo con el kernel activo (la mejor de varias repeticiones),
+// para que el speedup mida solo el reparto entre hilos y no la ganancia SIMD
+static int64_t medir_secuencial_kernel(const int* array, size_t tamano, uint64_t* tiempo_us) {
+    int64_t suma = 0;
+    *tiempo_us = UINT64_MAX;
+    for (int r = 0; r < REPETICIONES_BENCHMARK; r++) {
+        uint64_t inicio = obtener_tiempo_microsegundos();
+        suma = sumar_bloque(array, tamano);
+        uint64_t duracion = obtener_tiempo_microsegundos() - inicio;
+        if (duracion == 0) duracion = 1;
+        if (duracion < *tiempo_us) *tiempo_us = duracion;
+    }
+    return suma;
+}
+
 bool ejecutar_benchmark_suma(const int* array, size_t tamano, int num_hilos, 
                             benchmark_suma_t* benchmark) {
     if (array == NULL || tamano == 0 || num_hilos <= 0 || benchmark == NULL) {
@@ -243,12 +332,23 @@ bool ejecutar_benchmark_suma(const int* array, size_t tamano, int num_hilos,
     memset(benchmark, 0, sizeof(benchmark_suma_t));
     benchmark->num_hilos = num_hilos;
     benchmark->tamano_array = tamano;
+    benchmark->kernel = obtener_kernel_suma();
+    
+    // Bucle escalar (la mejor de varias repeticiones): referencia de
+    // correctitud y de la ganancia SIMD
+    benchmark->tiempo_escalar_us = UINT64_MAX;
+    for (int r = 0; r < REPETICIONES_BENCHMARK; r++) {
+        uint64_t tiempo_us;
+        benchmark->suma_secuencial = suma_secuencial(array, tamano, &tiempo_us);
+        if (tiempo_us < benchmark->tiempo_escalar_us) {
+            benchmark->tiempo_escalar_us = tiempo_us;
+        }
+    }
     
-    // Suma secuencial
-    benchmark->suma_secuencial = suma_secuencial(array, tamano, 
-                                                &benchmark->tiempo_secuencial_us);
+    // Secuencial con el mismo kernel que la versión paralela
+    int64_t suma_kernel = medir_secuencial_kernel(array, tamano, &benchmark->tiempo_secuencial_us);
     
-    // Suma paralela
+    // Suma paralela: la primera repetición además calienta el motor
     configuracion_suma_t config = {
         .array = array,
         .tamano = tamano,
@@ -256,24 +356,36 @@ bool ejecutar_benchmark_suma(const int* array, size_t tamano, int num_hilos,
         .mostrar_detalles = false
     };
     
-    resultado_suma_paralela_t resultado;
-    if (!suma_paralela(&config, &resultado)) {
-        return false;
+    benchmark->tiempo_paralelo_us = UINT64_MAX;
+    for (int r = 0; r < REPETICIONES_BENCHMARK; r++) {
+        resultado_suma_paralela_t resultado;
+        if (!suma_paralela(&config, &resultado)) {
+            return false;
+        }
+        benchmark->suma_paralela = resultado.suma_total;
+        uint64_t tiempo_us = resultado.tiempo_total_us > 0 ? resultado.tiempo_total_us : 1;
+        if (tiempo_us < benchmark->tiempo_paralelo_us) {
+            benchmark->tiempo_paralelo_us = tiempo_us;
+        }
+        limpiar_resultado_suma(&resultado);
     }
     
-    benchmark->suma_paralela = resultado.suma_total;
-    benchmark->tiempo_paralelo_us = resultado.tiempo_total_us;
+    // Ancho de banda efectivo frente al techo de la memoria
+    double bytes = (double)tamano * sizeof(int);
+    benchmark->gbps_secuencial = bytes / (benchmark->tiempo_secuencial_us * 1e3);
+    benchmark->gbps_paralelo = bytes / (benchmark->tiempo_paralelo_us * 1e3);
+    benchmark->techo_gbps = medir_techo_ancho_banda();
     
-    // Calcular métricas
-    if (benchmark->tiempo_secuencial_us > 0) {
-        benchmark->speedup = (double)benchmark->tiempo_secuencial_us / 
-                           benchmark->tiempo_paralelo_us;
-        benchmark->eficiencia = benchmark->speedup / num_hilos;
-    }
-    
-    limpiar_resultado_suma(&resultado);
+    // Calcular métricas: el speedup compara el mismo kernel con 1 y N hilos;
+    // la ganancia SIMD se informa aparte
+    benchmark->speedup = (double)benchmark->tiempo_secuencial_us / 
+                       benchmark->tiempo_paralelo_us;
+    benchmark->eficiencia = benchmark->speedup / num_hilos;
+    benchmark->ganancia_simd = (double)benchmark->tiempo_escalar_us /
+                             benchmark->tiempo_secuencial_us;
     
-    return verificar_sumas_iguales(benchmark->suma_secuencial, benchmark->suma_paralela);
+    return verificar_sumas_iguales(benchmark->suma_secuencial, benchmark->suma_paralela) &&
+           verificar_sumas_iguales(benchmark->suma_secuencial, suma_kernel);
 }
 
 // Funciones de impresión
@@ -284,8 +396,8 @@ void imprimir_resultados_suma_paralela(const resultado_suma_paralela_t* resultad
     }
     
     printf("\n=== Resultados de Suma Paralela ===\n");
-    printf("Suma total: %ld\n", resultado->suma_total);
-    printf("Tiempo total: %lu microsegundos (%.3f ms)\n", 
+    printf("Suma total: %" PRId64 "\n", resultado->suma_total);
+    printf("Tiempo total: %" PRIu64 " microsegundos (%.3f ms)\n", 
            resultado->tiempo_total_us, resultado->tiempo_total_us / 1000.0);
     printf("Hilos utilizados: %d\n", resultado->num_hilos_usados);
     
@@ -304,16 +416,31 @@ void imprimir_benchmark(const benchmark_suma_t* benchmark) {
     printf("Tamaño del array: %zu elementos\n", benchmark->tamano_array);
     printf("Número de hilos: %d\n", benchmark->num_hilos);
     printf("\nResultados:\n");
-    printf("  Suma secuencial: %ld (%lu us = %.3f ms)\n", 
+    printf("  Suma secuencial: %" PRId64 " (%" PRIu64 " us = %.3f ms, 1 hilo, kernel %s)\n", 
            benchmark->suma_secuencial, benchmark->tiempo_secuencial_us,
-           benchmark->tiempo_secuencial_us / 1000.0);
-    printf("  Suma paralela:   %ld (%lu us = %.3f ms)\n", 
+           benchmark->tiempo_secuencial_us / 1000.0, nombre_kernel_suma(benchmark->kernel));
+    printf("  Suma paralela:   %" PRId64 " (%" PRIu64 " us = %.3f ms)\n", 
            benchmark->suma_paralela, benchmark->tiempo_paralelo_us,
            benchmark->tiempo_paralelo_us / 1000.0);
+    printf("  Bucle escalar:   %" PRIu64 " us = %.3f ms\n",
+           benchmark->tiempo_escalar_us, benchmark->tiempo_escalar_us / 1000.0);
     
     printf("\nMétricas de rendimiento:\n");
-    printf("  Speedup:     %.2fx\n", benchmark->speedup);
+    printf("  Speedup:     %.2fx (hilos, mismo kernel)\n", benchmark->speedup);
     printf("  Eficiencia:  %.2f%%\n", benchmark->eficiencia * 100.0);
+    printf("  SIMD:        %.2fx (kernel %s frente al bucle escalar, 1 hilo)\n",
+           benchmark->ganancia_simd, nombre_kernel_suma(benchmark->kernel));
+    
+    printf("\nAncho de banda (kernel %s):\n", nombre_kernel_suma(benchmark->kernel));
+    printf("  Secuencial:  %.2f GB/s\n", benchmark->gbps_secuencial);
+    printf("  Paralelo:    %.2f GB/s\n", benchmark->gbps_paralelo);
+    if (benchmark->techo_gbps > 0.0) {
+        printf("  Techo RAM:   %.2f GB/s (paralelo al %.0f%% del techo)\n",
+               benchmark->techo_gbps, 100.0 * benchmark->gbps_paralelo / benchmark->techo_gbps);
+        if (benchmark->gbps_paralelo > benchmark->techo_gbps) {
+            printf("               El array cabe en caché: se supera el ancho de banda de la RAM\n");
+        }
+    }
     
     bool correcto = verificar_sumas_iguales(benchmark->suma_secuencial, 
                                           benchmark->suma_paralela);
@@ -326,9 +453,46 @@ void imprimir_benchmark(const benchmark_suma_t* benchmark) {
     }
 }
 
+bool ejecutar_comparacion_kernels(const int* array, size_t tamano, int num_hilos) {
+    if (array == NULL || tamano == 0 || num_hilos <= 0) {
+        return false;
+    }
+    
+    kernel_suma_t kernel_original = obtener_kernel_suma();
+    bool todo_correcto = true;
+    
+    printf("\n=== Comparación de Kernels (%zu elementos, %d hilos) ===\n", tamano, num_hilos);
+    printf("%-10s %-12s %-10s %-10s %-8s\n", "Kernel", "Tiempo(ms)", "GB/s", "% techo", "Estado");
+    
+    for (int k = 0; k < NUM_KERNELS_SUMA; k++) {
+        if (!forzar_kernel_suma((kernel_suma_t)k)) {
+            printf("%-10s %-12s %-10s %-10s %-8s\n",
+                   nombre_kernel_suma((kernel_suma_t)k), "N/A", "N/A", "N/A", "NO CPU");
+            continue;
+        }
+        benchmark_suma_t benchmark;
+        bool exito = ejecutar_benchmark_suma(array, tamano, num_hilos, &benchmark);
+        todo_correcto = todo_correcto && exito;
+        printf("%-10s %-12.3f %-10.2f %-10.0f %-8s\n",
+               nombre_kernel_suma((kernel_suma_t)k),
+               benchmark.tiempo_paralelo_us / 1000.0,
+               benchmark.gbps_paralelo,
+               benchmark.techo_gbps > 0.0 ? 100.0 * benchmark.gbps_paralelo / benchmark.techo_gbps : 0.0,
+               exito ? "OK" : "ERROR");
+    }
+    
+    forzar_kernel_suma(kernel_original);
+    return todo_correcto;
+}
+
 // Funciones utilitarias
 
 int calcular_num_hilos_optimo(size_t tamano_array) {
+    int num_hilos_perfil;
+    if (consultar_perfil_hilos(tamano_array, &num_hilos_perfil, NULL)) {
+        return num_hilos_perfil;
+    }
+    
     int num_cpus = obtener_num_cpus();
     if (num_cpus <= 0) {
         num_cpus = 4; // Valor por defecto
@@ -344,6 +508,16 @@ int calcular_num_hilos_optimo(size_t tamano_array) {
     }
 }
 
+size_t calcular_tamano_chunk_optimo(size_t tamano_array, int num_hilos) {
+    int num_hilos_perfil;
+    size_t tamano_chunk;
+    if (consultar_perfil_hilos(tamano_array, &num_hilos_perfil, &tamano_chunk) &&
+        num_hilos_perfil == num_hilos) {
+        return tamano_chunk;
+    }
+    return 0;
+}
+
 void dividir_rango_en_chunks(size_t inicio, size_t fin, int num_hilos, size_t* chunks) {
     if (chunks == NULL || num_hilos <= 0 || fin <= inicio) {
         return;
@@ -387,9 +561,10 @@ bool ejecutar_pruebas_escalabilidad(const int* array, size_t tamano, int max_hil
     printf("Tamaño del array: %zu elementos\n", tamano);
     printf("Probando de 1 a %d hilos\n\n", max_hilos);
     
-    // Benchmark secuencial como referencia
+    // Referencia: un hilo con el mismo kernel, para que el speedup mida solo
+    // el reparto entre hilos
     uint64_t tiempo_secuencial;
-    int64_t suma_referencia = suma_secuencial(array, tamano, &tiempo_secuencial);
+    int64_t suma_referencia = medir_secuencial_kernel(array, tamano, &tiempo_secuencial);
     
     printf("%-6s %-12s %-12s %-8s %-10s %-8s\n", 
            "Hilos", "Tiempo(ms)", "Speedup", "Efic(%)", "Suma", "Estado");
@@ -439,18 +614,18 @@ bool ejecutar_demo_completa_suma_paralela(void) {
     
     resultado_suma_paralela_t resultado_basico;
     if (suma_paralela(&config_basico, &resultado_basico)) {
-        printf("Suma total: %ld\n", resultado_basico.suma_total);
-        printf("Tiempo: %lu microsegundos\n", resultado_basico.tiempo_total_us);
+        printf("Suma total: %" PRId64 "\n", resultado_basico.suma_total);
+        printf("Tiempo: %" PRIu64 " microsegundos\n", resultado_basico.tiempo_total_us);
         limpiar_resultado_suma(&resultado_basico);
     }
     
     // 2. Array más grande para ver beneficios del paralelismo
     printf("\n2. Array Grande (1,000,000 elementos):\n");
     size_t tamano_grande = 1000000;
-    int* array_grande = crear_array_secuencia(tamano_grande, 1, 1);
+    int num_hilos_optimo = calcular_num_hilos_optimo(tamano_grande);
+    int* array_grande = crear_array_secuencia(tamano_grande, 1, 1, num_hilos_optimo);
     
     if (array_grande != NULL) {
-        int num_hilos_optimo = calcular_num_hilos_optimo(tamano_grande);
         printf("Número de hilos óptimo calculado: %d\n", num_hilos_optimo);
         
         benchmark_suma_t benchmark_grande;
@@ -458,6 +633,7 @@ bool ejecutar_demo_completa_suma_paralela(void) {
                                   &benchmark_grande)) {
             imprimir_benchmark(&benchmark_grande);
         }
+        ejecutar_comparacion_kernels(array_grande, tamano_grande, num_hilos_optimo);
         
         // 3. Pruebas de escalabilidad
         printf("\n3. Análisis de Escalabilidad:\n");
@@ -473,16 +649,28 @@ bool ejecutar_demo_completa_suma_paralela(void) {
     
     // Array aleatorio
     printf("\nArray aleatorio:\n");
-    int* array_aleatorio = crear_array_aleatorio(100000, -100, 100);
+    int* array_aleatorio = crear_array_aleatorio(100000, -100, 100, 4);
     if (array_aleatorio != NULL) {
         benchmark_suma_t bench_aleatorio;
         if (ejecutar_benchmark_suma(array_aleatorio, 100000, 4, &bench_aleatorio)) {
-            printf("Suma: %ld, Speedup: %.2fx\n", 
+            printf("Suma: %" PRId64 ", Speedup: %.2fx\n", 
                    bench_aleatorio.suma_paralela, bench_aleatorio.speedup);
         }
         free(array_aleatorio);
     }
     
+    // 5. Estadísticas en una sola pasada fusionada
+    printf("\n5. Estadísticas Fusionadas (8,000,000 elementos):\n");
+    size_t tamano_estadisticas = 8000000;
+    int num_hilos_estadisticas = calcular_num_hilos_optimo(tamano_estadisticas);
+    int* array_estadisticas = crear_array_aleatorio(tamano_estadisticas, -1000, 1000,
+                                                    num_hilos_estadisticas);
+    if (array_estadisticas != NULL) {
+        ejecutar_benchmark_estadisticas(array_estadisticas, tamano_estadisticas,
+                                        num_hilos_estadisticas);
+        free(array_estadisticas);
+    }
+    
     printf("\n=== Demostración Completada ===\n");
     return true;
 }
@@ -497,19 +685,18 @@ void calcular_estadisticas_array(const int* array, size_t tamano, int* min, int*
         return;
     }
     
-    int min_val = array[0];
-    int max_val = array[0];
-    int64_t suma = 0;
-    
-    for (size_t i = 0; i < tamano; i++) {
-        if (array[i] < min_val) min_val = array[i];
-        if (array[i] > max_val) max_val = array[i];
-        suma += array[i];
+    // Una sola pasada paralela para las tres estadísticas
+    estadisticas_array_t estadisticas = { 0 };
+    if (!calcular_estadisticas_paralelas(array, tamano, calcular_num_hilos_optimo(tamano), &estadisticas)) {
+        if (min) *min = 0;
+        if (max) *max = 0;
+        if (promedio) *promedio = 0.0;
+        return;
     }
     
-    if (min) *min = min_val;
-    if (max) *max = max_val;
-    if (promedio) *promedio = (double)suma / tamano;
+    if (min) *min = estadisticas.minimo;
+    if (max) *max = estadisticas.maximo;
+    if (promedio) *promedio = estadisticas.media;
 }
 
 bool validar_array_para_suma(const int* array, size_t tamano) {
@@ -0,0 +1,97 @@
+#ifndef CONTADOR_FRAGMENTADO_H
+#define CONTADOR_FRAGMENTADO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @file contador_fragmentado.h
+ * @brief Contador repartido en franjas por hilo
+ *
+ * Un contador global incrementado desde muchos hilos es correcto con un
+ * fetch_add atómico, pero todos los hilos escriben en la misma línea de
+ * caché y esa línea viaja de núcleo en núcleo en cada incremento.
+ *
+ * Este contador da a cada hilo su propia franja, alineada y rellenada hasta
+ * ocupar una línea de caché entera, de modo que dos franjas nunca comparten
+ * línea (sin false sharing). Cada hilo resuelve su franja una vez y después
+ * solo escribe en ella; leer recorre todas las franjas con cargas atómicas
+ * relajadas y las suma.
+ *
+ * La lectura no es una instantánea: si otros hilos siguen incrementando, el
+ * valor devuelto está entre el total al empezar y al terminar la lectura.
+ * Para métricas es suficiente; para decidir algo con el valor exacto no.
+ */
+
+#define TAMANO_LINEA_CACHE 64
+#define MAX_FRANJAS_CONTADOR 256
+
+// Franja de un hilo: ocupa exactamente una línea de caché
+typedef struct {
+    uint64_t valor;
+    char relleno[TAMANO_LINEA_CACHE - sizeof(uint64_t)];
+} __attribute__((aligned(TAMANO_LINEA_CACHE))) franja_contador_t;
+
+typedef struct {
+    franja_contador_t* franjas;        // num_franjas líneas de caché
+    int num_franjas;
+} contador_fragmentado_t;
+
+/**
+ * @brief Reserva las franjas de un contador (todas a cero)
+ * @param contador Contador a inicializar
+ * @param num_franjas Franjas a reservar, una por hilo escritor (1..MAX_FRANJAS_CONTADOR)
+ * @return true si la reserva fue exitosa
+ */
+bool contador_fragmentado_init(contador_fragmentado_t* contador, int num_franjas);
+
+/**
+ * @brief Libera las franjas de un contador
+ */
+void contador_fragmentado_destruir(contador_fragmentado_t* contador);
+
+/**
+ * @brief Franja de un hilo, para resolverla una vez antes de incrementar
+ * @param contador Contador
+ * @param id_hilo Identificador del hilo en [0, num_franjas)
+ * @return Franja del hilo, o NULL si id_hilo está fuera de rango
+ *
+ * Cada franja debe tener un solo hilo escritor: dos hilos no pueden pedir
+ * la misma franja para sumar en ella.
+ */
+static inline franja_contador_t* contador_fragmentado_franja(contador_fragmentado_t* contador,
+                                                             int id_hilo) {
+    if (id_hilo < 0 || id_hilo >= contador->num_franjas) {
+        return NULL;
+    }
+    return &contador->franjas[id_hilo];
+}
+
+/**
+ * @brief Suma delta en la franja del hilo que llama
+ * @param franja Franja obtenida con contador_fragmentado_franja
+ * @param delta Cantidad a sumar
+ *
+ * Como solo el dueño escribe en la franja, basta una carga y un store
+ * relajados, sin instrucción lock: no hay otro escritor con el que competir.
+ * Siguen siendo atómicos para que contador_fragmentado_leer nunca vea un
+ * valor a medio escribir.
+ */
+static inline void contador_fragmentado_sumar(franja_contador_t* franja, uint64_t delta) {
+    uint64_t valor = __atomic_load_n(&franja->valor, __ATOMIC_RELAXED);
+    __atomic_store_n(&franja->valor, valor + delta, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Suma todas las franjas
+ * @return Total acumulado (ver la nota sobre lecturas concurrentes)
+ */
+uint64_t contador_fragmentado_leer(const contador_fragmentado_t* contador);
+
+/**
+ * @brief Pone todas las franjas a cero (sin hilos incrementando)
+ */
+void contador_fragmentado_reiniciar(contador_fragmentado_t* contador);
+
+#endif // CONTADOR_FRAGMENTADO_H
@@ -93,12 +93,31 @@ typedef struct {
     double tasa_inconsistencia; // Porcentaje de experimentos incorrectos
 } analisis_estadistico_t;
 
+// Estrategias correctas para un contador compartido
+typedef enum {
+    ESTRATEGIA_ATOMICO,         // Un único contador con fetch_add atómico
+    ESTRATEGIA_MUTEX,           // Contador protegido por pthread_mutex_t
+    ESTRATEGIA_SPINLOCK,        // Contador protegido por pthread_spinlock_t
+    ESTRATEGIA_FRAGMENTADO,     // contador_fragmentado_t, una franja por hilo
+    NUM_ESTRATEGIAS_CONTADOR
+} estrategia_contador_t;
+
+// Resultado de medir una estrategia de contador
+typedef struct {
+    estrategia_contador_t estrategia;
+    uint64_t valor_esperado;    // Hilos x incrementos
+    uint64_t valor_obtenido;    // Lectura final del contador
+    uint64_t tiempo_total_us;   // Desde crear el primer hilo hasta el último join
+    double millones_ops_seg;    // Incrementos por segundo / 10^6
+} resultado_estrategia_t;
+
 // Estructura para comparación con versión sincronizada
 typedef struct {
     resultado_experimento_t experimento_race;     // Resultado con race condition
     resultado_experimento_t experimento_seguro;   // Resultado sincronizado
     uint64_t overhead_sincronizacion_us;          // Overhead de la sincronización
     double factor_slowdown;                       // Factor de ralentización
+    resultado_estrategia_t estrategias[NUM_ESTRATEGIAS_CONTADOR]; // Sin delay, mismos hilos e incrementos
 } comparacion_sincronizacion_t;
 
 /**
@@ -174,6 +193,11 @@ void limpiar_analisis_estadistico(analisis_estadistico_t* analisis);
 
 /**
  * @brief Compara experimentos con y sin sincronización
+ *
+ * Además del experimento con race condition y el sincronizado con mutex,
+ * mide sin delays las estrategias de estrategia_contador_t con los mismos
+ * hilos e incrementos.
+ *
  * @param config Configuración del experimento
  * @param comparacion Estructura donde almacenar la comparación
  * @return true si la comparación fue exitosa
@@ -181,6 +205,52 @@ void limpiar_analisis_estadistico(analisis_estadistico_t* analisis);
 bool ejecutar_comparacion_sincronizacion(const configuracion_experimento_t* config, 
                                         comparacion_sincronizacion_t* comparacion);
 
+// Contador compartido con la sincronización de una estrategia (opaco)
+typedef struct contador_estrategia contador_estrategia_t;
+
+/**
+ * @brief Crea un contador a cero para una estrategia
+ * @param estrategia Estrategia de sincronización
+ * @param num_hilos Hilos que lo van a incrementar (franjas del fragmentado,
+ *                  como mucho MAX_FRANJAS_CONTADOR)
+ * @return Contador, o NULL si los parámetros no son válidos o falla la reserva
+ */
+contador_estrategia_t* crear_contador_estrategia(estrategia_contador_t estrategia, int num_hilos);
+
+/**
+ * @brief Libera un contador creado con crear_contador_estrategia
+ */
+void destruir_contador_estrategia(contador_estrategia_t* contador);
+
+/**
+ * @brief Incrementa el contador varias veces, una operación sincronizada por incremento
+ * @param contador Contador
+ * @param id_hilo Identificador del hilo en [0, num_hilos)
+ * @param incrementos Número de incrementos
+ */
+void incrementar_contador_estrategia(contador_estrategia_t* contador, int id_hilo, int incrementos);
+
+/**
+ * @brief Valor actual del contador
+ */
+uint64_t leer_contador_estrategia(const contador_estrategia_t* contador);
+
+/**
+ * @brief Mide una estrategia de contador sin delays
+ * @param estrategia Estrategia a medir
+ * @param num_hilos Número de hilos incrementando
+ * @param incrementos_por_hilo Incrementos que hace cada hilo
+ * @param resultado Estructura donde almacenar la medición
+ * @return true si la medición fue exitosa (el valor final queda en resultado)
+ */
+bool medir_estrategia_contador(estrategia_contador_t estrategia, int num_hilos,
+                               int incrementos_por_hilo, resultado_estrategia_t* resultado);
+
+/**
+ * @brief Nombre legible de una estrategia de contador
+ */
+const char* nombre_estrategia_contador(estrategia_contador_t estrategia);
+
 /**
  * @brief Imprime los resultados de un experimento individual
  * @param resultado Puntero a los resultados del experimento
@@ -205,6 +275,12 @@ void imprimir_comparacion_sincronizacion(const comparacion_sincronizacion_t* com
  */
 uint64_t obtener_tiempo_microsegundos(void);
 
+/**
+ * @brief Obtiene tiempo monotónico en nanosegundos
+ * @return Tiempo en nanosegundos
+ */
+uint64_t obtener_tiempo_nanosegundos(void);
+
 /**
  * @brief Calcula estadísticas básicas de un array de enteros
  * @param valores Array de valores
@@ -0,0 +1,53 @@
+#include "../include/contador_fragmentado.h"
+#include <stdlib.h>
+#include <string.h>
+
+bool contador_fragmentado_init(contador_fragmentado_t* contador, int num_franjas) {
+    if (contador == NULL || num_franjas < 1 || num_franjas > MAX_FRANJAS_CONTADOR) {
+        return false;
+    }
+
+    // malloc solo garantiza 16 bytes de alineación: hace falta la línea entera
+    void* memoria = NULL;
+    if (posix_memalign(&memoria, TAMANO_LINEA_CACHE,
+                       (size_t)num_franjas * sizeof(franja_contador_t)) != 0) {
+        return false;
+    }
+
+    memset(memoria, 0, (size_t)num_franjas * sizeof(franja_contador_t));
+    contador->franjas = memoria;
+    contador->num_franjas = num_franjas;
+    return true;
+}
+
+void contador_fragmentado_destruir(contador_fragmentado_t* contador) {
+    if (contador == NULL) {
+        return;
+    }
+
+    free(contador->franjas);
+    contador->franjas = NULL;
+    contador->num_franjas = 0;
+}
+
+uint64_t contador_fragmentado_leer(const contador_fragmentado_t* contador) {
+    if (contador == NULL || contador->franjas == NULL) {
+        return 0;
+    }
+
+    uint64_t total = 0;
+    for (int i = 0; i < contador->num_franjas; i++) {
+        total += __atomic_load_n(&contador->franjas[i].valor, __ATOMIC_RELAXED);
+    }
+    return total;
+}
+
+void contador_fragmentado_reiniciar(contador_fragmentado_t* contador) {
+    if (contador == NULL || contador->franjas == NULL) {
+        return;
+    }
+
+    for (int i = 0; i < contador->num_franjas; i++) {
+        __atomic_store_n(&contador->franjas[i].valor, 0, __ATOMIC_RELAXED);
+    }
+}
@@ -1,10 +1,13 @@
 #include "../include/race_conditions.h"
+#include "../include/contador_fragmentado.h"
+#include <inttypes.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 #include <errno.h>
 #include <math.h>
+#include <time.h>
 
 // Variables globales para demostraciones
 int contador_global = 0;
@@ -403,6 +406,17 @@ bool ejecutar_comparacion_sincronizacion(const configuracion_experimento_t* conf
         return false;
     }
     
+    printf("Midiendo estrategias de contador sin delay...\n");
+    for (int e = 0; e < NUM_ESTRATEGIAS_CONTADOR; e++) {
+        if (!medir_estrategia_contador((estrategia_contador_t)e, config->num_hilos,
+                                       config->incrementos_por_hilo,
+                                       &comparacion->estrategias[e])) {
+            limpiar_resultado_experimento(&comparacion->experimento_race);
+            limpiar_resultado_experimento(&comparacion->experimento_seguro);
+            return false;
+        }
+    }
+    
     // Calcular métricas de comparación
     comparacion->overhead_sincronizacion_us = 
         comparacion->experimento_seguro.tiempo_total_us - comparacion->experimento_race.tiempo_total_us;
@@ -417,6 +431,185 @@ bool ejecutar_comparacion_sincronizacion(const configuracion_experimento_t* conf
     return true;
 }
 
+// Estrategias de contador compartido
+
+struct contador_estrategia {
+    estrategia_contador_t estrategia;
+    uint64_t contador;                  // ATOMICO, MUTEX y SPINLOCK
+    pthread_mutex_t mutex;
+    pthread_spinlock_t spinlock;
+    contador_fragmentado_t fragmentado; // FRAGMENTADO
+};
+
+contador_estrategia_t* crear_contador_estrategia(estrategia_contador_t estrategia, int num_hilos) {
+    if ((int)estrategia < 0 || estrategia >= NUM_ESTRATEGIAS_CONTADOR || num_hilos < 1) {
+        return NULL;
+    }
+    
+    contador_estrategia_t* contador = calloc(1, sizeof(contador_estrategia_t));
+    if (contador == NULL) {
+        return NULL;
+    }
+    contador->estrategia = estrategia;
+    
+    if (pthread_mutex_init(&contador->mutex, NULL) != 0) {
+        free(contador);
+        return NULL;
+    }
+    if (pthread_spin_init(&contador->spinlock, PTHREAD_PROCESS_PRIVATE) != 0) {
+        pthread_mutex_destroy(&contador->mutex);
+        free(contador);
+        return NULL;
+    }
+    if (estrategia == ESTRATEGIA_FRAGMENTADO) {
+        // Una franja por hilo: contador_fragmentado_sumar no admite dos escritores
+        if (!contador_fragmentado_init(&contador->fragmentado, num_hilos)) {
+            pthread_spin_destroy(&contador->spinlock);
+            pthread_mutex_destroy(&contador->mutex);
+            free(contador);
+            return NULL;
+        }
+    }
+    
+    return contador;
+}
+
+void destruir_contador_estrategia(contador_estrategia_t* contador) {
+    if (contador == NULL) {
+        return;
+    }
+    
+    contador_fragmentado_destruir(&contador->fragmentado);
+    pthread_spin_destroy(&contador->spinlock);
+    pthread_mutex_destroy(&contador->mutex);
+    free(contador);
+}
+
+void incrementar_contador_estrategia(contador_estrategia_t* contador, int id_hilo, int incrementos) {
+    // Un bucle por estrategia para no evaluar el switch en cada incremento
+    switch (contador->estrategia) {
+        case ESTRATEGIA_ATOMICO:
+            for (int i = 0; i < incrementos; i++) {
+                __atomic_fetch_add(&contador->contador, 1, __ATOMIC_RELAXED);
+            }
+            break;
+        case ESTRATEGIA_MUTEX:
+            for (int i = 0; i < incrementos; i++) {
+                pthread_mutex_lock(&contador->mutex);
+                contador->contador++;
+                pthread_mutex_unlock(&contador->mutex);
+            }
+            break;
+        case ESTRATEGIA_SPINLOCK:
+            for (int i = 0; i < incrementos; i++) {
+                pthread_spin_lock(&contador->spinlock);
+                contador->contador++;
+                pthread_spin_unlock(&contador->spinlock);
+            }
+            break;
+        case ESTRATEGIA_FRAGMENTADO: {
+            franja_contador_t* franja = contador_fragmentado_franja(&contador->fragmentado, id_hilo);
+            if (franja == NULL) {
+                break;
+            }
+            for (int i = 0; i < incrementos; i++) {
+                contador_fragmentado_sumar(franja, 1);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+uint64_t leer_contador_estrategia(const contador_estrategia_t* contador) {
+    if (contador == NULL) {
+        return 0;
+    }
+    if (contador->estrategia == ESTRATEGIA_FRAGMENTADO) {
+        return contador_fragmentado_leer(&contador->fragmentado);
+    }
+    return __atomic_load_n(&contador->contador, __ATOMIC_RELAXED);
+}
+
+const char* nombre_estrategia_contador(estrategia_contador_t estrategia) {
+    switch (estrategia) {
+        case ESTRATEGIA_ATOMICO:     return "Un solo fetch_add";
+        case ESTRATEGIA_MUTEX:       return "Mutex";
+        case ESTRATEGIA_SPINLOCK:    return "Spinlock";
+        case ESTRATEGIA_FRAGMENTADO: return "Fragmentado por hilo";
+        default:                     return "Desconocida";
+    }
+}
+
+typedef struct {
+    contador_estrategia_t* contador;
+    int id_hilo;
+    int incrementos_por_hilo;
+} parametros_estrategia_t;
+
+static void* hilo_incrementar_estrategia(void* arg) {
+    parametros_estrategia_t* params = (parametros_estrategia_t*)arg;
+    incrementar_contador_estrategia(params->contador, params->id_hilo, params->incrementos_por_hilo);
+    return NULL;
+}
+
+bool medir_estrategia_contador(estrategia_contador_t estrategia, int num_hilos,
+                               int incrementos_por_hilo, resultado_estrategia_t* resultado) {
+    if (resultado == NULL || incrementos_por_hilo < 0) {
+        return false;
+    }
+    
+    memset(resultado, 0, sizeof(resultado_estrategia_t));
+    resultado->estrategia = estrategia;
+    
+    contador_estrategia_t* contador = crear_contador_estrategia(estrategia, num_hilos);
+    if (contador == NULL) {
+        return false;
+    }
+    
+    pthread_t* hilos = malloc(num_hilos * sizeof(pthread_t));
+    parametros_estrategia_t* params = malloc(num_hilos * sizeof(parametros_estrategia_t));
+    bool ok = hilos != NULL && params != NULL;
+    
+    int creados = 0;
+    uint64_t tiempo_inicio = obtener_tiempo_microsegundos();
+    
+    for (int i = 0; ok && i < num_hilos; i++) {
+        params[i].contador = contador;
+        params[i].id_hilo = i;
+        params[i].incrementos_por_hilo = incrementos_por_hilo;
+        int ret = pthread_create(&hilos[i], NULL, hilo_incrementar_estrategia, &params[i]);
+        if (ret != 0) {
+            fprintf(stderr, "Error creando hilo %d: %s\n", i, strerror(ret));
+            ok = false;
+        } else {
+            creados++;
+        }
+    }
+    
+    for (int i = 0; i < creados; i++) {
+        pthread_join(hilos[i], NULL);
+    }
+    
+    uint64_t tiempo_fin = obtener_tiempo_microsegundos();
+    
+    if (ok) {
+        resultado->valor_esperado = (uint64_t)num_hilos * (uint64_t)incrementos_por_hilo;
+        resultado->valor_obtenido = leer_contador_estrategia(contador);
+        resultado->tiempo_total_us = tiempo_fin - tiempo_inicio;
+        if (resultado->tiempo_total_us > 0) {
+            resultado->millones_ops_seg = (double)resultado->valor_esperado /
+                                          (double)resultado->tiempo_total_us;
+        }
+    }
+    
+    destruir_contador_estrategia(contador);
+    free(params);
+    free(hilos);
+    return ok;
+}
+
 // Funciones de impresión
 
 void imprimir_resultado_experimento(const resultado_experimento_t* resultado) {
@@ -524,6 +717,24 @@ void imprimir_comparacion_sincronizacion(const comparacion_sincronizacion_t* com
                comparacion->experimento_race.diferencia);
     }
     
+    if (comparacion->estrategias[ESTRATEGIA_ATOMICO].valor_esperado > 0) {
+        const resultado_estrategia_t* atomico = &comparacion->estrategias[ESTRATEGIA_ATOMICO];
+        
+        printf("\nEstrategias de contador (sin delay, %d hilos):\n",
+               comparacion->experimento_race.num_hilos);
+        printf("  %-22s %13s %10s %13s  %s\n", "Estrategia", "Tiempo (μs)", "Mops/s", "vs atómico", "Valor");
+        for (int e = 0; e < NUM_ESTRATEGIAS_CONTADOR; e++) {
+            const resultado_estrategia_t* r = &comparacion->estrategias[e];
+            double relativo = (atomico->tiempo_total_us > 0)
+                ? (double)r->tiempo_total_us / atomico->tiempo_total_us : 1.0;
+            printf("  %-22s %12" PRIu64 " %10.2f %11.2fx  %s\n",
+                   nombre_estrategia_contador(r->estrategia),
+                   r->tiempo_total_us, r->millones_ops_seg, relativo,
+                   r->valor_obtenido == r->valor_esperado ? "✓" : "✗");
+        }
+        printf("  (El fragmentado evita que todos los hilos escriban la misma línea de caché)\n");
+    }
+    
     printf("\n✓ La sincronización GARANTIZA correctitud\n");
     if (comparacion->factor_slowdown > 1.5) {
         printf("⚠ La sincronización tiene overhead significativo (%.1fx más lento)\n", 
@@ -542,6 +753,12 @@ uint64_t obtener_tiempo_microsegundos(void) {
     return (uint64_t)tv.tv_sec * 1000000 + tv.tv_usec;
 }
 
+uint64_t obtener_tiempo_nanosegundos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
 void calcular_estadisticas(const int* valores, int n, int* min, int* max, 
                           double* promedio, double* desviacion) {
     if (valores == NULL || n <= 0) {
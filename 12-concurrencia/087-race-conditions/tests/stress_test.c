@@ -1,13 +1,23 @@
 /**
  * @file stress_test.c
  * @brief Tests de estrés para race conditions
+ *
+ * Sin argumentos ejecuta los tests de estrés interactivos. Con --barrido
+ * recorre combinaciones de estrategia, hilos e incrementos por lote; cada
+ * punto corre durante un tiempo fijo y se emite en CSV y/o JSON:
+ *
+ *     stress_test_race_conditions --barrido --hilos 1,2,4,8 \
+ *         --incrementos 1,64,4096 --estrategias atomico,fragmentado \
+ *         --duracion-ms 500 --csv barrido.csv --json barrido.json
  */
 
 #include "../include/race_conditions.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <signal.h>
 #include <unistd.h>
+#include <time.h>
 
 static volatile bool continuar_test = true;
 
@@ -235,14 +245,436 @@ void test_deteccion_temprana(void) {
     }
 }
 
-int main(void) {
-    printf("=== TESTS DE ESTRÉS PARA RACE CONDITIONS ===\n");
-    printf("Presione Ctrl+C para detener cualquier test\n");
+// ============================================================================
+// BARRIDO DE ESCALABILIDAD
+// ============================================================================
+
+#define MAX_VALORES_BARRIDO 32
+#define MAX_HILOS_BARRIDO 256
+#define MAX_MUESTRAS_LATENCIA 4096     // Muestras por hilo (reservorio uniforme)
+#define DURACION_BARRIDO_MS_DEFAULT 200
+
+typedef struct {
+    int hilos[MAX_VALORES_BARRIDO];
+    int num_hilos;
+    int incrementos[MAX_VALORES_BARRIDO];
+    int num_incrementos;
+    estrategia_contador_t estrategias[NUM_ESTRATEGIAS_CONTADOR];
+    int num_estrategias;
+    int duracion_ms;
+    const char* archivo_csv;
+    const char* archivo_json;
+} configuracion_barrido_t;
+
+typedef struct {
+    estrategia_contador_t estrategia;
+    int num_hilos;
+    int incrementos_por_lote;
+    uint64_t duracion_ns;
+    uint64_t incrementos_totales;
+    uint64_t valor_contador;
+    double millones_ops_seg;
+    uint64_t latencia_p50_ns;           // Latencia de un lote completo
+    uint64_t latencia_p99_ns;
+    uint64_t latencia_p999_ns;
+    uint64_t latencia_max_ns;
+} punto_barrido_t;
+
+typedef struct {
+    contador_estrategia_t* contador;
+    const int* detener;
+    int id_hilo;
+    int incrementos_por_lote;
+    uint64_t incrementos;
+    uint64_t lotes;
+    uint64_t latencia_max_ns;
+    uint64_t muestras[MAX_MUESTRAS_LATENCIA];
+    uint64_t semilla;
+} hilo_barrido_t;
+
+// Muestra con el peso de los lotes que representa
+typedef struct {
+    uint64_t valor;
+    double peso;
+} muestra_ponderada_t;
+
+static const char* const claves_estrategia[NUM_ESTRATEGIAS_CONTADOR] = {
+    [ESTRATEGIA_ATOMICO] = "atomico",
+    [ESTRATEGIA_MUTEX] = "mutex",
+    [ESTRATEGIA_SPINLOCK] = "spinlock",
+    [ESTRATEGIA_FRAGMENTADO] = "fragmentado"
+};
+
+static uint64_t siguiente_aleatorio(uint64_t* estado) {
+    // xorshift64: suficiente para elegir qué muestra reemplazar
+    uint64_t x = *estado;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *estado = x;
+    return x;
+}
+
+static void* hilo_barrido(void* arg) {
+    hilo_barrido_t* h = (hilo_barrido_t*)arg;
+    
+    while (!__atomic_load_n(h->detener, __ATOMIC_RELAXED)) {
+        uint64_t t0 = obtener_tiempo_nanosegundos();
+        incrementar_contador_estrategia(h->contador, h->id_hilo, h->incrementos_por_lote);
+        uint64_t latencia = obtener_tiempo_nanosegundos() - t0;
+        
+        h->incrementos += (uint64_t)h->incrementos_por_lote;
+        if (latencia > h->latencia_max_ns) {
+            h->latencia_max_ns = latencia;
+        }
+        
+        // Reservorio: cada lote tiene la misma probabilidad de quedar en la muestra
+        if (h->lotes < MAX_MUESTRAS_LATENCIA) {
+            h->muestras[h->lotes] = latencia;
+        } else {
+            uint64_t j = siguiente_aleatorio(&h->semilla) % (h->lotes + 1);
+            if (j < MAX_MUESTRAS_LATENCIA) {
+                h->muestras[j] = latencia;
+            }
+        }
+        h->lotes++;
+    }
+    
+    return NULL;
+}
+
+static int comparar_muestras(const void* a, const void* b) {
+    uint64_t x = ((const muestra_ponderada_t*)a)->valor;
+    uint64_t y = ((const muestra_ponderada_t*)b)->valor;
+    return (x > y) - (x < y);
+}
+
+static uint64_t percentil_ponderado(const muestra_ponderada_t* muestras, int n,
+                                    double peso_total, double percentil) {
+    double objetivo = peso_total * percentil / 100.0;
+    double acumulado = 0.0;
+    for (int i = 0; i < n; i++) {
+        acumulado += muestras[i].peso;
+        if (acumulado >= objetivo) {
+            return muestras[i].valor;
+        }
+    }
+    return n > 0 ? muestras[n - 1].valor : 0;
+}
+
+static bool ejecutar_punto_barrido(estrategia_contador_t estrategia, int num_hilos,
+                                   int incrementos_por_lote, int duracion_ms,
+                                   punto_barrido_t* punto) {
+    memset(punto, 0, sizeof(punto_barrido_t));
+    punto->estrategia = estrategia;
+    punto->num_hilos = num_hilos;
+    punto->incrementos_por_lote = incrementos_por_lote;
+    
+    contador_estrategia_t* contador = crear_contador_estrategia(estrategia, num_hilos);
+    pthread_t* hilos = malloc(num_hilos * sizeof(pthread_t));
+    hilo_barrido_t* datos = calloc(num_hilos, sizeof(hilo_barrido_t));
+    if (contador == NULL || hilos == NULL || datos == NULL) {
+        destruir_contador_estrategia(contador);
+        free(hilos);
+        free(datos);
+        return false;
+    }
+    
+    int detener = 0;
+    int creados = 0;
+    uint64_t inicio = obtener_tiempo_nanosegundos();
+    
+    for (int i = 0; i < num_hilos; i++) {
+        datos[i].contador = contador;
+        datos[i].detener = &detener;
+        datos[i].id_hilo = i;
+        datos[i].incrementos_por_lote = incrementos_por_lote;
+        datos[i].semilla = 0x9E3779B97F4A7C15ULL * (uint64_t)(i + 1);
+        if (pthread_create(&hilos[i], NULL, hilo_barrido, &datos[i]) != 0) {
+            break;
+        }
+        creados++;
+    }
+    
+    // Dormir en tramos cortos para atender Ctrl+C durante puntos largos
+    uint64_t fin_previsto = inicio + (uint64_t)duracion_ms * 1000000ULL;
+    while (continuar_test && obtener_tiempo_nanosegundos() < fin_previsto) {
+        usleep(1000);
+    }
+    __atomic_store_n(&detener, 1, __ATOMIC_RELAXED);
+    
+    for (int i = 0; i < creados; i++) {
+        pthread_join(hilos[i], NULL);
+    }
+    punto->duracion_ns = obtener_tiempo_nanosegundos() - inicio;
+    punto->valor_contador = leer_contador_estrategia(contador);
+    
+    // Fusionar reservorios: cada muestra de un hilo representa lotes/muestras lotes
+    muestra_ponderada_t* muestras = malloc((size_t)creados * MAX_MUESTRAS_LATENCIA *
+                                           sizeof(muestra_ponderada_t));
+    int num_muestras = 0;
+    double peso_total = 0.0;
+    for (int i = 0; i < creados; i++) {
+        punto->incrementos_totales += datos[i].incrementos;
+        if (datos[i].latencia_max_ns > punto->latencia_max_ns) {
+            punto->latencia_max_ns = datos[i].latencia_max_ns;
+        }
+        
+        int guardadas = datos[i].lotes < MAX_MUESTRAS_LATENCIA
+            ? (int)datos[i].lotes : MAX_MUESTRAS_LATENCIA;
+        if (muestras == NULL || guardadas == 0) {
+            continue;
+        }
+        double peso = (double)datos[i].lotes / guardadas;
+        for (int j = 0; j < guardadas; j++) {
+            muestras[num_muestras].valor = datos[i].muestras[j];
+            muestras[num_muestras].peso = peso;
+            num_muestras++;
+        }
+        peso_total += (double)datos[i].lotes;
+    }
+    
+    if (muestras != NULL && num_muestras > 0) {
+        qsort(muestras, num_muestras, sizeof(muestra_ponderada_t), comparar_muestras);
+        punto->latencia_p50_ns = percentil_ponderado(muestras, num_muestras, peso_total, 50.0);
+        punto->latencia_p99_ns = percentil_ponderado(muestras, num_muestras, peso_total, 99.0);
+        punto->latencia_p999_ns = percentil_ponderado(muestras, num_muestras, peso_total, 99.9);
+    }
+    if (punto->duracion_ns > 0) {
+        punto->millones_ops_seg = (double)punto->incrementos_totales * 1000.0 /
+                                  (double)punto->duracion_ns;
+    }
+    
+    bool ok = creados == num_hilos && muestras != NULL;
+    free(muestras);
+    destruir_contador_estrategia(contador);
+    free(hilos);
+    free(datos);
+    return ok;
+}
+
+static void escribir_csv_barrido(FILE* f, const punto_barrido_t* puntos, int n) {
+    fprintf(f, "estrategia,hilos,incrementos_por_lote,duracion_ms,incrementos_totales,"
+               "mops,lat_p50_ns,lat_p99_ns,lat_p999_ns,lat_max_ns,correcto\n");
+    for (int i = 0; i < n; i++) {
+        const punto_barrido_t* p = &puntos[i];
+        fprintf(f, "%s,%d,%d,%.3f,%llu,%.3f,%llu,%llu,%llu,%llu,%d\n",
+                claves_estrategia[p->estrategia], p->num_hilos, p->incrementos_por_lote,
+                p->duracion_ns / 1e6, (unsigned long long)p->incrementos_totales,
+                p->millones_ops_seg,
+                (unsigned long long)p->latencia_p50_ns, (unsigned long long)p->latencia_p99_ns,
+                (unsigned long long)p->latencia_p999_ns, (unsigned long long)p->latencia_max_ns,
+                p->valor_contador == p->incrementos_totales);
+    }
+}
+
+static void escribir_json_barrido(FILE* f, const configuracion_barrido_t* config,
+                                  const punto_barrido_t* puntos, int n) {
+    fprintf(f, "{\n  \"duracion_objetivo_ms\": %d,\n  \"puntos\": [\n", config->duracion_ms);
+    for (int i = 0; i < n; i++) {
+        const punto_barrido_t* p = &puntos[i];
+        fprintf(f, "    {\"estrategia\": \"%s\", \"hilos\": %d, \"incrementos_por_lote\": %d, "
+                   "\"duracion_ms\": %.3f, \"incrementos_totales\": %llu, \"mops\": %.3f, "
+                   "\"latencia_ns\": {\"p50\": %llu, \"p99\": %llu, \"p999\": %llu, \"max\": %llu}, "
+                   "\"correcto\": %s}%s\n",
+                claves_estrategia[p->estrategia], p->num_hilos, p->incrementos_por_lote,
+                p->duracion_ns / 1e6, (unsigned long long)p->incrementos_totales,
+                p->millones_ops_seg,
+                (unsigned long long)p->latencia_p50_ns, (unsigned long long)p->latencia_p99_ns,
+                (unsigned long long)p->latencia_p999_ns, (unsigned long long)p->latencia_max_ns,
+                p->valor_contador == p->incrementos_totales ? "true" : "false",
+                i + 1 < n ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+}
+
+static bool escribir_archivo_barrido(const char* nombre, bool json,
+                                     const configuracion_barrido_t* config,
+                                     const punto_barrido_t* puntos, int n) {
+    FILE* f = strcmp(nombre, "-") == 0 ? stdout : fopen(nombre, "w");
+    if (f == NULL) {
+        fprintf(stderr, "Error creando %s\n", nombre);
+        return false;
+    }
+    
+    if (json) {
+        escribir_json_barrido(f, config, puntos, n);
+    } else {
+        escribir_csv_barrido(f, puntos, n);
+    }
+    
+    if (f != stdout) {
+        fclose(f);
+    }
+    return true;
+}
+
+// Lista separada por comas de enteros en [minimo, maximo]
+static int parsear_lista_enteros(const char* texto, int* valores, int max_valores,
+                                 int minimo, int maximo) {
+    int n = 0;
+    const char* p = texto;
+    while (*p != '\0' && n < max_valores) {
+        char* fin;
+        long v = strtol(p, &fin, 10);
+        if (fin == p || v < minimo || v > maximo || (*fin != ',' && *fin != '\0')) {
+            return -1;
+        }
+        valores[n++] = (int)v;
+        p = (*fin == ',') ? fin + 1 : fin;
+    }
+    return (*p == '\0') ? n : -1;
+}
+
+static int parsear_lista_estrategias(const char* texto, estrategia_contador_t* estrategias) {
+    char copia[256];
+    snprintf(copia, sizeof(copia), "%s", texto);
+    
+    int n = 0;
+    for (char* clave = strtok(copia, ","); clave != NULL; clave = strtok(NULL, ",")) {
+        int encontrada = -1;
+        for (int e = 0; e < NUM_ESTRATEGIAS_CONTADOR; e++) {
+            if (strcmp(clave, claves_estrategia[e]) == 0) {
+                encontrada = e;
+            }
+        }
+        if (encontrada < 0 || n >= NUM_ESTRATEGIAS_CONTADOR) {
+            return -1;
+        }
+        estrategias[n++] = (estrategia_contador_t)encontrada;
+    }
+    return n;
+}
+
+static void mostrar_uso_barrido(const char* programa) {
+    fprintf(stderr, "Uso: %s [--barrido [opciones]]\n\n", programa);
+    fprintf(stderr, "Sin argumentos ejecuta los tests de estrés interactivos.\n\n");
+    fprintf(stderr, "Opciones del barrido:\n");
+    fprintf(stderr, "  --hilos L          Hilos a probar (por defecto 1,2,4,8)\n");
+    fprintf(stderr, "  --incrementos L    Incrementos por lote entre lecturas del reloj (por defecto 1,64,4096)\n");
+    fprintf(stderr, "  --estrategias L    atomico,mutex,spinlock,fragmentado (por defecto todas)\n");
+    fprintf(stderr, "  --duracion-ms N    Tiempo de cada punto (por defecto %d)\n", DURACION_BARRIDO_MS_DEFAULT);
+    fprintf(stderr, "  --csv ARCHIVO      Escribe CSV (\"-\" = salida estándar)\n");
+    fprintf(stderr, "  --json ARCHIVO     Escribe JSON (\"-\" = salida estándar)\n");
+    fprintf(stderr, "Sin --csv ni --json se escribe CSV en la salida estándar.\n");
+}
+
+static bool parsear_argumentos_barrido(int argc, char* argv[], configuracion_barrido_t* config) {
+    memset(config, 0, sizeof(configuracion_barrido_t));
+    int hilos_defecto[] = {1, 2, 4, 8};
+    int incrementos_defecto[] = {1, 64, 4096};
+    memcpy(config->hilos, hilos_defecto, sizeof(hilos_defecto));
+    config->num_hilos = 4;
+    memcpy(config->incrementos, incrementos_defecto, sizeof(incrementos_defecto));
+    config->num_incrementos = 3;
+    for (int e = 0; e < NUM_ESTRATEGIAS_CONTADOR; e++) {
+        config->estrategias[e] = (estrategia_contador_t)e;
+    }
+    config->num_estrategias = NUM_ESTRATEGIAS_CONTADOR;
+    config->duracion_ms = DURACION_BARRIDO_MS_DEFAULT;
+    
+    for (int i = 2; i < argc; i++) {
+        const char* valor = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (valor == NULL) {
+            return false;
+        }
+        
+        if (strcmp(argv[i], "--hilos") == 0) {
+            config->num_hilos = parsear_lista_enteros(valor, config->hilos, MAX_VALORES_BARRIDO,
+                                                      1, MAX_HILOS_BARRIDO);
+            if (config->num_hilos <= 0) return false;
+        } else if (strcmp(argv[i], "--incrementos") == 0) {
+            config->num_incrementos = parsear_lista_enteros(valor, config->incrementos,
+                                                            MAX_VALORES_BARRIDO, 1, 1 << 24);
+            if (config->num_incrementos <= 0) return false;
+        } else if (strcmp(argv[i], "--estrategias") == 0) {
+            config->num_estrategias = parsear_lista_estrategias(valor, config->estrategias);
+            if (config->num_estrategias <= 0) return false;
+        } else if (strcmp(argv[i], "--duracion-ms") == 0) {
+            int duracion;
+            if (parsear_lista_enteros(valor, &duracion, 1, 1, 600000) != 1) return false;
+            config->duracion_ms = duracion;
+        } else if (strcmp(argv[i], "--csv") == 0) {
+            config->archivo_csv = valor;
+        } else if (strcmp(argv[i], "--json") == 0) {
+            config->archivo_json = valor;
+        } else {
+            return false;
+        }
+        i++;
+    }
+    
+    if (config->archivo_csv == NULL && config->archivo_json == NULL) {
+        config->archivo_csv = "-";
+    }
+    return true;
+}
+
+static int ejecutar_barrido_escalabilidad(const configuracion_barrido_t* config) {
+    int total = config->num_estrategias * config->num_hilos * config->num_incrementos;
+    punto_barrido_t* puntos = calloc(total, sizeof(punto_barrido_t));
+    if (puntos == NULL) {
+        return EXIT_FAILURE;
+    }
+    
+    // El progreso va a stderr para que el CSV/JSON en stdout quede limpio
+    fprintf(stderr, "Barrido: %d puntos de %d ms\n", total, config->duracion_ms);
+    
+    int completados = 0;
+    bool todos_correctos = true;
+    for (int e = 0; e < config->num_estrategias && continuar_test; e++) {
+        for (int h = 0; h < config->num_hilos && continuar_test; h++) {
+            for (int k = 0; k < config->num_incrementos && continuar_test; k++) {
+                punto_barrido_t* p = &puntos[completados];
+                if (!ejecutar_punto_barrido(config->estrategias[e], config->hilos[h],
+                                            config->incrementos[k], config->duracion_ms, p)) {
+                    fprintf(stderr, "Error en el punto %s/%d hilos/%d incrementos\n",
+                            claves_estrategia[config->estrategias[e]],
+                            config->hilos[h], config->incrementos[k]);
+                    free(puntos);
+                    return EXIT_FAILURE;
+                }
+                completados++;
+                
+                bool correcto = p->valor_contador == p->incrementos_totales;
+                todos_correctos = todos_correctos && correcto;
+                fprintf(stderr, "  %-12s %3d hilos %6d inc/lote: %9.2f Mops/s  p99 %8llu ns %s\n",
+                        claves_estrategia[p->estrategia], p->num_hilos, p->incrementos_por_lote,
+                        p->millones_ops_seg, (unsigned long long)p->latencia_p99_ns,
+                        correcto ? "✓" : "✗");
+            }
+        }
+    }
     
+    bool escrito = true;
+    if (config->archivo_csv != NULL) {
+        escrito = escribir_archivo_barrido(config->archivo_csv, false, config, puntos, completados) && escrito;
+    }
+    if (config->archivo_json != NULL) {
+        escrito = escribir_archivo_barrido(config->archivo_json, true, config, puntos, completados) && escrito;
+    }
+    
+    free(puntos);
+    return (escrito && todos_correctos) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(int argc, char* argv[]) {
     // Configurar manejador de señales
     signal(SIGINT, manejador_señal);
     signal(SIGTERM, manejador_señal);
     
+    if (argc > 1) {
+        configuracion_barrido_t config;
+        if (strcmp(argv[1], "--barrido") != 0 || !parsear_argumentos_barrido(argc, argv, &config)) {
+            mostrar_uso_barrido(argv[0]);
+            return EXIT_FAILURE;
+        }
+        return ejecutar_barrido_escalabilidad(&config);
+    }
+    
+    printf("=== TESTS DE ESTRÉS PARA RACE CONDITIONS ===\n");
+    printf("Presione Ctrl+C para detener cualquier test\n");
+    
     test_deteccion_temprana();
     
     if (continuar_test) {
@@ -0,0 +1,73 @@
+#ifndef BUFFER_BYTES_H
+#define BUFFER_BYTES_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "productor_consumidor.h"
+
+// Variante orientada a bytes del buffer circular: registros de longitud
+// variable escritos y leídos en el propio anillo, sin copias intermedias ni
+// malloc por mensaje. Un productor y un consumidor por buffer (para varios
+// workers, un buffer por worker).
+//
+// Productor:  p = reservar_bytes(b, max); ... escribir en p ...; confirmar_bytes(b, usados);
+// Consumidor: p = leer_registro(b, &len); ... procesar p ...;    liberar_registro(b);
+
+// Cabecera que precede a cada registro en el anillo
+typedef struct {
+    uint32_t longitud;  // Bytes útiles del registro
+    uint32_t tipo;      // REGISTRO_DATOS o REGISTRO_RELLENO
+} cabecera_registro_t;
+
+#define REGISTRO_DATOS   1u
+#define REGISTRO_RELLENO 2u  // Hueco hasta el final del anillo: saltar a la posición 0
+
+typedef struct {
+    uint8_t *datos;
+    size_t capacidad;  // Potencia de dos
+    size_t mascara;
+
+    pthread_mutex_t mutex;
+    pthread_cond_t cond_lleno;
+    pthread_cond_t cond_vacio;
+
+    _Alignas(TAM_LINEA_CACHE) atomic_size_t cabeza;  // Bytes publicados (productor)
+    size_t cola_cache;
+    size_t reserva_relleno;                          // Reserva en curso: relleno previo
+    size_t reserva_maxima;                           // Reserva en curso: bytes pedidos
+    bool reserva_activa;
+    _Alignas(TAM_LINEA_CACHE) atomic_size_t cola;    // Bytes liberados (consumidor)
+    size_t cabeza_cache;
+    size_t lectura_pendiente;                        // Bytes a liberar del registro leído
+    _Alignas(TAM_LINEA_CACHE) atomic_uint productores_esperando;
+    atomic_uint consumidores_esperando;
+} buffer_bytes_t;
+
+// Inicialización y limpieza. La capacidad se redondea a potencia de dos.
+bool inicializar_buffer_bytes(buffer_bytes_t *buffer, size_t capacidad);
+void limpiar_buffer_bytes(buffer_bytes_t *buffer);
+
+// Tamaño máximo de registro que siempre cabe contiguo en el anillo
+size_t max_registro_bytes(const buffer_bytes_t *buffer);
+
+// Productor: reserva n bytes contiguos (bloquea hasta que haya hueco) y
+// devuelve dónde escribirlos. NULL si n supera max_registro_bytes().
+void *reservar_bytes(buffer_bytes_t *buffer, size_t n);
+// Igual pero sin bloquear: NULL si ahora mismo no hay hueco
+void *intentar_reservar_bytes(buffer_bytes_t *buffer, size_t n);
+// Publica la reserva con los bytes realmente escritos (0 < usados <= n).
+// Permite reservar el máximo de un recv() y confirmar solo lo recibido.
+int confirmar_bytes(buffer_bytes_t *buffer, size_t usados);
+
+// Consumidor: devuelve el siguiente registro sin copiarlo (bloquea hasta 1 s,
+// igual que consumir_item; NULL si vence el timeout). El puntero es válido
+// hasta liberar_registro().
+const void *leer_registro(buffer_bytes_t *buffer, size_t *longitud);
+const void *intentar_leer_registro(buffer_bytes_t *buffer, size_t *longitud);
+int liberar_registro(buffer_bytes_t *buffer);
+
+#endif // BUFFER_BYTES_H
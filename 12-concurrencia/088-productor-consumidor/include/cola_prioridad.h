@@ -0,0 +1,101 @@
+#ifndef COLA_PRIORIDAD_H
+#define COLA_PRIORIDAD_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "productor_consumidor.h"
+
+// Cola acotada con un carril FIFO por nivel de prioridad_cola_t. El buffer
+// circular es estrictamente FIFO y un trabajo urgente espera detrás de todo
+// el trabajo masivo encolado antes; aquí cada consumidor saca primero del
+// carril no vacío de mayor prioridad.
+//
+// - El carril i es el nivel i: tiene prioridad mayor que el i-1. Una máscara
+//   de bits marca los carriles con elementos, así que elegir carril es un
+//   __builtin_clz (O(1), sin recorrer).
+// - Envejecimiento: un elemento sube un nivel por cada espera_maxima_ns que
+//   pasa en la cola. Si la cabeza de un carril inferior supera así al carril
+//   superior no vacío, se sirve ella (promoción), pero como mucho una vez cada
+//   SERVICIOS_POR_PROMOCION servicios (4, en cola_prioridad.c): el carril
+//   superior conserva al menos 3 de cada 4. Mientras los consumidores dan
+//   abasto, un elemento de PRIORIDAD_BAJA espera poco más de
+//   NUM_CARRILES_PRIORIDAD - 1 esperas máximas. Con la cola saturada no hay
+//   cota: los carriles inferiores reciben al menos 1 de cada 4 servicios (no
+//   se quedan sin servir), pero si eso no alcanza para su carga su espera
+//   crece hasta que los productores se bloquean con el carril lleno.
+// - Cada carril tiene su propia capacidad: un productor de PRIORIDAD_BAJA con
+//   su carril lleno se bloquea sin impedir que entren elementos de
+//   PRIORIDAD_CRITICA.
+//
+// Un mutex protege toda la cola (mismo modelo que MODO_BUFFER_MUTEX) y solo se
+// señaliza si hay alguien esperando.
+
+// Niveles de prioridad de menor a mayor; el valor es el índice del carril
+typedef enum {
+    PRIORIDAD_BAJA,
+    PRIORIDAD_MEDIA,
+    PRIORIDAD_ALTA,
+    PRIORIDAD_CRITICA
+} prioridad_cola_t;
+
+#define NUM_CARRILES_PRIORIDAD 4
+
+typedef struct {
+    elemento_t dato;
+    uint64_t encolado_ns;  // CLOCK_MONOTONIC al producir
+} entrada_prioridad_t;
+
+typedef struct {
+    entrada_prioridad_t *entradas;
+    size_t cabeza;                // Próxima posición a consumir
+    size_t num_elementos;
+    pthread_cond_t cond_hueco;    // Productores de este carril esperando hueco
+    unsigned productores_esperando;
+    // Estadísticas (protegidas por el mutex de la cola)
+    uint64_t producidos;
+    uint64_t consumidos;
+    uint64_t promovidos;          // Servidos antes que un carril superior por envejecimiento
+} carril_prioridad_t;
+
+typedef struct {
+    carril_prioridad_t carriles[NUM_CARRILES_PRIORIDAD];  // De menor a mayor prioridad
+    size_t capacidad_carril;
+    unsigned mapa_no_vacios;      // Bit i = carril i tiene elementos
+    uint64_t espera_maxima_ns;    // 0 = sin envejecimiento (prioridad estricta)
+    unsigned servicios_sin_promocion;  // Servicios desde la última promoción
+    pthread_mutex_t mutex;
+    pthread_cond_t cond_datos;
+    unsigned consumidores_esperando;
+    bool cerrada;
+} cola_prioridad_t;
+
+// Inicialización y limpieza. capacidad_carril es la capacidad de cada carril.
+bool inicializar_cola_prioridad(cola_prioridad_t *cola, size_t capacidad_carril,
+                                uint64_t espera_maxima_ns);
+void limpiar_cola_prioridad(cola_prioridad_t *cola);
+
+// Despierta a todos los hilos bloqueados. Después no se admiten elementos y
+// los consumidores vacían lo que quede antes de recibir -1.
+void cerrar_cola_prioridad(cola_prioridad_t *cola);
+
+// Encola en el carril de la prioridad (bloquea si ese carril está lleno).
+// Un valor fuera del enum va al carril más cercano (BAJA o CRITICA).
+// Devuelve 0, o -1 si la cola está cerrada.
+int producir_con_prioridad(cola_prioridad_t *cola, elemento_t valor, prioridad_cola_t prioridad);
+
+// Saca el siguiente elemento según prioridad y envejecimiento (bloquea si la
+// cola está vacía). prioridad y espera_ns pueden ser NULL. Devuelve 0, o -1 si
+// la cola está cerrada y vacía.
+int consumir_por_prioridad(cola_prioridad_t *cola, elemento_t *valor,
+                           prioridad_cola_t *prioridad, uint64_t *espera_ns);
+
+// Carril (0..NUM_CARRILES_PRIORIDAD-1) en el que se encola una prioridad
+int carril_de_prioridad(prioridad_cola_t prioridad);
+
+// Elementos pendientes en total
+size_t ocupacion_cola_prioridad(cola_prioridad_t *cola);
+
+#endif // COLA_PRIORIDAD_H
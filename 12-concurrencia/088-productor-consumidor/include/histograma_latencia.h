@@ -0,0 +1,57 @@
+#ifndef HISTOGRAMA_LATENCIA_H
+#define HISTOGRAMA_LATENCIA_H
+
+#include <stdint.h>
+
+// Histograma log-lineal al estilo HDR para latencias en nanosegundos.
+//
+// Los valores por debajo de 2 * SUBCUBETAS_HISTOGRAMA tienen una cubeta cada
+// uno. A partir de ahí cada potencia de dos [2^e, 2^(e+1)) se parte en
+// SUBCUBETAS_HISTOGRAMA cubetas iguales, así que el error relativo de
+// cualquier percentil es como mucho 1/SUBCUBETAS_HISTOGRAMA (~3%) y todo el
+// rango de uint64_t cabe en unos pocos miles de contadores. Registrar es un
+// __builtin_clzll, un desplazamiento y un incremento: sin reservas ni
+// ordenaciones, y cada hilo puede tener el suyo y fusionarlos al final.
+
+#define BITS_SUBCUBETA_HISTOGRAMA 5
+#define SUBCUBETAS_HISTOGRAMA (1u << BITS_SUBCUBETA_HISTOGRAMA)
+#define NUM_CUBETAS_HISTOGRAMA ((64 - BITS_SUBCUBETA_HISTOGRAMA + 1) * SUBCUBETAS_HISTOGRAMA)
+
+typedef struct {
+    uint64_t cubetas[NUM_CUBETAS_HISTOGRAMA];
+    uint64_t total;
+    uint64_t minimo;
+    uint64_t maximo;
+    double suma;
+} histograma_latencia_t;
+
+static inline unsigned indice_cubeta_histograma(uint64_t valor) {
+    if (valor < 2 * SUBCUBETAS_HISTOGRAMA) return (unsigned)valor;
+    unsigned exponente = 63u - (unsigned)__builtin_clzll(valor);
+    unsigned desplazamiento = exponente - BITS_SUBCUBETA_HISTOGRAMA;
+    // valor >> desplazamiento está en [SUBCUBETAS, 2 * SUBCUBETAS)
+    return desplazamiento * SUBCUBETAS_HISTOGRAMA + (unsigned)(valor >> desplazamiento);
+}
+
+static inline void registrar_latencia(histograma_latencia_t *h, uint64_t valor) {
+    h->cubetas[indice_cubeta_histograma(valor)]++;
+    h->total++;
+    h->suma += (double)valor;
+    if (valor < h->minimo) h->minimo = valor;
+    if (valor > h->maximo) h->maximo = valor;
+}
+
+// Deja el histograma vacío
+void reiniciar_histograma(histograma_latencia_t *h);
+
+// Suma los contadores de origen en destino
+void fusionar_histogramas(histograma_latencia_t *destino, const histograma_latencia_t *origen);
+
+// Valor del percentil (0..100): límite superior de la cubeta que lo contiene,
+// recortado al máximo registrado. 0 si el histograma está vacío.
+uint64_t percentil_histograma(const histograma_latencia_t *h, double percentil);
+
+// Media exacta de los valores registrados (0 si está vacío)
+double media_histograma(const histograma_latencia_t *h);
+
+#endif // HISTOGRAMA_LATENCIA_H
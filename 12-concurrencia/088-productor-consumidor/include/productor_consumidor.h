@@ -2,6 +2,7 @@
 #define PRODUCTOR_CONSUMIDOR_H
 
 #include <pthread.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stddef.h>
 
@@ -9,35 +10,109 @@
 
 typedef int elemento_t;
 
+// Tamaño de línea de caché usado para separar los índices de los modos sin locks
+#define TAM_LINEA_CACHE 64
+
+// Modo de funcionamiento del buffer
+typedef enum {
+    MODO_BUFFER_MUTEX = 0,  // Mutex + variables de condición (N productores/N consumidores)
+    MODO_BUFFER_SPSC,       // Sin locks: exactamente 1 productor y 1 consumidor
+    MODO_BUFFER_MPMC        // Sin locks: N productores/N consumidores (secuencia por celda)
+} modo_buffer_t;
+
+// Punto de espera de un extremo del buffer. 'esperando' cuenta los hilos que
+// van a dormir, de modo que quien publica solo paga un despertar si hay
+// alguien. En los modos sin locks bajo Linux 'secuencia' es la palabra de
+// futex sobre la que se duerme; fuera de Linux se usan mutex + condición.
+typedef struct {
+    atomic_uint esperando;
+    atomic_uint secuencia;
+} punto_espera_t;
+
+// Celda del modo MPMC: la secuencia indica de quién es el turno sobre el dato
+// (secuencia == pos -> libre para el productor de pos;
+//  secuencia == pos + 1 -> lista para el consumidor de pos)
+typedef struct {
+    atomic_size_t secuencia;
+    elemento_t dato;
+} celda_mpmc_t;
+
 typedef struct {
     elemento_t *buffer;
     size_t capacidad;
-    size_t contador;
+    size_t contador;          // Solo en modo mutex; en general, ocupacion_buffer()
     size_t indice_entrada;
     size_t indice_salida;
     pthread_mutex_t mutex;
     pthread_cond_t cond_lleno;
     pthread_cond_t cond_vacio;
+
+    // Modos sin locks: anillo de tamaño potencia de dos con índices que crecen
+    // libremente (ocupación = cabeza - cola). Cada índice vive en su propia
+    // línea de caché. En SPSC cada índice tiene un único escritor, que guarda
+    // además una copia local del índice contrario; en MPMC los índices se
+    // reservan con CAS y cada celda lleva su número de secuencia.
+    modo_buffer_t modo;
+    size_t mascara;
+    celda_mpmc_t *celdas;                            // Solo en modo MPMC
+    _Alignas(TAM_LINEA_CACHE) atomic_size_t cabeza;  // Posición de inserción
+    size_t cola_cache;                               // SPSC: última cola vista por el productor
+    _Alignas(TAM_LINEA_CACHE) atomic_size_t cola;    // Posición de extracción
+    size_t cabeza_cache;                             // SPSC: última cabeza vista por el consumidor
+    // Productores esperando hueco y consumidores esperando datos
+    _Alignas(TAM_LINEA_CACHE) punto_espera_t espera_productores;
+    punto_espera_t espera_consumidores;
+    unsigned vueltas_espera;  // Espera activa antes de dormir (modos sin locks)
 } buffer_circular_t;
 
 // Inicialización y limpieza
 bool inicializar_buffer_circular(buffer_circular_t *buffer, size_t capacidad);
 void limpiar_buffer_circular(buffer_circular_t *buffer);
 
+// Inicializa el buffer en modo SPSC. La capacidad se redondea a la siguiente
+// potencia de dos. Solo puede haber un hilo productor y un hilo consumidor;
+// el mutex y las condiciones se usan únicamente para dormir cuando el anillo
+// está realmente lleno o vacío.
+bool inicializar_buffer_spsc(buffer_circular_t *buffer, size_t capacidad);
+
+// Inicializa el buffer en modo MPMC (cola acotada de Vyukov). Admite cualquier
+// número de productores y consumidores; la capacidad se redondea a la
+// siguiente potencia de dos (mínimo 2).
+bool inicializar_buffer_mpmc(buffer_circular_t *buffer, size_t capacidad);
+
+// Número de comprobaciones con pausa de CPU que hace un hilo de los modos
+// SPSC/MPMC antes de dormir cuando el buffer está lleno o vacío. 0 (por
+// defecto) duerme enseguida; unos cientos de vueltas evitan el coste de
+// dormir y despertar cuando el otro extremo va a responder en microsegundos.
+void configurar_espera_activa(buffer_circular_t *buffer, unsigned vueltas);
+
+// Número de elementos almacenados (válido en todos los modos; en los modos
+// sin locks es una instantánea aproximada si hay hilos operando)
+size_t ocupacion_buffer(const buffer_circular_t *buffer);
+
 // Operaciones bloqueantes del productor/consumidor
 int producir_item(buffer_circular_t *buffer, elemento_t valor);
 int consumir_item(buffer_circular_t *buffer, elemento_t *valor);
 
+// Operaciones por lotes: mueven hasta n elementos con una sola adquisición del
+// mutex y un solo despertar. Bloquean hasta poder mover al menos uno y
+// devuelven cuántos se movieron (consumir_lote devuelve -1 tras 1 s sin datos).
+int producir_lote(buffer_circular_t *buffer, const elemento_t *valores, size_t n);
+int consumir_lote(buffer_circular_t *buffer, elemento_t *valores, size_t n);
+
 // Utilidades y atajos usados por los tests
-static inline bool esta_lleno(const buffer_circular_t *b) { return b && b->contador == b->capacidad; }
-static inline bool esta_vacio(const buffer_circular_t *b) { return !b || b->contador == 0; }
+static inline bool esta_lleno(const buffer_circular_t *b) { return b && ocupacion_buffer(b) == b->capacidad; }
+static inline bool esta_vacio(const buffer_circular_t *b) { return !b || ocupacion_buffer(b) == 0; }
 
-// Macros de compatibilidad para tests antiguos
-#define ocupados contador
+// Macros de compatibilidad para tests antiguos. Ya no hay alias para
+// "ocupados": contador solo se mantiene en modo mutex, así que los tests que
+// leían buffer->ocupados deben usar ocupacion_buffer(buffer).
 #define tamaño capacidad
 
 // API de compatibilidad para tests (equivalente a las funciones "legacy")
 buffer_circular_t* crear_buffer(size_t capacidad);
+buffer_circular_t* crear_buffer_spsc(size_t capacidad);
+buffer_circular_t* crear_buffer_mpmc(size_t capacidad);
 void destruir_buffer(buffer_circular_t* buffer);
 
 // Wrappers de conveniencia (no bloqueantes) usados en algunos tests
@@ -49,6 +124,7 @@ typedef struct {
     buffer_circular_t *buffer;
     int num_datos;
     int delay_us;  // puede ser 0
+    int tam_lote;  // 0 o 1: item a item; >1: usa producir_lote
 } productor_args_t;
 
 typedef struct {
@@ -56,6 +132,7 @@ typedef struct {
     int num_datos;
     int delay_us;  // puede ser 0
     long long suma; // salida
+    int tam_lote;  // 0 o 1: item a item; >1: usa consumir_lote
 } consumidor_args_t;
 
 void* hilo_productor(void *arg);
@@ -0,0 +1,199 @@
+#include "../include/buffer_bytes.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+
+// Los registros se alinean a 8 bytes para que cada cabecera quede alineada
+#define ALINEACION_REGISTRO 8u
+#define CAPACIDAD_MINIMA_BYTES 64u
+
+static size_t tam_registro(size_t longitud) {
+    size_t total = sizeof(cabecera_registro_t) + longitud;
+    return (total + ALINEACION_REGISTRO - 1) & ~(size_t)(ALINEACION_REGISTRO - 1);
+}
+
+bool inicializar_buffer_bytes(buffer_bytes_t *buffer, size_t capacidad) {
+    if (!buffer || capacidad == 0) return false;
+    size_t capacidad_real = CAPACIDAD_MINIMA_BYTES;
+    while (capacidad_real < capacidad) capacidad_real <<= 1;
+
+    memset(buffer, 0, sizeof(*buffer));
+    buffer->datos = (uint8_t *)malloc(capacidad_real);
+    if (!buffer->datos) return false;
+    buffer->capacidad = capacidad_real;
+    buffer->mascara = capacidad_real - 1;
+    atomic_init(&buffer->cabeza, 0);
+    atomic_init(&buffer->cola, 0);
+    atomic_init(&buffer->productores_esperando, 0);
+    atomic_init(&buffer->consumidores_esperando, 0);
+    pthread_mutex_init(&buffer->mutex, NULL);
+    pthread_cond_init(&buffer->cond_lleno, NULL);
+    pthread_cond_init(&buffer->cond_vacio, NULL);
+    return true;
+}
+
+void limpiar_buffer_bytes(buffer_bytes_t *buffer) {
+    if (!buffer) return;
+    pthread_mutex_lock(&buffer->mutex);
+    pthread_cond_broadcast(&buffer->cond_lleno);
+    pthread_cond_broadcast(&buffer->cond_vacio);
+    pthread_mutex_unlock(&buffer->mutex);
+    pthread_cond_destroy(&buffer->cond_lleno);
+    pthread_cond_destroy(&buffer->cond_vacio);
+    pthread_mutex_destroy(&buffer->mutex);
+    free(buffer->datos);
+    memset(buffer, 0, sizeof(*buffer));
+}
+
+size_t max_registro_bytes(const buffer_bytes_t *buffer) {
+    if (!buffer || !buffer->datos) return 0;
+    // Con registros de hasta capacidad/2 el relleno más el registro siempre
+    // caben en un anillo vacío, esté donde esté la cabeza
+    return buffer->capacidad / 2 - sizeof(cabecera_registro_t);
+}
+
+// Mismo protocolo que el modo SPSC de buffer_circular_t: solo se toma el
+// mutex para dormir, y solo se señaliza si el otro extremo está esperando
+static void despertar_si_espera(buffer_bytes_t *b, atomic_uint *esperando, pthread_cond_t *cond) {
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(esperando, memory_order_relaxed) > 0) {
+        pthread_mutex_lock(&b->mutex);
+        pthread_cond_signal(cond);
+        pthread_mutex_unlock(&b->mutex);
+    }
+}
+
+static size_t bytes_libres(buffer_bytes_t *b, size_t cabeza, size_t necesarios) {
+    size_t libres = b->capacidad - (cabeza - b->cola_cache);
+    if (libres < necesarios) {
+        b->cola_cache = atomic_load_explicit(&b->cola, memory_order_acquire);
+        libres = b->capacidad - (cabeza - b->cola_cache);
+    }
+    return libres;
+}
+
+static size_t bytes_disponibles(buffer_bytes_t *b, size_t cola) {
+    size_t disponibles = b->cabeza_cache - cola;
+    if (disponibles == 0) {
+        b->cabeza_cache = atomic_load_explicit(&b->cabeza, memory_order_acquire);
+        disponibles = b->cabeza_cache - cola;
+    }
+    return disponibles;
+}
+
+static void *bytes_reservar(buffer_bytes_t *b, size_t n, bool bloqueante) {
+    if (!b || n == 0 || n > max_registro_bytes(b) || b->reserva_activa) return NULL;
+
+    size_t cabeza = atomic_load_explicit(&b->cabeza, memory_order_relaxed);
+    size_t hasta_fin = b->capacidad - (cabeza & b->mascara);
+    size_t total = tam_registro(n);
+    // Si no cabe contiguo hasta el final, se rellena ese trozo y se empieza en 0
+    size_t relleno = total <= hasta_fin ? 0 : hasta_fin;
+    size_t necesarios = relleno + total;
+
+    if (bytes_libres(b, cabeza, necesarios) < necesarios) {
+        if (!bloqueante) return NULL;
+        pthread_mutex_lock(&b->mutex);
+        atomic_fetch_add_explicit(&b->productores_esperando, 1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        while (bytes_libres(b, cabeza, necesarios) < necesarios) {
+            pthread_cond_wait(&b->cond_lleno, &b->mutex);
+        }
+        atomic_fetch_sub_explicit(&b->productores_esperando, 1, memory_order_relaxed);
+        pthread_mutex_unlock(&b->mutex);
+    }
+
+    b->reserva_relleno = relleno;
+    b->reserva_maxima = n;
+    b->reserva_activa = true;
+    return b->datos + ((cabeza + relleno) & b->mascara) + sizeof(cabecera_registro_t);
+}
+
+void *reservar_bytes(buffer_bytes_t *buffer, size_t n) {
+    return bytes_reservar(buffer, n, true);
+}
+
+void *intentar_reservar_bytes(buffer_bytes_t *buffer, size_t n) {
+    return bytes_reservar(buffer, n, false);
+}
+
+int confirmar_bytes(buffer_bytes_t *buffer, size_t usados) {
+    if (!buffer || !buffer->reserva_activa || usados == 0 || usados > buffer->reserva_maxima) {
+        return -1;
+    }
+
+    size_t cabeza = atomic_load_explicit(&buffer->cabeza, memory_order_relaxed);
+    if (buffer->reserva_relleno > 0) {
+        cabecera_registro_t *relleno = (cabecera_registro_t *)(buffer->datos + (cabeza & buffer->mascara));
+        relleno->longitud = (uint32_t)(buffer->reserva_relleno - sizeof(cabecera_registro_t));
+        relleno->tipo = REGISTRO_RELLENO;
+    }
+    size_t inicio = cabeza + buffer->reserva_relleno;
+    cabecera_registro_t *cabecera = (cabecera_registro_t *)(buffer->datos + (inicio & buffer->mascara));
+    cabecera->longitud = (uint32_t)usados;
+    cabecera->tipo = REGISTRO_DATOS;
+
+    // Relleno y registro se publican juntos con un único store release
+    atomic_store_explicit(&buffer->cabeza, inicio + tam_registro(usados), memory_order_release);
+    buffer->reserva_activa = false;
+    despertar_si_espera(buffer, &buffer->consumidores_esperando, &buffer->cond_vacio);
+    return 0;
+}
+
+static const void *bytes_leer(buffer_bytes_t *b, size_t *longitud, bool bloqueante) {
+    if (!b || !longitud || b->lectura_pendiente > 0) return NULL;
+
+    size_t cola = atomic_load_explicit(&b->cola, memory_order_relaxed);
+    if (bytes_disponibles(b, cola) == 0) {
+        if (!bloqueante) return NULL;
+
+        struct timespec timeout;
+        clock_gettime(CLOCK_REALTIME, &timeout);
+        timeout.tv_sec += 1;
+
+        bool hay_datos = true;
+        pthread_mutex_lock(&b->mutex);
+        atomic_fetch_add_explicit(&b->consumidores_esperando, 1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        while (bytes_disponibles(b, cola) == 0) {
+            if (pthread_cond_timedwait(&b->cond_vacio, &b->mutex, &timeout) == ETIMEDOUT) {
+                hay_datos = false;
+                break;
+            }
+        }
+        atomic_fetch_sub_explicit(&b->consumidores_esperando, 1, memory_order_relaxed);
+        pthread_mutex_unlock(&b->mutex);
+        if (!hay_datos) return NULL;
+    }
+
+    size_t desplazamiento = cola & b->mascara;
+    size_t saltar = 0;
+    const cabecera_registro_t *cabecera = (const cabecera_registro_t *)(b->datos + desplazamiento);
+    if (cabecera->tipo == REGISTRO_RELLENO) {
+        // El registro real se publicó junto al relleno, al principio del anillo
+        saltar = b->capacidad - desplazamiento;
+        cabecera = (const cabecera_registro_t *)b->datos;
+    }
+
+    b->lectura_pendiente = saltar + tam_registro(cabecera->longitud);
+    *longitud = cabecera->longitud;
+    return cabecera + 1;
+}
+
+const void *leer_registro(buffer_bytes_t *buffer, size_t *longitud) {
+    return bytes_leer(buffer, longitud, true);
+}
+
+const void *intentar_leer_registro(buffer_bytes_t *buffer, size_t *longitud) {
+    return bytes_leer(buffer, longitud, false);
+}
+
+int liberar_registro(buffer_bytes_t *buffer) {
+    if (!buffer || buffer->lectura_pendiente == 0) return -1;
+    size_t cola = atomic_load_explicit(&buffer->cola, memory_order_relaxed);
+    atomic_store_explicit(&buffer->cola, cola + buffer->lectura_pendiente, memory_order_release);
+    buffer->lectura_pendiente = 0;
+    despertar_si_espera(buffer, &buffer->productores_esperando, &buffer->cond_lleno);
+    return 0;
+}
@@ -0,0 +1,170 @@
+#include "../include/cola_prioridad.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Como mucho una promoción por envejecimiento cada tantos servicios
+#define SERVICIOS_POR_PROMOCION 4
+
+static uint64_t reloj_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+int carril_de_prioridad(prioridad_cola_t prioridad) {
+    int carril = (int)prioridad;
+    if (carril < 0) return 0;
+    if (carril >= NUM_CARRILES_PRIORIDAD) return NUM_CARRILES_PRIORIDAD - 1;
+    return carril;
+}
+
+bool inicializar_cola_prioridad(cola_prioridad_t *cola, size_t capacidad_carril,
+                                uint64_t espera_maxima_ns) {
+    if (!cola || capacidad_carril == 0) return false;
+
+    memset(cola, 0, sizeof(*cola));
+    cola->capacidad_carril = capacidad_carril;
+    cola->espera_maxima_ns = espera_maxima_ns;
+    for (int i = 0; i < NUM_CARRILES_PRIORIDAD; i++) {
+        carril_prioridad_t *c = &cola->carriles[i];
+        c->entradas = (entrada_prioridad_t *)malloc(capacidad_carril * sizeof(entrada_prioridad_t));
+        if (!c->entradas) {
+            for (int j = 0; j < i; j++) {
+                free(cola->carriles[j].entradas);
+                pthread_cond_destroy(&cola->carriles[j].cond_hueco);
+            }
+            return false;
+        }
+        pthread_cond_init(&c->cond_hueco, NULL);
+    }
+    pthread_mutex_init(&cola->mutex, NULL);
+    pthread_cond_init(&cola->cond_datos, NULL);
+    return true;
+}
+
+void cerrar_cola_prioridad(cola_prioridad_t *cola) {
+    if (!cola) return;
+    pthread_mutex_lock(&cola->mutex);
+    cola->cerrada = true;
+    pthread_cond_broadcast(&cola->cond_datos);
+    for (int i = 0; i < NUM_CARRILES_PRIORIDAD; i++) {
+        pthread_cond_broadcast(&cola->carriles[i].cond_hueco);
+    }
+    pthread_mutex_unlock(&cola->mutex);
+}
+
+void limpiar_cola_prioridad(cola_prioridad_t *cola) {
+    if (!cola) return;
+    cerrar_cola_prioridad(cola);
+    for (int i = 0; i < NUM_CARRILES_PRIORIDAD; i++) {
+        free(cola->carriles[i].entradas);
+        cola->carriles[i].entradas = NULL;
+        pthread_cond_destroy(&cola->carriles[i].cond_hueco);
+    }
+    pthread_cond_destroy(&cola->cond_datos);
+    pthread_mutex_destroy(&cola->mutex);
+}
+
+int producir_con_prioridad(cola_prioridad_t *cola, elemento_t valor, prioridad_cola_t prioridad) {
+    if (!cola) return -1;
+    int indice = carril_de_prioridad(prioridad);
+    carril_prioridad_t *c = &cola->carriles[indice];
+
+    pthread_mutex_lock(&cola->mutex);
+    while (c->num_elementos == cola->capacidad_carril && !cola->cerrada) {
+        c->productores_esperando++;
+        pthread_cond_wait(&c->cond_hueco, &cola->mutex);
+        c->productores_esperando--;
+    }
+    if (cola->cerrada) {
+        pthread_mutex_unlock(&cola->mutex);
+        return -1;
+    }
+
+    size_t posicion = (c->cabeza + c->num_elementos) % cola->capacidad_carril;
+    c->entradas[posicion].dato = valor;
+    c->entradas[posicion].encolado_ns = reloj_ns();
+    c->num_elementos++;
+    c->producidos++;
+    cola->mapa_no_vacios |= 1u << indice;
+    if (cola->consumidores_esperando > 0) pthread_cond_signal(&cola->cond_datos);
+    pthread_mutex_unlock(&cola->mutex);
+    return 0;
+}
+
+// Carril a servir. Sin envejecimiento, el superior no vacío. Con él, cada
+// cabeza puntúa su carril * espera_maxima + lo que lleva esperando (un nivel
+// por cada espera_maxima) y gana la puntuación más alta. Es servir primero el
+// plazo más cercano, y con la cola saturada igualaría el retraso de todos los
+// carriles, también el de los superiores; por eso tras una promoción se
+// sirve el superior no vacío las SERVICIOS_POR_PROMOCION - 1 veces siguientes.
+static int elegir_carril(cola_prioridad_t *cola) {
+    unsigned mapa = cola->mapa_no_vacios;
+    int superior = 31 - __builtin_clz(mapa);
+    if (cola->servicios_sin_promocion < SERVICIOS_POR_PROMOCION - 1) {
+        cola->servicios_sin_promocion++;
+        return superior;
+    }
+    if ((mapa & ((1u << superior) - 1u)) == 0 || cola->espera_maxima_ns == 0) return superior;
+
+    uint64_t ahora = reloj_ns();
+    uint64_t mejor = 0;
+    int elegido = superior;
+    while (mapa) {
+        int i = __builtin_ctz(mapa);
+        mapa &= mapa - 1u;
+        const carril_prioridad_t *c = &cola->carriles[i];
+        uint64_t puntuacion = (uint64_t)i * cola->espera_maxima_ns +
+                              (ahora - c->entradas[c->cabeza].encolado_ns);
+        if (puntuacion >= mejor) {  // En empate gana el carril superior
+            mejor = puntuacion;
+            elegido = i;
+        }
+    }
+    if (elegido != superior) {
+        cola->carriles[elegido].promovidos++;
+        cola->servicios_sin_promocion = 0;
+    }
+    return elegido;
+}
+
+int consumir_por_prioridad(cola_prioridad_t *cola, elemento_t *valor,
+                           prioridad_cola_t *prioridad, uint64_t *espera_ns) {
+    if (!cola || !valor) return -1;
+
+    pthread_mutex_lock(&cola->mutex);
+    while (cola->mapa_no_vacios == 0 && !cola->cerrada) {
+        cola->consumidores_esperando++;
+        pthread_cond_wait(&cola->cond_datos, &cola->mutex);
+        cola->consumidores_esperando--;
+    }
+    if (cola->mapa_no_vacios == 0) {
+        pthread_mutex_unlock(&cola->mutex);
+        return -1;
+    }
+
+    int indice = elegir_carril(cola);
+    carril_prioridad_t *c = &cola->carriles[indice];
+    entrada_prioridad_t entrada = c->entradas[c->cabeza];
+    c->cabeza = (c->cabeza + 1) % cola->capacidad_carril;
+    c->num_elementos--;
+    c->consumidos++;
+    if (c->num_elementos == 0) cola->mapa_no_vacios &= ~(1u << indice);
+    if (c->productores_esperando > 0) pthread_cond_signal(&c->cond_hueco);
+    pthread_mutex_unlock(&cola->mutex);
+
+    *valor = entrada.dato;
+    if (prioridad) *prioridad = (prioridad_cola_t)indice;
+    if (espera_ns) *espera_ns = reloj_ns() - entrada.encolado_ns;
+    return 0;
+}
+
+size_t ocupacion_cola_prioridad(cola_prioridad_t *cola) {
+    if (!cola) return 0;
+    size_t total = 0;
+    pthread_mutex_lock(&cola->mutex);
+    for (int i = 0; i < NUM_CARRILES_PRIORIDAD; i++) total += cola->carriles[i].num_elementos;
+    pthread_mutex_unlock(&cola->mutex);
+    return total;
+}
@@ -0,0 +1,54 @@
+#include "../include/histograma_latencia.h"
+#include <string.h>
+
+// Mayor valor que cae en la cubeta indice
+static uint64_t limite_superior_cubeta(unsigned indice) {
+    if (indice < 2 * SUBCUBETAS_HISTOGRAMA) return indice;
+    unsigned desplazamiento = indice / SUBCUBETAS_HISTOGRAMA - 1;
+    uint64_t mantisa = indice - desplazamiento * SUBCUBETAS_HISTOGRAMA;
+    // En la última cubeta (mantisa + 1) << 58 desborda a 0 y queda UINT64_MAX
+    return ((mantisa + 1) << desplazamiento) - 1;
+}
+
+void reiniciar_histograma(histograma_latencia_t *h) {
+    if (!h) return;
+    memset(h, 0, sizeof(*h));
+    h->minimo = UINT64_MAX;
+}
+
+void fusionar_histogramas(histograma_latencia_t *destino, const histograma_latencia_t *origen) {
+    if (!destino || !origen || origen->total == 0) return;
+    for (unsigned i = 0; i < NUM_CUBETAS_HISTOGRAMA; i++) {
+        destino->cubetas[i] += origen->cubetas[i];
+    }
+    destino->total += origen->total;
+    destino->suma += origen->suma;
+    if (origen->minimo < destino->minimo) destino->minimo = origen->minimo;
+    if (origen->maximo > destino->maximo) destino->maximo = origen->maximo;
+}
+
+uint64_t percentil_histograma(const histograma_latencia_t *h, double percentil) {
+    if (!h || h->total == 0) return 0;
+    if (percentil <= 0.0) return h->minimo;
+    if (percentil >= 100.0) return h->maximo;
+
+    // Rango del elemento buscado (1..total), redondeando hacia arriba
+    uint64_t objetivo = (uint64_t)(percentil / 100.0 * (double)h->total);
+    if ((double)objetivo < percentil / 100.0 * (double)h->total) objetivo++;
+    if (objetivo == 0) objetivo = 1;
+
+    uint64_t acumulado = 0;
+    for (unsigned i = 0; i < NUM_CUBETAS_HISTOGRAMA; i++) {
+        acumulado += h->cubetas[i];
+        if (acumulado >= objetivo) {
+            uint64_t limite = limite_superior_cubeta(i);
+            return limite < h->maximo ? limite : h->maximo;
+        }
+    }
+    return h->maximo;
+}
+
+double media_histograma(const histograma_latencia_t *h) {
+    if (!h || h->total == 0) return 0.0;
+    return h->suma / (double)h->total;
+}
@@ -4,6 +4,25 @@
 #include <unistd.h>
 #include <time.h>
 #include <errno.h>
+#include <stdint.h>
+#include <limits.h>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+static void inicializar_sincronizacion(buffer_circular_t *buffer) {
+    atomic_init(&buffer->cabeza, 0);
+    atomic_init(&buffer->cola, 0);
+    atomic_init(&buffer->espera_productores.esperando, 0);
+    atomic_init(&buffer->espera_productores.secuencia, 0);
+    atomic_init(&buffer->espera_consumidores.esperando, 0);
+    atomic_init(&buffer->espera_consumidores.secuencia, 0);
+    pthread_mutex_init(&buffer->mutex, NULL);
+    pthread_cond_init(&buffer->cond_lleno, NULL);
+    pthread_cond_init(&buffer->cond_vacio, NULL);
+}
 
 bool inicializar_buffer_circular(buffer_circular_t *buffer, size_t capacidad) {
     if (!buffer || capacidad == 0) return false;
@@ -11,12 +30,303 @@ bool inicializar_buffer_circular(buffer_circular_t *buffer, size_t capacidad) {
     buffer->buffer = (elemento_t *)malloc(capacidad * sizeof(elemento_t));
     if (!buffer->buffer) return false;
     buffer->capacidad = capacidad;
-    pthread_mutex_init(&buffer->mutex, NULL);
-    pthread_cond_init(&buffer->cond_lleno, NULL);
-    pthread_cond_init(&buffer->cond_vacio, NULL);
+    buffer->modo = MODO_BUFFER_MUTEX;
+    inicializar_sincronizacion(buffer);
     return true;
 }
 
+static size_t siguiente_potencia_dos(size_t n) {
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+bool inicializar_buffer_spsc(buffer_circular_t *buffer, size_t capacidad) {
+    if (!buffer || capacidad == 0) return false;
+    size_t capacidad_real = siguiente_potencia_dos(capacidad);
+    if (!inicializar_buffer_circular(buffer, capacidad_real)) return false;
+    buffer->modo = MODO_BUFFER_SPSC;
+    buffer->mascara = capacidad_real - 1;
+    return true;
+}
+
+bool inicializar_buffer_mpmc(buffer_circular_t *buffer, size_t capacidad) {
+    if (!buffer || capacidad == 0) return false;
+    // Con una sola celda la secuencia tras insertar coincidiría con la
+    // siguiente posición y el buffer nunca parecería lleno
+    size_t capacidad_real = siguiente_potencia_dos(capacidad < 2 ? 2 : capacidad);
+    memset(buffer, 0, sizeof(*buffer));
+    buffer->celdas = (celda_mpmc_t *)malloc(capacidad_real * sizeof(celda_mpmc_t));
+    if (!buffer->celdas) return false;
+    for (size_t i = 0; i < capacidad_real; i++) {
+        atomic_init(&buffer->celdas[i].secuencia, i);
+    }
+    buffer->capacidad = capacidad_real;
+    buffer->mascara = capacidad_real - 1;
+    buffer->modo = MODO_BUFFER_MPMC;
+    inicializar_sincronizacion(buffer);
+    return true;
+}
+
+void configurar_espera_activa(buffer_circular_t *buffer, unsigned vueltas) {
+    if (buffer) buffer->vueltas_espera = vueltas;
+}
+
+size_t ocupacion_buffer(const buffer_circular_t *buffer) {
+    if (!buffer) return 0;
+    if (buffer->modo == MODO_BUFFER_MUTEX) return buffer->contador;
+    // Leer primero la cola: ambos índices solo crecen, así cabeza >= cola
+    size_t cola = atomic_load_explicit(&buffer->cola, memory_order_acquire);
+    size_t cabeza = atomic_load_explicit(&buffer->cabeza, memory_order_acquire);
+    size_t ocupados_spsc = cabeza - cola;
+    return ocupados_spsc > buffer->capacidad ? buffer->capacidad : ocupados_spsc;
+}
+
+// ================================
+// Espera y despertar
+// ================================
+
+static inline void pausa_cpu(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+// Modo mutex: los contadores de espera se tocan con el mutex tomado
+static void mutex_despertar_si_espera(punto_espera_t *p, pthread_cond_t *cond, size_t movidos) {
+    if (atomic_load_explicit(&p->esperando, memory_order_relaxed) == 0) return;
+    if (movidos > 1) {
+        pthread_cond_broadcast(cond);
+    } else {
+        pthread_cond_signal(cond);
+    }
+}
+
+static int mutex_esperar(buffer_circular_t *b, punto_espera_t *p, pthread_cond_t *cond,
+                         const struct timespec *limite) {
+    atomic_fetch_add_explicit(&p->esperando, 1, memory_order_relaxed);
+    int rc = limite ? pthread_cond_timedwait(cond, &b->mutex, limite)
+                    : pthread_cond_wait(cond, &b->mutex);
+    atomic_fetch_sub_explicit(&p->esperando, 1, memory_order_relaxed);
+    return rc;
+}
+
+// Modos sin locks: se duerme con un futex sobre p->secuencia (Linux) o con
+// mutex + condición. La condición se comprueba siempre después de anunciarse
+// en p->esperando y de una barrera seq_cst, que se empareja con la de
+// despertar_si_espera(): o el que espera ve el índice nuevo o el que publica
+// ve el contador, nunca ninguna de las dos cosas.
+typedef bool (*condicion_espera_fn)(buffer_circular_t *b, void *ctx);
+
+#ifdef __linux__
+#define RELOJ_ESPERA CLOCK_MONOTONIC
+
+static int futex_esperar(atomic_uint *palabra, unsigned visto, const struct timespec *limite) {
+    // FUTEX_WAIT_BITSET interpreta el límite como instante absoluto de CLOCK_MONOTONIC
+    if (syscall(SYS_futex, (uint32_t *)palabra, FUTEX_WAIT_BITSET_PRIVATE, visto,
+                limite, NULL, FUTEX_BITSET_MATCH_ANY) == -1) {
+        return errno;
+    }
+    return 0;
+}
+
+static void futex_despertar(atomic_uint *palabra, int hilos) {
+    syscall(SYS_futex, (uint32_t *)palabra, FUTEX_WAKE_PRIVATE, hilos, NULL, NULL, 0);
+}
+#else
+#define RELOJ_ESPERA CLOCK_REALTIME
+#endif
+
+// Límite de 1 segundo que usan todas las esperas de consumidores
+static void limite_espera_consumidor(struct timespec *limite) {
+    clock_gettime(RELOJ_ESPERA, limite);
+    limite->tv_sec += 1;
+}
+
+static bool esperar_condicion(buffer_circular_t *b, punto_espera_t *p, pthread_cond_t *cond,
+                              condicion_espera_fn cumple, void *ctx, bool con_timeout) {
+    for (unsigned i = 0; i < b->vueltas_espera; i++) {
+        if (cumple(b, ctx)) return true;
+        pausa_cpu();
+    }
+
+    struct timespec limite;
+    if (con_timeout) limite_espera_consumidor(&limite);
+
+#ifdef __linux__
+    (void)cond;
+    for (;;) {
+        unsigned visto = atomic_load_explicit(&p->secuencia, memory_order_relaxed);
+        atomic_fetch_add_explicit(&p->esperando, 1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        bool listo = cumple(b, ctx);
+        // Si alguien publica entre la comprobación y el futex, 'secuencia' ya
+        // no vale 'visto' y el kernel vuelve enseguida (EAGAIN)
+        int rc = listo ? 0 : futex_esperar(&p->secuencia, visto, con_timeout ? &limite : NULL);
+        atomic_fetch_sub_explicit(&p->esperando, 1, memory_order_relaxed);
+        if (listo) return true;
+        if (rc == ETIMEDOUT) return cumple(b, ctx);
+    }
+#else
+    bool listo;
+    pthread_mutex_lock(&b->mutex);
+    atomic_fetch_add_explicit(&p->esperando, 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    while (!(listo = cumple(b, ctx))) {
+        int rc = con_timeout ? pthread_cond_timedwait(cond, &b->mutex, &limite)
+                             : pthread_cond_wait(cond, &b->mutex);
+        if (rc == ETIMEDOUT) {
+            listo = cumple(b, ctx);
+            break;
+        }
+    }
+    atomic_fetch_sub_explicit(&p->esperando, 1, memory_order_relaxed);
+    pthread_mutex_unlock(&b->mutex);
+    return listo;
+#endif
+}
+
+// Solo se hace la llamada al sistema si hay alguien durmiendo. Si se han
+// movido varios elementos se despierta a todos los que esperan.
+static void despertar_si_espera(buffer_circular_t *b, punto_espera_t *p,
+                                pthread_cond_t *cond, size_t movidos) {
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&p->esperando, memory_order_relaxed) == 0) return;
+#ifdef __linux__
+    (void)b;
+    (void)cond;
+    atomic_fetch_add_explicit(&p->secuencia, 1, memory_order_relaxed);
+    futex_despertar(&p->secuencia, movidos > 1 ? INT_MAX : 1);
+#else
+    pthread_mutex_lock(&b->mutex);
+    if (movidos > 1) {
+        pthread_cond_broadcast(cond);
+    } else {
+        pthread_cond_signal(cond);
+    }
+    pthread_mutex_unlock(&b->mutex);
+#endif
+}
+
+// ================================
+// Modo SPSC (sin locks en el camino rápido)
+// ================================
+
+// Copia con vuelta: como mucho dos memcpy por lote
+static void copiar_hacia_anillo(elemento_t *anillo, size_t capacidad, size_t inicio,
+                                const elemento_t *origen, size_t n) {
+    size_t primera = capacidad - inicio;
+    if (primera > n) primera = n;
+    memcpy(anillo + inicio, origen, primera * sizeof(elemento_t));
+    memcpy(anillo, origen + primera, (n - primera) * sizeof(elemento_t));
+}
+
+static void copiar_desde_anillo(const elemento_t *anillo, size_t capacidad, size_t inicio,
+                                elemento_t *destino, size_t n) {
+    size_t primera = capacidad - inicio;
+    if (primera > n) primera = n;
+    memcpy(destino, anillo + inicio, primera * sizeof(elemento_t));
+    memcpy(destino + primera, anillo, (n - primera) * sizeof(elemento_t));
+}
+
+// Huecos libres vistos por el productor. Solo relee la cola compartida cuando
+// la copia local no deja sitio para los elementos pedidos.
+static size_t spsc_huecos_libres(buffer_circular_t *b, size_t cabeza, size_t pedidos) {
+    size_t libres = b->capacidad - (cabeza - b->cola_cache);
+    if (libres < pedidos) {
+        b->cola_cache = atomic_load_explicit(&b->cola, memory_order_acquire);
+        libres = b->capacidad - (cabeza - b->cola_cache);
+    }
+    return libres;
+}
+
+static size_t spsc_elementos_disponibles(buffer_circular_t *b, size_t cola, size_t pedidos) {
+    size_t disponibles = b->cabeza_cache - cola;
+    if (disponibles < pedidos) {
+        b->cabeza_cache = atomic_load_explicit(&b->cabeza, memory_order_acquire);
+        disponibles = b->cabeza_cache - cola;
+    }
+    return disponibles;
+}
+
+static bool spsc_hay_hueco(buffer_circular_t *b, void *ctx) {
+    return spsc_huecos_libres(b, *(size_t *)ctx, 1) > 0;
+}
+
+static bool spsc_hay_datos(buffer_circular_t *b, void *ctx) {
+    return spsc_elementos_disponibles(b, *(size_t *)ctx, 1) > 0;
+}
+
+// Anillo realmente lleno: esperar hasta que el consumidor libere hueco
+static size_t spsc_esperar_hueco(buffer_circular_t *b, size_t cabeza) {
+    esperar_condicion(b, &b->espera_productores, &b->cond_lleno, spsc_hay_hueco, &cabeza, false);
+    return spsc_huecos_libres(b, cabeza, 1);
+}
+
+// Anillo realmente vacío: mismo timeout de 1 segundo que el modo mutex.
+// Devuelve 0 si vence el timeout.
+static size_t spsc_esperar_datos(buffer_circular_t *b, size_t cola) {
+    if (!esperar_condicion(b, &b->espera_consumidores, &b->cond_vacio, spsc_hay_datos, &cola, true)) {
+        return 0;
+    }
+    return spsc_elementos_disponibles(b, cola, 1);
+}
+
+static int spsc_producir(buffer_circular_t *b, elemento_t valor, bool bloqueante) {
+    size_t cabeza = atomic_load_explicit(&b->cabeza, memory_order_relaxed);
+
+    if (spsc_huecos_libres(b, cabeza, 1) == 0) {
+        if (!bloqueante) return -1;
+        spsc_esperar_hueco(b, cabeza);
+    }
+
+    b->buffer[cabeza & b->mascara] = valor;
+    atomic_store_explicit(&b->cabeza, cabeza + 1, memory_order_release);
+    despertar_si_espera(b, &b->espera_consumidores, &b->cond_vacio, 1);
+    return 0;
+}
+
+static int spsc_consumir(buffer_circular_t *b, elemento_t *valor, bool bloqueante) {
+    size_t cola = atomic_load_explicit(&b->cola, memory_order_relaxed);
+
+    if (spsc_elementos_disponibles(b, cola, 1) == 0) {
+        if (!bloqueante || spsc_esperar_datos(b, cola) == 0) return -1;
+    }
+
+    *valor = b->buffer[cola & b->mascara];
+    atomic_store_explicit(&b->cola, cola + 1, memory_order_release);
+    despertar_si_espera(b, &b->espera_productores, &b->cond_lleno, 1);
+    return 0;
+}
+
+static int spsc_producir_lote(buffer_circular_t *b, const elemento_t *valores, size_t n) {
+    size_t cabeza = atomic_load_explicit(&b->cabeza, memory_order_relaxed);
+
+    size_t libres = spsc_huecos_libres(b, cabeza, n);
+    if (libres == 0) libres = spsc_esperar_hueco(b, cabeza);
+
+    size_t k = n < libres ? n : libres;
+    copiar_hacia_anillo(b->buffer, b->capacidad, cabeza & b->mascara, valores, k);
+    atomic_store_explicit(&b->cabeza, cabeza + k, memory_order_release);
+    despertar_si_espera(b, &b->espera_consumidores, &b->cond_vacio, k);
+    return (int)k;
+}
+
+static int spsc_consumir_lote(buffer_circular_t *b, elemento_t *valores, size_t n) {
+    size_t cola = atomic_load_explicit(&b->cola, memory_order_relaxed);
+
+    size_t disponibles = spsc_elementos_disponibles(b, cola, n);
+    if (disponibles == 0 && (disponibles = spsc_esperar_datos(b, cola)) == 0) return -1;
+
+    size_t k = n < disponibles ? n : disponibles;
+    copiar_desde_anillo(b->buffer, b->capacidad, cola & b->mascara, valores, k);
+    atomic_store_explicit(&b->cola, cola + k, memory_order_release);
+    despertar_si_espera(b, &b->espera_productores, &b->cond_lleno, k);
+    return (int)k;
+}
+
 void limpiar_buffer_circular(buffer_circular_t *buffer) {
     if (!buffer) return;
     pthread_mutex_lock(&buffer->mutex);
@@ -27,25 +337,148 @@ void limpiar_buffer_circular(buffer_circular_t *buffer) {
     pthread_cond_destroy(&buffer->cond_vacio);
     pthread_mutex_destroy(&buffer->mutex);
     free(buffer->buffer);
+    free(buffer->celdas);
     memset(buffer, 0, sizeof(*buffer));
 }
 
+// ================================
+// Modo MPMC (cola acotada de Vyukov)
+// ================================
+
+static bool mpmc_intentar_producir(buffer_circular_t *b, elemento_t valor) {
+    size_t pos = atomic_load_explicit(&b->cabeza, memory_order_relaxed);
+    celda_mpmc_t *celda;
+
+    for (;;) {
+        celda = &b->celdas[pos & b->mascara];
+        size_t secuencia = atomic_load_explicit(&celda->secuencia, memory_order_acquire);
+        intptr_t diferencia = (intptr_t)secuencia - (intptr_t)pos;
+        if (diferencia == 0) {
+            // Celda libre para esta vuelta: reservar la posición
+            if (atomic_compare_exchange_weak_explicit(&b->cabeza, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diferencia < 0) {
+            return false;  // El consumidor de la vuelta anterior aún no la ha liberado: lleno
+        } else {
+            pos = atomic_load_explicit(&b->cabeza, memory_order_relaxed);
+        }
+    }
+
+    celda->dato = valor;
+    atomic_store_explicit(&celda->secuencia, pos + 1, memory_order_release);
+    return true;
+}
+
+static bool mpmc_intentar_consumir(buffer_circular_t *b, elemento_t *valor) {
+    size_t pos = atomic_load_explicit(&b->cola, memory_order_relaxed);
+    celda_mpmc_t *celda;
+
+    for (;;) {
+        celda = &b->celdas[pos & b->mascara];
+        size_t secuencia = atomic_load_explicit(&celda->secuencia, memory_order_acquire);
+        intptr_t diferencia = (intptr_t)secuencia - (intptr_t)(pos + 1);
+        if (diferencia == 0) {
+            if (atomic_compare_exchange_weak_explicit(&b->cola, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diferencia < 0) {
+            return false;  // El productor de esta posición aún no ha publicado: vacío
+        } else {
+            pos = atomic_load_explicit(&b->cola, memory_order_relaxed);
+        }
+    }
+
+    *valor = celda->dato;
+    // Dejar la celda lista para el productor de la siguiente vuelta
+    atomic_store_explicit(&celda->secuencia, pos + b->mascara + 1, memory_order_release);
+    return true;
+}
+
+static bool mpmc_producir_condicion(buffer_circular_t *b, void *ctx) {
+    return mpmc_intentar_producir(b, *(elemento_t *)ctx);
+}
+
+static bool mpmc_consumir_condicion(buffer_circular_t *b, void *ctx) {
+    return mpmc_intentar_consumir(b, (elemento_t *)ctx);
+}
+
+// Cola llena: esperar hasta poder insertar el valor
+static void mpmc_esperar_y_producir(buffer_circular_t *b, elemento_t valor) {
+    esperar_condicion(b, &b->espera_productores, &b->cond_lleno, mpmc_producir_condicion, &valor, false);
+}
+
+// Cola vacía: esperar hasta poder extraer un valor (false si vence el timeout)
+static bool mpmc_esperar_y_consumir(buffer_circular_t *b, elemento_t *valor) {
+    return esperar_condicion(b, &b->espera_consumidores, &b->cond_vacio, mpmc_consumir_condicion, valor, true);
+}
+
+static int mpmc_producir(buffer_circular_t *b, elemento_t valor, bool bloqueante) {
+    if (!mpmc_intentar_producir(b, valor)) {
+        if (!bloqueante) return -1;
+        mpmc_esperar_y_producir(b, valor);
+    }
+    despertar_si_espera(b, &b->espera_consumidores, &b->cond_vacio, 1);
+    return 0;
+}
+
+static int mpmc_consumir(buffer_circular_t *b, elemento_t *valor, bool bloqueante) {
+    if (!mpmc_intentar_consumir(b, valor)) {
+        if (!bloqueante || !mpmc_esperar_y_consumir(b, valor)) return -1;
+    }
+    despertar_si_espera(b, &b->espera_productores, &b->cond_lleno, 1);
+    return 0;
+}
+
+// En MPMC cada celda tiene su propia secuencia, así que el lote se reserva
+// celda a celda; lo que se ahorra es la espera y el despertar por elemento.
+static int mpmc_producir_lote(buffer_circular_t *b, const elemento_t *valores, size_t n) {
+    size_t k = 0;
+    while (k < n && mpmc_intentar_producir(b, valores[k])) k++;
+    if (k == 0) {
+        mpmc_esperar_y_producir(b, valores[0]);
+        k = 1;
+        while (k < n && mpmc_intentar_producir(b, valores[k])) k++;
+    }
+    despertar_si_espera(b, &b->espera_consumidores, &b->cond_vacio, k);
+    return (int)k;
+}
+
+static int mpmc_consumir_lote(buffer_circular_t *b, elemento_t *valores, size_t n) {
+    size_t k = 0;
+    while (k < n && mpmc_intentar_consumir(b, &valores[k])) k++;
+    if (k == 0) {
+        if (!mpmc_esperar_y_consumir(b, &valores[0])) return -1;
+        k = 1;
+        while (k < n && mpmc_intentar_consumir(b, &valores[k])) k++;
+    }
+    despertar_si_espera(b, &b->espera_productores, &b->cond_lleno, k);
+    return (int)k;
+}
+
 int producir_item(buffer_circular_t *buffer, elemento_t valor) {
     if (!buffer) return -1;
+    if (buffer->modo == MODO_BUFFER_SPSC) return spsc_producir(buffer, valor, true);
+    if (buffer->modo == MODO_BUFFER_MPMC) return mpmc_producir(buffer, valor, true);
     pthread_mutex_lock(&buffer->mutex);
     while (buffer->contador == buffer->capacidad) {
-        pthread_cond_wait(&buffer->cond_lleno, &buffer->mutex);
+        mutex_esperar(buffer, &buffer->espera_productores, &buffer->cond_lleno, NULL);
     }
     buffer->buffer[buffer->indice_entrada] = valor;
     buffer->indice_entrada = (buffer->indice_entrada + 1) % buffer->capacidad;
     buffer->contador++;
-    pthread_cond_signal(&buffer->cond_vacio);
+    // Solo se señaliza si algún consumidor duerme: sin carga no hay llamada al sistema
+    mutex_despertar_si_espera(&buffer->espera_consumidores, &buffer->cond_vacio, 1);
     pthread_mutex_unlock(&buffer->mutex);
     return 0;
 }
 
 int consumir_item(buffer_circular_t *buffer, elemento_t *valor) {
     if (!buffer || !valor) return -1;
+    if (buffer->modo == MODO_BUFFER_SPSC) return spsc_consumir(buffer, valor, true);
+    if (buffer->modo == MODO_BUFFER_MPMC) return mpmc_consumir(buffer, valor, true);
     
     pthread_mutex_lock(&buffer->mutex);
     
@@ -55,7 +488,7 @@ int consumir_item(buffer_circular_t *buffer, elemento_t *valor) {
     timeout.tv_sec += 1; // 1 segundo de timeout
     
     while (buffer->contador == 0) {
-        int result = pthread_cond_timedwait(&buffer->cond_vacio, &buffer->mutex, &timeout);
+        int result = mutex_esperar(buffer, &buffer->espera_consumidores, &buffer->cond_vacio, &timeout);
         if (result == ETIMEDOUT) {
             pthread_mutex_unlock(&buffer->mutex);
             return -1; // Timeout
@@ -66,7 +499,7 @@ int consumir_item(buffer_circular_t *buffer, elemento_t *valor) {
     buffer->indice_salida = (buffer->indice_salida + 1) % buffer->capacidad;
     buffer->contador--;
     
-    pthread_cond_signal(&buffer->cond_lleno);
+    mutex_despertar_si_espera(&buffer->espera_productores, &buffer->cond_lleno, 1);
     pthread_mutex_unlock(&buffer->mutex);
     
     return 0;
@@ -74,13 +507,15 @@ int consumir_item(buffer_circular_t *buffer, elemento_t *valor) {
 
 int insertar_item(buffer_circular_t *buffer, elemento_t valor) {
     if (!buffer) return -1;
+    if (buffer->modo == MODO_BUFFER_SPSC) return spsc_producir(buffer, valor, false);
+    if (buffer->modo == MODO_BUFFER_MPMC) return mpmc_producir(buffer, valor, false);
     int rc = -1;
     pthread_mutex_lock(&buffer->mutex);
     if (buffer->contador < buffer->capacidad) {
         buffer->buffer[buffer->indice_entrada] = valor;
         buffer->indice_entrada = (buffer->indice_entrada + 1) % buffer->capacidad;
         buffer->contador++;
-        pthread_cond_signal(&buffer->cond_vacio);
+        mutex_despertar_si_espera(&buffer->espera_consumidores, &buffer->cond_vacio, 1);
         rc = 0;
     }
     pthread_mutex_unlock(&buffer->mutex);
@@ -89,21 +524,91 @@ int insertar_item(buffer_circular_t *buffer, elemento_t valor) {
 
 int extraer_item(buffer_circular_t *buffer, elemento_t *valor) {
     if (!buffer || !valor) return -1;
+    if (buffer->modo == MODO_BUFFER_SPSC) return spsc_consumir(buffer, valor, false);
+    if (buffer->modo == MODO_BUFFER_MPMC) return mpmc_consumir(buffer, valor, false);
     int rc = -1;
     pthread_mutex_lock(&buffer->mutex);
     if (buffer->contador > 0) {
         *valor = buffer->buffer[buffer->indice_salida];
         buffer->indice_salida = (buffer->indice_salida + 1) % buffer->capacidad;
         buffer->contador--;
-        pthread_cond_signal(&buffer->cond_lleno);
+        mutex_despertar_si_espera(&buffer->espera_productores, &buffer->cond_lleno, 1);
         rc = 0;
     }
     pthread_mutex_unlock(&buffer->mutex);
     return rc;
 }
 
+int producir_lote(buffer_circular_t *buffer, const elemento_t *valores, size_t n) {
+    if (!buffer || !valores || n > INT_MAX) return -1;
+    if (n == 0) return 0;
+    if (buffer->modo == MODO_BUFFER_SPSC) return spsc_producir_lote(buffer, valores, n);
+    if (buffer->modo == MODO_BUFFER_MPMC) return mpmc_producir_lote(buffer, valores, n);
+
+    pthread_mutex_lock(&buffer->mutex);
+    while (buffer->contador == buffer->capacidad) {
+        mutex_esperar(buffer, &buffer->espera_productores, &buffer->cond_lleno, NULL);
+    }
+    size_t libres = buffer->capacidad - buffer->contador;
+    size_t k = n < libres ? n : libres;
+    copiar_hacia_anillo(buffer->buffer, buffer->capacidad, buffer->indice_entrada, valores, k);
+    buffer->indice_entrada = (buffer->indice_entrada + k) % buffer->capacidad;
+    buffer->contador += k;
+    // Un único despertar por lote; si hay varios items puede haber trabajo para varios
+    mutex_despertar_si_espera(&buffer->espera_consumidores, &buffer->cond_vacio, k);
+    pthread_mutex_unlock(&buffer->mutex);
+    return (int)k;
+}
+
+int consumir_lote(buffer_circular_t *buffer, elemento_t *valores, size_t n) {
+    if (!buffer || !valores || n > INT_MAX) return -1;
+    if (n == 0) return 0;
+    if (buffer->modo == MODO_BUFFER_SPSC) return spsc_consumir_lote(buffer, valores, n);
+    if (buffer->modo == MODO_BUFFER_MPMC) return mpmc_consumir_lote(buffer, valores, n);
+
+    pthread_mutex_lock(&buffer->mutex);
+
+    struct timespec timeout;
+    clock_gettime(CLOCK_REALTIME, &timeout);
+    timeout.tv_sec += 1; // 1 segundo de timeout, igual que consumir_item
+
+    while (buffer->contador == 0) {
+        if (mutex_esperar(buffer, &buffer->espera_consumidores, &buffer->cond_vacio, &timeout) == ETIMEDOUT) {
+            pthread_mutex_unlock(&buffer->mutex);
+            return -1;
+        }
+    }
+    size_t k = n < buffer->contador ? n : buffer->contador;
+    copiar_desde_anillo(buffer->buffer, buffer->capacidad, buffer->indice_salida, valores, k);
+    buffer->indice_salida = (buffer->indice_salida + k) % buffer->capacidad;
+    buffer->contador -= k;
+    mutex_despertar_si_espera(&buffer->espera_productores, &buffer->cond_lleno, k);
+    pthread_mutex_unlock(&buffer->mutex);
+    return (int)k;
+}
+
 void* hilo_productor(void *arg) {
     productor_args_t *p = (productor_args_t *)arg;
+    if (p->tam_lote > 1) {
+        elemento_t *lote = (elemento_t *)malloc((size_t)p->tam_lote * sizeof(elemento_t));
+        if (!lote) return NULL;
+        int enviados = 0;
+        while (enviados < p->num_datos) {
+            int pendientes = p->num_datos - enviados;
+            int n = pendientes < p->tam_lote ? pendientes : p->tam_lote;
+            for (int i = 0; i < n; i++) lote[i] = rand() % 100;
+            // producir_lote puede aceptar menos de n si el buffer tiene poco hueco
+            for (int i = 0; i < n; ) {
+                int r = producir_lote(p->buffer, lote + i, (size_t)(n - i));
+                if (r < 0) break;
+                i += r;
+            }
+            enviados += n;
+            if (p->delay_us > 0) usleep(p->delay_us);
+        }
+        free(lote);
+        return NULL;
+    }
     for (int i = 0; i < p->num_datos; i++) {
         int dato = rand() % 100;
         producir_item(p->buffer, dato);
@@ -115,6 +620,22 @@ void* hilo_productor(void *arg) {
 void* hilo_consumidor(void *arg) {
     consumidor_args_t *c = (consumidor_args_t *)arg;
     c->suma = 0;
+    if (c->tam_lote > 1) {
+        elemento_t *lote = (elemento_t *)malloc((size_t)c->tam_lote * sizeof(elemento_t));
+        if (!lote) return NULL;
+        int recibidos = 0;
+        while (recibidos < c->num_datos) {
+            int pendientes = c->num_datos - recibidos;
+            int n = pendientes < c->tam_lote ? pendientes : c->tam_lote;
+            int r = consumir_lote(c->buffer, lote, (size_t)n);
+            if (r < 0) break;  // 1 s sin datos: el productor ya no envía más
+            for (int i = 0; i < r; i++) c->suma += lote[i];
+            recibidos += r;
+            if (c->delay_us > 0) usleep(c->delay_us);
+        }
+        free(lote);
+        return NULL;
+    }
     for (int i = 0; i < c->num_datos; i++) {
         int dato = 0;
         consumir_item(c->buffer, &dato);
@@ -128,8 +649,13 @@ void* hilo_consumidor(void *arg) {
 // API de compatibilidad para tests
 // ================================
 
+// La estructura está alineada a línea de caché; malloc no lo garantiza
+static buffer_circular_t* reservar_estructura_buffer(void) {
+    return aligned_alloc(_Alignof(buffer_circular_t), sizeof(buffer_circular_t));
+}
+
 buffer_circular_t* crear_buffer(size_t capacidad) {
-    buffer_circular_t* buffer = malloc(sizeof(buffer_circular_t));
+    buffer_circular_t* buffer = reservar_estructura_buffer();
     if (!buffer) return NULL;
     
     if (!inicializar_buffer_circular(buffer, capacidad)) {
@@ -140,6 +666,30 @@ buffer_circular_t* crear_buffer(size_t capacidad) {
     return buffer;
 }
 
+buffer_circular_t* crear_buffer_spsc(size_t capacidad) {
+    buffer_circular_t* buffer = reservar_estructura_buffer();
+    if (!buffer) return NULL;
+    
+    if (!inicializar_buffer_spsc(buffer, capacidad)) {
+        free(buffer);
+        return NULL;
+    }
+    
+    return buffer;
+}
+
+buffer_circular_t* crear_buffer_mpmc(size_t capacidad) {
+    buffer_circular_t* buffer = reservar_estructura_buffer();
+    if (!buffer) return NULL;
+    
+    if (!inicializar_buffer_mpmc(buffer, capacidad)) {
+        free(buffer);
+        return NULL;
+    }
+    
+    return buffer;
+}
+
 void destruir_buffer(buffer_circular_t* buffer) {
     if (buffer) {
         limpiar_buffer_circular(buffer);
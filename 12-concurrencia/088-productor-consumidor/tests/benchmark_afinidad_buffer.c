@@ -0,0 +1,174 @@
+/**
+ * @file benchmark_afinidad_buffer.c
+ * @brief Throughput del buffer según dónde se colocan productores y consumidores
+ *
+ * Los productores reciben los índices 0..P-1 de la política y los
+ * consumidores P..P+C-1, así que con la política compacta el primer
+ * consumidor cae en el hermano SMT (o el núcleo vecino) del primer productor
+ * y los índices del anillo viajan por la L1/L2 compartida. Con la dispersa
+ * cada extremo queda en otro dominio L3 o nodo y cada traspaso de línea de
+ * caché cruza la interconexión.
+ *
+ * Uso: benchmark_afinidad_buffer [elementos] [capacidad]
+ *      AFINIDAD_HILOS no se usa: se prueban todas las políticas
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../include/productor_consumidor.h"
+#include "topologia_cpu.h"
+
+#define ELEMENTOS_POR_DEFECTO 2000000
+#define CAPACIDAD_POR_DEFECTO 1024
+#define VUELTAS_ESPERA_ACTIVA 256
+#define MAX_HILOS_EXTREMO 8
+
+typedef struct {
+    buffer_circular_t* buffer;
+    int primero;          // Primer valor que produce este hilo
+    int cantidad;         // Elementos que produce o consume
+    long long suma;       // Consumidores: suma de lo recibido
+} extremo_t;
+
+static void* productor(void* arg) {
+    extremo_t* e = arg;
+    for (int i = 0; i < e->cantidad; i++) {
+        producir_item(e->buffer, (e->primero + i) & 1023);
+    }
+    return NULL;
+}
+
+static void* consumidor(void* arg) {
+    extremo_t* e = arg;
+    e->suma = 0;
+    for (int i = 0; i < e->cantidad; i++) {
+        elemento_t valor;
+        if (consumir_item(e->buffer, &valor) != 0) {
+            break;  // 1 s sin datos
+        }
+        e->suma += valor;
+    }
+    return NULL;
+}
+
+static double segundos_desde(const struct timespec* inicio) {
+    struct timespec fin;
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    return (double)(fin.tv_sec - inicio->tv_sec) + (fin.tv_nsec - inicio->tv_nsec) / 1e9;
+}
+
+// Devuelve millones de elementos por segundo, o -1 si la suma no cuadra
+static double medir(modo_buffer_t modo, int productores, int consumidores,
+                    int elementos, size_t capacidad, politica_afinidad_t politica) {
+    buffer_circular_t buffer;
+    bool iniciado = false;
+    switch (modo) {
+        case MODO_BUFFER_MUTEX: iniciado = inicializar_buffer_circular(&buffer, capacidad); break;
+        case MODO_BUFFER_SPSC:  iniciado = inicializar_buffer_spsc(&buffer, capacidad); break;
+        case MODO_BUFFER_MPMC:  iniciado = inicializar_buffer_mpmc(&buffer, capacidad); break;
+    }
+    if (!iniciado) {
+        return -1.0;
+    }
+    if (modo != MODO_BUFFER_MUTEX) {
+        configurar_espera_activa(&buffer, VUELTAS_ESPERA_ACTIVA);
+    }
+
+    pthread_t hilos[2 * MAX_HILOS_EXTREMO];
+    extremo_t extremos[2 * MAX_HILOS_EXTREMO];
+    int por_productor = elementos / productores;
+    int por_consumidor = elementos / consumidores;
+    int total = por_productor * productores;
+    long long esperada = 0;
+    for (int i = 0; i < total; i++) {
+        esperada += i & 1023;
+    }
+
+    struct timespec inicio;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    int creados = 0;
+    for (int i = 0; i < productores + consumidores; i++) {
+        bool es_productor = i < productores;
+        extremos[i] = (extremo_t){
+            .buffer = &buffer,
+            .primero = es_productor ? i * por_productor : 0,
+            .cantidad = es_productor ? por_productor : por_consumidor,
+        };
+        // El último consumidor recoge el resto de la división
+        if (!es_productor && i == productores + consumidores - 1) {
+            extremos[i].cantidad = total - por_consumidor * (consumidores - 1);
+        }
+        if (crear_hilo_con_afinidad(&hilos[i], es_productor ? productor : consumidor,
+                                    &extremos[i], politica, i) != 0) {
+            break;
+        }
+        creados++;
+    }
+    for (int i = 0; i < creados; i++) {
+        pthread_join(hilos[i], NULL);
+    }
+    double segundos = segundos_desde(&inicio);
+
+    long long suma = 0;
+    for (int i = productores; i < creados; i++) {
+        suma += extremos[i].suma;
+    }
+    limpiar_buffer_circular(&buffer);
+    if (creados != productores + consumidores || suma != esperada || segundos <= 0.0) {
+        return -1.0;
+    }
+    return total / segundos / 1e6;
+}
+
+int main(int argc, char* argv[]) {
+    int elementos = (argc > 1) ? atoi(argv[1]) : ELEMENTOS_POR_DEFECTO;
+    size_t capacidad = (argc > 2) ? (size_t)atol(argv[2]) : CAPACIDAD_POR_DEFECTO;
+    if (elementos <= 0 || capacidad == 0) {
+        fprintf(stderr, "Uso: %s [elementos] [capacidad]\n", argv[0]);
+        return 1;
+    }
+
+    const topologia_cpu_t* topologia = obtener_topologia_cpu();
+    mostrar_topologia_cpu(topologia);
+
+    struct {
+        const char* nombre;
+        modo_buffer_t modo;
+        int productores;
+        int consumidores;
+    } configuraciones[] = {
+        { "SPSC 1P/1C", MODO_BUFFER_SPSC, 1, 1 },
+        { "MPMC 2P/2C", MODO_BUFFER_MPMC, 2, 2 },
+        { "Mutex 2P/2C", MODO_BUFFER_MUTEX, 2, 2 },
+    };
+    int num_configuraciones = (int)(sizeof(configuraciones) / sizeof(configuraciones[0]));
+
+    printf("\n=== THROUGHPUT DEL BUFFER POR POLÍTICA DE AFINIDAD ===\n");
+    printf("%d elementos, capacidad %zu (millones de elementos/s)\n\n", elementos, capacidad);
+    printf("%-12s", "");
+    for (int p = 0; p < NUM_POLITICAS_AFINIDAD; p++) {
+        printf(" %10s", nombre_politica_afinidad((politica_afinidad_t)p));
+    }
+    printf("\n");
+
+    bool correcto = true;
+    for (int c = 0; c < num_configuraciones; c++) {
+        printf("%-12s", configuraciones[c].nombre);
+        for (int p = 0; p < NUM_POLITICAS_AFINIDAD; p++) {
+            double mops = medir(configuraciones[c].modo, configuraciones[c].productores,
+                                configuraciones[c].consumidores, elementos, capacidad,
+                                (politica_afinidad_t)p);
+            if (mops < 0.0) {
+                printf(" %10s", "ERROR");
+                correcto = false;
+            } else {
+                printf(" %10.2f", mops);
+            }
+            fflush(stdout);
+        }
+        printf("\n");
+    }
+
+    return correcto ? 0 : 1;
+}
@@ -0,0 +1,268 @@
+/**
+ * @file benchmark_cola_prioridad.c
+ * @brief Latencia por prioridad de la cola multicarril bajo saturación
+ *
+ * Un productor por nivel de prioridad envía a ritmo fijo (bucle abierto) y
+ * la suma de los ritmos es mayor que lo que pueden servir los consumidores,
+ * así que la cola está siempre saturada. Cada consumidor simula trabajo por
+ * elemento y anota cuánto esperó cada elemento desde que se encoló.
+ *
+ * Se comparan tres escenarios con la misma carga:
+ * - FIFO: todo en un carril, como el buffer circular
+ * - Prioridad estricta: sin envejecimiento
+ * - Con envejecimiento: cada elemento sube un nivel por cada espera máxima
+ *   que pasa en la cola, pero tras cada promoción se sirve el carril
+ *   superior las 3 veces siguientes (como mucho 1 promoción cada 4
+ *   servicios, ver SERVICIOS_POR_PROMOCION en cola_prioridad.c)
+ *
+ * Uso: benchmark_cola_prioridad [duracion_ms] [espera_maxima_us]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../include/cola_prioridad.h"
+
+#define NUM_CONSUMIDORES 2
+#define TRABAJO_POR_ELEMENTO_NS 5000      // Cada consumidor sirve 200k elementos/s
+#define CAPACIDAD_CARRIL 256
+#define MAX_MUESTRAS_LATENCIA 4096        // Por consumidor y prioridad (reservorio)
+#define INTERVALO_PRODUCTOR_NS 100000     // Cada cuánto despierta un productor
+#define DURACION_MS_DEFAULT 1000
+#define ESPERA_MAXIMA_US_DEFAULT 2000
+
+// Carga ofrecida por nivel en % de la capacidad de los consumidores (150% en total)
+static const struct {
+    prioridad_cola_t prioridad;
+    const char *nombre;
+    int porcentaje_carga;
+} niveles[NUM_CARRILES_PRIORIDAD] = {
+    { PRIORIDAD_CRITICA, "CRITICA", 20 },
+    { PRIORIDAD_ALTA, "ALTA", 30 },
+    { PRIORIDAD_MEDIA, "MEDIA", 40 },
+    { PRIORIDAD_BAJA, "BAJA", 60 },
+};
+
+typedef struct {
+    cola_prioridad_t *cola;
+    prioridad_cola_t prioridad; // Prioridad con la que se encola
+    int nivel;                  // Nivel real (índice en niveles[]), viaja como dato
+    double elementos_por_ns;
+    const int *detener;
+    uint64_t enviados;
+} productor_t;
+
+typedef struct {
+    uint64_t servidos;
+    uint64_t latencia_max_ns;
+    uint64_t muestras[MAX_MUESTRAS_LATENCIA];
+} latencias_nivel_t;
+
+typedef struct {
+    cola_prioridad_t *cola;
+    uint64_t semilla;
+    latencias_nivel_t niveles[NUM_CARRILES_PRIORIDAD];
+} consumidor_t;
+
+typedef struct {
+    uint64_t valor;
+    double peso;
+} muestra_ponderada_t;
+
+static uint64_t reloj_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t siguiente_aleatorio(uint64_t *estado) {
+    // xorshift64: suficiente para elegir qué muestra reemplazar
+    uint64_t x = *estado;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *estado = x;
+    return x;
+}
+
+static void *hilo_productor_ritmo(void *arg) {
+    productor_t *p = (productor_t *)arg;
+    uint64_t inicio = reloj_ns();
+    struct timespec pausa = { 0, INTERVALO_PRODUCTOR_NS };
+
+    while (!__atomic_load_n(p->detener, __ATOMIC_RELAXED)) {
+        // Bucle abierto: envía lo que toca según el tiempo transcurrido
+        uint64_t debidos = (uint64_t)((double)(reloj_ns() - inicio) * p->elementos_por_ns);
+        while (p->enviados < debidos && !__atomic_load_n(p->detener, __ATOMIC_RELAXED)) {
+            if (producir_con_prioridad(p->cola, p->nivel, p->prioridad) != 0) return NULL;
+            p->enviados++;
+        }
+        nanosleep(&pausa, NULL);
+    }
+    return NULL;
+}
+
+static void *hilo_consumidor_latencia(void *arg) {
+    consumidor_t *c = (consumidor_t *)arg;
+    elemento_t nivel;
+    uint64_t espera;
+
+    while (consumir_por_prioridad(c->cola, &nivel, NULL, &espera) == 0) {
+        latencias_nivel_t *l = &c->niveles[nivel];
+        if (espera > l->latencia_max_ns) l->latencia_max_ns = espera;
+        if (l->servidos < MAX_MUESTRAS_LATENCIA) {
+            l->muestras[l->servidos] = espera;
+        } else {
+            uint64_t j = siguiente_aleatorio(&c->semilla) % (l->servidos + 1);
+            if (j < MAX_MUESTRAS_LATENCIA) l->muestras[j] = espera;
+        }
+        l->servidos++;
+
+        // Trabajo simulado: espera activa para no ceder la CPU
+        uint64_t fin = reloj_ns() + TRABAJO_POR_ELEMENTO_NS;
+        while (reloj_ns() < fin) { }
+    }
+    return NULL;
+}
+
+static int comparar_muestras(const void *a, const void *b) {
+    uint64_t x = ((const muestra_ponderada_t *)a)->valor;
+    uint64_t y = ((const muestra_ponderada_t *)b)->valor;
+    return (x > y) - (x < y);
+}
+
+static uint64_t percentil_ponderado(const muestra_ponderada_t *muestras, int n,
+                                    double peso_total, double percentil) {
+    double objetivo = peso_total * percentil / 100.0;
+    double acumulado = 0.0;
+    for (int i = 0; i < n; i++) {
+        acumulado += muestras[i].peso;
+        if (acumulado >= objetivo) return muestras[i].valor;
+    }
+    return n > 0 ? muestras[n - 1].valor : 0;
+}
+
+static void mostrar_nivel(const char *escenario, int nivel, consumidor_t *consumidores,
+                          uint64_t enviados, uint64_t promovidos, double segundos) {
+    muestra_ponderada_t muestras[NUM_CONSUMIDORES * MAX_MUESTRAS_LATENCIA];
+    int n = 0;
+    double peso_total = 0.0;
+    uint64_t servidos = 0, maximo = 0;
+
+    for (int i = 0; i < NUM_CONSUMIDORES; i++) {
+        const latencias_nivel_t *l = &consumidores[i].niveles[nivel];
+        servidos += l->servidos;
+        if (l->latencia_max_ns > maximo) maximo = l->latencia_max_ns;
+        int guardadas = l->servidos < MAX_MUESTRAS_LATENCIA ? (int)l->servidos
+                                                            : MAX_MUESTRAS_LATENCIA;
+        for (int j = 0; j < guardadas; j++) {
+            muestras[n].valor = l->muestras[j];
+            muestras[n].peso = (double)l->servidos / guardadas;
+            n++;
+        }
+        peso_total += (double)l->servidos;
+    }
+    qsort(muestras, (size_t)n, sizeof(muestra_ponderada_t), comparar_muestras);
+
+    printf("%-20s %-8s %10llu %10llu %9.0f %10.1f %10.1f %10.1f %10llu\n",
+           escenario, niveles[nivel].nombre,
+           (unsigned long long)enviados, (unsigned long long)servidos,
+           segundos > 0.0 ? servidos / segundos : 0.0,
+           percentil_ponderado(muestras, n, peso_total, 50.0) / 1000.0,
+           percentil_ponderado(muestras, n, peso_total, 99.0) / 1000.0,
+           maximo / 1000.0, (unsigned long long)promovidos);
+}
+
+static bool ejecutar_escenario(const char *nombre, bool un_carril, uint64_t espera_maxima_ns,
+                               int duracion_ms) {
+    cola_prioridad_t cola;
+    if (!inicializar_cola_prioridad(&cola, CAPACIDAD_CARRIL, espera_maxima_ns)) return false;
+
+    productor_t productores[NUM_CARRILES_PRIORIDAD];
+    consumidor_t *consumidores = calloc(NUM_CONSUMIDORES, sizeof(consumidor_t));
+    pthread_t hilos_productores[NUM_CARRILES_PRIORIDAD];
+    pthread_t hilos_consumidores[NUM_CONSUMIDORES];
+    if (!consumidores) {
+        limpiar_cola_prioridad(&cola);
+        return false;
+    }
+
+    int detener = 0;
+    double capacidad_por_ns = (double)NUM_CONSUMIDORES / TRABAJO_POR_ELEMENTO_NS;
+    int productores_creados = 0, consumidores_creados = 0;
+    for (int i = 0; i < NUM_CONSUMIDORES; i++) {
+        consumidores[i].cola = &cola;
+        consumidores[i].semilla = 0x9E3779B97F4A7C15ull * (uint64_t)(i + 1);
+        if (pthread_create(&hilos_consumidores[i], NULL, hilo_consumidor_latencia,
+                           &consumidores[i]) != 0) break;
+        consumidores_creados++;
+    }
+    uint64_t inicio = reloj_ns();
+    for (int i = 0; i < NUM_CARRILES_PRIORIDAD; i++) {
+        productores[i] = (productor_t){
+            .cola = &cola,
+            .prioridad = un_carril ? PRIORIDAD_BAJA : niveles[i].prioridad,
+            .nivel = i,
+            .elementos_por_ns = capacidad_por_ns * niveles[i].porcentaje_carga / 100.0,
+            .detener = &detener,
+        };
+        if (pthread_create(&hilos_productores[i], NULL, hilo_productor_ritmo,
+                           &productores[i]) != 0) break;
+        productores_creados++;
+    }
+
+    struct timespec duracion = { duracion_ms / 1000, (long)(duracion_ms % 1000) * 1000000L };
+    nanosleep(&duracion, NULL);
+    __atomic_store_n(&detener, 1, __ATOMIC_RELAXED);
+    // Los productores pueden estar bloqueados en un carril lleno: cerrar los despierta
+    cerrar_cola_prioridad(&cola);
+    double segundos = (reloj_ns() - inicio) / 1e9;
+    for (int i = 0; i < productores_creados; i++) pthread_join(hilos_productores[i], NULL);
+    for (int i = 0; i < consumidores_creados; i++) pthread_join(hilos_consumidores[i], NULL);
+
+    for (int i = 0; i < NUM_CARRILES_PRIORIDAD; i++) {
+        uint64_t promovidos = un_carril ? 0
+            : cola.carriles[carril_de_prioridad(niveles[i].prioridad)].promovidos;
+        mostrar_nivel(nombre, i, consumidores, productores[i].enviados, promovidos, segundos);
+    }
+    printf("\n");
+
+    bool ok = productores_creados == NUM_CARRILES_PRIORIDAD &&
+              consumidores_creados == NUM_CONSUMIDORES;
+    free(consumidores);
+    limpiar_cola_prioridad(&cola);
+    return ok;
+}
+
+int main(int argc, char *argv[]) {
+    int duracion_ms = argc > 1 ? atoi(argv[1]) : DURACION_MS_DEFAULT;
+    long espera_maxima_us = argc > 2 ? atol(argv[2]) : ESPERA_MAXIMA_US_DEFAULT;
+    if (duracion_ms <= 0 || espera_maxima_us <= 0) {
+        fprintf(stderr, "Uso: %s [duracion_ms] [espera_maxima_us]\n", argv[0]);
+        return 1;
+    }
+
+    printf("=== LATENCIA POR PRIORIDAD CON CARGA SATURADA ===\n");
+    printf("%d consumidores x %d ns por elemento, carriles de %d, %d ms por escenario\n",
+           NUM_CONSUMIDORES, TRABAJO_POR_ELEMENTO_NS, CAPACIDAD_CARRIL, duracion_ms);
+    printf("Carga ofrecida:");
+    int total = 0;
+    for (int i = 0; i < NUM_CARRILES_PRIORIDAD; i++) {
+        printf(" %s %d%%", niveles[i].nombre, niveles[i].porcentaje_carga);
+        total += niveles[i].porcentaje_carga;
+    }
+    printf(" (total %d%% de la capacidad)\n\n", total);
+
+    printf("%-20s %-8s %10s %10s %9s %10s %10s %10s %10s\n", "Escenario", "Nivel",
+           "Enviados", "Servidos", "Serv/s", "p50 us", "p99 us", "max us", "Promovidos");
+
+    char envejecimiento[48];
+    snprintf(envejecimiento, sizeof(envejecimiento), "Envejecimiento %ldus",
+             espera_maxima_us);
+    bool ok = ejecutar_escenario("FIFO (un carril)", true, 0, duracion_ms) &&
+              ejecutar_escenario("Prioridad estricta", false, 0, duracion_ms) &&
+              ejecutar_escenario(envejecimiento, false, (uint64_t)espera_maxima_us * 1000u,
+                                 duracion_ms);
+    return ok ? 0 : 1;
+}
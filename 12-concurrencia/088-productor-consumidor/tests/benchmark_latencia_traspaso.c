@@ -0,0 +1,289 @@
+/**
+ * @file benchmark_latencia_traspaso.c
+ * @brief Latencia de traspaso por elemento (percentiles HDR) de cada modo del buffer
+ *
+ * El productor marca cada elemento con el instante en que debía salir y el
+ * consumidor registra la diferencia al volver de consumir_item en un
+ * histograma log-lineal por hilo. En bucle abierto ese instante es el
+ * programado (inicio + k * intervalo), no el de la llamada: si el productor
+ * se retrasa porque el buffer estaba lleno, el retraso cuenta como latencia
+ * en lugar de desaparecer (omisión coordinada). En bucle cerrado no hay
+ * calendario y la marca es el reloj justo antes de producir. La marca viaja como el
+ * propio dato: los 32 bits bajos de los nanosegundos desde el arranque, que
+ * restados módulo 2^32 dan latencias correctas hasta ~4 s.
+ *
+ * Dos tipos de carga:
+ * - Bucle abierto: cada productor envía a ritmo fijo, sin esperar a que se
+ *   consuma nada. Si el consumidor se atrasa el elemento espera en el buffer y
+ *   eso aparece en la cola del histograma en lugar de bajar el ritmo.
+ * - Bucle cerrado: los productores envían tan rápido como el buffer acepta.
+ *   El buffer pasa casi todo el tiempo lleno, así que la latencia es la de
+ *   atravesarlo entero (ley de Little: capacidad / throughput).
+ *
+ * Uso: benchmark_latencia_traspaso [elementos] [elementos_por_s] [capacidad]
+ *      AFINIDAD_HILOS fija productores (índices 0..P-1) y consumidores (P..)
+ */
+
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../include/productor_consumidor.h"
+#include "../include/histograma_latencia.h"
+#include "topologia_cpu.h"
+
+#define ELEMENTOS_POR_DEFECTO 100000
+#define RITMO_POR_DEFECTO 100000          // Elementos/s en bucle abierto (total)
+#define CAPACIDAD_POR_DEFECTO 1024
+#define TAM_LOTE 32
+#define VUELTAS_ESPERA_ACTIVA 256
+#define MAX_HILOS_EXTREMO 4
+#define ESPERA_MINIMA_DORMIR_NS 100000    // Más lejos que esto se duerme; si no, sched_yield
+
+typedef struct {
+    const char *nombre;
+    modo_buffer_t modo;
+    int tam_lote;          // 1: item a item
+    int productores;
+    int consumidores;
+} variante_t;
+
+static const variante_t variantes[] = {
+    { "Mutex", MODO_BUFFER_MUTEX, 1, 1, 1 },
+    { "Mutex por lotes", MODO_BUFFER_MUTEX, TAM_LOTE, 1, 1 },
+    { "SPSC sin locks", MODO_BUFFER_SPSC, 1, 1, 1 },
+    { "MPMC sin locks", MODO_BUFFER_MPMC, 1, 1, 1 },
+    { "Mutex", MODO_BUFFER_MUTEX, 1, 2, 2 },
+    { "Mutex por lotes", MODO_BUFFER_MUTEX, TAM_LOTE, 2, 2 },
+    { "MPMC sin locks", MODO_BUFFER_MPMC, 1, 2, 2 },
+};
+
+typedef struct {
+    buffer_circular_t *buffer;
+    int cantidad;            // Elementos que produce o consume este hilo
+    int tam_lote;
+    uint64_t intervalo_ns;   // Productor en bucle abierto; 0 = bucle cerrado
+    uint64_t desfase_ns;     // Escalona los productores dentro del intervalo
+    histograma_latencia_t *histograma;  // Consumidor
+    int recibidos;
+} extremo_t;
+
+static uint64_t base_ns;  // Origen de las marcas de tiempo
+
+static uint64_t reloj_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static elemento_t marca_en(uint64_t instante) {
+    return (elemento_t)(uint32_t)(instante - base_ns);
+}
+
+static elemento_t marca_tiempo(void) {
+    return marca_en(reloj_ns());
+}
+
+static uint64_t latencia_desde(elemento_t marca, uint32_t ahora) {
+    return (uint32_t)(ahora - (uint32_t)marca);
+}
+
+// Espera hasta el instante 'objetivo' sin acaparar la CPU del consumidor
+static void esperar_hasta(uint64_t objetivo) {
+    uint64_t ahora;
+    while ((ahora = reloj_ns()) < objetivo) {
+        if (objetivo - ahora > ESPERA_MINIMA_DORMIR_NS) {
+            struct timespec pausa = { 0, (long)(objetivo - ahora - ESPERA_MINIMA_DORMIR_NS / 2) };
+            nanosleep(&pausa, NULL);
+        } else {
+            sched_yield();
+        }
+    }
+}
+
+static void *productor(void *arg) {
+    extremo_t *e = (extremo_t *)arg;
+    elemento_t lote[TAM_LOTE];
+    uint64_t inicio = reloj_ns() + e->desfase_ns;
+    int enviados = 0;
+
+    while (enviados < e->cantidad) {
+        int n = 1;
+        if (e->intervalo_ns > 0) {
+            // Bucle abierto: espera al siguiente elemento programado y luego
+            // agrupa en el lote los que ya deberían haber salido
+            esperar_hasta(inicio + (uint64_t)enviados * e->intervalo_ns);
+            if (e->tam_lote > 1) {
+                uint64_t debidos = (reloj_ns() - inicio) / e->intervalo_ns + 1;
+                n = (int)(debidos - (uint64_t)enviados);
+            }
+        } else {
+            n = e->tam_lote;
+        }
+        if (n > e->tam_lote) n = e->tam_lote;
+        if (n > e->cantidad - enviados) n = e->cantidad - enviados;
+
+        // Elemento k: instante programado en bucle abierto, reloj en cerrado
+        if (e->tam_lote == 1) {
+            producir_item(e->buffer, e->intervalo_ns > 0
+                          ? marca_en(inicio + (uint64_t)enviados * e->intervalo_ns)
+                          : marca_tiempo());
+            enviados++;
+            continue;
+        }
+        if (e->intervalo_ns > 0) {
+            for (int i = 0; i < n; i++) {
+                lote[i] = marca_en(inicio + (uint64_t)(enviados + i) * e->intervalo_ns);
+            }
+        } else {
+            elemento_t marca = marca_tiempo();
+            for (int i = 0; i < n; i++) lote[i] = marca;
+        }
+        // producir_lote puede aceptar menos de n si el buffer tiene poco hueco
+        for (int i = 0; i < n; ) {
+            int r = producir_lote(e->buffer, lote + i, (size_t)(n - i));
+            if (r <= 0) return NULL;
+            i += r;
+        }
+        enviados += n;
+    }
+    return NULL;
+}
+
+static void *consumidor(void *arg) {
+    extremo_t *e = (extremo_t *)arg;
+    elemento_t lote[TAM_LOTE];
+    e->recibidos = 0;
+
+    while (e->recibidos < e->cantidad) {
+        if (e->tam_lote == 1) {
+            elemento_t marca;
+            if (consumir_item(e->buffer, &marca) != 0) break;  // 1 s sin datos
+            registrar_latencia(e->histograma, latencia_desde(marca, (uint32_t)(reloj_ns() - base_ns)));
+            e->recibidos++;
+            continue;
+        }
+        int pendientes = e->cantidad - e->recibidos;
+        int r = consumir_lote(e->buffer, lote, (size_t)(pendientes < TAM_LOTE ? pendientes : TAM_LOTE));
+        if (r <= 0) break;
+        uint32_t ahora = (uint32_t)(reloj_ns() - base_ns);
+        for (int i = 0; i < r; i++) registrar_latencia(e->histograma, latencia_desde(lote[i], ahora));
+        e->recibidos += r;
+    }
+    return NULL;
+}
+
+// Ejecuta una variante y deja en 'total' el histograma fusionado. ritmo = 0
+// es bucle cerrado. Devuelve los segundos que tardó, o -1 si algo falló.
+static double medir(const variante_t *v, int elementos, double ritmo, size_t capacidad,
+                    histograma_latencia_t *total) {
+    buffer_circular_t buffer;
+    bool iniciado = false;
+    switch (v->modo) {
+        case MODO_BUFFER_MUTEX: iniciado = inicializar_buffer_circular(&buffer, capacidad); break;
+        case MODO_BUFFER_SPSC:  iniciado = inicializar_buffer_spsc(&buffer, capacidad); break;
+        case MODO_BUFFER_MPMC:  iniciado = inicializar_buffer_mpmc(&buffer, capacidad); break;
+    }
+    if (!iniciado) return -1.0;
+    if (v->modo != MODO_BUFFER_MUTEX) configurar_espera_activa(&buffer, VUELTAS_ESPERA_ACTIVA);
+
+    int num_hilos = v->productores + v->consumidores;
+    pthread_t hilos[2 * MAX_HILOS_EXTREMO];
+    extremo_t extremos[2 * MAX_HILOS_EXTREMO];
+    histograma_latencia_t *histogramas = malloc((size_t)v->consumidores * sizeof(*histogramas));
+    if (!histogramas) {
+        limpiar_buffer_circular(&buffer);
+        return -1.0;
+    }
+
+    // Cada productor lleva 1/P del ritmo total, desfasado para no coincidir
+    uint64_t intervalo = ritmo > 0 ? (uint64_t)(1e9 * v->productores / ritmo) : 0;
+    int por_productor = elementos / v->productores;
+    int por_consumidor = por_productor * v->productores / v->consumidores;
+    politica_afinidad_t politica = politica_afinidad_por_defecto();
+
+    base_ns = reloj_ns();
+    int creados = 0;
+    for (int i = 0; i < num_hilos; i++) {
+        bool es_productor = i < v->productores;
+        extremo_t *e = &extremos[i];
+        e->buffer = &buffer;
+        e->tam_lote = v->tam_lote;
+        e->intervalo_ns = intervalo;
+        e->desfase_ns = intervalo * (uint64_t)i / (uint64_t)v->productores;
+        e->cantidad = es_productor ? por_productor : por_consumidor;
+        e->histograma = NULL;
+        if (!es_productor) {
+            e->histograma = &histogramas[i - v->productores];
+            reiniciar_histograma(e->histograma);
+        }
+        if (crear_hilo_con_afinidad(&hilos[i], es_productor ? productor : consumidor,
+                                    e, politica, i) != 0) {
+            break;
+        }
+        creados++;
+    }
+    for (int i = 0; i < creados; i++) pthread_join(hilos[i], NULL);
+    double segundos = (double)(reloj_ns() - base_ns) / 1e9;
+
+    reiniciar_histograma(total);
+    bool completo = creados == num_hilos;
+    for (int i = 0; i < v->consumidores; i++) {
+        fusionar_histogramas(total, &histogramas[i]);
+        if (extremos[v->productores + i].recibidos != por_consumidor) completo = false;
+    }
+    free(histogramas);
+    limpiar_buffer_circular(&buffer);
+    return completo ? segundos : -1.0;
+}
+
+static void imprimir_tabla(const char *titulo, int elementos, double ritmo, size_t capacidad) {
+    printf("\n=== %s ===\n", titulo);
+    printf("%-16s %5s %9s %9s %9s %9s %10s %9s %9s\n", "Variante", "P/C",
+           "p50 ns", "p90 ns", "p99 ns", "p99.9 ns", "max ns", "media ns", "Melem/s");
+
+    histograma_latencia_t *h = malloc(sizeof(*h));
+    if (!h) return;
+    for (size_t i = 0; i < sizeof(variantes) / sizeof(variantes[0]); i++) {
+        const variante_t *v = &variantes[i];
+        double segundos = medir(v, elementos, ritmo, capacidad, h);
+        printf("%-16s %3d/%-1d ", v->nombre, v->productores, v->consumidores);
+        if (segundos < 0) {
+            printf("  ✗ error (faltan elementos)\n");
+            continue;
+        }
+        printf("%9llu %9llu %9llu %9llu %10llu %9.0f %9.2f\n",
+               (unsigned long long)percentil_histograma(h, 50.0),
+               (unsigned long long)percentil_histograma(h, 90.0),
+               (unsigned long long)percentil_histograma(h, 99.0),
+               (unsigned long long)percentil_histograma(h, 99.9),
+               (unsigned long long)h->maximo, media_histograma(h),
+               (double)h->total / segundos / 1e6);
+    }
+    free(h);
+}
+
+int main(int argc, char *argv[]) {
+    int elementos = argc > 1 ? atoi(argv[1]) : ELEMENTOS_POR_DEFECTO;
+    double ritmo = argc > 2 ? atof(argv[2]) : RITMO_POR_DEFECTO;
+    size_t capacidad = argc > 3 ? (size_t)atol(argv[3]) : CAPACIDAD_POR_DEFECTO;
+    if (elementos < 4 || ritmo <= 0 || capacidad == 0) {
+        fprintf(stderr, "Uso: %s [elementos] [elementos_por_s] [capacidad]\n", argv[0]);
+        return 1;
+    }
+    // Múltiplo de 4 para repartir exacto entre 1, 2 o 4 productores y consumidores
+    elementos -= elementos % 4;
+
+    printf("Latencia de traspaso productor → consumidor\n");
+    printf("Elementos: %d, capacidad: %zu, lote: %d, afinidad: %s\n", elementos, capacidad,
+           TAM_LOTE, nombre_politica_afinidad(politica_afinidad_por_defecto()));
+
+    char titulo[96];
+    snprintf(titulo, sizeof(titulo), "BUCLE ABIERTO: %.0f elementos/s", ritmo);
+    imprimir_tabla(titulo, elementos, ritmo, capacidad);
+    imprimir_tabla("BUCLE CERRADO: tan rápido como acepte el buffer", elementos, 0.0, capacidad);
+
+    printf("\nPercentiles con error relativo ≤ %.1f%% (histograma log-lineal, %u subcubetas"
+           " por potencia de dos)\n", 100.0 / SUBCUBETAS_HISTOGRAMA, SUBCUBETAS_HISTOGRAMA);
+    return 0;
+}
@@ -17,6 +17,7 @@
 #include <string.h>
 #include <sys/time.h>
 #include "../include/productor_consumidor.h"
+#include "../include/buffer_bytes.h"
 
 /**
  * @brief Configuración para benchmarks
@@ -513,3 +514,401 @@ Test(benchmark_productor_consumidor, benchmark_stress_concurrencia, .timeout = 2
     destruir_buffer(buffer);
     printf("=== Fin del Benchmark de Stress ===\n\n");
 }
+
+/**
+ * @brief Datos para el benchmark de modos (sin contadores compartidos)
+ */
+typedef struct {
+    buffer_circular_t *buffer;
+    int num_items;
+    long long suma;
+} modo_data_t;
+
+static void *productor_modo(void *arg) {
+    modo_data_t *data = (modo_data_t *)arg;
+    for (int i = 0; i < data->num_items; i++) {
+        producir_item(data->buffer, i);
+    }
+    return NULL;
+}
+
+static void *consumidor_modo(void *arg) {
+    modo_data_t *data = (modo_data_t *)arg;
+    int item;
+    int consumidos = 0;
+    data->suma = 0;
+    while (consumidos < data->num_items) {
+        if (consumir_item(data->buffer, &item) == 0) {
+            data->suma += item;
+            consumidos++;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Ejecuta 1 productor y 1 consumidor y devuelve items/segundo
+ */
+static double medir_throughput_1x1(buffer_circular_t *buffer, int num_items, long long *suma) {
+    pthread_t productor_thread, consumidor_thread;
+    modo_data_t data_productor = { .buffer = buffer, .num_items = num_items, .suma = 0 };
+    modo_data_t data_consumidor = { .buffer = buffer, .num_items = num_items, .suma = 0 };
+
+    double inicio = obtener_tiempo_actual();
+    pthread_create(&consumidor_thread, NULL, consumidor_modo, &data_consumidor);
+    pthread_create(&productor_thread, NULL, productor_modo, &data_productor);
+    pthread_join(productor_thread, NULL);
+    pthread_join(consumidor_thread, NULL);
+    double tiempo_total = obtener_tiempo_actual() - inicio;
+
+    *suma = data_consumidor.suma;
+    return num_items / tiempo_total;
+}
+
+/**
+ * @brief Benchmark comparativo: modo mutex frente a modo SPSC sin locks
+ */
+Test(benchmark_productor_consumidor, benchmark_modo_spsc_vs_mutex, .timeout = 30.0) {
+    const int NUM_ITEMS = 1000000;
+    const size_t CAPACIDAD = 1024;
+    const long long SUMA_ESPERADA = (long long)NUM_ITEMS * (NUM_ITEMS - 1) / 2;
+
+    printf("\n=== Benchmark de Modos: Mutex vs SPSC ===\n");
+    printf("Items a procesar: %d\n", NUM_ITEMS);
+    printf("Capacidad del buffer: %zu\n", CAPACIDAD);
+
+    buffer_circular_t *buffer_mutex = crear_buffer(CAPACIDAD);
+    buffer_circular_t *buffer_spsc = crear_buffer_spsc(CAPACIDAD);
+    cr_assert_not_null(buffer_mutex);
+    cr_assert_not_null(buffer_spsc);
+
+    long long suma_mutex = 0, suma_spsc = 0;
+    double throughput_mutex = medir_throughput_1x1(buffer_mutex, NUM_ITEMS, &suma_mutex);
+    double throughput_spsc = medir_throughput_1x1(buffer_spsc, NUM_ITEMS, &suma_spsc);
+
+    printf("Modo mutex: %.2f items/segundo\n", throughput_mutex);
+    printf("Modo SPSC:  %.2f items/segundo\n", throughput_spsc);
+    printf("Aceleración SPSC: %.2fx\n", throughput_spsc / throughput_mutex);
+
+    // Ningún item se pierde ni se duplica en ninguno de los dos modos
+    cr_assert_eq(suma_mutex, SUMA_ESPERADA, "El modo mutex debe entregar todos los items");
+    cr_assert_eq(suma_spsc, SUMA_ESPERADA, "El modo SPSC debe entregar todos los items");
+    cr_assert(esta_vacio(buffer_mutex), "Buffer mutex debe estar vacío al final");
+    cr_assert(esta_vacio(buffer_spsc), "Buffer SPSC debe estar vacío al final");
+
+    destruir_buffer(buffer_mutex);
+    destruir_buffer(buffer_spsc);
+    printf("=== Fin del Benchmark de Modos ===\n\n");
+}
+
+/**
+ * @brief Ejecuta N productores y N consumidores y devuelve items/segundo
+ */
+static double medir_throughput_nxn(buffer_circular_t *buffer, int num_hilos,
+                                   int items_por_hilo, long long *suma) {
+    pthread_t productores[num_hilos];
+    pthread_t consumidores[num_hilos];
+    modo_data_t datos_productores[num_hilos];
+    modo_data_t datos_consumidores[num_hilos];
+
+    double inicio = obtener_tiempo_actual();
+    for (int i = 0; i < num_hilos; i++) {
+        datos_consumidores[i] = (modo_data_t){ .buffer = buffer, .num_items = items_por_hilo, .suma = 0 };
+        pthread_create(&consumidores[i], NULL, consumidor_modo, &datos_consumidores[i]);
+    }
+    for (int i = 0; i < num_hilos; i++) {
+        datos_productores[i] = (modo_data_t){ .buffer = buffer, .num_items = items_por_hilo, .suma = 0 };
+        pthread_create(&productores[i], NULL, productor_modo, &datos_productores[i]);
+    }
+    for (int i = 0; i < num_hilos; i++) {
+        pthread_join(productores[i], NULL);
+    }
+    *suma = 0;
+    for (int i = 0; i < num_hilos; i++) {
+        pthread_join(consumidores[i], NULL);
+        *suma += datos_consumidores[i].suma;
+    }
+    double tiempo_total = obtener_tiempo_actual() - inicio;
+
+    return (double)num_hilos * items_por_hilo / tiempo_total;
+}
+
+/**
+ * @brief Barrido 1x1 .. NxN (N = núcleos en línea): mutex frente a MPMC
+ */
+Test(benchmark_productor_consumidor, benchmark_barrido_mpmc_vs_mutex, .timeout = 60.0) {
+    const int ITEMS_POR_HILO = 200000;
+    const size_t CAPACIDAD = 1024;
+    const long long SUMA_POR_HILO = (long long)ITEMS_POR_HILO * (ITEMS_POR_HILO - 1) / 2;
+    long num_nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+    if (num_nucleos < 1) num_nucleos = 1;
+
+    printf("\n=== Barrido de Hilos: Mutex vs MPMC ===\n");
+    printf("Items por productor: %d\n", ITEMS_POR_HILO);
+    printf("Núcleos en línea: %ld\n", num_nucleos);
+    printf("%-8s %18s %18s %10s\n", "Hilos", "Mutex (items/s)", "MPMC (items/s)", "Ratio");
+
+    int num_hilos = 1;
+    for (;;) {
+        buffer_circular_t *buffer_mutex = crear_buffer(CAPACIDAD);
+        buffer_circular_t *buffer_mpmc = crear_buffer_mpmc(CAPACIDAD);
+        cr_assert_not_null(buffer_mutex);
+        cr_assert_not_null(buffer_mpmc);
+
+        long long suma_mutex = 0, suma_mpmc = 0;
+        double throughput_mutex = medir_throughput_nxn(buffer_mutex, num_hilos, ITEMS_POR_HILO, &suma_mutex);
+        double throughput_mpmc = medir_throughput_nxn(buffer_mpmc, num_hilos, ITEMS_POR_HILO, &suma_mpmc);
+
+        char etiqueta[32];
+        snprintf(etiqueta, sizeof(etiqueta), "%dx%d", num_hilos, num_hilos);
+        printf("%-8s %18.2f %18.2f %9.2fx\n", etiqueta, throughput_mutex, throughput_mpmc,
+               throughput_mpmc / throughput_mutex);
+
+        cr_assert_eq(suma_mutex, SUMA_POR_HILO * num_hilos, "El modo mutex debe entregar todos los items");
+        cr_assert_eq(suma_mpmc, SUMA_POR_HILO * num_hilos, "El modo MPMC debe entregar todos los items");
+        cr_assert(esta_vacio(buffer_mpmc), "Buffer MPMC debe estar vacío al final");
+
+        destruir_buffer(buffer_mutex);
+        destruir_buffer(buffer_mpmc);
+
+        if (num_hilos >= num_nucleos) break;
+        num_hilos = (num_hilos * 2 > num_nucleos) ? (int)num_nucleos : num_hilos * 2;
+    }
+
+    printf("=== Fin del Barrido de Hilos ===\n\n");
+}
+
+/**
+ * @brief Throughput frente a tamaño de lote usando hilo_productor/hilo_consumidor
+ */
+Test(benchmark_productor_consumidor, benchmark_tamaño_lote, .timeout = 60.0) {
+    const int NUM_ITEMS = 500000;
+    const size_t CAPACIDAD = 1024;
+    int lotes[] = {1, 4, 16, 64, 256};
+    int num_lotes = sizeof(lotes) / sizeof(lotes[0]);
+
+    printf("\n=== Benchmark de Tamaño de Lote ===\n");
+    printf("Items a procesar: %d\n", NUM_ITEMS);
+    printf("Capacidad del buffer: %zu\n", CAPACIDAD);
+    printf("%-8s %18s %18s\n", "Lote", "Mutex (items/s)", "SPSC (items/s)");
+
+    for (int i = 0; i < num_lotes; i++) {
+        double throughput[2];
+        for (int modo = 0; modo < 2; modo++) {
+            buffer_circular_t *buffer = modo == 0 ? crear_buffer(CAPACIDAD) : crear_buffer_spsc(CAPACIDAD);
+            cr_assert_not_null(buffer);
+
+            productor_args_t args_productor = {
+                .buffer = buffer, .num_datos = NUM_ITEMS, .delay_us = 0, .tam_lote = lotes[i]
+            };
+            consumidor_args_t args_consumidor = {
+                .buffer = buffer, .num_datos = NUM_ITEMS, .delay_us = 0, .suma = 0, .tam_lote = lotes[i]
+            };
+            pthread_t productor_thread, consumidor_thread;
+
+            double inicio = obtener_tiempo_actual();
+            pthread_create(&consumidor_thread, NULL, hilo_consumidor, &args_consumidor);
+            pthread_create(&productor_thread, NULL, hilo_productor, &args_productor);
+            pthread_join(productor_thread, NULL);
+            pthread_join(consumidor_thread, NULL);
+            throughput[modo] = NUM_ITEMS / (obtener_tiempo_actual() - inicio);
+
+            // Valores en [0, 100): la suma acotada detecta items perdidos o inventados
+            cr_assert_leq(args_consumidor.suma, 99LL * NUM_ITEMS, "Suma fuera de rango");
+            cr_assert(esta_vacio(buffer), "Buffer debe estar vacío al final");
+            destruir_buffer(buffer);
+        }
+        printf("%-8d %18.2f %18.2f\n", lotes[i], throughput[0], throughput[1]);
+    }
+
+    printf("=== Fin del Benchmark de Tamaño de Lote ===\n\n");
+}
+
+/**
+ * @brief Datos para el benchmark del buffer de bytes
+ */
+typedef struct {
+    buffer_bytes_t *buffer;
+    int num_mensajes;
+    size_t bytes_totales;
+    int errores;
+} bytes_data_t;
+
+/**
+ * @brief Longitud pseudoaleatoria y reproducible del mensaje i (1..1500 bytes)
+ */
+static size_t longitud_mensaje(int i) {
+    return 1 + ((size_t)i * 2654435761u) % 1500;
+}
+
+static void *productor_bytes(void *arg) {
+    bytes_data_t *data = (bytes_data_t *)arg;
+    for (int i = 0; i < data->num_mensajes; i++) {
+        size_t longitud = longitud_mensaje(i);
+        uint8_t *destino = reservar_bytes(data->buffer, longitud);
+        // Se escribe directamente en el anillo: no hay copia intermedia
+        memset(destino, (uint8_t)i, longitud);
+        confirmar_bytes(data->buffer, longitud);
+        data->bytes_totales += longitud;
+    }
+    return NULL;
+}
+
+static void *consumidor_bytes(void *arg) {
+    bytes_data_t *data = (bytes_data_t *)arg;
+    for (int i = 0; i < data->num_mensajes; i++) {
+        size_t longitud = 0;
+        const uint8_t *origen = leer_registro(data->buffer, &longitud);
+        if (!origen) {
+            data->errores++;
+            continue;
+        }
+        if (longitud != longitud_mensaje(i) || origen[0] != (uint8_t)i || origen[longitud - 1] != (uint8_t)i) {
+            data->errores++;
+        }
+        data->bytes_totales += longitud;
+        liberar_registro(data->buffer);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Benchmark de mensajes de longitud variable con reserva/confirmación
+ */
+Test(benchmark_productor_consumidor, benchmark_buffer_bytes, .timeout = 30.0) {
+    const int NUM_MENSAJES = 200000;
+    buffer_bytes_t buffer;
+    cr_assert(inicializar_buffer_bytes(&buffer, 64 * 1024));
+
+    bytes_data_t data_productor = { .buffer = &buffer, .num_mensajes = NUM_MENSAJES };
+    bytes_data_t data_consumidor = { .buffer = &buffer, .num_mensajes = NUM_MENSAJES };
+    pthread_t productor_thread, consumidor_thread;
+
+    printf("\n=== Benchmark de Buffer de Bytes (reserva/confirmación) ===\n");
+    printf("Mensajes: %d (1..1500 bytes)\n", NUM_MENSAJES);
+    printf("Capacidad del anillo: %zu bytes\n", buffer.capacidad);
+
+    double inicio = obtener_tiempo_actual();
+    pthread_create(&consumidor_thread, NULL, consumidor_bytes, &data_consumidor);
+    pthread_create(&productor_thread, NULL, productor_bytes, &data_productor);
+    pthread_join(productor_thread, NULL);
+    pthread_join(consumidor_thread, NULL);
+    double tiempo_total = obtener_tiempo_actual() - inicio;
+
+    printf("Tiempo total: %.3f segundos\n", tiempo_total);
+    printf("Throughput: %.2f mensajes/segundo\n", NUM_MENSAJES / tiempo_total);
+    printf("Ancho de banda: %.2f MB/s\n", data_consumidor.bytes_totales / tiempo_total / 1e6);
+
+    cr_assert_eq(data_consumidor.errores, 0, "Todos los registros deben llegar íntegros y en orden");
+    cr_assert_eq(data_consumidor.bytes_totales, data_productor.bytes_totales, "Mismos bytes enviados y recibidos");
+    cr_assert_null(reservar_bytes(&buffer, max_registro_bytes(&buffer) + 1),
+                   "Un registro mayor que el máximo debe rechazarse");
+
+    limpiar_buffer_bytes(&buffer);
+    printf("=== Fin del Benchmark de Buffer de Bytes ===\n\n");
+}
+
+/**
+ * @brief Tiempo monotónico en nanosegundos
+ */
+static uint64_t obtener_tiempo_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Datos para medir la latencia de entrega (producir -> consumir)
+ */
+typedef struct {
+    buffer_circular_t *buffer;
+    int num_items;
+    int pausa_us;          // Separación entre items: carga baja
+    uint64_t *t_envio;     // Indexado por el valor del item
+    uint64_t *latencias;   // Salida del consumidor, en ns
+} entrega_data_t;
+
+static void *productor_entrega(void *arg) {
+    entrega_data_t *data = (entrega_data_t *)arg;
+    for (int i = 0; i < data->num_items; i++) {
+        data->t_envio[i] = obtener_tiempo_ns();
+        producir_item(data->buffer, i);
+        if (data->pausa_us > 0) usleep(data->pausa_us);
+    }
+    return NULL;
+}
+
+static void *consumidor_entrega(void *arg) {
+    entrega_data_t *data = (entrega_data_t *)arg;
+    for (int i = 0; i < data->num_items; i++) {
+        int item;
+        while (consumir_item(data->buffer, &item) != 0) {}
+        data->latencias[i] = obtener_tiempo_ns() - data->t_envio[item];
+    }
+    return NULL;
+}
+
+static int comparar_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Latencia de entrega p50/p99 con carga baja para cada modo de espera
+ */
+Test(benchmark_productor_consumidor, benchmark_latencia_entrega, .timeout = 60.0) {
+    const int NUM_ITEMS = 5000;
+    const int PAUSA_US = 20;
+    const unsigned VUELTAS_ESPERA = 2000;
+
+    struct {
+        const char *nombre;
+        buffer_circular_t *(*crear)(size_t);
+        unsigned vueltas;
+    } configuraciones[] = {
+        { "Mutex",               crear_buffer,      0 },
+        { "SPSC (futex)",        crear_buffer_spsc, 0 },
+        { "SPSC (espera activa)", crear_buffer_spsc, VUELTAS_ESPERA },
+        { "MPMC (futex)",        crear_buffer_mpmc, 0 },
+        { "MPMC (espera activa)", crear_buffer_mpmc, VUELTAS_ESPERA },
+    };
+    int num_configuraciones = sizeof(configuraciones) / sizeof(configuraciones[0]);
+
+    uint64_t *t_envio = malloc(NUM_ITEMS * sizeof(uint64_t));
+    uint64_t *latencias = malloc(NUM_ITEMS * sizeof(uint64_t));
+    cr_assert_not_null(t_envio);
+    cr_assert_not_null(latencias);
+
+    printf("\n=== Benchmark de Latencia de Entrega ===\n");
+    printf("Items: %d, pausa entre items: %d μs\n", NUM_ITEMS, PAUSA_US);
+    printf("%-22s %12s %12s %12s\n", "Modo", "p50 (μs)", "p99 (μs)", "máx (μs)");
+
+    for (int c = 0; c < num_configuraciones; c++) {
+        buffer_circular_t *buffer = configuraciones[c].crear(64);
+        cr_assert_not_null(buffer);
+        configurar_espera_activa(buffer, configuraciones[c].vueltas);
+
+        entrega_data_t data = {
+            .buffer = buffer, .num_items = NUM_ITEMS, .pausa_us = PAUSA_US,
+            .t_envio = t_envio, .latencias = latencias
+        };
+        pthread_t productor_thread, consumidor_thread;
+        pthread_create(&consumidor_thread, NULL, consumidor_entrega, &data);
+        pthread_create(&productor_thread, NULL, productor_entrega, &data);
+        pthread_join(productor_thread, NULL);
+        pthread_join(consumidor_thread, NULL);
+
+        qsort(latencias, NUM_ITEMS, sizeof(uint64_t), comparar_u64);
+        printf("%-22s %12.2f %12.2f %12.2f\n", configuraciones[c].nombre,
+               latencias[NUM_ITEMS / 2] / 1e3,
+               latencias[(int)(NUM_ITEMS * 0.99)] / 1e3,
+               latencias[NUM_ITEMS - 1] / 1e3);
+
+        cr_assert(esta_vacio(buffer), "Buffer debe estar vacío al final");
+        destruir_buffer(buffer);
+    }
+
+    free(t_envio);
+    free(latencias);
+    printf("=== Fin del Benchmark de Latencia de Entrega ===\n\n");
+}
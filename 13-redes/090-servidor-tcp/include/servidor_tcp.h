@@ -84,7 +84,9 @@ typedef enum {
     MODO_FORK,          // Fork por cliente
     MODO_THREAD,        // Thread por cliente
     MODO_SELECT,        // I/O multiplexing con select
-    MODO_POLL           // I/O multiplexing con poll
+    MODO_POLL,          // I/O multiplexing con poll
+    MODO_EPOLL,         // epoll edge-triggered con sockets no bloqueantes (Linux)
+    MODO_REUSEPORT      // Varios hilos EPOLL, cada uno con su socket SO_REUSEPORT (Linux)
 } modo_servidor_t;
 
 /**
@@ -103,6 +105,8 @@ typedef struct {
     int no_delay;                   // TCP_NODELAY
     int verbose;                    // Logging detallado
     int daemonizar;                 // Ejecutar como daemon
+    int num_trabajadores;           // Hilos de MODO_REUSEPORT (0 = núcleos disponibles)
+    int eco_splice;                 // Eco con splice() socket->tubería->socket (Linux; 2 fds más por cliente)
 } config_servidor_t;
 
 /**
@@ -118,6 +122,9 @@ typedef struct {
     pid_t pid_proceso;              // PID del proceso hijo (si MODO_FORK)
     pthread_t thread_id;            // ID del thread (si MODO_THREAD)
     int activo;                     // Cliente activo (1) o desconectado (0)
+    int tuberia_eco[2];             // Tubería del eco con splice (si estado_splice == 1)
+    int estado_splice;              // 0 sin probar, 1 tubería lista, -1 usar copia
+    size_t capacidad_tuberia;       // Bytes que admite tuberia_eco (si estado_splice == 1)
 } info_cliente_t;
 
 /**
@@ -164,7 +171,9 @@ typedef struct servidor_tcp {
     .keep_alive = 1, \
     .no_delay = 0, \
     .verbose = 0, \
-    .daemonizar = 0 \
+    .daemonizar = 0, \
+    .num_trabajadores = 0, \
+    .eco_splice = 0 \
 }
 
 // ============================================================================
@@ -221,6 +230,13 @@ resultado_servidor_t aceptar_cliente(servidor_tcp_t* servidor, info_cliente_t* i
  * @param servidor Puntero al servidor
  * @param cliente Información del cliente
  * @return SERVIDOR_EXITO en caso de éxito, código de error en caso contrario
+ *
+ * Con config.eco_splice (Linux) los datos van del socket a una tubería del
+ * cliente y de ahí de vuelta al socket con splice(), sin pasar por espacio
+ * de usuario. La tubería son dos descriptores más por cliente. Si splice no
+ * está disponible o no se puede crear la tubería se usa recv + send con un
+ * buffer en la pila, y el cliente se queda en esa ruta. MODO_SELECT y
+ * config.verbose usan siempre la copia.
  */
 resultado_servidor_t procesar_cliente_eco(servidor_tcp_t* servidor, info_cliente_t* cliente);
 
@@ -263,6 +279,42 @@ resultado_servidor_t servidor_modo_thread(servidor_tcp_t* servidor);
  */
 resultado_servidor_t servidor_modo_select(servidor_tcp_t* servidor);
 
+/**
+ * @brief Ejecutar servidor con I/O multiplexing (poll)
+ * @param servidor Puntero al servidor
+ * @return SERVIDOR_EXITO en caso de éxito, código de error en caso contrario
+ *
+ * Sin el límite FD_SETSIZE de select, pero el kernel sigue recorriendo
+ * todos los descriptores en cada llamada.
+ */
+resultado_servidor_t servidor_modo_poll(servidor_tcp_t* servidor);
+
+/**
+ * @brief Ejecutar servidor con epoll edge-triggered (solo Linux)
+ * @param servidor Puntero al servidor
+ * @return SERVIDOR_EXITO en caso de éxito, código de error en caso contrario
+ *
+ * Sockets no bloqueantes registrados una sola vez con EPOLLET: cada
+ * despertar devuelve solo las conexiones listas, así que el trabajo es
+ * O(listas) y no O(conectadas). Cada conexión lee hasta EAGAIN y guarda en
+ * su propio buffer lo que no pudo reenviar; mientras quede algo pendiente
+ * deja de leer y espera a que el socket vuelva a admitir escritura.
+ */
+resultado_servidor_t servidor_modo_epoll(servidor_tcp_t* servidor);
+
+/**
+ * @brief Ejecutar servidor con varios aceptadores SO_REUSEPORT (solo Linux)
+ * @param servidor Puntero al servidor
+ * @return SERVIDOR_EXITO en caso de éxito, código de error en caso contrario
+ *
+ * Arranca num_trabajadores hilos (0 = uno por núcleo). Cada uno abre su
+ * propio socket de escucha en el mismo puerto con SO_REUSEPORT, así que el
+ * kernel reparte las conexiones entrantes entre colas de accept separadas,
+ * y atiende a sus clientes con el bucle de MODO_EPOLL sobre su propia parte
+ * de la tabla de clientes. En el camino de accept no hay nada compartido.
+ */
+resultado_servidor_t servidor_modo_reuseport(servidor_tcp_t* servidor);
+
 // ============================================================================
 // FUNCIONES DE UTILIDAD
 // ============================================================================
@@ -293,6 +345,13 @@ resultado_servidor_t configurar_socket_servidor(servidor_tcp_t* servidor);
  */
 void instalar_manejadores_senales(servidor_tcp_t* servidor);
 
+/**
+ * @brief Nombre de un modo de operación ("SECUENCIAL", "EPOLL"...)
+ * @param modo Modo del servidor
+ * @return String con el nombre del modo
+ */
+const char* nombre_modo_servidor(modo_servidor_t modo);
+
 /**
  * @brief Convertir código de error a string descriptivo
  * @param codigo Código de error
@@ -332,11 +391,25 @@ resultado_servidor_t demo_servidor_basico(void);
 resultado_servidor_t demo_servidor_modos(void);
 
 /**
- * @brief Demo de rendimiento: servidor con métricas
+ * @brief Demo de rendimiento: compara los modos con las mismas conexiones
+ *        concurrentes persistentes (mensajes/s y conexiones atendidas)
  * @return SERVIDOR_EXITO en caso de éxito, código de error en caso contrario
  */
 resultado_servidor_t demo_servidor_rendimiento(void);
 
+/**
+ * @brief Demo de aceptación: conexiones/s de MODO_REUSEPORT con 1, 2, 4...
+ *        hilos frente a un único socket de escucha en MODO_EPOLL
+ * @return SERVIDOR_EXITO en caso de éxito, código de error en caso contrario
+ */
+resultado_servidor_t demo_servidor_reuseport(void);
+
+/**
+ * @brief Demo de eco masivo: ciclos por byte del eco con copia frente a splice
+ * @return SERVIDOR_EXITO en caso de éxito, código de error en caso contrario
+ */
+resultado_servidor_t demo_servidor_splice(void);
+
 /**
  * @brief Demo de configuración: servidor personalizable
  * @return SERVIDOR_EXITO en caso de éxito, código de error en caso contrario
@@ -364,12 +437,14 @@ resultado_servidor_t cliente_prueba_simple(const char* host, int puerto,
  * @brief Generar múltiples clientes de prueba concurrentes
  * @param host Dirección del servidor
  * @param puerto Puerto del servidor
- * @param num_clientes Número de clientes a crear
- * @param mensajes_por_cliente Mensajes por cliente
+ * @param num_clientes Número de clientes a crear (un proceso cada uno)
+ * @param mensajes_por_cliente Mensajes por cliente; cada uno abre su propia conexión
+ * @param conexiones_por_segundo Conexiones completadas por segundo (NULL = no devolver)
  * @return SERVIDOR_EXITO en caso de éxito, código de error en caso contrario
  */
 resultado_servidor_t stress_test_clientes(const char* host, int puerto, 
-                                         int num_clientes, int mensajes_por_cliente);
+                                         int num_clientes, int mensajes_por_cliente,
+                                         double* conexiones_por_segundo);
 
 #ifdef __cplusplus
 }
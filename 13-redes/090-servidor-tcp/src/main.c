@@ -23,10 +23,12 @@ static void imprimir_menu(void) {
     printf("5. Configurar servidor personalizado\n");
     printf("6. Ejecutar stress test\n");
     printf("7. Demo de rendimiento\n");
-    printf("8. Información sobre TCP y sockets\n");
-    printf("9. Salir\n");
+    printf("8. Demo de aceptación (SO_REUSEPORT)\n");
+    printf("9. Demo de eco con splice\n");
+    printf("10. Información sobre TCP y sockets\n");
+    printf("11. Salir\n");
     printf("==========================================\n");
-    printf("Selecciona una opción (1-9): ");
+    printf("Selecciona una opción (1-11): ");
 }
 
 /**
@@ -135,7 +137,10 @@ static config_servidor_t configurar_servidor_interactivo(void) {
     printf("2. Fork (proceso por cliente)\n");
     printf("3. Thread (hilo por cliente)\n");
     printf("4. Select (I/O multiplexing)\n");
-    printf("Seleccionar modo (1-4): ");
+    printf("5. Poll (I/O multiplexing sin límite FD_SETSIZE)\n");
+    printf("6. Epoll edge-triggered (Linux)\n");
+    printf("7. Reuseport (un socket de escucha por hilo, Linux)\n");
+    printf("Seleccionar modo (1-7): ");
     
     if (fgets(buffer, sizeof(buffer), stdin) && strlen(buffer) > 1) {
         opcion = atoi(buffer);
@@ -144,12 +149,26 @@ static config_servidor_t configurar_servidor_interactivo(void) {
             case 2: config.modo = MODO_FORK; break;
             case 3: config.modo = MODO_THREAD; break;
             case 4: config.modo = MODO_SELECT; break;
+            case 5: config.modo = MODO_POLL; break;
+            case 6: config.modo = MODO_EPOLL; break;
+            case 7: config.modo = MODO_REUSEPORT; break;
             default:
                 printf("Modo inválido, usando SECUENCIAL\n");
                 config.modo = MODO_SECUENCIAL;
         }
     }
     
+    if (config.modo == MODO_REUSEPORT) {
+        printf("Número de hilos (0 = uno por núcleo, actual %d): ", config.num_trabajadores);
+        if (fgets(buffer, sizeof(buffer), stdin) && strlen(buffer) > 1) {
+            config.num_trabajadores = atoi(buffer);
+            if (config.num_trabajadores < 0) {
+                printf("Valor inválido, usando uno por núcleo\n");
+                config.num_trabajadores = 0;
+            }
+        }
+    }
+    
     printf("Habilitar logs detallados? (s/N): ");
     if (fgets(buffer, sizeof(buffer), stdin) && 
         (buffer[0] == 's' || buffer[0] == 'S')) {
@@ -213,19 +232,16 @@ static void ejecutar_stress_test(void) {
     }
     
     printf("\nEjecutando stress test...\n");
-    time_t inicio = time(NULL);
+    double conexiones_por_segundo = 0.0;
     
     resultado_servidor_t resultado = stress_test_clientes(host, puerto, 
-                                                        num_clientes, mensajes_por_cliente);
-    
-    time_t fin = time(NULL);
+                                                        num_clientes, mensajes_por_cliente,
+                                                        &conexiones_por_segundo);
     
     if (resultado == SERVIDOR_EXITO) {
         printf("✅ Stress test completado exitosamente\n");
-        printf("Tiempo total: %ld segundos\n", fin - inicio);
         printf("Total de transacciones: %d\n", num_clientes * mensajes_por_cliente);
-        printf("Transacciones por segundo: %.2f\n", 
-               (double)(num_clientes * mensajes_por_cliente) / (fin - inicio));
+        printf("Conexiones por segundo: %.2f\n", conexiones_por_segundo);
     } else {
         printf("❌ Error en stress test: %s\n", servidor_strerror(resultado));
     }
@@ -252,11 +268,7 @@ static void ejecutar_servidor_con_config(const config_servidor_t* config) {
     
     printf("✅ Servidor iniciado correctamente\n");
     printf("🌐 Dirección: %s:%d\n", config->host, config->puerto);
-    printf("📊 Modo: %s\n", 
-           config->modo == MODO_SECUENCIAL ? "SECUENCIAL" :
-           config->modo == MODO_FORK ? "FORK" :
-           config->modo == MODO_THREAD ? "THREAD" :
-           config->modo == MODO_SELECT ? "SELECT" : "DESCONOCIDO");
+    printf("📊 Modo: %s\n", nombre_modo_servidor(config->modo));
     printf("👥 Max clientes: %d\n", config->max_clientes);
     printf("⏱️ Timeout: %d segundos\n", config->timeout_cliente_seg);
     printf("\n📡 Prueba la conexión con:\n");
@@ -362,13 +374,25 @@ int main(void) {
             }
             
             case 8: {
+                printf("\n--- Demo de aceptación ---\n");
+                demo_servidor_reuseport();
+                break;
+            }
+            
+            case 9: {
+                printf("\n--- Demo de eco con splice ---\n");
+                demo_servidor_splice();
+                break;
+            }
+            
+            case 10: {
                 imprimir_info_tcp();
                 printf("Presiona Enter para continuar...");
                 fgets(buffer, sizeof(buffer), stdin);
                 break;
             }
             
-            case 9: {
+            case 11: {
                 printf("\n👋 ¡Gracias por usar el servidor TCP de eco!\n");
                 printf("📚 Has aprendido sobre:\n");
                 printf("   • Sockets de servidor BSD\n");
@@ -385,7 +409,7 @@ int main(void) {
             }
             
             default: {
-                printf("❌ Opción inválida. Por favor selecciona 1-9.\n");
+                printf("❌ Opción inválida. Por favor selecciona 1-11.\n");
                 break;
             }
         }
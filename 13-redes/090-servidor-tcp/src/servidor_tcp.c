@@ -7,6 +7,19 @@
 
 #include "../include/servidor_tcp.h"
 #include <netinet/tcp.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/epoll.h>
+#include <sys/syscall.h>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
 
 // ============================================================================
 // VARIABLES GLOBALES PARA MANEJO DE SEÑALES
@@ -95,34 +108,204 @@ static resultado_servidor_t configurar_timeout_socket(int socket_fd, int timeout
     return SERVIDOR_EXITO;
 }
 
+/**
+ * @brief Sucesos que cuentan las estadísticas
+ */
+typedef enum {
+    ESTADISTICA_CONEXION,
+    ESTADISTICA_DESCONEXION,
+    ESTADISTICA_MENSAJE,
+    ESTADISTICA_RECHAZO,
+    ESTADISTICA_ERROR,
+    ESTADISTICA_TIMEOUT
+} suceso_estadistica_t;
+
+/**
+ * @brief Sumar un suceso a unas estadísticas (sin sincronizar)
+ */
+static void sumar_estadistica(estadisticas_servidor_t* stats, suceso_estadistica_t suceso,
+                              size_t bytes, double tiempo_ms) {
+    switch (suceso) {
+        case ESTADISTICA_CONEXION:
+            stats->conexiones_totales++;
+            stats->conexiones_activas++;
+            break;
+        case ESTADISTICA_DESCONEXION:
+            stats->conexiones_activas--;
+            break;
+        case ESTADISTICA_MENSAJE:
+            stats->mensajes_procesados++;
+            stats->bytes_transferidos += bytes;
+            if (tiempo_ms > 0) {
+                double total_tiempo = stats->tiempo_promedio_ms * (stats->mensajes_procesados - 1);
+                stats->tiempo_promedio_ms = (total_tiempo + tiempo_ms) / stats->mensajes_procesados;
+            }
+            break;
+        case ESTADISTICA_RECHAZO:
+            stats->conexiones_rechazadas++;
+            break;
+        case ESTADISTICA_ERROR:
+            stats->errores_red++;
+            break;
+        case ESTADISTICA_TIMEOUT:
+            stats->timeouts++;
+            break;
+    }
+}
+
 /**
  * @brief Actualizar estadísticas del servidor de forma thread-safe
  */
-static void actualizar_estadisticas(servidor_tcp_t* servidor, const char* operacion, 
+static void actualizar_estadisticas(servidor_tcp_t* servidor, suceso_estadistica_t suceso, 
                                    size_t bytes, double tiempo_ms) {
     if (!servidor) return;
     
     pthread_mutex_lock(&servidor->mutex_stats);
+    sumar_estadistica(&servidor->stats, suceso, bytes, tiempo_ms);
+    pthread_mutex_unlock(&servidor->mutex_stats);
+}
+
+/**
+ * @brief Contar un suceso en las estadísticas propias del hilo o, sin ellas, en las globales
+ *
+ * Los trabajadores de MODO_REUSEPORT cuentan en sus propias estadísticas
+ * para no serializarse en mutex_stats; se fusionan al terminar.
+ */
+static void contar_suceso(servidor_tcp_t* servidor, estadisticas_servidor_t* locales,
+                          suceso_estadistica_t suceso, size_t bytes, double tiempo_ms) {
+    if (locales) {
+        sumar_estadistica(locales, suceso, bytes, tiempo_ms);
+    } else {
+        actualizar_estadisticas(servidor, suceso, bytes, tiempo_ms);
+    }
+}
+
+/**
+ * @brief Añadir a las estadísticas globales las de un hilo
+ */
+static void fusionar_estadisticas(servidor_tcp_t* servidor, const estadisticas_servidor_t* locales) {
+    pthread_mutex_lock(&servidor->mutex_stats);
+    estadisticas_servidor_t* stats = &servidor->stats;
+    int mensajes = stats->mensajes_procesados + locales->mensajes_procesados;
+    if (mensajes > 0) {
+        stats->tiempo_promedio_ms = (stats->tiempo_promedio_ms * stats->mensajes_procesados +
+                                     locales->tiempo_promedio_ms * locales->mensajes_procesados) / mensajes;
+    }
+    stats->conexiones_totales += locales->conexiones_totales;
+    stats->conexiones_activas += locales->conexiones_activas;
+    stats->conexiones_rechazadas += locales->conexiones_rechazadas;
+    stats->mensajes_procesados = mensajes;
+    stats->bytes_transferidos += locales->bytes_transferidos;
+    stats->errores_red += locales->errores_red;
+    stats->timeouts += locales->timeouts;
+    pthread_mutex_unlock(&servidor->mutex_stats);
+}
+
+/**
+ * @brief Índice del primer slot de cliente libre, o -1 si están todos ocupados
+ */
+static int buscar_slot_libre(const servidor_tcp_t* servidor) {
+    for (int i = 0; i < servidor->config.max_clientes; i++) {
+        if (!servidor->clientes[i].activo) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Descriptores que ocupa cada cliente atendido con procesar_cliente_eco
+ *
+ * El socket y, con eco_splice, los dos extremos de su tubería.
+ */
+static rlim_t descriptores_por_cliente(const config_servidor_t* config) {
+    #ifdef __linux__
+    return config->eco_splice ? 3 : 1;
+    #else
+    (void)config;
+    return 1;
+    #endif
+}
+
+/**
+ * @brief Subir el límite blando de descriptores (hasta el duro) si no alcanza
+ */
+static void ajustar_limite_descriptores(rlim_t necesarios) {
+    struct rlimit limite;
+    if (getrlimit(RLIMIT_NOFILE, &limite) != 0 || limite.rlim_cur >= necesarios) {
+        return;
+    }
+    limite.rlim_cur = (limite.rlim_max != RLIM_INFINITY && limite.rlim_max < necesarios) ?
+                      limite.rlim_max : necesarios;
+    if (setrlimit(RLIMIT_NOFILE, &limite) != 0) {
+        perror("setrlimit RLIMIT_NOFILE");
+    }
+}
+
+/**
+ * @brief Crear un socket de escucha (socket + opciones + bind + listen)
+ *
+ * Con reusar_puerto_kernel se activa SO_REUSEPORT antes del bind, para que
+ * varios sockets puedan escuchar en el mismo puerto con colas separadas.
+ */
+static resultado_servidor_t abrir_socket_escucha(const config_servidor_t* config, int reusar_puerto_kernel,
+                                                 int* socket_escucha) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        perror("socket");
+        return SERVIDOR_ERROR_SOCKET;
+    }
+    
+    // Configurar opciones del socket
+    resultado_servidor_t resultado = configurar_socket_opciones(fd, config);
+    if (resultado != SERVIDOR_EXITO) {
+        close(fd);
+        return resultado;
+    }
+    
+    #ifdef SO_REUSEPORT
+    int opcion = 1;
+    if (reusar_puerto_kernel && setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &opcion, sizeof(opcion)) < 0) {
+        perror("setsockopt SO_REUSEPORT");
+        close(fd);
+        return SERVIDOR_ERROR_SOCKET;
+    }
+    #else
+    (void)reusar_puerto_kernel;
+    #endif
+    
+    // Configurar dirección del servidor
+    struct sockaddr_in direccion_servidor;
+    memset(&direccion_servidor, 0, sizeof(direccion_servidor));
+    direccion_servidor.sin_family = AF_INET;
+    direccion_servidor.sin_port = htons(config->puerto);
     
-    if (strcmp(operacion, "conexion") == 0) {
-        servidor->stats.conexiones_totales++;
-        servidor->stats.conexiones_activas++;
-    } else if (strcmp(operacion, "desconexion") == 0) {
-        servidor->stats.conexiones_activas--;
-    } else if (strcmp(operacion, "mensaje") == 0) {
-        servidor->stats.mensajes_procesados++;
-        servidor->stats.bytes_transferidos += bytes;
-        if (tiempo_ms > 0) {
-            double total_tiempo = servidor->stats.tiempo_promedio_ms * (servidor->stats.mensajes_procesados - 1);
-            servidor->stats.tiempo_promedio_ms = (total_tiempo + tiempo_ms) / servidor->stats.mensajes_procesados;
+    if (strcmp(config->host, "0.0.0.0") == 0) {
+        direccion_servidor.sin_addr.s_addr = INADDR_ANY;
+    } else {
+        if (inet_aton(config->host, &direccion_servidor.sin_addr) == 0) {
+            fprintf(stderr, "Dirección IP inválida: %s\n", config->host);
+            close(fd);
+            return SERVIDOR_ERROR_PARAMETRO;
         }
-    } else if (strcmp(operacion, "error") == 0) {
-        servidor->stats.errores_red++;
-    } else if (strcmp(operacion, "timeout") == 0) {
-        servidor->stats.timeouts++;
     }
     
-    pthread_mutex_unlock(&servidor->mutex_stats);
+    // Bind
+    if (bind(fd, (struct sockaddr*)&direccion_servidor, sizeof(direccion_servidor)) < 0) {
+        perror("bind");
+        close(fd);
+        return SERVIDOR_ERROR_BIND;
+    }
+    
+    // Listen
+    if (listen(fd, config->backlog) < 0) {
+        perror("listen");
+        close(fd);
+        return SERVIDOR_ERROR_LISTEN;
+    }
+    
+    *socket_escucha = fd;
+    return SERVIDOR_EXITO;
 }
 
 // ============================================================================
@@ -172,11 +355,7 @@ servidor_tcp_t* crear_servidor(const config_servidor_t* config) {
     
     if (servidor->config.verbose) {
         printf("[SERVIDOR] Creado en modo %s, puerto %d\n",
-               servidor->config.modo == MODO_SECUENCIAL ? "SECUENCIAL" :
-               servidor->config.modo == MODO_FORK ? "FORK" :
-               servidor->config.modo == MODO_THREAD ? "THREAD" :
-               servidor->config.modo == MODO_SELECT ? "SELECT" : "POLL",
-               servidor->config.puerto);
+               nombre_modo_servidor(servidor->config.modo), servidor->config.puerto);
     }
     
     return servidor;
@@ -212,60 +391,22 @@ void destruir_servidor(servidor_tcp_t* servidor) {
 resultado_servidor_t iniciar_servidor(servidor_tcp_t* servidor) {
     if (!servidor) return SERVIDOR_ERROR_PARAMETRO;
     
-    // Crear socket
-    servidor->socket_servidor = socket(AF_INET, SOCK_STREAM, 0);
-    if (servidor->socket_servidor < 0) {
-        perror("socket");
-        return SERVIDOR_ERROR_SOCKET;
-    }
-    
-    // Configurar opciones del socket
-    resultado_servidor_t resultado = configurar_socket_opciones(servidor->socket_servidor, &servidor->config);
+    // En MODO_REUSEPORT este es el socket del primer trabajador
+    int socket_escucha;
+    resultado_servidor_t resultado = abrir_socket_escucha(&servidor->config,
+                                                          servidor->config.modo == MODO_REUSEPORT,
+                                                          &socket_escucha);
     if (resultado != SERVIDOR_EXITO) {
-        close(servidor->socket_servidor);
         return resultado;
     }
-    
-    // Configurar dirección del servidor
-    struct sockaddr_in direccion_servidor;
-    memset(&direccion_servidor, 0, sizeof(direccion_servidor));
-    direccion_servidor.sin_family = AF_INET;
-    direccion_servidor.sin_port = htons(servidor->config.puerto);
-    
-    if (strcmp(servidor->config.host, "0.0.0.0") == 0) {
-        direccion_servidor.sin_addr.s_addr = INADDR_ANY;
-    } else {
-        if (inet_aton(servidor->config.host, &direccion_servidor.sin_addr) == 0) {
-            fprintf(stderr, "Dirección IP inválida: %s\n", servidor->config.host);
-            close(servidor->socket_servidor);
-            return SERVIDOR_ERROR_PARAMETRO;
-        }
-    }
-    
-    // Bind
-    if (bind(servidor->socket_servidor, (struct sockaddr*)&direccion_servidor, 
-             sizeof(direccion_servidor)) < 0) {
-        perror("bind");
-        close(servidor->socket_servidor);
-        return SERVIDOR_ERROR_BIND;
-    }
-    
-    // Listen
-    if (listen(servidor->socket_servidor, servidor->config.backlog) < 0) {
-        perror("listen");
-        close(servidor->socket_servidor);
-        return SERVIDOR_ERROR_LISTEN;
-    }
+    servidor->socket_servidor = socket_escucha;
     
     // Instalar manejadores de señales
     instalar_manejadores_senales(servidor);
     
     printf("[SERVIDOR] Escuchando en %s:%d (backlog: %d, modo: %s)\n",
            servidor->config.host, servidor->config.puerto, servidor->config.backlog,
-           servidor->config.modo == MODO_SECUENCIAL ? "SECUENCIAL" :
-           servidor->config.modo == MODO_FORK ? "FORK" :
-           servidor->config.modo == MODO_THREAD ? "THREAD" :
-           servidor->config.modo == MODO_SELECT ? "SELECT" : "POLL");
+           nombre_modo_servidor(servidor->config.modo));
     
     servidor->ejecutandose = 1;
     return SERVIDOR_EXITO;
@@ -287,9 +428,11 @@ resultado_servidor_t ejecutar_servidor(servidor_tcp_t* servidor) {
         case MODO_SELECT:
             return servidor_modo_select(servidor);
         case MODO_POLL:
-            // TODO: Implementar modo poll
-            fprintf(stderr, "Modo POLL no implementado aún\n");
-            return SERVIDOR_ERROR_SISTEMA;
+            return servidor_modo_poll(servidor);
+        case MODO_EPOLL:
+            return servidor_modo_epoll(servidor);
+        case MODO_REUSEPORT:
+            return servidor_modo_reuseport(servidor);
         default:
             fprintf(stderr, "Modo de servidor desconocido: %d\n", servidor->config.modo);
             return SERVIDOR_ERROR_PARAMETRO;
@@ -311,11 +454,19 @@ void detener_servidor(servidor_tcp_t* servidor) {
 // GESTIÓN DE CLIENTES
 // ============================================================================
 
-resultado_servidor_t aceptar_cliente(servidor_tcp_t* servidor, info_cliente_t* info_cliente) {
-    if (!servidor || !info_cliente) return SERVIDOR_ERROR_PARAMETRO;
-    
+/**
+ * @brief Aceptar un cliente de un socket de escucha concreto
+ *
+ * MODO_REUSEPORT tiene un socket de escucha por trabajador; el resto de
+ * modos usan siempre servidor->socket_servidor. Con locales != NULL los
+ * sucesos se cuentan ahí en lugar de en las estadísticas globales. Si
+ * accept falla, errno conserva su código al volver.
+ */
+static resultado_servidor_t aceptar_cliente_de(servidor_tcp_t* servidor, int socket_escucha,
+                                               info_cliente_t* info_cliente,
+                                               estadisticas_servidor_t* locales) {
     socklen_t tam_direccion = sizeof(info_cliente->direccion);
-    info_cliente->socket_fd = accept(servidor->socket_servidor, 
+    info_cliente->socket_fd = accept(socket_escucha, 
                                    (struct sockaddr*)&info_cliente->direccion, 
                                    &tam_direccion);
     
@@ -323,8 +474,13 @@ resultado_servidor_t aceptar_cliente(servidor_tcp_t* servidor, info_cliente_t* i
         if (errno == EINTR) {
             return SERVIDOR_SHUTDOWN; // Interrupción por señal
         }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return SERVIDOR_ERROR_TIMEOUT; // Socket no bloqueante sin conexiones pendientes
+        }
+        int error = errno;
         perror("accept");
-        actualizar_estadisticas(servidor, "error", 0, 0);
+        contar_suceso(servidor, locales, ESTADISTICA_ERROR, 0, 0);
+        errno = error;
         return SERVIDOR_ERROR_ACCEPT;
     }
     
@@ -345,9 +501,11 @@ resultado_servidor_t aceptar_cliente(servidor_tcp_t* servidor, info_cliente_t* i
     info_cliente->bytes_recibidos = 0;
     info_cliente->bytes_enviados = 0;
     info_cliente->activo = 1;
+    info_cliente->estado_splice = 0; // La tubería del eco se crea con el primer mensaje
+    info_cliente->capacidad_tuberia = 0;
     
     // Actualizar estadísticas
-    actualizar_estadisticas(servidor, "conexion", 0, 0);
+    contar_suceso(servidor, locales, ESTADISTICA_CONEXION, 0, 0);
     
     if (servidor->config.verbose) {
         char ip_cliente[INET_ADDRSTRLEN];
@@ -359,9 +517,16 @@ resultado_servidor_t aceptar_cliente(servidor_tcp_t* servidor, info_cliente_t* i
     return SERVIDOR_EXITO;
 }
 
-resultado_servidor_t procesar_cliente_eco(servidor_tcp_t* servidor, info_cliente_t* cliente) {
-    if (!servidor || !cliente) return SERVIDOR_ERROR_PARAMETRO;
+resultado_servidor_t aceptar_cliente(servidor_tcp_t* servidor, info_cliente_t* info_cliente) {
+    if (!servidor || !info_cliente) return SERVIDOR_ERROR_PARAMETRO;
     
+    return aceptar_cliente_de(servidor, servidor->socket_servidor, info_cliente, NULL);
+}
+
+/**
+ * @brief Eco copiando a espacio de usuario: recv a un buffer en la pila y send
+ */
+static resultado_servidor_t procesar_eco_copia(servidor_tcp_t* servidor, info_cliente_t* cliente) {
     char buffer[servidor->config.buffer_size];
     struct timespec inicio, fin;
     clock_gettime(CLOCK_MONOTONIC, &inicio);
@@ -374,11 +539,11 @@ resultado_servidor_t procesar_cliente_eco(servidor_tcp_t* servidor, info_cliente
     
     if (bytes_leidos < 0) {
         if (errno == EAGAIN || errno == EWOULDBLOCK) {
-            actualizar_estadisticas(servidor, "timeout", 0, 0);
+            actualizar_estadisticas(servidor, ESTADISTICA_TIMEOUT, 0, 0);
             return SERVIDOR_ERROR_TIMEOUT;
         }
         perror("recv");
-        actualizar_estadisticas(servidor, "error", 0, 0);
+        actualizar_estadisticas(servidor, ESTADISTICA_ERROR, 0, 0);
         return SERVIDOR_ERROR_RECV;
     }
     
@@ -411,7 +576,7 @@ resultado_servidor_t procesar_cliente_eco(servidor_tcp_t* servidor, info_cliente
             return SERVIDOR_SHUTDOWN;
         }
         perror("send");
-        actualizar_estadisticas(servidor, "error", 0, 0);
+        actualizar_estadisticas(servidor, ESTADISTICA_ERROR, 0, 0);
         return SERVIDOR_ERROR_SEND;
     }
     
@@ -441,7 +606,7 @@ resultado_servidor_t procesar_cliente_eco(servidor_tcp_t* servidor, info_cliente
                        (fin.tv_nsec - inicio.tv_nsec) / 1000000.0;
     
     // Actualizar estadísticas
-    actualizar_estadisticas(servidor, "mensaje", bytes_leidos + bytes_enviados, tiempo_ms);
+    actualizar_estadisticas(servidor, ESTADISTICA_MENSAJE, bytes_leidos + bytes_enviados, tiempo_ms);
     
     if (servidor->config.verbose) {
         printf("[SERVIDOR] Eco enviado a fd:%d (%zd bytes, %.2f ms)\n", 
@@ -451,7 +616,136 @@ resultado_servidor_t procesar_cliente_eco(servidor_tcp_t* servidor, info_cliente
     return SERVIDOR_EXITO;
 }
 
-void desconectar_cliente(servidor_tcp_t* servidor, info_cliente_t* cliente) {
+#ifdef __linux__
+
+/**
+ * @brief Eco sin copias: socket -> tubería -> socket con splice()
+ *
+ * Los datos se quedan en páginas del kernel: el primer splice las pasa del
+ * buffer de recepción a la tubería y el segundo de la tubería al de envío.
+ * La tubería se crea con el primer mensaje y dura lo que la conexión. Si
+ * no se puede crear o splice no admite este socket se marca el cliente para
+ * usar la copia y se devuelve SERVIDOR_ERROR_SISTEMA sin haber consumido nada.
+ */
+static resultado_servidor_t procesar_eco_splice(servidor_tcp_t* servidor, info_cliente_t* cliente) {
+    size_t maximo = servidor->config.buffer_size > 0 ? (size_t)servidor->config.buffer_size : BUFFER_MAXIMO;
+    
+    if (cliente->estado_splice == 0) {
+        if (pipe2(cliente->tuberia_eco, O_CLOEXEC) < 0) {
+            // EMFILE/ENFILE: sin descriptores para la tubería; no es un fallo del cliente
+            perror("pipe2 (eco con splice, se usa la copia)");
+            actualizar_estadisticas(servidor, ESTADISTICA_ERROR, 0, 0);
+            cliente->estado_splice = -1;
+            return SERVIDOR_ERROR_SISTEMA;
+        }
+        // Por defecto la tubería admite 64 KiB. Si no se puede agrandar hasta
+        // buffer_size (límite /proc/sys/fs/pipe-max-size) cada splice lee
+        // como mucho lo que quepa.
+        int capacidad = fcntl(cliente->tuberia_eco[1], F_GETPIPE_SZ);
+        if (capacidad > 0 && maximo > (size_t)capacidad) {
+            int nueva = fcntl(cliente->tuberia_eco[1], F_SETPIPE_SZ, (int)maximo);
+            if (nueva > 0) {
+                capacidad = nueva;
+            }
+        }
+        if (capacidad <= 0) {
+            perror("fcntl F_GETPIPE_SZ (eco con splice, se usa la copia)");
+            close(cliente->tuberia_eco[0]);
+            close(cliente->tuberia_eco[1]);
+            cliente->estado_splice = -1;
+            return SERVIDOR_ERROR_SISTEMA;
+        }
+        cliente->capacidad_tuberia = (size_t)capacidad;
+        cliente->estado_splice = 1;
+    }
+    if (maximo > cliente->capacidad_tuberia) {
+        maximo = cliente->capacidad_tuberia;
+    }
+    
+    struct timespec inicio, fin;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    
+    ssize_t bytes_leidos;
+    do {
+        bytes_leidos = splice(cliente->socket_fd, NULL, cliente->tuberia_eco[1], NULL, maximo, SPLICE_F_MOVE);
+    } while (bytes_leidos < 0 && errno == EINTR);
+    
+    if (bytes_leidos < 0) {
+        if (errno == EINVAL || errno == ENOSYS) {
+            // Este socket no admite splice: seguir con la copia
+            close(cliente->tuberia_eco[0]);
+            close(cliente->tuberia_eco[1]);
+            cliente->estado_splice = -1;
+            return SERVIDOR_ERROR_SISTEMA;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            actualizar_estadisticas(servidor, ESTADISTICA_TIMEOUT, 0, 0);
+            return SERVIDOR_ERROR_TIMEOUT;
+        }
+        perror("splice socket->tubería");
+        actualizar_estadisticas(servidor, ESTADISTICA_ERROR, 0, 0);
+        return SERVIDOR_ERROR_RECV;
+    }
+    
+    if (bytes_leidos == 0) {
+        // Cierre limpio del lado del cliente
+        return SERVIDOR_SHUTDOWN;
+    }
+    cliente->bytes_recibidos += (size_t)bytes_leidos;
+    
+    // Vaciar la tubería entera: el siguiente mensaje debe encontrarla vacía
+    size_t pendientes = (size_t)bytes_leidos;
+    while (pendientes > 0) {
+        ssize_t enviados = splice(cliente->tuberia_eco[0], NULL, cliente->socket_fd, NULL,
+                                  pendientes, SPLICE_F_MOVE);
+        if (enviados < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EPIPE || errno == ECONNRESET) {
+                return SERVIDOR_SHUTDOWN;
+            }
+            perror("splice tubería->socket");
+            actualizar_estadisticas(servidor, ESTADISTICA_ERROR, 0, 0);
+            return SERVIDOR_ERROR_SEND;
+        }
+        pendientes -= (size_t)enviados;
+        cliente->bytes_enviados += (size_t)enviados;
+    }
+    cliente->mensajes_procesados++;
+    
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    double tiempo_ms = (fin.tv_sec - inicio.tv_sec) * 1000.0 + 
+                       (fin.tv_nsec - inicio.tv_nsec) / 1000000.0;
+    actualizar_estadisticas(servidor, ESTADISTICA_MENSAJE, 2 * (size_t)bytes_leidos, tiempo_ms);
+    
+    return SERVIDOR_EXITO;
+}
+
+#endif
+
+resultado_servidor_t procesar_cliente_eco(servidor_tcp_t* servidor, info_cliente_t* cliente) {
+    if (!servidor || !cliente) return SERVIDOR_ERROR_PARAMETRO;
+    
+    #ifdef __linux__
+    // Con verbose hace falta el texto en un buffer para mostrarlo. En SELECT
+    // los dos descriptores de la tubería acercarían los sockets a FD_SETSIZE.
+    if (servidor->config.eco_splice && !servidor->config.verbose &&
+        servidor->config.modo != MODO_SELECT && cliente->estado_splice >= 0) {
+        resultado_servidor_t resultado = procesar_eco_splice(servidor, cliente);
+        if (resultado != SERVIDOR_ERROR_SISTEMA || cliente->estado_splice >= 0) {
+            return resultado;
+        }
+        // splice no disponible: este mensaje y los siguientes van por la copia
+    }
+    #endif
+    
+    return procesar_eco_copia(servidor, cliente);
+}
+
+/**
+ * @brief desconectar_cliente contando la desconexión en locales si no es NULL
+ */
+static void desconectar_cliente_de(servidor_tcp_t* servidor, info_cliente_t* cliente,
+                                   estadisticas_servidor_t* locales) {
     if (!cliente || cliente->socket_fd < 0) return;
     
     if (servidor && servidor->config.verbose) {
@@ -464,11 +758,21 @@ void desconectar_cliente(servidor_tcp_t* servidor, info_cliente_t* cliente) {
     cliente->socket_fd = -1;
     cliente->activo = 0;
     
+    if (cliente->estado_splice > 0) {
+        close(cliente->tuberia_eco[0]);
+        close(cliente->tuberia_eco[1]);
+    }
+    cliente->estado_splice = 0;
+    
     if (servidor) {
-        actualizar_estadisticas(servidor, "desconexion", 0, 0);
+        contar_suceso(servidor, locales, ESTADISTICA_DESCONEXION, 0, 0);
     }
 }
 
+void desconectar_cliente(servidor_tcp_t* servidor, info_cliente_t* cliente) {
+    desconectar_cliente_de(servidor, cliente, NULL);
+}
+
 // ============================================================================
 // MODOS DE OPERACIÓN
 // ============================================================================
@@ -594,6 +898,8 @@ resultado_servidor_t servidor_modo_thread(servidor_tcp_t* servidor) {
     
     printf("[SERVIDOR] Ejecutando en modo THREAD\n");
     servidor_global = servidor; // Para acceso desde threads (solución simple)
+    ajustar_limite_descriptores((rlim_t)servidor->config.max_clientes *
+                                descriptores_por_cliente(&servidor->config) + 64);
     
     while (servidor->ejecutandose && !servidor->shutdown_solicitado) {
         // Buscar slot libre para cliente
@@ -672,16 +978,16 @@ resultado_servidor_t servidor_modo_select(servidor_tcp_t* servidor) {
             memset(&nuevo_cliente, 0, sizeof(nuevo_cliente));
             
             resultado_servidor_t resultado = aceptar_cliente(servidor, &nuevo_cliente);
-            if (resultado == SERVIDOR_EXITO) {
+            if (resultado == SERVIDOR_EXITO && nuevo_cliente.socket_fd >= FD_SETSIZE) {
+                // FD_SET con un descriptor >= FD_SETSIZE escribiría fuera del fd_set
+                printf("[SERVIDOR] Descriptor %d fuera de FD_SETSIZE, rechazando conexión\n",
+                       nuevo_cliente.socket_fd);
+                actualizar_estadisticas(servidor, ESTADISTICA_RECHAZO, 0, 0);
+                desconectar_cliente(servidor, &nuevo_cliente);
+            } else if (resultado == SERVIDOR_EXITO) {
                 // Buscar slot libre
-                int slot_libre = -1;
-                for (int i = 0; i < servidor->config.max_clientes; i++) {
-                    if (!servidor->clientes[i].activo) {
-                        slot_libre = i;
-                        break;
-                    }
-                }
-                
+                int slot_libre = buscar_slot_libre(servidor);
+
                 if (slot_libre != -1) {
                     servidor->clientes[slot_libre] = nuevo_cliente;
                     FD_SET(nuevo_cliente.socket_fd, &master_set);
@@ -690,6 +996,7 @@ resultado_servidor_t servidor_modo_select(servidor_tcp_t* servidor) {
                     }
                 } else {
                     printf("[SERVIDOR] Máximo de clientes alcanzado, rechazando conexión\n");
+                    actualizar_estadisticas(servidor, ESTADISTICA_RECHAZO, 0, 0);
                     desconectar_cliente(servidor, &nuevo_cliente);
                 }
             }
@@ -716,65 +1023,552 @@ resultado_servidor_t servidor_modo_select(servidor_tcp_t* servidor) {
     return SERVIDOR_EXITO;
 }
 
-// ============================================================================
-// FUNCIONES DE UTILIDAD
-// ============================================================================
-
-void obtener_estadisticas_servidor(const servidor_tcp_t* servidor, estadisticas_servidor_t* stats) {
-    if (!servidor || !stats) return;
+resultado_servidor_t servidor_modo_poll(servidor_tcp_t* servidor) {
+    if (!servidor) return SERVIDOR_ERROR_PARAMETRO;
     
-    pthread_mutex_lock((pthread_mutex_t*)&servidor->mutex_stats);
-    *stats = servidor->stats;
-    pthread_mutex_unlock((pthread_mutex_t*)&servidor->mutex_stats);
-}
-
-void resetear_estadisticas_servidor(servidor_tcp_t* servidor) {
-    if (!servidor) return;
+    printf("[SERVIDOR] Ejecutando en modo POLL\n");
     
-    pthread_mutex_lock(&servidor->mutex_stats);
-    memset(&servidor->stats, 0, sizeof(estadisticas_servidor_t));
-    servidor->stats.tiempo_inicio = time(NULL);
-    pthread_mutex_unlock(&servidor->mutex_stats);
-}
-
-resultado_servidor_t configurar_socket_servidor(servidor_tcp_t* servidor) {
-    return configurar_socket_opciones(servidor->socket_servidor, &servidor->config);
-}
-
-void instalar_manejadores_senales(servidor_tcp_t* servidor) {
-    servidor_global = servidor;
+    int max_clientes = servidor->config.max_clientes;
+    ajustar_limite_descriptores((rlim_t)max_clientes * descriptores_por_cliente(&servidor->config) + 64);
     
-    signal(SIGINT, manejador_shutdown);   // Ctrl+C
-    signal(SIGTERM, manejador_shutdown);  // Terminación
-    signal(SIGCHLD, manejador_sigchld);   // Procesos hijos terminados
-    signal(SIGPIPE, SIG_IGN);             // Ignorar SIGPIPE
-}
-
-const char* servidor_strerror(resultado_servidor_t codigo) {
-    switch (codigo) {
-        case SERVIDOR_EXITO: return "Operación exitosa";
-        case SERVIDOR_ERROR_SOCKET: return "Error creando socket";
-        case SERVIDOR_ERROR_BIND: return "Error en bind";
-        case SERVIDOR_ERROR_LISTEN: return "Error en listen";
-        case SERVIDOR_ERROR_ACCEPT: return "Error en accept";
-        case SERVIDOR_ERROR_RECV: return "Error recibiendo datos";
-        case SERVIDOR_ERROR_SEND: return "Error enviando datos";
-        case SERVIDOR_ERROR_MEMORIA: return "Error de memoria";
-        case SERVIDOR_ERROR_TIMEOUT: return "Timeout";
-        case SERVIDOR_ERROR_PARAMETRO: return "Parámetro inválido";
-        case SERVIDOR_ERROR_SISTEMA: return "Error del sistema";
-        case SERVIDOR_SHUTDOWN: return "Shutdown del servidor";
-        default: return "Error desconocido";
+    // fds[0] es el socket de escucha; fds[k] (k >= 1) es el cliente slot_de[k].
+    // Los activos se mantienen contiguos para pasar a poll solo los que hay.
+    struct pollfd* fds = malloc(sizeof(struct pollfd) * (size_t)(max_clientes + 1));
+    int* slot_de = malloc(sizeof(int) * (size_t)(max_clientes + 1));
+    if (!fds || !slot_de) {
+        free(fds);
+        free(slot_de);
+        return SERVIDOR_ERROR_MEMORIA;
     }
-}
-
-resultado_servidor_t obtener_info_cliente(int cliente_fd, info_cliente_t* info) {
-    if (!info || cliente_fd < 0) return SERVIDOR_ERROR_PARAMETRO;
+    fds[0].fd = servidor->socket_servidor;
+    fds[0].events = POLLIN;
+    nfds_t num_fds = 1;
     
-    socklen_t tam = sizeof(info->direccion);
-    if (getpeername(cliente_fd, (struct sockaddr*)&info->direccion, &tam) < 0) {
-        perror("getpeername");
-        return SERVIDOR_ERROR_SISTEMA;
+    while (servidor->ejecutandose && !servidor->shutdown_solicitado) {
+        int actividad = poll(fds, num_fds, 1000); // Timeout de 1 segundo
+        
+        if (actividad < 0) {
+            if (errno == EINTR) {
+                continue; // Señal recibida
+            }
+            perror("poll");
+            break;
+        }
+        
+        if (actividad == 0) {
+            continue; // Timeout
+        }
+        
+        // Clientes de atrás hacia delante: al quitar uno se trae el último,
+        // que ya se ha revisado en esta vuelta
+        for (nfds_t k = num_fds - 1; k >= 1; k--) {
+            if (fds[k].revents == 0) {
+                continue;
+            }
+            
+            info_cliente_t* cliente = &servidor->clientes[slot_de[k]];
+            resultado_servidor_t resultado = procesar_cliente_eco(servidor, cliente);
+            if (resultado == SERVIDOR_EXITO) {
+                continue;
+            }
+            if (resultado != SERVIDOR_SHUTDOWN && resultado != SERVIDOR_ERROR_TIMEOUT) {
+                fprintf(stderr, "Error procesando cliente: %s\n", servidor_strerror(resultado));
+            }
+            desconectar_cliente(servidor, cliente);
+            num_fds--;
+            fds[k] = fds[num_fds];
+            slot_de[k] = slot_de[num_fds];
+        }
+        
+        // Nuevas conexiones
+        if (fds[0].revents & POLLIN) {
+            info_cliente_t nuevo_cliente;
+            memset(&nuevo_cliente, 0, sizeof(nuevo_cliente));
+            
+            if (aceptar_cliente(servidor, &nuevo_cliente) == SERVIDOR_EXITO) {
+                int slot_libre = buscar_slot_libre(servidor);
+                if (slot_libre != -1) {
+                    servidor->clientes[slot_libre] = nuevo_cliente;
+                    fds[num_fds].fd = nuevo_cliente.socket_fd;
+                    fds[num_fds].events = POLLIN;
+                    fds[num_fds].revents = 0;
+                    slot_de[num_fds] = slot_libre;
+                    num_fds++;
+                } else {
+                    printf("[SERVIDOR] Máximo de clientes alcanzado, rechazando conexión\n");
+                    actualizar_estadisticas(servidor, ESTADISTICA_RECHAZO, 0, 0);
+                    desconectar_cliente(servidor, &nuevo_cliente);
+                }
+            }
+        }
+    }
+    
+    free(fds);
+    free(slot_de);
+    return SERVIDOR_EXITO;
+}
+
+#ifdef __linux__
+
+#define MAX_EVENTOS_EPOLL 256
+#define ID_ESCUCHA_EPOLL UINT64_MAX  // epoll_data.u64 del socket de escucha
+
+/**
+ * @brief Bytes ya leídos de una conexión que todavía no se han reenviado
+ *
+ * Se reserva la primera vez que un eco no cabe entero en el socket; la
+ * mayoría de conexiones nunca lo necesita.
+ */
+typedef struct {
+    char* datos;
+    size_t inicio;                  // Primer byte pendiente
+    size_t fin;                     // Un byte después del último pendiente
+} pendiente_epoll_t;
+
+/**
+ * @brief Enviar sin bloquear; devuelve bytes enviados, 0 si el socket está lleno o -1
+ */
+static ssize_t enviar_no_bloqueante(int fd, const char* datos, size_t longitud) {
+    ssize_t enviados;
+    do {
+        enviados = send(fd, datos, longitud, MSG_NOSIGNAL);
+    } while (enviados < 0 && errno == EINTR);
+    
+    if (enviados < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        return 0;
+    }
+    return enviados;
+}
+
+/**
+ * @brief Atender una conexión tras un aviso edge-triggered
+ *
+ * Con EPOLLET solo llega un aviso por cambio de estado, así que hay que
+ * seguir hasta que recv o send devuelvan EAGAIN: si se deja de leer porque
+ * el eco no cabe, el siguiente aviso será EPOLLOUT cuando el socket admita
+ * escritura otra vez, y entonces se vacía lo pendiente y se sigue leyendo.
+ */
+static resultado_servidor_t atender_conexion_epoll(servidor_tcp_t* servidor, info_cliente_t* cliente,
+                                                   pendiente_epoll_t* pendiente,
+                                                   char* lectura, size_t tam_lectura,
+                                                   estadisticas_servidor_t* locales) {
+    int fd = cliente->socket_fd;
+    
+    while (1) {
+        // Primero lo que quedó sin enviar en vueltas anteriores
+        while (pendiente->inicio < pendiente->fin) {
+            ssize_t n = enviar_no_bloqueante(fd, pendiente->datos + pendiente->inicio,
+                                             pendiente->fin - pendiente->inicio);
+            if (n < 0) {
+                return (errno == EPIPE || errno == ECONNRESET) ? SERVIDOR_SHUTDOWN : SERVIDOR_ERROR_SEND;
+            }
+            if (n == 0) {
+                return SERVIDOR_EXITO; // Esperar a EPOLLOUT
+            }
+            pendiente->inicio += (size_t)n;
+            cliente->bytes_enviados += (size_t)n;
+        }
+        pendiente->inicio = pendiente->fin = 0;
+        
+        ssize_t leidos;
+        do {
+            leidos = recv(fd, lectura, tam_lectura, 0);
+        } while (leidos < 0 && errno == EINTR);
+        
+        if (leidos == 0) {
+            return SERVIDOR_SHUTDOWN; // Cierre limpio del lado del cliente
+        }
+        if (leidos < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return SERVIDOR_EXITO; // Esperar a EPOLLIN
+            }
+            if (errno == ECONNRESET) {
+                return SERVIDOR_SHUTDOWN;
+            }
+            contar_suceso(servidor, locales, ESTADISTICA_ERROR, 0, 0);
+            return SERVIDOR_ERROR_RECV;
+        }
+        cliente->bytes_recibidos += (size_t)leidos;
+        
+        // Eco directo desde el bloque leído; solo se copia lo que no cabe
+        ssize_t enviados = enviar_no_bloqueante(fd, lectura, (size_t)leidos);
+        if (enviados < 0) {
+            return (errno == EPIPE || errno == ECONNRESET) ? SERVIDOR_SHUTDOWN : SERVIDOR_ERROR_SEND;
+        }
+        cliente->bytes_enviados += (size_t)enviados;
+        
+        if (enviados < leidos) {
+            if (!pendiente->datos) {
+                pendiente->datos = malloc(tam_lectura);
+                if (!pendiente->datos) {
+                    return SERVIDOR_ERROR_MEMORIA;
+                }
+            }
+            pendiente->fin = (size_t)(leidos - enviados);
+            memcpy(pendiente->datos, lectura + enviados, pendiente->fin);
+        }
+        
+        cliente->mensajes_procesados++;
+        contar_suceso(servidor, locales, ESTADISTICA_MENSAJE, (size_t)leidos + (size_t)enviados, 0);
+    }
+}
+
+/**
+ * @brief Bucle epoll sobre un socket de escucha y un tramo de la tabla de clientes
+ *
+ * Atiende los slots [primer_slot, primer_slot + num_slots). MODO_EPOLL lo
+ * ejecuta con la tabla entera; en MODO_REUSEPORT cada trabajador tiene su
+ * socket, su tramo y sus estadísticas (locales), y no toca nada de los demás.
+ */
+static resultado_servidor_t bucle_epoll(servidor_tcp_t* servidor, int socket_escucha,
+                                        int primer_slot, int num_slots,
+                                        estadisticas_servidor_t* locales) {
+    info_cliente_t* clientes = servidor->clientes + primer_slot;
+    size_t tam_lectura = servidor->config.buffer_size > 0 ? (size_t)servidor->config.buffer_size : BUFFER_MAXIMO;
+    
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd < 0) {
+        perror("epoll_create1");
+        return SERVIDOR_ERROR_SISTEMA;
+    }
+    
+    // Pila de slots libres: aceptar y desconectar son O(1)
+    pendiente_epoll_t* pendientes = calloc((size_t)num_slots, sizeof(pendiente_epoll_t));
+    int* libres = malloc(sizeof(int) * (size_t)num_slots);
+    char* lectura = malloc(tam_lectura);
+    if (!pendientes || !libres || !lectura) {
+        free(pendientes);
+        free(libres);
+        free(lectura);
+        close(epoll_fd);
+        return SERVIDOR_ERROR_MEMORIA;
+    }
+    int num_libres = 0;
+    for (int i = num_slots - 1; i >= 0; i--) {
+        if (!clientes[i].activo) {
+            libres[num_libres++] = i;
+        }
+    }
+    
+    // Descriptor de reserva: sin descriptores libres (EMFILE) se cierra para
+    // poder aceptar la conexión pendiente y rechazarla. Con EPOLLET, dejarla
+    // en la cola no volvería a avisar y el resto de la cola se quedaría parada.
+    int reserva = open("/dev/null", O_RDONLY | O_CLOEXEC);
+    
+    // El socket de escucha también es no bloqueante: se acepta hasta EAGAIN
+    int flags = fcntl(socket_escucha, F_GETFL, 0);
+    fcntl(socket_escucha, F_SETFL, flags | O_NONBLOCK);
+    
+    struct epoll_event evento;
+    evento.events = EPOLLIN | EPOLLET;
+    evento.data.u64 = ID_ESCUCHA_EPOLL;
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, socket_escucha, &evento) < 0) {
+        perror("epoll_ctl listen");
+        free(pendientes);
+        free(libres);
+        free(lectura);
+        if (reserva >= 0) close(reserva);
+        close(epoll_fd);
+        return SERVIDOR_ERROR_SISTEMA;
+    }
+    
+    struct epoll_event eventos[MAX_EVENTOS_EPOLL];
+    
+    while (servidor->ejecutandose && !servidor->shutdown_solicitado) {
+        int listos = epoll_wait(epoll_fd, eventos, MAX_EVENTOS_EPOLL, 1000); // Timeout de 1 segundo
+        
+        if (listos < 0) {
+            if (errno == EINTR) {
+                continue; // Señal recibida
+            }
+            perror("epoll_wait");
+            break;
+        }
+        
+        for (int e = 0; e < listos; e++) {
+            if (eventos[e].data.u64 == ID_ESCUCHA_EPOLL) {
+                // Aceptar todas las conexiones pendientes
+                while (1) {
+                    info_cliente_t nuevo_cliente;
+                    memset(&nuevo_cliente, 0, sizeof(nuevo_cliente));
+                    resultado_servidor_t aceptado = aceptar_cliente_de(servidor, socket_escucha,
+                                                                       &nuevo_cliente, locales);
+                    if (aceptado == SERVIDOR_ERROR_TIMEOUT) {
+                        break; // EAGAIN: cola vacía
+                    }
+                    if (aceptado != SERVIDOR_EXITO) {
+                        // Errores de una sola conexión: seguir con el resto de la cola
+                        if (errno == EINTR || errno == ECONNABORTED || errno == EPROTO) {
+                            continue;
+                        }
+                        if ((errno == EMFILE || errno == ENFILE) && reserva >= 0) {
+                            close(reserva);
+                            int descartado = accept(socket_escucha, NULL, NULL);
+                            if (descartado >= 0) {
+                                close(descartado);
+                                contar_suceso(servidor, locales, ESTADISTICA_RECHAZO, 0, 0);
+                            }
+                            reserva = open("/dev/null", O_RDONLY | O_CLOEXEC);
+                            if (descartado >= 0) {
+                                continue;
+                            }
+                        }
+                        break;
+                    }
+                    if (num_libres == 0) {
+                        if (servidor->config.verbose) {
+                            printf("[SERVIDOR] Máximo de clientes alcanzado, rechazando conexión\n");
+                        }
+                        contar_suceso(servidor, locales, ESTADISTICA_RECHAZO, 0, 0);
+                        desconectar_cliente_de(servidor, &nuevo_cliente, locales);
+                        continue;
+                    }
+                    
+                    int fd_flags = fcntl(nuevo_cliente.socket_fd, F_GETFL, 0);
+                    fcntl(nuevo_cliente.socket_fd, F_SETFL, fd_flags | O_NONBLOCK);
+                    
+                    int slot = libres[--num_libres];
+                    clientes[slot] = nuevo_cliente;
+                    
+                    // Registrar lectura y escritura una sola vez: con EPOLLET no
+                    // hace falta EPOLL_CTL_MOD para pedir o dejar de pedir EPOLLOUT
+                    struct epoll_event ev_cliente;
+                    ev_cliente.events = EPOLLIN | EPOLLOUT | EPOLLET;
+                    ev_cliente.data.u64 = (uint64_t)slot;
+                    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, nuevo_cliente.socket_fd, &ev_cliente) < 0) {
+                        perror("epoll_ctl cliente");
+                        desconectar_cliente_de(servidor, &clientes[slot], locales);
+                        libres[num_libres++] = slot;
+                    }
+                }
+                continue;
+            }
+            
+            int slot = (int)eventos[e].data.u64;
+            info_cliente_t* cliente = &clientes[slot];
+            if (!cliente->activo) {
+                continue; // Cerrado antes en esta misma tanda
+            }
+            
+            resultado_servidor_t resultado = atender_conexion_epoll(servidor, cliente, &pendientes[slot],
+                                                                    lectura, tam_lectura, locales);
+            if (resultado == SERVIDOR_EXITO) {
+                continue;
+            }
+            if (resultado != SERVIDOR_SHUTDOWN) {
+                fprintf(stderr, "Error procesando cliente: %s\n", servidor_strerror(resultado));
+            }
+            // close() también lo quita del conjunto de epoll
+            desconectar_cliente_de(servidor, cliente, locales);
+            pendientes[slot].inicio = pendientes[slot].fin = 0;
+            libres[num_libres++] = slot;
+        }
+    }
+    
+    for (int i = 0; i < num_slots; i++) {
+        free(pendientes[i].datos);
+    }
+    free(pendientes);
+    free(libres);
+    free(lectura);
+    if (reserva >= 0) close(reserva);
+    close(epoll_fd);
+    return SERVIDOR_EXITO;
+}
+
+resultado_servidor_t servidor_modo_epoll(servidor_tcp_t* servidor) {
+    if (!servidor) return SERVIDOR_ERROR_PARAMETRO;
+    
+    printf("[SERVIDOR] Ejecutando en modo EPOLL (edge-triggered)\n");
+    
+    ajustar_limite_descriptores((rlim_t)servidor->config.max_clientes + 64);
+    return bucle_epoll(servidor, servidor->socket_servidor, 0, servidor->config.max_clientes, NULL);
+}
+
+/**
+ * @brief Un trabajador de MODO_REUSEPORT: su socket de escucha, su tramo de clientes
+ *        y sus estadísticas, que se suman a las globales al terminar
+ */
+typedef struct {
+    servidor_tcp_t* servidor;
+    int socket_escucha;
+    int primer_slot;
+    int num_slots;
+    estadisticas_servidor_t stats;
+    pthread_t hilo;
+    resultado_servidor_t resultado;
+} trabajador_reuseport_t;
+
+static void* hilo_trabajador_reuseport(void* arg) {
+    trabajador_reuseport_t* trabajador = (trabajador_reuseport_t*)arg;
+    trabajador->resultado = bucle_epoll(trabajador->servidor, trabajador->socket_escucha,
+                                        trabajador->primer_slot, trabajador->num_slots,
+                                        &trabajador->stats);
+    return NULL;
+}
+
+resultado_servidor_t servidor_modo_reuseport(servidor_tcp_t* servidor) {
+    if (!servidor) return SERVIDOR_ERROR_PARAMETRO;
+    
+    int max_clientes = servidor->config.max_clientes;
+    int num_trabajadores = servidor->config.num_trabajadores;
+    if (num_trabajadores <= 0) {
+        long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+        num_trabajadores = nucleos > 0 ? (int)nucleos : 1;
+    }
+    if (num_trabajadores > max_clientes) {
+        num_trabajadores = max_clientes > 0 ? max_clientes : 1;
+    }
+    
+    printf("[SERVIDOR] Ejecutando en modo REUSEPORT (%d trabajadores)\n", num_trabajadores);
+    
+    ajustar_limite_descriptores((rlim_t)max_clientes + (rlim_t)num_trabajadores * 2 + 64);
+    
+    trabajador_reuseport_t* trabajadores = calloc((size_t)num_trabajadores, sizeof(trabajador_reuseport_t));
+    if (!trabajadores) {
+        return SERVIDOR_ERROR_MEMORIA;
+    }
+    
+    // El primer trabajador usa el socket de iniciar_servidor(); el resto abre
+    // el suyo en el mismo puerto. La tabla de clientes se reparte en tramos.
+    resultado_servidor_t resultado = SERVIDOR_EXITO;
+    int abiertos = 0;
+    int siguiente_slot = 0;
+    for (int t = 0; t < num_trabajadores; t++) {
+        trabajador_reuseport_t* trabajador = &trabajadores[t];
+        trabajador->servidor = servidor;
+        trabajador->primer_slot = siguiente_slot;
+        trabajador->num_slots = max_clientes / num_trabajadores + (t < max_clientes % num_trabajadores);
+        siguiente_slot += trabajador->num_slots;
+        
+        if (t == 0) {
+            trabajador->socket_escucha = servidor->socket_servidor;
+        } else {
+            resultado = abrir_socket_escucha(&servidor->config, 1, &trabajador->socket_escucha);
+            if (resultado != SERVIDOR_EXITO) {
+                break;
+            }
+        }
+        abiertos++;
+    }
+    
+    int lanzados = 0;
+    if (resultado == SERVIDOR_EXITO) {
+        for (; lanzados < num_trabajadores; lanzados++) {
+            if (pthread_create(&trabajadores[lanzados].hilo, NULL, hilo_trabajador_reuseport,
+                               &trabajadores[lanzados]) != 0) {
+                perror("pthread_create trabajador");
+                resultado = SERVIDOR_ERROR_SISTEMA;
+                servidor->ejecutandose = 0; // Que terminen los ya lanzados
+                break;
+            }
+        }
+    }
+    
+    for (int t = 0; t < lanzados; t++) {
+        pthread_join(trabajadores[t].hilo, NULL);
+        fusionar_estadisticas(servidor, &trabajadores[t].stats);
+        if (resultado == SERVIDOR_EXITO && trabajadores[t].resultado != SERVIDOR_EXITO) {
+            resultado = trabajadores[t].resultado;
+        }
+    }
+    
+    // El socket del primer trabajador lo cierra destruir_servidor()
+    for (int t = 1; t < abiertos; t++) {
+        close(trabajadores[t].socket_escucha);
+    }
+    free(trabajadores);
+    return resultado;
+}
+
+#else
+
+resultado_servidor_t servidor_modo_epoll(servidor_tcp_t* servidor) {
+    if (!servidor) return SERVIDOR_ERROR_PARAMETRO;
+    fprintf(stderr, "Modo EPOLL solo disponible en Linux; usa MODO_POLL\n");
+    return SERVIDOR_ERROR_SISTEMA;
+}
+
+resultado_servidor_t servidor_modo_reuseport(servidor_tcp_t* servidor) {
+    if (!servidor) return SERVIDOR_ERROR_PARAMETRO;
+    fprintf(stderr, "Modo REUSEPORT solo disponible en Linux; usa MODO_POLL\n");
+    return SERVIDOR_ERROR_SISTEMA;
+}
+
+#endif
+
+// ============================================================================
+// FUNCIONES DE UTILIDAD
+// ============================================================================
+
+void obtener_estadisticas_servidor(const servidor_tcp_t* servidor, estadisticas_servidor_t* stats) {
+    if (!servidor || !stats) return;
+    
+    pthread_mutex_lock((pthread_mutex_t*)&servidor->mutex_stats);
+    *stats = servidor->stats;
+    pthread_mutex_unlock((pthread_mutex_t*)&servidor->mutex_stats);
+}
+
+void resetear_estadisticas_servidor(servidor_tcp_t* servidor) {
+    if (!servidor) return;
+    
+    pthread_mutex_lock(&servidor->mutex_stats);
+    memset(&servidor->stats, 0, sizeof(estadisticas_servidor_t));
+    servidor->stats.tiempo_inicio = time(NULL);
+    pthread_mutex_unlock(&servidor->mutex_stats);
+}
+
+resultado_servidor_t configurar_socket_servidor(servidor_tcp_t* servidor) {
+    return configurar_socket_opciones(servidor->socket_servidor, &servidor->config);
+}
+
+void instalar_manejadores_senales(servidor_tcp_t* servidor) {
+    servidor_global = servidor;
+    
+    signal(SIGINT, manejador_shutdown);   // Ctrl+C
+    signal(SIGTERM, manejador_shutdown);  // Terminación
+    signal(SIGCHLD, manejador_sigchld);   // Procesos hijos terminados
+    signal(SIGPIPE, SIG_IGN);             // Ignorar SIGPIPE
+}
+
+const char* nombre_modo_servidor(modo_servidor_t modo) {
+    switch (modo) {
+        case MODO_SECUENCIAL: return "SECUENCIAL";
+        case MODO_FORK: return "FORK";
+        case MODO_THREAD: return "THREAD";
+        case MODO_SELECT: return "SELECT";
+        case MODO_POLL: return "POLL";
+        case MODO_EPOLL: return "EPOLL";
+        case MODO_REUSEPORT: return "REUSEPORT";
+        default: return "DESCONOCIDO";
+    }
+}
+
+const char* servidor_strerror(resultado_servidor_t codigo) {
+    switch (codigo) {
+        case SERVIDOR_EXITO: return "Operación exitosa";
+        case SERVIDOR_ERROR_SOCKET: return "Error creando socket";
+        case SERVIDOR_ERROR_BIND: return "Error en bind";
+        case SERVIDOR_ERROR_LISTEN: return "Error en listen";
+        case SERVIDOR_ERROR_ACCEPT: return "Error en accept";
+        case SERVIDOR_ERROR_RECV: return "Error recibiendo datos";
+        case SERVIDOR_ERROR_SEND: return "Error enviando datos";
+        case SERVIDOR_ERROR_MEMORIA: return "Error de memoria";
+        case SERVIDOR_ERROR_TIMEOUT: return "Timeout";
+        case SERVIDOR_ERROR_PARAMETRO: return "Parámetro inválido";
+        case SERVIDOR_ERROR_SISTEMA: return "Error del sistema";
+        case SERVIDOR_SHUTDOWN: return "Shutdown del servidor";
+        default: return "Error desconocido";
+    }
+}
+
+resultado_servidor_t obtener_info_cliente(int cliente_fd, info_cliente_t* info) {
+    if (!info || cliente_fd < 0) return SERVIDOR_ERROR_PARAMETRO;
+    
+    socklen_t tam = sizeof(info->direccion);
+    if (getpeername(cliente_fd, (struct sockaddr*)&info->direccion, &tam) < 0) {
+        perror("getpeername");
+        return SERVIDOR_ERROR_SISTEMA;
     }
     
     info->socket_fd = cliente_fd;
@@ -869,33 +1663,581 @@ resultado_servidor_t demo_servidor_modos(void) {
     return resultado;
 }
 
+#define PUERTO_DEMO_RENDIMIENTO 9191
+#define TAM_MENSAJE_DEMO 64
+
+/**
+ * @brief Servidor ejecutándose en segundo plano durante una medición
+ */
+typedef struct {
+    servidor_tcp_t* servidor;
+    resultado_servidor_t resultado;
+} ejecucion_servidor_t;
+
+static void* hilo_ejecutar_servidor(void* arg) {
+    ejecucion_servidor_t* ejecucion = (ejecucion_servidor_t*)arg;
+    ejecucion->resultado = ejecutar_servidor(ejecucion->servidor);
+    return NULL;
+}
+
+/**
+ * @brief Conectar a 127.0.0.1:puerto con timeout de recepción de 2 segundos
+ */
+static int conectar_local(int puerto) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    
+    struct sockaddr_in direccion;
+    memset(&direccion, 0, sizeof(direccion));
+    direccion.sin_family = AF_INET;
+    direccion.sin_port = htons(puerto);
+    direccion.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    
+    if (connect(fd, (struct sockaddr*)&direccion, sizeof(direccion)) < 0) {
+        close(fd);
+        return -1;
+    }
+    
+    struct timeval tv = { 2, 0 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    int opcion = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &opcion, sizeof(opcion));
+    return fd;
+}
+
+/**
+ * @brief Medir un modo con conexiones persistentes concurrentes
+ *
+ * Un único hilo cliente abre todas las conexiones y hace rondas: envía un
+ * mensaje por cada conexión y después recoge todos los ecos, así que el
+ * servidor siempre tiene num_conexiones sockets abiertos y muchos listos a
+ * la vez. Devuelve mensajes por segundo, o -1 si el servidor no arrancó.
+ */
+static double medir_modo_servidor(modo_servidor_t modo, int puerto, int num_conexiones, int rondas,
+                                  int* atendidas, int* rechazadas) {
+    config_servidor_t config = CONFIG_SERVIDOR_DEFECTO;
+    strcpy(config.host, "127.0.0.1");
+    config.puerto = puerto;
+    config.modo = modo;
+    config.backlog = num_conexiones;
+    config.max_clientes = num_conexiones + 1; // +1 para la conexión que despierta al final
+    config.timeout_cliente_seg = 5;
+    config.buffer_size = 8192;
+    config.no_delay = 1;
+    config.verbose = 0;
+    
+    *atendidas = 0;
+    *rechazadas = 0;
+    servidor_tcp_t* servidor = crear_servidor(&config);
+    if (!servidor) return -1.0;
+    if (iniciar_servidor(servidor) != SERVIDOR_EXITO) {
+        destruir_servidor(servidor);
+        return -1.0;
+    }
+    
+    // Cliente y servidor comparten el proceso: dos descriptores por conexión
+    ajustar_limite_descriptores((rlim_t)num_conexiones * 2 + 64);
+    int* conexiones = malloc(sizeof(int) * (size_t)num_conexiones);
+    ejecucion_servidor_t ejecucion = { servidor, SERVIDOR_EXITO };
+    pthread_t hilo;
+    fflush(stdout); // En MODO_FORK cada hijo hereda (y vacía al salir) el buffer de stdout
+    if (!conexiones || pthread_create(&hilo, NULL, hilo_ejecutar_servidor, &ejecucion) != 0) {
+        free(conexiones);
+        destruir_servidor(servidor);
+        return -1.0;
+    }
+    
+    for (int i = 0; i < num_conexiones; i++) {
+        conexiones[i] = conectar_local(config.puerto);
+    }
+    char mensaje[TAM_MENSAJE_DEMO];
+    char respuesta[TAM_MENSAJE_DEMO];
+    memset(mensaje, 'x', sizeof(mensaje));
+    long mensajes = 0;
+    struct timespec inicio, fin;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    
+    for (int r = 0; r < rondas; r++) {
+        for (int i = 0; i < num_conexiones; i++) {
+            if (conexiones[i] >= 0 && send(conexiones[i], mensaje, sizeof(mensaje), MSG_NOSIGNAL) != (ssize_t)sizeof(mensaje)) {
+                close(conexiones[i]);
+                conexiones[i] = -1;
+            }
+        }
+        for (int i = 0; i < num_conexiones; i++) {
+            size_t recibidos = 0;
+            while (conexiones[i] >= 0 && recibidos < sizeof(respuesta)) {
+                ssize_t n = recv(conexiones[i], respuesta + recibidos, sizeof(respuesta) - recibidos, 0);
+                if (n < 0 && errno == EINTR) continue;
+                if (n <= 0) {
+                    // Rechazada por el servidor o sin respuesta en 2 s
+                    close(conexiones[i]);
+                    conexiones[i] = -1;
+                    break;
+                }
+                recibidos += (size_t)n;
+            }
+            if (conexiones[i] >= 0) mensajes++;
+        }
+    }
+    
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    double segundos = (fin.tv_sec - inicio.tv_sec) + (fin.tv_nsec - inicio.tv_nsec) / 1e9;
+    
+    for (int i = 0; i < num_conexiones; i++) {
+        if (conexiones[i] >= 0) {
+            (*atendidas)++;
+            close(conexiones[i]);
+        }
+    }
+    free(conexiones);
+    
+    // Los modos SECUENCIAL/FORK/THREAD esperan en accept(): una conexión los despierta
+    detener_servidor(servidor);
+    int despertador = conectar_local(config.puerto);
+    if (despertador >= 0) close(despertador);
+    pthread_join(hilo, NULL);
+    
+    // En MODO_THREAD los hilos de cliente usan el servidor hasta desconectar
+    estadisticas_servidor_t stats;
+    for (int espera = 0; espera < 200; espera++) {
+        obtener_estadisticas_servidor(servidor, &stats);
+        if (modo != MODO_THREAD || stats.conexiones_activas <= 0) break;
+        usleep(10000);
+    }
+    *rechazadas = stats.conexiones_rechazadas;
+    destruir_servidor(servidor);
+    
+    return segundos > 0 ? mensajes / segundos : 0.0;
+}
+
 resultado_servidor_t demo_servidor_rendimiento(void) {
     printf("\n=== DEMO: Rendimiento del Servidor ===\n");
     
+    // Un puerto por medición: los hijos de MODO_FORK pueden seguir vivos
+    // (hasta su timeout) con conexiones del puerto anterior.
+    // SECUENCIAL atiende una conexión hasta que se cierra, así que con
+    // conexiones persistentes concurrentes las demás nunca reciben eco.
+    // THREAD y FORK crean un hilo o proceso por conexión: solo con la carga pequeña.
+    static const struct {
+        int conexiones;
+        int rondas;
+        int todos_los_modos;
+    } cargas[] = {
+        { 100, 200, 1 },
+        { 5000, 20, 0 },
+    };
+    static const modo_servidor_t modos[] = {
+        MODO_EPOLL, MODO_POLL, MODO_SELECT, MODO_THREAD, MODO_FORK
+    };
+    
+    struct {
+        int conexiones;
+        modo_servidor_t modo;
+        double mensajes_por_segundo;
+        int atendidas;
+        int rechazadas;
+    } resultados[2 * 5];
+    int num_resultados = 0;
+    
+    for (size_t c = 0; c < sizeof(cargas) / sizeof(cargas[0]); c++) {
+        for (size_t m = 0; m < sizeof(modos) / sizeof(modos[0]); m++) {
+            if (!cargas[c].todos_los_modos && (modos[m] == MODO_THREAD || modos[m] == MODO_FORK)) {
+                continue;
+            }
+            printf("\n--- %s con %d conexiones ---\n", nombre_modo_servidor(modos[m]), cargas[c].conexiones);
+            resultados[num_resultados].conexiones = cargas[c].conexiones;
+            resultados[num_resultados].modo = modos[m];
+            resultados[num_resultados].mensajes_por_segundo =
+                medir_modo_servidor(modos[m], PUERTO_DEMO_RENDIMIENTO + num_resultados,
+                                    cargas[c].conexiones, cargas[c].rondas,
+                                    &resultados[num_resultados].atendidas,
+                                    &resultados[num_resultados].rechazadas);
+            num_resultados++;
+        }
+    }
+    
+    printf("\n%-11s %-11s %10s %11s %12s\n", "Conexiones", "Modo", "Atendidas", "Rechazadas", "Mensajes/s");
+    for (int i = 0; i < num_resultados; i++) {
+        printf("%-11d %-11s ", resultados[i].conexiones, nombre_modo_servidor(resultados[i].modo));
+        if (resultados[i].mensajes_por_segundo < 0) {
+            printf("%10s\n", "error");
+            continue;
+        }
+        printf("%10d %11d %12.0f\n", resultados[i].atendidas, resultados[i].rechazadas,
+               resultados[i].mensajes_por_segundo);
+    }
+    printf("\nSELECT no admite descriptores >= FD_SETSIZE (%d) y recorre todos en cada\n"
+           "vuelta; POLL quita el límite pero sigue siendo O(conectadas) por llamada;\n"
+           "EPOLL solo devuelve las conexiones listas.\n", FD_SETSIZE);
+    
+    return SERVIDOR_EXITO;
+}
+
+#define PUERTO_DEMO_ACEPTACION 9291
+#define BACKLOG_DEMO_ACEPTACION 64
+#define CLIENTES_DEMO_ACEPTACION 32
+#define CONEXIONES_DEMO_ACEPTACION 250
+
+/**
+ * @brief Contador ListenOverflows de /proc/net/netstat (-1 si no está disponible)
+ *
+ * Cuenta los SYN/ACK descartados porque la cola de accept estaba llena.
+ */
+static long leer_desbordes_escucha(void) {
+    FILE* archivo = fopen("/proc/net/netstat", "r");
+    if (!archivo) return -1;
+    
+    // Cada grupo ocupa dos líneas: nombres de los campos y sus valores
+    char nombres[4096];
+    char valores[4096];
+    long desbordes = -1;
+    while (desbordes < 0 && fgets(nombres, sizeof(nombres), archivo) &&
+           fgets(valores, sizeof(valores), archivo)) {
+        if (strncmp(nombres, "TcpExt:", 7) != 0) continue;
+        
+        char* guardado_nombres;
+        char* guardado_valores;
+        char* nombre = strtok_r(nombres, " \n", &guardado_nombres);
+        char* valor = strtok_r(valores, " \n", &guardado_valores);
+        while (nombre && valor) {
+            if (strcmp(nombre, "ListenOverflows") == 0) {
+                desbordes = atol(valor);
+                break;
+            }
+            nombre = strtok_r(NULL, " \n", &guardado_nombres);
+            valor = strtok_r(NULL, " \n", &guardado_valores);
+        }
+    }
+    fclose(archivo);
+    return desbordes;
+}
+
+/**
+ * @brief Medir conexiones/s contra un servidor en un proceso hijo
+ *
+ * El servidor corre en otro proceso para que los clientes de
+ * stress_test_clientes() (que hacen fork) no hereden sus hilos. Devuelve
+ * conexiones por segundo, o -1 si el servidor no arrancó.
+ */
+static double medir_aceptacion(modo_servidor_t modo, int num_trabajadores, int puerto, long* desbordes) {
+    *desbordes = -1;
+    fflush(stdout);
+    pid_t servidor_pid = fork();
+    if (servidor_pid < 0) {
+        perror("fork servidor");
+        return -1.0;
+    }
+    
+    if (servidor_pid == 0) {
+        if (!freopen("/dev/null", "w", stdout)) _exit(1);
+        
+        config_servidor_t config = CONFIG_SERVIDOR_DEFECTO;
+        strcpy(config.host, "127.0.0.1");
+        config.puerto = puerto;
+        config.modo = modo;
+        config.num_trabajadores = num_trabajadores;
+        config.backlog = BACKLOG_DEMO_ACEPTACION;
+        config.max_clientes = 1024; // Cada hilo solo dispone de su tramo: holgura para rezagados
+        config.timeout_cliente_seg = 5;
+        config.keep_alive = 0;
+        
+        servidor_tcp_t* servidor = crear_servidor(&config);
+        if (!servidor) _exit(1);
+        if (iniciar_servidor(servidor) != SERVIDOR_EXITO) {
+            destruir_servidor(servidor);
+            _exit(1);
+        }
+        ejecutar_servidor(servidor);
+        destruir_servidor(servidor);
+        _exit(0);
+    }
+    
+    // Esperar a que escuche (hasta 2 s)
+    int listo = 0;
+    for (int intento = 0; intento < 200 && !listo; intento++) {
+        int fd = conectar_local(puerto);
+        if (fd >= 0) {
+            close(fd);
+            listo = 1;
+        } else {
+            usleep(10000);
+        }
+    }
+    
+    double tasa = -1.0;
+    if (listo) {
+        long antes = leer_desbordes_escucha();
+        if (stress_test_clientes("127.0.0.1", puerto, CLIENTES_DEMO_ACEPTACION,
+                                 CONEXIONES_DEMO_ACEPTACION, &tasa) != SERVIDOR_EXITO) {
+            tasa = -1.0;
+        }
+        long despues = leer_desbordes_escucha();
+        if (antes >= 0 && despues >= 0) {
+            *desbordes = despues - antes;
+        }
+    }
+    
+    kill(servidor_pid, SIGTERM);
+    while (waitpid(servidor_pid, NULL, 0) < 0 && errno == EINTR);
+    return tasa;
+}
+
+resultado_servidor_t demo_servidor_reuseport(void) {
+    printf("\n=== DEMO: Aceptación con SO_REUSEPORT ===\n");
+    printf("%d clientes abren %d conexiones cada uno, sin pausas (backlog %d por socket)\n",
+           CLIENTES_DEMO_ACEPTACION, CONEXIONES_DEMO_ACEPTACION, BACKLOG_DEMO_ACEPTACION);
+    
+    long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+    int max_trabajadores = nucleos > 4 ? (int)nucleos : 4;
+    
+    struct {
+        modo_servidor_t modo;
+        int trabajadores;
+        double conexiones_por_segundo;
+        long desbordes;
+    } resultados[16];
+    int num_resultados = 0;
+    
+    // Referencia: un solo socket de escucha y un solo hilo
+    resultados[num_resultados].modo = MODO_EPOLL;
+    resultados[num_resultados].trabajadores = 1;
+    num_resultados++;
+    for (int t = 1; t <= max_trabajadores && num_resultados < 16; t *= 2) {
+        resultados[num_resultados].modo = MODO_REUSEPORT;
+        resultados[num_resultados].trabajadores = t;
+        num_resultados++;
+    }
+    
+    for (int i = 0; i < num_resultados; i++) {
+        printf("\n--- %s con %d hilo(s) ---\n", nombre_modo_servidor(resultados[i].modo),
+               resultados[i].trabajadores);
+        resultados[i].conexiones_por_segundo =
+            medir_aceptacion(resultados[i].modo, resultados[i].trabajadores,
+                             PUERTO_DEMO_ACEPTACION + i, &resultados[i].desbordes);
+    }
+    
+    printf("\n%-11s %6s %14s %10s\n", "Modo", "Hilos", "Conexiones/s", "Desbordes");
+    for (int i = 0; i < num_resultados; i++) {
+        printf("%-11s %6d ", nombre_modo_servidor(resultados[i].modo), resultados[i].trabajadores);
+        if (resultados[i].conexiones_por_segundo < 0) {
+            printf("%14s\n", "error");
+            continue;
+        }
+        printf("%14.0f ", resultados[i].conexiones_por_segundo);
+        if (resultados[i].desbordes < 0) {
+            printf("%10s\n", "n/d");
+        } else {
+            printf("%10ld\n", resultados[i].desbordes);
+        }
+    }
+    printf("\nDesbordes: conexiones descartadas con la cola de accept llena\n"
+           "(ListenOverflows, para todo el sistema). Núcleos disponibles: %ld\n", nucleos);
+    
+    return SERVIDOR_EXITO;
+}
+
+#define PUERTO_DEMO_SPLICE 9391
+#define BLOQUE_DEMO_SPLICE 65536
+#define TOTAL_DEMO_SPLICE (256u * 1024 * 1024)
+
+/**
+ * @brief Contador de ciclos de CPU del hilo que llama (-1 si no hay PMU accesible)
+ */
+static int abrir_contador_ciclos(void) {
+    #ifdef __linux__
+    struct perf_event_attr atributos;
+    memset(&atributos, 0, sizeof(atributos));
+    atributos.type = PERF_TYPE_HARDWARE;
+    atributos.size = sizeof(atributos);
+    atributos.config = PERF_COUNT_HW_CPU_CYCLES;
+    atributos.exclude_kernel = 0; // El trabajo del eco está casi todo en el kernel
+    atributos.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &atributos, 0, -1, -1, 0);
+    #else
+    return -1;
+    #endif
+}
+
+/**
+ * @brief Frecuencia del TSC en Hz medida contra CLOCK_MONOTONIC (0 fuera de x86)
+ */
+static double estimar_hz_tsc(void) {
+    #if defined(__x86_64__) || defined(__i386__)
+    struct timespec inicio, fin;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    unsigned long long tsc_inicio = __rdtsc();
+    usleep(50000);
+    unsigned long long tsc_fin = __rdtsc();
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    double segundos = (fin.tv_sec - inicio.tv_sec) + (fin.tv_nsec - inicio.tv_nsec) / 1e9;
+    return segundos > 0 ? (double)(tsc_fin - tsc_inicio) / segundos : 0.0;
+    #else
+    return 0.0;
+    #endif
+}
+
+/**
+ * @brief Servidor en segundo plano que mide su propio coste de CPU
+ */
+typedef struct {
+    servidor_tcp_t* servidor;
+    double segundos_cpu;
+    long long ciclos;               // -1 si no hay contador de ciclos
+} medicion_eco_t;
+
+static void* hilo_servidor_medido(void* arg) {
+    medicion_eco_t* medicion = (medicion_eco_t*)arg;
+    int contador = abrir_contador_ciclos();
+    struct timespec inicio, fin;
+    
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &inicio);
+    ejecutar_servidor(medicion->servidor);
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &fin);
+    
+    medicion->segundos_cpu = (fin.tv_sec - inicio.tv_sec) + (fin.tv_nsec - inicio.tv_nsec) / 1e9;
+    medicion->ciclos = -1;
+    if (contador >= 0) {
+        long long ciclos;
+        if (read(contador, &ciclos, sizeof(ciclos)) == (ssize_t)sizeof(ciclos)) {
+            medicion->ciclos = ciclos;
+        }
+        close(contador);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Enviar TOTAL_DEMO_SPLICE bytes por una conexión (lo recoge otro hilo)
+ */
+static void* hilo_emisor_masivo(void* arg) {
+    int fd = *(int*)arg;
+    char* bloque = malloc(BLOQUE_DEMO_SPLICE);
+    if (!bloque) return NULL;
+    memset(bloque, 'x', BLOQUE_DEMO_SPLICE);
+    
+    size_t enviados = 0;
+    while (enviados < TOTAL_DEMO_SPLICE) {
+        ssize_t n = send(fd, bloque, BLOQUE_DEMO_SPLICE, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        enviados += (size_t)n;
+    }
+    free(bloque);
+    return NULL;
+}
+
+/**
+ * @brief Medir el eco de una transferencia grande con copia o con splice
+ *
+ * MODO_SECUENCIAL atiende la única conexión en su propio hilo, que mide su
+ * tiempo de CPU y sus ciclos: solo cuenta el trabajo del servidor. Devuelve
+ * MB/s de eco, o -1 si algo falló.
+ */
+static double medir_eco_masivo(int eco_splice, int puerto, medicion_eco_t* medicion) {
     config_servidor_t config = CONFIG_SERVIDOR_DEFECTO;
-    config.modo = MODO_SELECT;
-    config.max_clientes = 20;
-    config.buffer_size = 8192;
-    config.verbose = 0; // Menos verbose para mejor rendimiento
+    strcpy(config.host, "127.0.0.1");
+    config.puerto = puerto;
+    config.modo = MODO_SECUENCIAL;
+    config.max_clientes = 2;
+    config.timeout_cliente_seg = 5;
+    config.buffer_size = BLOQUE_DEMO_SPLICE;
+    config.eco_splice = eco_splice;
     
     servidor_tcp_t* servidor = crear_servidor(&config);
-    if (!servidor) return SERVIDOR_ERROR_MEMORIA;
+    if (!servidor) return -1.0;
+    if (iniciar_servidor(servidor) != SERVIDOR_EXITO) {
+        destruir_servidor(servidor);
+        return -1.0;
+    }
     
-    resultado_servidor_t resultado = iniciar_servidor(servidor);
-    if (resultado != SERVIDOR_EXITO) {
+    medicion->servidor = servidor;
+    pthread_t hilo_servidor;
+    if (pthread_create(&hilo_servidor, NULL, hilo_servidor_medido, medicion) != 0) {
         destruir_servidor(servidor);
-        return resultado;
+        return -1.0;
     }
     
-    printf("Servidor optimizado para rendimiento. Presiona Ctrl+C para detener.\n");
-    printf("Métricas se actualizarán automáticamente.\n");
+    char* recepcion = malloc(BLOQUE_DEMO_SPLICE);
+    int fd = conectar_local(puerto);
+    size_t recibidos = 0;
+    struct timespec inicio, fin;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
     
-    resultado = ejecutar_servidor(servidor);
+    pthread_t hilo_emisor;
+    if (recepcion && fd >= 0 && pthread_create(&hilo_emisor, NULL, hilo_emisor_masivo, &fd) == 0) {
+        while (recibidos < TOTAL_DEMO_SPLICE) {
+            ssize_t n = recv(fd, recepcion, BLOQUE_DEMO_SPLICE, 0);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) break;
+            recibidos += (size_t)n;
+        }
+        shutdown(fd, SHUT_RDWR); // Desbloquea al emisor si el eco se cortó
+        pthread_join(hilo_emisor, NULL);
+    }
     
-    imprimir_estadisticas_servidor(servidor, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    double segundos = (fin.tv_sec - inicio.tv_sec) + (fin.tv_nsec - inicio.tv_nsec) / 1e9;
+    if (fd >= 0) close(fd);
+    free(recepcion);
+    
+    // MODO_SECUENCIAL espera en accept(): una conexión lo despierta
+    detener_servidor(servidor);
+    int despertador = conectar_local(puerto);
+    if (despertador >= 0) close(despertador);
+    pthread_join(hilo_servidor, NULL);
     destruir_servidor(servidor);
     
-    return resultado;
+    if (recibidos < TOTAL_DEMO_SPLICE || segundos <= 0) return -1.0;
+    return recibidos / segundos / (1024.0 * 1024.0);
+}
+
+resultado_servidor_t demo_servidor_splice(void) {
+    printf("\n=== DEMO: Eco con copia frente a splice ===\n");
+    printf("Eco de %u MiB en bloques de %d KiB por una sola conexión\n",
+           TOTAL_DEMO_SPLICE / (1024 * 1024), BLOQUE_DEMO_SPLICE / 1024);
+    
+    double hz_tsc = estimar_hz_tsc();
+    static const char* nombres[] = { "COPIA", "SPLICE" };
+    double mb_por_segundo[2];
+    medicion_eco_t mediciones[2];
+    
+    for (int ruta = 0; ruta < 2; ruta++) {
+        printf("\n--- %s ---\n", nombres[ruta]);
+        memset(&mediciones[ruta], 0, sizeof(mediciones[ruta]));
+        mb_por_segundo[ruta] = medir_eco_masivo(ruta, PUERTO_DEMO_SPLICE + ruta, &mediciones[ruta]);
+    }
+    
+    int ciclos_estimados = 0;
+    printf("\n%-8s %10s %14s %12s\n", "Ruta", "MB/s", "ns CPU/byte", "Ciclos/byte");
+    for (int ruta = 0; ruta < 2; ruta++) {
+        printf("%-8s ", nombres[ruta]);
+        if (mb_por_segundo[ruta] < 0) {
+            printf("%10s\n", "error");
+            continue;
+        }
+        // Cada byte recibido se devuelve: el servidor mueve 2 x TOTAL_DEMO_SPLICE
+        double bytes = 2.0 * TOTAL_DEMO_SPLICE;
+        double ciclos = (double)mediciones[ruta].ciclos;
+        if (mediciones[ruta].ciclos < 0) {
+            ciclos = mediciones[ruta].segundos_cpu * hz_tsc;
+            ciclos_estimados = 1;
+        }
+        printf("%10.0f %14.3f ", mb_por_segundo[ruta], mediciones[ruta].segundos_cpu * 1e9 / bytes);
+        if (ciclos > 0) {
+            printf("%12.3f\n", ciclos / bytes);
+        } else {
+            printf("%12s\n", "n/d");
+        }
+    }
+    
+    printf("\nCoste del hilo del servidor por byte movido (recibido + reenviado).\n");
+    if (ciclos_estimados && hz_tsc > 0) {
+        printf("Sin contador de ciclos accesible: ciclos = tiempo de CPU x TSC (%.2f GHz).\n",
+               hz_tsc / 1e9);
+    }
+    
+    return SERVIDOR_EXITO;
 }
 
 resultado_servidor_t demo_servidor_configuracion(void) {
@@ -1023,14 +2365,35 @@ resultado_servidor_t cliente_prueba_simple(const char* host, int puerto,
 }
 
 resultado_servidor_t stress_test_clientes(const char* host, int puerto, 
-                                         int num_clientes, int mensajes_por_cliente) {
+                                         int num_clientes, int mensajes_por_cliente,
+                                         double* conexiones_por_segundo) {
+    if (!host || num_clientes <= 0 || mensajes_por_cliente <= 0) return SERVIDOR_ERROR_PARAMETRO;
+    
     printf("Iniciando stress test: %d clientes, %d mensajes cada uno\n", 
            num_clientes, mensajes_por_cliente);
+    fflush(stdout); // Que los hijos no hereden (y repitan) el buffer pendiente
+    
+    // Cada hijo anota sus conexiones completadas en memoria compartida
+    int* completadas = mmap(NULL, sizeof(int) * (size_t)num_clientes, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    pid_t* hijos = malloc(sizeof(pid_t) * (size_t)num_clientes);
+    if (completadas == MAP_FAILED || !hijos) {
+        if (completadas != MAP_FAILED) munmap(completadas, sizeof(int) * (size_t)num_clientes);
+        free(hijos);
+        return SERVIDOR_ERROR_MEMORIA;
+    }
+    memset(completadas, 0, sizeof(int) * (size_t)num_clientes);
+    
+    resultado_servidor_t resultado_final = SERVIDOR_EXITO;
+    int lanzados = 0;
+    struct timespec inicio, fin;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
     
     for (int cliente = 0; cliente < num_clientes; cliente++) {
         pid_t pid = fork();
         if (pid == 0) {
-            // Proceso hijo - cliente
+            // Proceso hijo - cliente: cada mensaje es una conexión nueva, sin
+            // pausas, para que el servidor reciba una ráfaga de conexiones
             for (int msg = 0; msg < mensajes_por_cliente; msg++) {
                 char mensaje[256];
                 char respuesta[256];
@@ -1044,21 +2407,37 @@ resultado_servidor_t stress_test_clientes(const char* host, int puerto,
                            cliente, msg, servidor_strerror(resultado));
                     break;
                 }
-                
-                usleep(10000); // 10ms entre mensajes
+                completadas[cliente]++;
             }
-            exit(0);
+            _exit(0);
         } else if (pid < 0) {
             perror("fork cliente");
-            return SERVIDOR_ERROR_SISTEMA;
+            resultado_final = SERVIDOR_ERROR_SISTEMA;
+            break;
         }
+        hijos[lanzados++] = pid;
     }
     
-    // Esperar a todos los clientes
+    // Esperar a todos los clientes (solo a los nuestros: puede haber otros hijos)
+    for (int i = 0; i < lanzados; i++) {
+        while (waitpid(hijos[i], NULL, 0) < 0 && errno == EINTR);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    double segundos = (fin.tv_sec - inicio.tv_sec) + (fin.tv_nsec - inicio.tv_nsec) / 1e9;
+    
+    long total = 0;
     for (int i = 0; i < num_clientes; i++) {
-        wait(NULL);
+        total += completadas[i];
+    }
+    double tasa = segundos > 0 ? total / segundos : 0.0;
+    if (conexiones_por_segundo) {
+        *conexiones_por_segundo = tasa;
     }
     
-    printf("Stress test completado\n");
-    return SERVIDOR_EXITO;
+    printf("Stress test completado: %ld/%ld conexiones en %.2f s (%.0f conexiones/s)\n",
+           total, (long)num_clientes * mensajes_por_cliente, segundos, tasa);
+    
+    munmap(completadas, sizeof(int) * (size_t)num_clientes);
+    free(hijos);
+    return resultado_final;
 }
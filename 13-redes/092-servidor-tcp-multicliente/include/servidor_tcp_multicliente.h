@@ -5,12 +5,12 @@
  * @date 2024
  * 
  * Este header define la API completa para implementar un servidor TCP
- * que maneja múltiples clientes simultáneamente usando pthread para
- * crear un hilo por cada conexión cliente.
+ * que maneja múltiples clientes simultáneamente con un número fijo de
+ * hilos reactor, cada uno con su propio conjunto epoll.
  * 
  * Características principales:
- * - Servidor TCP multihilo con pthread
- * - Pool de hilos configurable
+ * - Servidor TCP multihilo con pthread y epoll
+ * - Reactores acotados por max_hilos con reparto al menos cargado
  * - Manejo robusto de conexiones y errores
  * - Estadísticas de conexiones en tiempo real
  * - Configuración avanzada de servidor
@@ -22,6 +22,7 @@
 #define SERVIDOR_TCP_MULTICLIENTE_H
 
 #include <stdio.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
@@ -43,6 +44,10 @@
 #define PUERTO_DEFAULT 9090
 #define BUFFER_SIZE_DEFAULT 4096
 #define MAX_CONEXIONES_DEFAULT 100
+#define MAX_CONEXIONES_LIMITE 65536
+#define MAX_TABLA_DESCRIPTORES (1 << 20)  // Tope de la tabla indexada por fd
+#define CAPACIDAD_COLA_SALIDA 64          // Mensajes pendientes por cliente
+#define IOV_POR_ESCRITURA 16              // Mensajes reunidos en cada envío
 #define MAX_HILOS_DEFAULT 50
 #define TIMEOUT_CLIENTE_DEFAULT 300  // 5 minutos
 #define BACKLOG_DEFAULT 10
@@ -80,7 +85,7 @@ typedef enum {
 typedef struct {
     int puerto;                    ///< Puerto de escucha
     int max_conexiones;           ///< Máximo número de conexiones simultáneas
-    int max_hilos;               ///< Máximo número de hilos worker
+    int max_hilos;               ///< Máximo número de hilos reactor
     int buffer_size;             ///< Tamaño del buffer por cliente
     int timeout_cliente;         ///< Timeout para clientes inactivos (segundos)
     int backlog;                 ///< Tamaño de la cola de listen()
@@ -91,12 +96,25 @@ typedef struct {
     char bind_ip[64];            ///< IP específica para bind (INADDR_ANY si vacío)
 } ConfigServidor;
 
+/**
+ * @brief Mensaje inmutable compartido por las colas de varios clientes
+ *
+ * Un broadcast reserva uno solo y cada cola de destino retiene una
+ * referencia; el último en soltarlo lo libera.
+ */
+typedef struct {
+    volatile int referencias;    ///< Referencias vivas (colas y creador)
+    size_t tamaño;               ///< Bytes de datos
+    char datos[];                ///< Contenido, no cambia tras crearse
+} MensajeCompartido;
+
 /**
  * @brief Información de un cliente conectado
  */
 typedef struct {
     int socket_fd;               ///< Descriptor del socket del cliente
     pthread_t thread_id;         ///< ID del hilo que atiende al cliente
+    int reactor;                 ///< Índice del reactor que atiende al cliente
     struct sockaddr_in direccion; ///< Dirección IP y puerto del cliente
     time_t tiempo_conexion;      ///< Timestamp de conexión
     time_t ultima_actividad;     ///< Timestamp de última actividad
@@ -106,6 +124,15 @@ typedef struct {
     size_t mensajes_recibidos;   ///< Número de mensajes recibidos
     int activo;                  ///< Flag de cliente activo
     char identificador[32];      ///< Identificador único del cliente
+    MensajeCompartido* cola_salida[CAPACIDAD_COLA_SALIDA]; ///< Anillo de mensajes por enviar
+    int cabeza_cola;             ///< Posición del mensaje más antiguo
+    int mensajes_en_cola;        ///< Mensajes en cola_salida
+    size_t enviados_cabeza;      ///< Bytes ya enviados del más antiguo
+    int escritura_armada;        ///< El reactor espera EPOLLOUT en vez de EPOLLIN
+    int cola_desbordada;         ///< Se llenó la cola: cliente demasiado lento
+    // Desde aquí los campos sobreviven al reinicio del slot en registrar_cliente
+    uint32_t generacion;         ///< Cambia en cada registro del slot
+    volatile int cerrojo_cola;   ///< Spinlock de la cola (0 = libre)
 } InfoCliente;
 
 /**
@@ -130,24 +157,12 @@ typedef struct {
     size_t mensajes_totales;         ///< Total de mensajes procesados
     size_t errores_red;             ///< Errores de red ocurridos
     size_t errores_hilos;           ///< Errores de hilos ocurridos
+    size_t desconexiones_cola_llena; ///< Clientes lentos expulsados
     time_t tiempo_inicio;           ///< Timestamp de inicio del servidor
     time_t tiempo_actividad;        ///< Timestamp de última actividad
     pthread_mutex_t mutex;          ///< Mutex para acceso thread-safe
 } EstadisticasServidor;
 
-/**
- * @brief Contexto principal del servidor
- */
-typedef struct {
-    ConfigServidor config;              ///< Configuración del servidor
-    EstadisticasServidor stats;         ///< Estadísticas del servidor
-    InfoCliente* clientes;              ///< Array de información de clientes
-    int socket_servidor;                ///< Socket principal del servidor
-    int ejecutando;                     ///< Flag de ejecución
-    pthread_mutex_t mutex_clientes;     ///< Mutex para lista de clientes
-    pthread_mutex_t mutex_logs;         ///< Mutex para logging thread-safe
-} ContextoServidor;
-
 // =============================================================================
 // TIPOS DE FUNCIONES CALLBACK
 // =============================================================================
@@ -159,10 +174,45 @@ typedef struct {
  * @param tamaño Tamaño del mensaje
  * @param contexto Contexto del servidor
  * @return Número de bytes a enviar de respuesta, 0 para no responder, -1 para error
+ *
+ * La respuesta son los primeros bytes de buffer (el eco devuelve tamaño).
+ * Se invoca desde el hilo reactor del cliente, así que no debe bloquear.
  */
 typedef ssize_t (*ProcesadorMensaje)(InfoCliente* cliente, const char* buffer, 
                                      size_t tamaño, void* contexto);
 
+/**
+ * @brief Hilo reactor: atiende muchas conexiones con su propio conjunto epoll
+ */
+typedef struct {
+    int id;                      ///< Índice del reactor
+    int epoll_fd;                ///< Conjunto epoll propio del reactor
+    pthread_t hilo;              ///< Hilo que ejecuta el bucle del reactor
+    volatile int conexiones;     ///< Conexiones asignadas, para el reparto
+    void* servidor_ctx;          ///< Contexto del servidor principal
+} ReactorServidor;
+
+/**
+ * @brief Contexto principal del servidor
+ */
+typedef struct {
+    ConfigServidor config;              ///< Configuración del servidor
+    EstadisticasServidor stats;         ///< Estadísticas del servidor
+    InfoCliente* clientes;              ///< Array de información de clientes
+    InfoCliente** tabla_fd;             ///< Cliente por descriptor, lectura sin mutex
+    int tam_tabla_fd;                   ///< Entradas de tabla_fd
+    int* slots_libres;                  ///< Pila de índices libres de clientes
+    int num_slots_libres;               ///< Elementos en slots_libres
+    int socket_servidor;                ///< Socket principal del servidor
+    int ejecutando;                     ///< Flag de ejecución
+    pthread_mutex_t mutex_clientes;     ///< Mutex para lista de clientes
+    pthread_mutex_t mutex_logs;         ///< Mutex para logging thread-safe
+    ReactorServidor* reactores;         ///< Hilos reactor en ejecución
+    int num_reactores;                  ///< Número de reactores (<= max_hilos)
+    ProcesadorMensaje procesador;       ///< Procesador para TIPO_CUSTOM
+    void* datos_procesador;             ///< Datos de usuario del procesador
+} ContextoServidor;
+
 /**
  * @brief Función callback para manejar conexión de cliente
  * @param cliente Información del cliente
@@ -256,9 +306,43 @@ InfoCliente* aceptar_cliente(ContextoServidor* contexto);
  * @brief Función principal del hilo de atención a cliente
  * @param arg Puntero a ParametrosHilo
  * @return NULL
+ *
+ * Atiende un único cliente con E/S bloqueante. ejecutar_servidor ya no
+ * crea un hilo por cliente; se mantiene para quien quiera ese modelo.
  */
 void* atender_cliente(void* arg);
 
+/**
+ * @brief Bucle de un hilo reactor: epoll_wait, recv, procesador y send
+ * @param arg Puntero a ReactorServidor
+ * @return NULL
+ */
+void* ejecutar_reactor(void* arg);
+
+/**
+ * @brief Número de reactores que arrancará el servidor
+ * @param config Configuración del servidor
+ * @return min(max_hilos, núcleos en línea), al menos 1
+ */
+int calcular_num_reactores(const ConfigServidor* config);
+
+/**
+ * @brief Entrega un cliente ya registrado al reactor menos cargado
+ * @param contexto Contexto del servidor
+ * @param cliente Cliente registrado
+ * @return SERVER_EXITO si éxito, código de error caso contrario
+ */
+int asignar_cliente_a_reactor(ContextoServidor* contexto, InfoCliente* cliente);
+
+/**
+ * @brief Instala el procesador de mensajes usado con TIPO_CUSTOM
+ * @param contexto Contexto del servidor
+ * @param procesador Callback de procesamiento
+ * @param datos Datos de usuario accesibles en contexto->datos_procesador
+ */
+void establecer_procesador_mensajes(ContextoServidor* contexto, 
+                                   ProcesadorMensaje procesador, void* datos);
+
 /**
  * @brief Registra un nuevo cliente en el servidor
  * @param contexto Contexto del servidor
@@ -281,9 +365,29 @@ void desregistrar_cliente(ContextoServidor* contexto, InfoCliente* cliente);
  * @param contexto Contexto del servidor
  * @param socket_fd Descriptor del socket a buscar
  * @return Puntero a InfoCliente si encontrado, NULL caso contrario
+ *
+ * O(1) y sin mutex: indexa tabla_fd. El puntero siempre es válido mientras
+ * viva el contexto; quien lo guarde debe usar referencia_cliente para
+ * detectar que el slot se reutilizó.
  */
 InfoCliente* buscar_cliente_por_socket(ContextoServidor* contexto, int socket_fd);
 
+/**
+ * @brief Referencia estable a un cliente: slot y generación
+ * @param contexto Contexto del servidor
+ * @param cliente Cliente registrado
+ * @return (índice del slot << 32) | generación
+ */
+uint64_t referencia_cliente(const ContextoServidor* contexto, const InfoCliente* cliente);
+
+/**
+ * @brief Resuelve una referencia sin tomar mutex_clientes
+ * @param contexto Contexto del servidor
+ * @param referencia Valor devuelto por referencia_cliente
+ * @return El cliente si el slot sigue ocupado por la misma generación, NULL si no
+ */
+InfoCliente* resolver_referencia_cliente(ContextoServidor* contexto, uint64_t referencia);
+
 /**
  * @brief Desconecta un cliente específico
  * @param contexto Contexto del servidor
@@ -327,10 +431,46 @@ ssize_t recibir_de_cliente(InfoCliente* cliente, char* buffer, size_t tamaño_bu
  * @param tamaño Tamaño del mensaje
  * @param excluir Cliente a excluir del broadcast (opcional)
  * @return Número de clientes que recibieron el mensaje
+ *
+ * Con reactores en marcha solo encola: una reserva por broadcast y ningún
+ * send en el hilo que lo emite, así un cliente lento no frena al resto.
  */
 int enviar_broadcast(ContextoServidor* contexto, const char* mensaje, 
                     size_t tamaño, InfoCliente* excluir);
 
+/**
+ * @brief Crea un mensaje compartido con una referencia para el llamador
+ * @param datos Contenido a copiar
+ * @param tamaño Tamaño del contenido
+ * @return Mensaje nuevo, NULL si error
+ */
+MensajeCompartido* crear_mensaje_compartido(const char* datos, size_t tamaño);
+
+/**
+ * @brief Añade una referencia a un mensaje compartido
+ * @param mensaje Mensaje a retener
+ */
+void retener_mensaje_compartido(MensajeCompartido* mensaje);
+
+/**
+ * @brief Suelta una referencia; con la última se libera el mensaje
+ * @param mensaje Mensaje a liberar
+ */
+void liberar_mensaje_compartido(MensajeCompartido* mensaje);
+
+/**
+ * @brief Pone un mensaje en la cola de salida de un cliente sin bloquear
+ * @param contexto Contexto del servidor
+ * @param cliente Cliente destinatario
+ * @param mensaje Mensaje a encolar (la cola toma su propia referencia)
+ * @return 0 si se encoló, -1 si el cliente no está activo o su cola está llena
+ *
+ * El reactor del cliente lo envía al recibir EPOLLOUT. Si la cola se llena,
+ * el cliente se marca como desbordado y su reactor lo desconecta.
+ */
+int encolar_mensaje_cliente(ContextoServidor* contexto, InfoCliente* cliente,
+                           MensajeCompartido* mensaje);
+
 // =============================================================================
 // FUNCIONES DE ESTADÍSTICAS Y LOGGING
 // =============================================================================
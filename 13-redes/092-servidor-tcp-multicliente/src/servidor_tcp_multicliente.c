@@ -5,14 +5,25 @@
  * @date 2024
  * 
  * Implementación robusta de un servidor TCP que maneja múltiples clientes
- * simultáneamente usando pthread_create para crear un hilo por conexión.
+ * simultáneamente con un número fijo de hilos reactor (epoll) a los que el
+ * hilo aceptador reparte las conexiones.
  * Incluye manejo avanzado de errores, estadísticas, logging y funciones
  * de demostración educativas.
  */
 
 #include "../include/servidor_tcp_multicliente.h"
 #include <stdarg.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sched.h>
+#include <stddef.h>
+#include <sys/epoll.h>
 #include <sys/resource.h>
+#include <sys/uio.h>
+
+#define EVENTOS_POR_ESPERA_REACTOR 64   // Eventos recogidos por epoll_wait
+#define ESPERA_REACTOR_MS 500           // Cada cuánto se revisa ejecutando
+#define ACEPTACIONES_POR_DESPERTAR 64   // accept() seguidos tras cada poll
 
 // Variable global para el contexto del servidor (para manejadores de señales)
 static ContextoServidor* g_servidor_ctx = NULL;
@@ -45,7 +56,7 @@ int validar_configuracion_servidor(const ConfigServidor* config) {
         return SERVER_ERROR_CONFIGURACION;
     }
     
-    if (config->max_conexiones <= 0 || config->max_conexiones > 1000) {
+    if (config->max_conexiones <= 0 || config->max_conexiones > MAX_CONEXIONES_LIMITE) {
         return SERVER_ERROR_CONFIGURACION;
     }
     
@@ -110,6 +121,28 @@ int aplicar_configuracion_socket(int socket_fd, const ConfigServidor* config) {
 // FUNCIONES PRINCIPALES DEL SERVIDOR
 // =============================================================================
 
+// Un descriptor nunca supera el límite blando de RLIMIT_NOFILE, así que la
+// tabla indexada por fd no necesita más entradas
+static int calcular_tam_tabla_fd(void) {
+    struct rlimit limite;
+    if (getrlimit(RLIMIT_NOFILE, &limite) != 0 ||
+        limite.rlim_cur == RLIM_INFINITY ||
+        limite.rlim_cur > MAX_TABLA_DESCRIPTORES) {
+        return MAX_TABLA_DESCRIPTORES;
+    }
+    return (int)limite.rlim_cur;
+}
+
+static void liberar_tablas_clientes(ContextoServidor* contexto) {
+    free(contexto->clientes);
+    free(contexto->tabla_fd);
+    free(contexto->slots_libres);
+    contexto->clientes = NULL;
+    contexto->tabla_fd = NULL;
+    contexto->slots_libres = NULL;
+    contexto->num_slots_libres = 0;
+}
+
 int inicializar_servidor(ContextoServidor* contexto, const ConfigServidor* config) {
     if (!contexto || !config) return SERVER_ERROR_CONFIGURACION;
     
@@ -125,21 +158,32 @@ int inicializar_servidor(ContextoServidor* contexto, const ConfigServidor* confi
     contexto->socket_servidor = -1;
     contexto->ejecutando = 0;
     
-    // Reservar memoria para clientes
+    // Reservar memoria para clientes, la tabla por descriptor y la pila de
+    // slots libres
+    contexto->tam_tabla_fd = calcular_tam_tabla_fd();
     contexto->clientes = calloc(config->max_conexiones, sizeof(InfoCliente));
-    if (!contexto->clientes) {
+    contexto->tabla_fd = calloc(contexto->tam_tabla_fd, sizeof(InfoCliente*));
+    contexto->slots_libres = malloc(config->max_conexiones * sizeof(int));
+    if (!contexto->clientes || !contexto->tabla_fd || !contexto->slots_libres) {
+        liberar_tablas_clientes(contexto);
         return SERVER_ERROR_MEMORIA;
     }
     
+    // El slot 0 queda en la cima para que se ocupen en orden
+    for (int i = 0; i < config->max_conexiones; i++) {
+        contexto->slots_libres[i] = config->max_conexiones - 1 - i;
+    }
+    contexto->num_slots_libres = config->max_conexiones;
+    
     // Inicializar mutexes
     if (pthread_mutex_init(&contexto->mutex_clientes, NULL) != 0) {
-        free(contexto->clientes);
+        liberar_tablas_clientes(contexto);
         return SERVER_ERROR_SISTEMA;
     }
     
     if (pthread_mutex_init(&contexto->mutex_logs, NULL) != 0) {
         pthread_mutex_destroy(&contexto->mutex_clientes);
-        free(contexto->clientes);
+        liberar_tablas_clientes(contexto);
         return SERVER_ERROR_SISTEMA;
     }
     
@@ -223,6 +267,218 @@ void instalar_manejadores_senales(ContextoServidor* contexto) {
     signal(SIGPIPE, SIG_IGN); // Ignorar SIGPIPE para conexiones cerradas
 }
 
+// =============================================================================
+// MENSAJES COMPARTIDOS Y COLAS DE SALIDA
+// =============================================================================
+
+MensajeCompartido* crear_mensaje_compartido(const char* datos, size_t tamaño) {
+    if (!datos || tamaño == 0) return NULL;
+    
+    MensajeCompartido* mensaje = malloc(sizeof(MensajeCompartido) + tamaño);
+    if (!mensaje) return NULL;
+    
+    mensaje->referencias = 1;
+    mensaje->tamaño = tamaño;
+    memcpy(mensaje->datos, datos, tamaño);
+    return mensaje;
+}
+
+void retener_mensaje_compartido(MensajeCompartido* mensaje) {
+    if (mensaje) {
+        __sync_add_and_fetch(&mensaje->referencias, 1);
+    }
+}
+
+void liberar_mensaje_compartido(MensajeCompartido* mensaje) {
+    if (mensaje && __sync_sub_and_fetch(&mensaje->referencias, 1) == 0) {
+        free(mensaje);
+    }
+}
+
+// Las secciones protegidas son unas pocas instrucciones y a lo sumo un
+// send o epoll_ctl no bloqueantes; si el dueño está desalojado, girar no
+// sirve de nada y se cede la CPU
+static void bloquear_cola(InfoCliente* cliente) {
+    int vueltas = 0;
+    while (__sync_lock_test_and_set(&cliente->cerrojo_cola, 1)) {
+        while (cliente->cerrojo_cola) {
+            if (++vueltas > 64) {
+                sched_yield();
+            }
+        }
+    }
+}
+
+static void desbloquear_cola(InfoCliente* cliente) {
+    __sync_lock_release(&cliente->cerrojo_cola);
+}
+
+// Cambia el interés del cliente en el epoll de su reactor: EPOLLIN para
+// leer o EPOLLOUT mientras tenga cola. Con la cola bloqueada: así el
+// descriptor no puede cerrarse (y reutilizarse) a mitad.
+static int cambiar_interes_cliente(ContextoServidor* contexto, InfoCliente* cliente,
+                                   uint32_t eventos) {
+    if (cliente->reactor < 0 || cliente->socket_fd < 0) return 0;
+    
+    struct epoll_event evento;
+    memset(&evento, 0, sizeof(evento));
+    evento.events = eventos;
+    evento.data.u64 = referencia_cliente(contexto, cliente);
+    return epoll_ctl(contexto->reactores[cliente->reactor].epoll_fd, EPOLL_CTL_MOD,
+                     cliente->socket_fd, &evento);
+}
+
+// Con la cola bloqueada. desregistrar_cliente() pone activo a 0 y cierra el
+// descriptor bajo el mismo cerrojo, así que mientras activo valga 1 el
+// socket_fd que se ve aquí es el de este cliente y no uno ya reutilizado.
+static int encolar_con_cola_bloqueada(ContextoServidor* contexto, InfoCliente* cliente,
+                                      MensajeCompartido* mensaje) {
+    if (!cliente->activo || cliente->socket_fd < 0) return -1;
+    
+    int resultado = 0;
+    if (cliente->mensajes_en_cola == CAPACIDAD_COLA_SALIDA) {
+        // No se espera a un cliente lento: su reactor lo desconecta. Con el
+        // socket lleno EPOLLOUT no llegaría nunca; shutdown le despierta con
+        // EPOLLHUP sin liberar el descriptor, que sigue siendo del reactor
+        if (!cliente->cola_desbordada) {
+            cliente->cola_desbordada = 1;
+            shutdown(cliente->socket_fd, SHUT_RDWR);
+        }
+        resultado = -1;
+    } else {
+        int posicion = (cliente->cabeza_cola + cliente->mensajes_en_cola) % CAPACIDAD_COLA_SALIDA;
+        retener_mensaje_compartido(mensaje);
+        cliente->cola_salida[posicion] = mensaje;
+        cliente->mensajes_en_cola++;
+    }
+    
+    if (!cliente->escritura_armada &&
+        cambiar_interes_cliente(contexto, cliente, EPOLLOUT) == 0) {
+        cliente->escritura_armada = 1;
+    }
+    
+    return resultado;
+}
+
+int encolar_mensaje_cliente(ContextoServidor* contexto, InfoCliente* cliente,
+                           MensajeCompartido* mensaje) {
+    if (!contexto || !cliente || !mensaje) return -1;
+    
+    bloquear_cola(cliente);
+    int resultado = encolar_con_cola_bloqueada(contexto, cliente, mensaje);
+    desbloquear_cola(cliente);
+    
+    return resultado;
+}
+
+// Entrega desde el reactor dueño del cliente: con la cola vacía se intenta
+// el send directo y solo si no cabe entero se encola el mensaje, con lo ya
+// enviado como avance de la cabeza. Se ahorra armar EPOLLOUT y desarmarlo.
+static int entregar_mensaje_propio(ContextoServidor* contexto, InfoCliente* cliente,
+                                   MensajeCompartido* mensaje) {
+    bloquear_cola(cliente);
+    
+    if (!cliente->activo || cliente->mensajes_en_cola > 0 || cliente->cola_desbordada) {
+        int resultado = encolar_con_cola_bloqueada(contexto, cliente, mensaje);
+        desbloquear_cola(cliente);
+        return resultado;
+    }
+    
+    ssize_t enviados = send(cliente->socket_fd, mensaje->datos, mensaje->tamaño, MSG_NOSIGNAL);
+    if (enviados < 0) {
+        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            desbloquear_cola(cliente);
+            return -1;
+        }
+        enviados = 0;
+    }
+    
+    int resultado = 0;
+    if ((size_t)enviados < mensaje->tamaño) {
+        resultado = encolar_con_cola_bloqueada(contexto, cliente, mensaje);
+        cliente->enviados_cabeza = (size_t)enviados;
+    } else {
+        cliente->mensajes_enviados++;
+    }
+    
+    desbloquear_cola(cliente);
+    
+    if (enviados > 0) {
+        cliente->bytes_enviados += (size_t)enviados;
+    }
+    
+    return resultado;
+}
+
+// Con la cola bloqueada
+static void descartar_cola_bloqueada(InfoCliente* cliente) {
+    while (cliente->mensajes_en_cola > 0) {
+        liberar_mensaje_compartido(cliente->cola_salida[cliente->cabeza_cola]);
+        cliente->cola_salida[cliente->cabeza_cola] = NULL;
+        cliente->cabeza_cola = (cliente->cabeza_cola + 1) % CAPACIDAD_COLA_SALIDA;
+        cliente->mensajes_en_cola--;
+    }
+    cliente->enviados_cabeza = 0;
+}
+
+// Respuesta desde el reactor dueño: con la cola vacía se envía directamente
+// sin reservar nada, y solo lo que no cabe en el socket pasa a la cola. Se
+// hace todo con la cola bloqueada para que ningún broadcast se cuele entre
+// la parte enviada y el resto.
+static int enviar_respuesta_cliente(ContextoServidor* contexto, InfoCliente* cliente,
+                                    const char* datos, size_t tamaño) {
+    int resultado = 0;
+    ssize_t enviados = 0;
+    
+    bloquear_cola(cliente);
+    
+    if (!cliente->activo || cliente->socket_fd < 0) {
+        desbloquear_cola(cliente);
+        return -1;
+    }
+    
+    if (cliente->mensajes_en_cola == 0) {
+        enviados = send(cliente->socket_fd, datos, tamaño, MSG_NOSIGNAL);
+        if (enviados < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                desbloquear_cola(cliente);
+                return -1;
+            }
+            enviados = 0;
+        }
+    }
+    
+    if ((size_t)enviados < tamaño) {
+        MensajeCompartido* resto = crear_mensaje_compartido(datos + enviados,
+                                                            tamaño - (size_t)enviados);
+        resultado = resto ? encolar_con_cola_bloqueada(contexto, cliente, resto) : -1;
+        liberar_mensaje_compartido(resto);
+    }
+    
+    desbloquear_cola(cliente);
+    
+    if (enviados > 0) {
+        cliente->bytes_enviados += (size_t)enviados;
+        cliente->ultima_actividad = obtener_timestamp_actual();
+    }
+    if ((size_t)enviados == tamaño) {
+        cliente->mensajes_enviados++;
+    }
+    
+    return resultado;
+}
+
+// Respuestas de comandos: por la cola si el cliente lo atiende un reactor,
+// send directo si lo atiende su propio hilo bloqueante
+static void responder_cliente(ContextoServidor* contexto, InfoCliente* cliente,
+                              const char* datos, size_t tamaño) {
+    if (__atomic_load_n(&cliente->reactor, __ATOMIC_ACQUIRE) >= 0) {
+        enviar_respuesta_cliente(contexto, cliente, datos, tamaño);
+    } else {
+        enviar_a_cliente(cliente, datos, tamaño);
+    }
+}
+
 // =============================================================================
 // FUNCIONES DE MANEJO DE CLIENTES
 // =============================================================================
@@ -233,13 +489,11 @@ InfoCliente* registrar_cliente(ContextoServidor* contexto, int cliente_fd,
     
     LOCK_CLIENTES(contexto);
     
-    // Buscar slot libre para el cliente
+    // Sacar un slot libre de la pila
     InfoCliente* cliente = NULL;
-    for (int i = 0; i < contexto->config.max_conexiones; i++) {
-        if (!contexto->clientes[i].activo) {
-            cliente = &contexto->clientes[i];
-            break;
-        }
+    if (contexto->num_slots_libres > 0 && cliente_fd < contexto->tam_tabla_fd) {
+        int slot = contexto->slots_libres[--contexto->num_slots_libres];
+        cliente = &contexto->clientes[slot];
     }
     
     if (!cliente) {
@@ -254,17 +508,29 @@ InfoCliente* registrar_cliente(ContextoServidor* contexto, int cliente_fd,
         return NULL;
     }
     
-    // Inicializar información del cliente
-    memset(cliente, 0, sizeof(InfoCliente));
+    // Inicializar información del cliente. La generación y el cerrojo de la
+    // cola quedan fuera del memset: las referencias al ocupante anterior
+    // deben dejar de valer, y un broadcast rezagado puede tener el cerrojo
+    bloquear_cola(cliente);
+    uint32_t generacion = cliente->generacion + 1;
+    if (generacion == 0) generacion = 1;
+    memset(cliente, 0, offsetof(InfoCliente, generacion));
     cliente->socket_fd = cliente_fd;
     cliente->direccion = *direccion;
     cliente->tiempo_conexion = obtener_timestamp_actual();
     cliente->ultima_actividad = cliente->tiempo_conexion;
-    cliente->activo = 1;
+    cliente->reactor = -1;
     
     // Generar identificador único
     generar_id_cliente(direccion, cliente->identificador, sizeof(cliente->identificador));
     
+    // Publicar para los lectores sin mutex: primero el contenido, luego
+    // activo y por último la entrada de la tabla
+    __atomic_store_n(&cliente->generacion, generacion, __ATOMIC_RELEASE);
+    __atomic_store_n(&cliente->activo, 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&contexto->tabla_fd[cliente_fd], cliente, __ATOMIC_RELEASE);
+    desbloquear_cola(cliente);
+    
     // Actualizar estadísticas
     actualizar_estadisticas_conexion(&contexto->stats, 1, 0);
     
@@ -282,8 +548,25 @@ void desregistrar_cliente(ContextoServidor* contexto, InfoCliente* cliente) {
     
     LOCK_CLIENTES(contexto);
     
-    // Marcar cliente como inactivo
-    cliente->activo = 0;
+    // Otro hilo pudo desregistrarlo mientras se esperaba el mutex; meterlo
+    // dos veces en la pila de libres lo daría a dos clientes
+    if (!cliente->activo) {
+        UNLOCK_CLIENTES(contexto);
+        return;
+    }
+    
+ 
+    // Marcar cliente como inactivo y retirarlo de la tabla antes de cerrar,
+    // porque el siguiente accept puede reutilizar el mismo descriptor. Todo
+    // con la cola bloqueada: un broadcast de otro reactor que ya vio activo
+    // a 1 termina su shutdown() o epoll_ctl() antes del close(), y los que
+    // lleguen después ven activo a 0 y socket_fd a -1
+    bloquear_cola(cliente);
+    __atomic_store_n(&cliente->activo, 0, __ATOMIC_RELEASE);
+    if (cliente->socket_fd >= 0 && cliente->socket_fd < contexto->tam_tabla_fd &&
+        contexto->tabla_fd[cliente->socket_fd] == cliente) {
+        __atomic_store_n(&contexto->tabla_fd[cliente->socket_fd], NULL, __ATOMIC_RELEASE);
+    }
     
     // Cerrar socket si está abierto
     if (cliente->socket_fd >= 0) {
@@ -291,6 +574,12 @@ void desregistrar_cliente(ContextoServidor* contexto, InfoCliente* cliente) {
         cliente->socket_fd = -1;
     }
     
+    // Soltar los mensajes que no llegaron a enviarse
+    descartar_cola_bloqueada(cliente);
+    desbloquear_cola(cliente);
+    
+    contexto->slots_libres[contexto->num_slots_libres++] = (int)(cliente - contexto->clientes);
+    
     // Actualizar estadísticas
     actualizar_estadisticas_conexion(&contexto->stats, 0, 1);
     
@@ -305,20 +594,42 @@ void desregistrar_cliente(ContextoServidor* contexto, InfoCliente* cliente) {
 }
 
 InfoCliente* buscar_cliente_por_socket(ContextoServidor* contexto, int socket_fd) {
-    if (!contexto || socket_fd < 0) return NULL;
+    if (!contexto || socket_fd < 0 || socket_fd >= contexto->tam_tabla_fd) return NULL;
+    
+    // Los slots viven tanto como el contexto, así que el puntero se puede
+    // desreferenciar aunque el cliente se esté yendo; activo y socket_fd
+    // confirman que sigue siendo el dueño del descriptor
+    InfoCliente* cliente = __atomic_load_n(&contexto->tabla_fd[socket_fd], __ATOMIC_ACQUIRE);
+    if (!cliente || !__atomic_load_n(&cliente->activo, __ATOMIC_ACQUIRE) ||
+        cliente->socket_fd != socket_fd) {
+        return NULL;
+    }
     
-    LOCK_CLIENTES(contexto);
+    return cliente;
+}
+
+uint64_t referencia_cliente(const ContextoServidor* contexto, const InfoCliente* cliente) {
+    if (!contexto || !cliente) return 0;
     
-    for (int i = 0; i < contexto->config.max_conexiones; i++) {
-        if (contexto->clientes[i].activo && 
-            contexto->clientes[i].socket_fd == socket_fd) {
-            UNLOCK_CLIENTES(contexto);
-            return &contexto->clientes[i];
-        }
+    uint64_t slot = (uint64_t)(cliente - contexto->clientes);
+    return (slot << 32) | __atomic_load_n(&cliente->generacion, __ATOMIC_ACQUIRE);
+}
+
+InfoCliente* resolver_referencia_cliente(ContextoServidor* contexto, uint64_t referencia) {
+    if (!contexto) return NULL;
+    
+    uint64_t slot = referencia >> 32;
+    if (slot >= (uint64_t)contexto->config.max_conexiones) return NULL;
+    
+    // La generación nunca es 0 en un slot ocupado, así que la referencia 0
+    // tampoco resuelve
+    InfoCliente* cliente = &contexto->clientes[slot];
+    if (!__atomic_load_n(&cliente->activo, __ATOMIC_ACQUIRE) ||
+        __atomic_load_n(&cliente->generacion, __ATOMIC_ACQUIRE) != (uint32_t)referencia) {
+        return NULL;
     }
     
-    UNLOCK_CLIENTES(contexto);
-    return NULL;
+    return cliente;
 }
 
 InfoCliente* aceptar_cliente(ContextoServidor* contexto) {
@@ -332,7 +643,8 @@ InfoCliente* aceptar_cliente(ContextoServidor* contexto) {
                            &tamaño_direccion);
     
     if (cliente_fd < 0) {
-        if (errno != EINTR && contexto->ejecutando) {
+        if (errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK &&
+            contexto->ejecutando) {
             LOG_ERROR(contexto, "Error en accept: %s", strerror(errno));
         }
         return NULL;
@@ -386,6 +698,42 @@ int enviar_broadcast(ContextoServidor* contexto, const char* mensaje,
     
     int clientes_enviados = 0;
     
+    if (contexto->num_reactores > 0) {
+        // Una sola reserva para todos los destinatarios; cada reactor lo
+        // envía a los suyos cuando sus sockets admiten datos
+        MensajeCompartido* compartido = crear_mensaje_compartido(mensaje, tamaño);
+        if (!compartido) return 0;
+        
+        // Los clientes del reactor que emite pueden recibirlo directamente
+        int reactor_actual = -1;
+        for (int r = 0; r < contexto->num_reactores; r++) {
+            if (pthread_equal(pthread_self(), contexto->reactores[r].hilo)) {
+                reactor_actual = r;
+                break;
+            }
+        }
+        
+        for (int i = 0; i < contexto->config.max_conexiones; i++) {
+            InfoCliente* cliente = &contexto->clientes[i];
+            
+            if (cliente == excluir || !__atomic_load_n(&cliente->activo, __ATOMIC_ACQUIRE)) {
+                continue;
+            }
+            
+            int resultado = (reactor_actual >= 0 &&
+                             __atomic_load_n(&cliente->reactor, __ATOMIC_ACQUIRE) == reactor_actual)
+                          ? entregar_mensaje_propio(contexto, cliente, compartido)
+                          : encolar_mensaje_cliente(contexto, cliente, compartido);
+            if (resultado == 0) {
+                clientes_enviados++;
+            }
+        }
+        
+        liberar_mensaje_compartido(compartido);
+        return clientes_enviados;
+    }
+    
+    // Sin reactores cada cliente tiene su hilo bloqueante (atender_cliente)
     LOCK_CLIENTES(contexto);
     
     for (int i = 0; i < contexto->config.max_conexiones; i++) {
@@ -403,6 +751,102 @@ int enviar_broadcast(ContextoServidor* contexto, const char* mensaje,
     return clientes_enviados;
 }
 
+// =============================================================================
+// PROCESAMIENTO DE MENSAJES
+// =============================================================================
+
+static ssize_t procesar_mensaje_eco(InfoCliente* cliente, const char* buffer,
+                                    size_t tamaño, void* contexto) {
+    (void)cliente;
+    (void)buffer;
+    (void)contexto;
+    return (ssize_t)tamaño;
+}
+
+static ssize_t procesar_mensaje_chat(InfoCliente* cliente, const char* buffer,
+                                     size_t tamaño, void* contexto) {
+    ContextoServidor* ctx = (ContextoServidor*)contexto;
+    (void)tamaño;
+    
+    // Broadcast del mensaje a todos los clientes
+    char mensaje_chat[ctx->config.buffer_size + 100];
+    snprintf(mensaje_chat, sizeof(mensaje_chat),
+            "[%s]: %s", cliente->identificador, buffer);
+    
+    int clientes_enviados = enviar_broadcast(ctx, mensaje_chat,
+                                           strlen(mensaje_chat), cliente);
+    
+    LOG_INFO(ctx, "Mensaje de %s enviado a %d clientes",
+            cliente->identificador, clientes_enviados);
+    return 0;
+}
+
+void establecer_procesador_mensajes(ContextoServidor* contexto,
+                                   ProcesadorMensaje procesador, void* datos) {
+    if (!contexto) return;
+    
+    contexto->procesador = procesador;
+    contexto->datos_procesador = datos;
+}
+
+// Atiende los comandos comunes y pasa el resto al procesador del tipo de
+// servidor. buffer debe terminar en '\0'. Devuelve los bytes de buffer a
+// enviar como respuesta, 0 si no hay respuesta o -1 para desconectar.
+static ssize_t procesar_mensaje_cliente(ContextoServidor* contexto, InfoCliente* cliente,
+                                        char* buffer, size_t tamaño) {
+    // Procesar comandos especiales
+    if (strncmp(buffer, COMANDO_QUIT, strlen(COMANDO_QUIT)) == 0) {
+        LOG_INFO(contexto, "Cliente %s solicitó desconexión", cliente->identificador);
+        return -1;
+    } else if (strncmp(buffer, COMANDO_STATS, strlen(COMANDO_STATS)) == 0) {
+        // Enviar estadísticas del cliente
+        char stats_msg[512];
+        snprintf(stats_msg, sizeof(stats_msg),
+                "=== ESTADÍSTICAS ===\n"
+                "Tiempo conectado: %ld segundos\n"
+                "Bytes enviados: %zu\n"
+                "Bytes recibidos: %zu\n"
+                "Mensajes enviados: %zu\n"
+                "Mensajes recibidos: %zu\n"
+                "==================\n",
+                obtener_timestamp_actual() - cliente->tiempo_conexion,
+                cliente->bytes_enviados, cliente->bytes_recibidos,
+                cliente->mensajes_enviados, cliente->mensajes_recibidos);
+        
+        responder_cliente(contexto, cliente, stats_msg, strlen(stats_msg));
+        return 0;
+    } else if (strncmp(buffer, COMANDO_HELP, strlen(COMANDO_HELP)) == 0) {
+        const char* help_msg =
+            "=== COMANDOS DISPONIBLES ===\n"
+            "quit  - Desconectar\n"
+            "stats - Ver estadísticas\n"
+            "help  - Esta ayuda\n"
+            "===========================\n";
+        
+        responder_cliente(contexto, cliente, help_msg, strlen(help_msg));
+        return 0;
+    }
+    
+    ProcesadorMensaje procesador = NULL;
+    if (contexto->config.tipo_servidor == TIPO_ECO) {
+        procesador = procesar_mensaje_eco;
+    } else if (contexto->config.tipo_servidor == TIPO_CHAT) {
+        procesador = procesar_mensaje_chat;
+    } else if (contexto->config.tipo_servidor == TIPO_CUSTOM) {
+        procesador = contexto->procesador;
+    }
+    
+    ssize_t respuesta = procesador ? procesador(cliente, buffer, tamaño, contexto) : 0;
+    if (respuesta > (ssize_t)tamaño) {
+        respuesta = (ssize_t)tamaño;
+    }
+    
+    // Actualizar estadísticas globales
+    actualizar_estadisticas_comunicacion(&contexto->stats, tamaño, tamaño);
+    
+    return respuesta;
+}
+
 // =============================================================================
 // FUNCIÓN PRINCIPAL DEL HILO DE CLIENTE
 // =============================================================================
@@ -441,68 +885,23 @@ void* atender_cliente(void* arg) {
     
     // Bucle principal de comunicación
     while (CLIENTE_ACTIVO(cliente) && contexto->ejecutando) {
-        ssize_t bytes_recibidos = recibir_de_cliente(cliente, buffer, 
+        ssize_t bytes_recibidos = recibir_de_cliente(cliente, buffer,
                                                     params->config->buffer_size - 1);
         
         if (bytes_recibidos > 0) {
             buffer[bytes_recibidos] = '\0';
             
-            // Procesar comandos especiales
-            if (strncmp(buffer, COMANDO_QUIT, strlen(COMANDO_QUIT)) == 0) {
-                LOG_INFO(contexto, "Cliente %s solicitó desconexión", direccion_str);
+            ssize_t respuesta = procesar_mensaje_cliente(contexto, cliente, buffer,
+                                                         (size_t)bytes_recibidos);
+            if (respuesta < 0) {
                 break;
-            } else if (strncmp(buffer, COMANDO_STATS, strlen(COMANDO_STATS)) == 0) {
-                // Enviar estadísticas del cliente
-                char stats_msg[512];
-                snprintf(stats_msg, sizeof(stats_msg),
-                        "=== ESTADÍSTICAS ===\n"
-                        "Tiempo conectado: %ld segundos\n"
-                        "Bytes enviados: %zu\n"
-                        "Bytes recibidos: %zu\n"
-                        "Mensajes enviados: %zu\n"
-                        "Mensajes recibidos: %zu\n"
-                        "==================\n",
-                        obtener_timestamp_actual() - cliente->tiempo_conexion,
-                        cliente->bytes_enviados, cliente->bytes_recibidos,
-                        cliente->mensajes_enviados, cliente->mensajes_recibidos);
-                
-                enviar_a_cliente(cliente, stats_msg, strlen(stats_msg));
-                continue;
-            } else if (strncmp(buffer, COMANDO_HELP, strlen(COMANDO_HELP)) == 0) {
-                const char* help_msg = 
-                    "=== COMANDOS DISPONIBLES ===\n"
-                    "quit  - Desconectar\n"
-                    "stats - Ver estadísticas\n"
-                    "help  - Esta ayuda\n"
-                    "===========================\n";
-                
-                enviar_a_cliente(cliente, help_msg, strlen(help_msg));
-                continue;
             }
             
-            // Eco del mensaje (comportamiento por defecto)
-            if (params->config->tipo_servidor == TIPO_ECO) {
-                if (enviar_a_cliente(cliente, buffer, bytes_recibidos) < 0) {
-                    LOG_WARN(contexto, "Error enviando eco a %s", direccion_str);
-                    break;
-                }
-            } else if (params->config->tipo_servidor == TIPO_CHAT) {
-                // Broadcast del mensaje a todos los clientes
-                char mensaje_chat[params->config->buffer_size + 100];
-                snprintf(mensaje_chat, sizeof(mensaje_chat), 
-                        "[%s]: %s", cliente->identificador, buffer);
-                
-                int clientes_enviados = enviar_broadcast(contexto, mensaje_chat, 
-                                                       strlen(mensaje_chat), cliente);
-                
-                LOG_INFO(contexto, "Mensaje de %s enviado a %d clientes", 
-                        direccion_str, clientes_enviados);
+            if (respuesta > 0 && enviar_a_cliente(cliente, buffer, (size_t)respuesta) < 0) {
+                LOG_WARN(contexto, "Error enviando respuesta a %s", direccion_str);
+                break;
             }
-            
-            // Actualizar estadísticas globales
-            actualizar_estadisticas_comunicacion(&contexto->stats, 
-                                                bytes_recibidos, bytes_recibidos);
-            
+        
         } else if (bytes_recibidos == 0) {
             // Cliente desconectado normalmente
             LOG_INFO(contexto, "Cliente %s desconectado", direccion_str);
@@ -516,7 +915,7 @@ void* atender_cliente(void* arg) {
         }
         
         // Verificar timeout del cliente
-        if (params->config->timeout_cliente > 0 && 
+        if (params->config->timeout_cliente > 0 &&
             CLIENTE_TIMEOUT(cliente, params->config->timeout_cliente)) {
             LOG_INFO(contexto, "Timeout para cliente %s", direccion_str);
             break;
@@ -543,81 +942,432 @@ void* atender_cliente(void* arg) {
 }
 
 // =============================================================================
-// FUNCIÓN PRINCIPAL DEL SERVIDOR
+// HILOS REACTOR
 // =============================================================================
 
-int ejecutar_servidor(ContextoServidor* contexto) {
-    if (!contexto) return SERVER_ERROR_CONFIGURACION;
-    
-    // Crear socket del servidor
-    if (crear_socket_servidor(contexto) < 0) {
-        return SERVER_ERROR_SOCKET;
+int calcular_num_reactores(const ConfigServidor* config) {
+    if (!config) return 1;
+    
+    // Más reactores que núcleos solo añade cambios de contexto: cada reactor
+    // ya atiende cientos de conexiones sin bloquearse
+    int reactores = config->max_hilos;
+    long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+    if (nucleos > 0 && nucleos < reactores) {
+        reactores = (int)nucleos;
     }
     
-    // Instalar manejadores de señales
-    instalar_manejadores_senales(contexto);
-    
-    // Marcar servidor como ejecutándose
-    contexto->ejecutando = 1;
-    contexto->stats.tiempo_inicio = obtener_timestamp_actual();
+    return reactores > 0 ? reactores : 1;
+}
+
+static void cerrar_cliente_reactor(ReactorServidor* reactor, InfoCliente* cliente) {
+    ContextoServidor* contexto = (ContextoServidor*)reactor->servidor_ctx;
     
-    LOG_INFO(contexto, "Servidor iniciado - Puerto: %d, Max conexiones: %d, Max hilos: %d", 
-             contexto->config.puerto, contexto->config.max_conexiones, contexto->config.max_hilos);
+    // Con mensajes a medias la despedida saldría intercalada
+    bloquear_cola(cliente);
+    if (cliente->socket_fd >= 0) {
+        epoll_ctl(reactor->epoll_fd, EPOLL_CTL_DEL, cliente->socket_fd, NULL);
+    }
+    int cola_vacia = cliente->mensajes_en_cola == 0;
+    desbloquear_cola(cliente);
+    if (cola_vacia) {
+        enviar_a_cliente(cliente, MENSAJE_DESPEDIDA, strlen(MENSAJE_DESPEDIDA));
+    }
     
-    // Bucle principal de aceptación de conexiones
-    while (contexto->ejecutando) {
-        InfoCliente* cliente = aceptar_cliente(contexto);
+    desregistrar_cliente(contexto, cliente);
+    __sync_sub_and_fetch(&reactor->conexiones, 1);
+}
+
+// Envía la cola con un sendmsg de varios iovec (writev con MSG_NOSIGNAL).
+// Solo el reactor dueño saca mensajes, así que los reunidos siguen vivos
+// fuera del cerrojo mientras los broadcasts siguen añadiendo detrás.
+// Devuelve -1 si hay que cerrar al cliente.
+static int vaciar_cola_cliente(ContextoServidor* contexto, InfoCliente* cliente) {
+    struct iovec partes[IOV_POR_ESCRITURA];
+    
+    for (;;) {
+        bloquear_cola(cliente);
+        
+        if (cliente->cola_desbordada) {
+            desbloquear_cola(cliente);
+            return -1;
+        }
+        
+        // Solo este reactor cierra el descriptor, pero se lee con el
+        // cerrojo como el resto de accesos a socket_fd
+        int socket_fd = cliente->socket_fd;
+        if (socket_fd < 0) {
+            desbloquear_cola(cliente);
+            return -1;
+        }
+        
+        int num_partes = cliente->mensajes_en_cola < IOV_POR_ESCRITURA
+                       ? cliente->mensajes_en_cola : IOV_POR_ESCRITURA;
+        if (num_partes == 0) {
+            // Cola vacía: volver a leer del cliente
+            int resultado = cambiar_interes_cliente(contexto, cliente, EPOLLIN);
+            cliente->escritura_armada = 0;
+            desbloquear_cola(cliente);
+            return resultado;
+        }
+        
+        size_t total = 0;
+        for (int i = 0; i < num_partes; i++) {
+            MensajeCompartido* mensaje =
+                cliente->cola_salida[(cliente->cabeza_cola + i) % CAPACIDAD_COLA_SALIDA];
+            size_t desplazamiento = (i == 0) ? cliente->enviados_cabeza : 0;
+            partes[i].iov_base = mensaje->datos + desplazamiento;
+            partes[i].iov_len = mensaje->tamaño - desplazamiento;
+            total += partes[i].iov_len;
+        }
+        
+        desbloquear_cola(cliente);
         
-        if (!cliente) {
-            if (contexto->ejecutando) {
-                // Solo es error si el servidor sigue ejecutándose
-                usleep(10000); // Pausa corta para evitar busy loop
+        struct msghdr envio;
+        memset(&envio, 0, sizeof(envio));
+        envio.msg_iov = partes;
+        envio.msg_iovlen = num_partes;
+        
+        ssize_t enviados = sendmsg(socket_fd, &envio, MSG_NOSIGNAL);
+        if (enviados < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) return 0;
+            return -1;
+        }
+        
+        cliente->bytes_enviados += (size_t)enviados;
+        cliente->ultima_actividad = obtener_timestamp_actual();
+        
+        // Retirar los mensajes enviados enteros y avanzar en el parcial
+        bloquear_cola(cliente);
+        size_t resto = (size_t)enviados;
+        while (resto > 0) {
+            MensajeCompartido* mensaje = cliente->cola_salida[cliente->cabeza_cola];
+            size_t pendiente = mensaje->tamaño - cliente->enviados_cabeza;
+            if (resto < pendiente) {
+                cliente->enviados_cabeza += resto;
+                break;
             }
-            continue;
+            resto -= pendiente;
+            liberar_mensaje_compartido(mensaje);
+            cliente->cola_salida[cliente->cabeza_cola] = NULL;
+            cliente->cabeza_cola = (cliente->cabeza_cola + 1) % CAPACIDAD_COLA_SALIDA;
+            cliente->mensajes_en_cola--;
+            cliente->enviados_cabeza = 0;
+            cliente->mensajes_enviados++;
         }
+        desbloquear_cola(cliente);
         
-        // Verificar límite de hilos activos
+        // Socket lleno: EPOLLOUT sigue armado y avisará cuando haya hueco
+        if ((size_t)enviados < total) return 0;
+    }
+}
+
+static void atender_escritura_reactor(ReactorServidor* reactor, InfoCliente* cliente) {
+    ContextoServidor* contexto = (ContextoServidor*)reactor->servidor_ctx;
+    
+    if (vaciar_cola_cliente(contexto, cliente) == 0) return;
+    
+    if (cliente->cola_desbordada) {
+        LOG_WARN(contexto, "Cola de salida llena para %s, desconectando cliente lento",
+                 cliente->identificador);
         LOCK_STATS(&contexto->stats);
-        int hilos_activos = contexto->stats.hilos_activos;
+        contexto->stats.desconexiones_cola_llena++;
         UNLOCK_STATS(&contexto->stats);
+    } else {
+        LOG_WARN(contexto, "Error enviando a %s: %s", cliente->identificador, strerror(errno));
+    }
+    cerrar_cliente_reactor(reactor, cliente);
+}
+
+static void atender_lectura_reactor(ReactorServidor* reactor, InfoCliente* cliente,
+                                    char* buffer) {
+    ContextoServidor* contexto = (ContextoServidor*)reactor->servidor_ctx;
+    
+    ssize_t bytes_recibidos = recibir_de_cliente(cliente, buffer,
+                                                contexto->config.buffer_size - 1);
+    if (bytes_recibidos == 0) {
+        LOG_INFO(contexto, "Cliente %s desconectado", cliente->identificador);
+        cerrar_cliente_reactor(reactor, cliente);
+        return;
+    }
+    
+    if (bytes_recibidos < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) return;
+        LOG_WARN(contexto, "Error recibiendo de %s: %s",
+                 cliente->identificador, strerror(errno));
+        cerrar_cliente_reactor(reactor, cliente);
+        return;
+    }
+    
+    buffer[bytes_recibidos] = '\0';
+    
+    ssize_t respuesta = procesar_mensaje_cliente(contexto, cliente, buffer,
+                                                 (size_t)bytes_recibidos);
+    if (respuesta < 0) {
+        cerrar_cliente_reactor(reactor, cliente);
+        return;
+    }
+    
+    if (respuesta > 0 &&
+        enviar_respuesta_cliente(contexto, cliente, buffer, (size_t)respuesta) < 0) {
+        LOG_WARN(contexto, "Error enviando respuesta a %s", cliente->identificador);
+        cerrar_cliente_reactor(reactor, cliente);
+    }
+}
+
+// Cierra los clientes del reactor caducados, o todos si todos != 0. Solo este
+// reactor cierra a sus clientes, así que basta la lectura sin mutex.
+static void cerrar_clientes_reactor(ReactorServidor* reactor, int todos) {
+    ContextoServidor* contexto = (ContextoServidor*)reactor->servidor_ctx;
+    int timeout = contexto->config.timeout_cliente;
+    
+    if (!todos && timeout <= 0) return;
+    
+    for (int i = 0; i < contexto->config.max_conexiones; i++) {
+        InfoCliente* cliente = &contexto->clientes[i];
         
-        if (hilos_activos >= contexto->config.max_hilos) {
-            LOG_WARN(contexto, "Máximo de hilos alcanzado, rechazando cliente");
-            desregistrar_cliente(contexto, cliente);
+        if (!__atomic_load_n(&cliente->activo, __ATOMIC_ACQUIRE) ||
+            __atomic_load_n(&cliente->reactor, __ATOMIC_ACQUIRE) != reactor->id) {
             continue;
         }
         
-        // Crear parámetros para el hilo
-        ParametrosHilo* params = malloc(sizeof(ParametrosHilo));
-        if (!params) {
-            LOG_ERROR(contexto, "Error asignando memoria para parámetros de hilo");
-            desregistrar_cliente(contexto, cliente);
-            continue;
+        if (todos) {
+            cerrar_cliente_reactor(reactor, cliente);
+        } else if (CLIENTE_TIMEOUT(cliente, timeout)) {
+            LOG_INFO(contexto, "Timeout para cliente %s", cliente->identificador);
+            cerrar_cliente_reactor(reactor, cliente);
+        }
+    }
+}
+
+void* ejecutar_reactor(void* arg) {
+    ReactorServidor* reactor = (ReactorServidor*)arg;
+    ContextoServidor* contexto = (ContextoServidor*)reactor->servidor_ctx;
+    char* buffer = malloc(contexto->config.buffer_size);
+    
+    if (!buffer) {
+        LOG_ERROR(contexto, "Error asignando buffer para reactor %d", reactor->id);
+        return NULL;
+    }
+    
+    LOCK_STATS(&contexto->stats);
+    contexto->stats.hilos_activos++;
+    UNLOCK_STATS(&contexto->stats);
+    
+    struct epoll_event eventos[EVENTOS_POR_ESPERA_REACTOR];
+    time_t ultima_revision = obtener_timestamp_actual();
+    
+    while (contexto->ejecutando) {
+        int listos = epoll_wait(reactor->epoll_fd, eventos,
+                                EVENTOS_POR_ESPERA_REACTOR, ESPERA_REACTOR_MS);
+        if (listos < 0) {
+            if (errno == EINTR) continue;
+            LOG_ERROR(contexto, "Error en epoll_wait del reactor %d: %s",
+                      reactor->id, strerror(errno));
+            break;
         }
         
-        params->cliente = cliente;
-        params->config = &contexto->config;
-        params->servidor_ctx = contexto;
+        for (int i = 0; i < listos; i++) {
+            // Un evento de esta misma tanda pudo cerrar al cliente y el
+            // aceptador reutilizar su slot: la generación ya no coincide
+            InfoCliente* cliente = resolver_referencia_cliente(contexto, eventos[i].data.u64);
+            if (!cliente) continue;
+            
+            // El interés es EPOLLIN o EPOLLOUT, nunca ambos: mientras haya
+            // cola no se lee, y así el eco no acumula respuestas sin límite.
+            // HUP y ERR se descubren al leer o escribir.
+            if (eventos[i].events & EPOLLOUT || cliente->cola_desbordada) {
+                atender_escritura_reactor(reactor, cliente);
+            } else {
+                atender_lectura_reactor(reactor, cliente, buffer);
+            }
+        }
+        
+        time_t ahora = obtener_timestamp_actual();
+        if (ahora != ultima_revision) {
+            cerrar_clientes_reactor(reactor, 0);
+            ultima_revision = ahora;
+        }
+    }
+    
+    cerrar_clientes_reactor(reactor, 1);
+    
+    LOCK_STATS(&contexto->stats);
+    contexto->stats.hilos_activos--;
+    UNLOCK_STATS(&contexto->stats);
+    
+    free(buffer);
+    return NULL;
+}
+
+int asignar_cliente_a_reactor(ContextoServidor* contexto, InfoCliente* cliente) {
+    if (!contexto || !CLIENTE_ACTIVO(cliente) || contexto->num_reactores <= 0) {
+        return SERVER_ERROR_CONFIGURACION;
+    }
+    
+    int flags = fcntl(cliente->socket_fd, F_GETFL, 0);
+    if (flags < 0 || fcntl(cliente->socket_fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+        return SERVER_ERROR_SISTEMA;
+    }
+    
+    // El socket está vacío, así que la bienvenida cabe entera
+    if (enviar_a_cliente(cliente, MENSAJE_BIENVENIDA, strlen(MENSAJE_BIENVENIDA)) < 0) {
+        LOG_WARN(contexto, "Error enviando bienvenida a %s", cliente->identificador);
+    }
+    
+    // Reparto al menos cargado; solo este hilo suma, los reactores restan
+    ReactorServidor* reactor = &contexto->reactores[0];
+    for (int i = 1; i < contexto->num_reactores; i++) {
+        if (contexto->reactores[i].conexiones < reactor->conexiones) {
+            reactor = &contexto->reactores[i];
+        }
+    }
+    
+    cliente->thread_id = reactor->hilo;
+    __sync_add_and_fetch(&reactor->conexiones, 1);
+    
+    // Un broadcast pudo encolar algo antes de tener reactor; con la cola
+    // bloqueada nadie puede armar EPOLLOUT entre la elección y el ADD
+    bloquear_cola(cliente);
+    __atomic_store_n(&cliente->reactor, reactor->id, __ATOMIC_RELEASE);
+    cliente->escritura_armada = cliente->mensajes_en_cola > 0 || cliente->cola_desbordada;
+    
+    struct epoll_event evento;
+    memset(&evento, 0, sizeof(evento));
+    evento.events = cliente->escritura_armada ? EPOLLOUT : EPOLLIN;
+    evento.data.u64 = referencia_cliente(contexto, cliente);
+    int resultado = epoll_ctl(reactor->epoll_fd, EPOLL_CTL_ADD, cliente->socket_fd, &evento);
+    desbloquear_cola(cliente);
+    
+    if (resultado < 0) {
+        __sync_sub_and_fetch(&reactor->conexiones, 1);
+        LOG_ERROR(contexto, "Error añadiendo cliente al reactor %d: %s",
+                  reactor->id, strerror(errno));
+        return SERVER_ERROR_SISTEMA;
+    }
+    
+    return SERVER_EXITO;
+}
+
+static void detener_reactores(ContextoServidor* contexto) {
+    // Los reactores ven ejecutando == 0 como mucho ESPERA_REACTOR_MS después
+    for (int i = 0; i < contexto->num_reactores; i++) {
+        pthread_join(contexto->reactores[i].hilo, NULL);
+        close(contexto->reactores[i].epoll_fd);
+    }
+    
+    free(contexto->reactores);
+    contexto->reactores = NULL;
+    contexto->num_reactores = 0;
+}
+
+static int iniciar_reactores(ContextoServidor* contexto) {
+    int total = calcular_num_reactores(&contexto->config);
+    
+    contexto->reactores = calloc(total, sizeof(ReactorServidor));
+    if (!contexto->reactores) {
+        return SERVER_ERROR_MEMORIA;
+    }
+    
+    for (int i = 0; i < total; i++) {
+        ReactorServidor* reactor = &contexto->reactores[i];
+        reactor->id = i;
+        reactor->servidor_ctx = contexto;
+        reactor->epoll_fd = epoll_create1(0);
         
-        // Crear hilo para atender al cliente
-        if (pthread_create(&cliente->thread_id, NULL, atender_cliente, params) != 0) {
-            LOG_ERROR(contexto, "Error creando hilo para cliente: %s", strerror(errno));
-            desregistrar_cliente(contexto, cliente);
-            free(params);
+        if (reactor->epoll_fd < 0 ||
+            pthread_create(&reactor->hilo, NULL, ejecutar_reactor, reactor) != 0) {
+            LOG_ERROR(contexto, "Error creando reactor %d: %s", i, strerror(errno));
+            if (reactor->epoll_fd >= 0) close(reactor->epoll_fd);
             
             LOCK_STATS(&contexto->stats);
             contexto->stats.errores_hilos++;
             UNLOCK_STATS(&contexto->stats);
             
+            // Parar los que ya arrancaron
+            contexto->ejecutando = 0;
+            detener_reactores(contexto);
+            return SERVER_ERROR_THREAD;
+        }
+        
+        contexto->num_reactores = i + 1;
+    }
+    
+    return SERVER_EXITO;
+}
+
+// =============================================================================
+// FUNCIÓN PRINCIPAL DEL SERVIDOR
+// =============================================================================
+
+int ejecutar_servidor(ContextoServidor* contexto) {
+    if (!contexto) return SERVER_ERROR_CONFIGURACION;
+    
+    // Crear socket del servidor
+    if (crear_socket_servidor(contexto) < 0) {
+        return SERVER_ERROR_SOCKET;
+    }
+    
+    // accept no debe bloquear si el cliente se va entre poll y accept
+    int flags = fcntl(contexto->socket_servidor, F_GETFL, 0);
+    if (flags >= 0) {
+        fcntl(contexto->socket_servidor, F_SETFL, flags | O_NONBLOCK);
+    }
+    
+    // Instalar manejadores de señales
+    instalar_manejadores_senales(contexto);
+    
+    // Marcar servidor como ejecutándose
+    contexto->ejecutando = 1;
+    contexto->stats.tiempo_inicio = obtener_timestamp_actual();
+    
+    int resultado = iniciar_reactores(contexto);
+    if (resultado != SERVER_EXITO) {
+        close(contexto->socket_servidor);
+        contexto->socket_servidor = -1;
+        return resultado;
+    }
+    
+    LOG_INFO(contexto, "Servidor iniciado - Puerto: %d, Max conexiones: %d, Reactores: %d/%d",
+             contexto->config.puerto, contexto->config.max_conexiones,
+             contexto->num_reactores, contexto->config.max_hilos);
+    
+    // Bucle principal de aceptación: el timeout de poll permite ver
+    // ejecutando == 0 aunque no lleguen conexiones
+    struct pollfd escucha;
+    escucha.fd = contexto->socket_servidor;
+    escucha.events = POLLIN;
+    
+    while (contexto->ejecutando) {
+        escucha.revents = 0;
+        if (poll(&escucha, 1, ESPERA_REACTOR_MS) <= 0) {
             continue;
         }
         
-        // Detach del hilo para liberación automática de recursos
-        if (pthread_detach(cliente->thread_id) != 0) {
-            LOG_WARN(contexto, "Error haciendo detach del hilo");
+        for (int i = 0; i < ACEPTACIONES_POR_DESPERTAR && contexto->ejecutando; i++) {
+            errno = 0;
+            InfoCliente* cliente = aceptar_cliente(contexto);
+            
+            if (!cliente) {
+                if (errno != 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                    // Sin descriptores o memoria: pausa corta para evitar busy loop
+                    usleep(10000);
+                }
+                break;
+            }
+            
+            if (asignar_cliente_a_reactor(contexto, cliente) != SERVER_EXITO) {
+                desregistrar_cliente(contexto, cliente);
+            }
         }
     }
     
+    detener_reactores(contexto);
+    
+    if (contexto->socket_servidor >= 0) {
+        close(contexto->socket_servidor);
+        contexto->socket_servidor = -1;
+    }
+    
     LOG_INFO(contexto, "Servidor detenido");
     return SERVER_EXITO;
 }
@@ -628,21 +1378,8 @@ void detener_servidor(ContextoServidor* contexto) {
     LOG_INFO(contexto, "Iniciando detención del servidor...");
     contexto->ejecutando = 0;
     
-    // Cerrar socket principal para interrumpir accept()
-    if (contexto->socket_servidor >= 0) {
-        close(contexto->socket_servidor);
-        contexto->socket_servidor = -1;
-    }
-    
-    // Desconectar todos los clientes activos
-    LOCK_CLIENTES(contexto);
-    for (int i = 0; i < contexto->config.max_conexiones; i++) {
-        if (contexto->clientes[i].activo) {
-            close(contexto->clientes[i].socket_fd);
-            contexto->clientes[i].activo = 0;
-        }
-    }
-    UNLOCK_CLIENTES(contexto);
+    // El bucle de aceptación cierra el socket principal y cada reactor
+    // despide y desregistra a sus propios clientes al salir
     
     // Esperar un poco para que los hilos terminen
     sleep(1);
@@ -654,10 +1391,7 @@ void limpiar_servidor(ContextoServidor* contexto) {
     if (!contexto) return;
     
     // Liberar memoria de clientes
-    if (contexto->clientes) {
-        free(contexto->clientes);
-        contexto->clientes = NULL;
-    }
+    liberar_tablas_clientes(contexto);
     
     // Destruir mutexes
     pthread_mutex_destroy(&contexto->mutex_clientes);
@@ -732,6 +1466,7 @@ void mostrar_estadisticas_servidor(const ContextoServidor* contexto) {
     printf("Mensajes totales: %zu\n", contexto->stats.mensajes_totales);
     printf("Errores de red: %zu\n", contexto->stats.errores_red);
     printf("Errores de hilos: %zu\n", contexto->stats.errores_hilos);
+    printf("Clientes lentos desconectados: %zu\n", contexto->stats.desconexiones_cola_llena);
     
     if (tiempo_ejecucion > 0) {
         printf("Promedio conexiones/hora: %.2f\n", 
@@ -0,0 +1,335 @@
+/**
+ * @file benchmark_broadcast.c
+ * @brief Benchmark del broadcast del chat con una fracción de lectores lentos
+ * @author Autor: Tu Nombre
+ * @date 2024
+ *
+ * Arranca el servidor en modo TIPO_CHAT dentro del proceso, conecta N
+ * destinatarios y un emisor, y mide cuánto tarda cada mensaje del emisor
+ * en llegar a todos los destinatarios rápidos. Los lectores lentos nunca
+ * leen: con las colas de salida por cliente deben acabar desconectados sin
+ * que la latencia de los rápidos se resienta. Cada escenario se ejecuta sin
+ * lentos y con lentos para comparar.
+ */
+
+#include "servidor_tcp_multicliente.h"
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <fcntl.h>
+
+#define DESTINATARIOS_DEFAULT 1000
+#define PORCENTAJE_LENTOS_DEFAULT 1.0
+#define MENSAJES_DEFAULT 500
+#define TAMAÑO_MENSAJE_DEFAULT 128
+#define PUERTO_BENCHMARK_BROADCAST 9494
+#define RCVBUF_LECTOR_LENTO 4096
+#define ESPERA_MAXIMA_MENSAJE_S 5
+
+/**
+ * @brief Estado compartido entre el emisor y el hilo lector
+ */
+typedef struct {
+    int* sockets;                ///< Sockets de los destinatarios rápidos
+    size_t* recibidos;           ///< Mensajes completos por destinatario
+    int num_rapidos;             ///< Número de destinatarios rápidos
+    int* llegadas;               ///< Destinatarios que ya tienen cada mensaje
+    int mensajes;                ///< Mensajes que enviará el emisor
+    int completados;             ///< Mensajes recibidos por todos los rápidos
+    volatile int ejecutando;     ///< El lector sigue mientras valga 1
+    pthread_mutex_t mutex;       ///< Protege completados
+    pthread_cond_t cond;         ///< Avisa al emisor de cada mensaje completo
+} EstadoLector;
+
+static ContextoServidor g_contexto;
+
+static double segundos_monotonicos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int comparar_doubles(const void* a, const void* b) {
+    double da = *(const double*)a;
+    double db = *(const double*)b;
+    return (da > db) - (da < db);
+}
+
+static void* hilo_servidor(void* arg) {
+    (void)arg;
+    ejecutar_servidor(&g_contexto);
+    return NULL;
+}
+
+static int conectar_destinatario(int puerto, int rcvbuf) {
+    int sockfd = socket(AF_INET, SOCK_STREAM, 0);
+    if (sockfd < 0) return -1;
+
+    // Con el buffer de recepción pequeño el lector lento se llena antes
+    if (rcvbuf > 0) {
+        setsockopt(sockfd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+    }
+
+    struct sockaddr_in direccion;
+    memset(&direccion, 0, sizeof(direccion));
+    direccion.sin_family = AF_INET;
+    direccion.sin_port = htons(puerto);
+    direccion.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (connect(sockfd, (struct sockaddr*)&direccion, sizeof(direccion)) < 0) {
+        close(sockfd);
+        return -1;
+    }
+
+    // Consumir la bienvenida para que no cuente como mensaje
+    char bienvenida[sizeof(MENSAJE_BIENVENIDA)];
+    if (recv(sockfd, bienvenida, strlen(MENSAJE_BIENVENIDA), MSG_WAITALL) !=
+        (ssize_t)strlen(MENSAJE_BIENVENIDA)) {
+        close(sockfd);
+        return -1;
+    }
+
+    return sockfd;
+}
+
+/**
+ * @brief Lee de todos los destinatarios rápidos y cuenta mensajes completos
+ *
+ * Cada mensaje del emisor acaba en '\n' y no contiene otro, así que cada
+ * salto de línea recibido es un mensaje entregado.
+ */
+static void* hilo_lector(void* arg) {
+    EstadoLector* estado = (EstadoLector*)arg;
+    int epoll_fd = epoll_create1(0);
+    if (epoll_fd < 0) return NULL;
+
+    for (int i = 0; i < estado->num_rapidos; i++) {
+        struct epoll_event evento;
+        memset(&evento, 0, sizeof(evento));
+        evento.events = EPOLLIN;
+        evento.data.u32 = (uint32_t)i;
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, estado->sockets[i], &evento);
+    }
+
+    struct epoll_event eventos[256];
+    char buffer[65536];
+
+    while (estado->ejecutando) {
+        int listos = epoll_wait(epoll_fd, eventos, 256, 100);
+
+        for (int e = 0; e < listos; e++) {
+            int i = (int)eventos[e].data.u32;
+            ssize_t n = recv(estado->sockets[i], buffer, sizeof(buffer), 0);
+            if (n <= 0) {
+                if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+                    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, estado->sockets[i], NULL);
+                }
+                continue;
+            }
+
+            for (ssize_t b = 0; b < n; b++) {
+                if (buffer[b] != '\n') continue;
+
+                size_t mensaje = estado->recibidos[i]++;
+                if (mensaje < (size_t)estado->mensajes &&
+                    ++estado->llegadas[mensaje] == estado->num_rapidos) {
+                    pthread_mutex_lock(&estado->mutex);
+                    estado->completados++;
+                    pthread_cond_signal(&estado->cond);
+                    pthread_mutex_unlock(&estado->mutex);
+                }
+            }
+        }
+    }
+
+    close(epoll_fd);
+    return NULL;
+}
+
+/**
+ * @brief Ejecuta un escenario completo y muestra sus resultados
+ * @return 0 si todos los mensajes llegaron a todos los rápidos, -1 si no
+ */
+static int ejecutar_escenario(int puerto, int destinatarios, int lentos,
+                              int mensajes, int tamaño_mensaje) {
+    ConfigServidor config;
+    configurar_servidor_por_defecto(&config);
+    config.puerto = puerto;
+    config.tipo_servidor = TIPO_CHAT;
+    config.max_conexiones = destinatarios + 16;
+    config.log_detallado = 0;
+    config.timeout_cliente = 0;
+    config.backlog = 128;
+
+    if (inicializar_servidor(&g_contexto, &config) != SERVER_EXITO) {
+        fprintf(stderr, "Error inicializando servidor\n");
+        return -1;
+    }
+
+    pthread_t servidor;
+    pthread_create(&servidor, NULL, hilo_servidor, NULL);
+    usleep(200000);
+
+    int num_rapidos = destinatarios - lentos;
+    EstadoLector estado;
+    memset(&estado, 0, sizeof(estado));
+    estado.sockets = malloc(num_rapidos * sizeof(int));
+    estado.recibidos = calloc(num_rapidos, sizeof(size_t));
+    estado.llegadas = calloc(mensajes, sizeof(int));
+    estado.num_rapidos = num_rapidos;
+    estado.mensajes = mensajes;
+    estado.ejecutando = 1;
+    pthread_mutex_init(&estado.mutex, NULL);
+    pthread_cond_init(&estado.cond, NULL);
+
+    int* sockets_lentos = malloc((lentos > 0 ? lentos : 1) * sizeof(int));
+    double* latencias = malloc(mensajes * sizeof(double));
+    int resultado = 0;
+    int rapidos = 0, lentos_conectados = 0;
+
+    // Repartir los lentos entre los rápidos en vez de ponerlos todos juntos
+    for (int i = 0; i < destinatarios; i++) {
+        int lento = lentos > 0 && (long)i * lentos / destinatarios !=
+                                  (long)(i + 1) * lentos / destinatarios;
+        int sockfd = conectar_destinatario(puerto, lento ? RCVBUF_LECTOR_LENTO : 0);
+        if (sockfd < 0) {
+            fprintf(stderr, "Error conectando destinatario %d: %s\n", i, strerror(errno));
+            resultado = -1;
+            break;
+        }
+
+        if (lento) {
+            sockets_lentos[lentos_conectados++] = sockfd;
+        } else {
+            fcntl(sockfd, F_SETFL, fcntl(sockfd, F_GETFL, 0) | O_NONBLOCK);
+            estado.sockets[rapidos++] = sockfd;
+        }
+    }
+
+    int emisor = resultado == 0 ? conectar_destinatario(puerto, 0) : -1;
+    pthread_t lector;
+    int lector_iniciado = 0;
+
+    if (emisor < 0 || rapidos != num_rapidos) {
+        resultado = -1;
+    } else {
+        pthread_create(&lector, NULL, hilo_lector, &estado);
+        lector_iniciado = 1;
+    }
+
+    char* mensaje = malloc(tamaño_mensaje);
+    memset(mensaje, 'A', tamaño_mensaje - 1);
+    mensaje[tamaño_mensaje - 1] = '\n';
+
+    double inicio = segundos_monotonicos();
+    int enviados = 0;
+
+    // Bucle cerrado: el siguiente mensaje sale cuando todos los rápidos
+    // tienen el anterior, así el servidor nunca junta dos en un recv
+    for (int k = 0; k < mensajes && resultado == 0; k++) {
+        double t0 = segundos_monotonicos();
+        if (send(emisor, mensaje, tamaño_mensaje, MSG_NOSIGNAL) != tamaño_mensaje) {
+            resultado = -1;
+            break;
+        }
+
+        struct timespec limite;
+        clock_gettime(CLOCK_REALTIME, &limite);
+        limite.tv_sec += ESPERA_MAXIMA_MENSAJE_S;
+
+        pthread_mutex_lock(&estado.mutex);
+        while (estado.completados <= k && resultado == 0) {
+            if (pthread_cond_timedwait(&estado.cond, &estado.mutex, &limite) == ETIMEDOUT) {
+                fprintf(stderr, "Mensaje %d: solo %d/%d destinatarios tras %d s\n",
+                        k, estado.llegadas[k], num_rapidos, ESPERA_MAXIMA_MENSAJE_S);
+                resultado = -1;
+            }
+        }
+        pthread_mutex_unlock(&estado.mutex);
+
+        latencias[k] = (segundos_monotonicos() - t0) * 1e6;
+        enviados++;
+    }
+
+    double duracion = segundos_monotonicos() - inicio;
+
+    estado.ejecutando = 0;
+    if (lector_iniciado) pthread_join(lector, NULL);
+
+    LOCK_STATS(&g_contexto.stats);
+    size_t expulsados = g_contexto.stats.desconexiones_cola_llena;
+    UNLOCK_STATS(&g_contexto.stats);
+
+    double p50 = 0.0, p99 = 0.0, maximo = 0.0;
+    if (enviados > 0) {
+        qsort(latencias, enviados, sizeof(double), comparar_doubles);
+        p50 = latencias[enviados / 2];
+        p99 = latencias[(int)(enviados * 0.99)];
+        maximo = latencias[enviados - 1];
+    }
+
+    printf("%-10d %-7d %9.0f %9.1f %9.1f %9.1f %11.0f %11zu\n",
+           destinatarios, lentos, enviados / duracion, p50, p99, maximo,
+           (double)enviados * num_rapidos / duracion, expulsados);
+
+    // Parar el servidor y cerrar los clientes
+    detener_servidor(&g_contexto);
+    pthread_join(servidor, NULL);
+
+    if (emisor >= 0) close(emisor);
+    for (int i = 0; i < rapidos; i++) close(estado.sockets[i]);
+    for (int i = 0; i < lentos_conectados; i++) close(sockets_lentos[i]);
+    limpiar_servidor(&g_contexto);
+
+    pthread_mutex_destroy(&estado.mutex);
+    pthread_cond_destroy(&estado.cond);
+    free(estado.sockets);
+    free(estado.recibidos);
+    free(estado.llegadas);
+    free(sockets_lentos);
+    free(latencias);
+    free(mensaje);
+
+    return resultado;
+}
+
+int main(int argc, char* argv[]) {
+    int destinatarios = argc > 1 ? atoi(argv[1]) : DESTINATARIOS_DEFAULT;
+    double porcentaje_lentos = argc > 2 ? atof(argv[2]) : PORCENTAJE_LENTOS_DEFAULT;
+    int mensajes = argc > 3 ? atoi(argv[3]) : MENSAJES_DEFAULT;
+    int tamaño_mensaje = argc > 4 ? atoi(argv[4]) : TAMAÑO_MENSAJE_DEFAULT;
+
+    if (destinatarios <= 0 || destinatarios > MAX_CONEXIONES_LIMITE - 16 ||
+        porcentaje_lentos < 0 || porcentaje_lentos >= 100 || mensajes <= 0 ||
+        tamaño_mensaje < 2 || tamaño_mensaje >= BUFFER_SIZE_DEFAULT - 100) {
+        fprintf(stderr, "Uso: %s [destinatarios] [%%_lentos] [mensajes] [tamaño]\n", argv[0]);
+        return 1;
+    }
+
+    // Cada destinatario ocupa dos descriptores en este proceso
+    struct rlimit limite;
+    if (getrlimit(RLIMIT_NOFILE, &limite) == 0 && limite.rlim_cur < limite.rlim_max) {
+        limite.rlim_cur = limite.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limite);
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+
+    int lentos = (int)(destinatarios * porcentaje_lentos / 100.0 + 0.5);
+
+    printf("=== BENCHMARK BROADCAST CHAT ===\n");
+    printf("%d mensajes de %d bytes; los lentos nunca leen (SO_RCVBUF %d)\n",
+           mensajes, tamaño_mensaje, RCVBUF_LECTOR_LENTO);
+    printf("Latencia: desde el send del emisor hasta que el último rápido lo tiene\n\n");
+    printf("%-10s %-7s %9s %9s %9s %9s %11s %11s\n",
+           "Destinos", "Lentos", "Msg/s", "p50 us", "p99 us", "max us",
+           "Entregas/s", "Expulsados");
+
+    int resultado = ejecutar_escenario(PUERTO_BENCHMARK_BROADCAST, destinatarios, 0,
+                                       mensajes, tamaño_mensaje);
+    if (lentos > 0) {
+        resultado |= ejecutar_escenario(PUERTO_BENCHMARK_BROADCAST + 1, destinatarios, lentos,
+                                        mensajes, tamaño_mensaje);
+    }
+
+    return resultado == 0 ? 0 : 1;
+}